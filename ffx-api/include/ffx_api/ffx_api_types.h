@@ -237,6 +237,6 @@ typedef struct FfxApiSwapchainFramePacingTuning
     float safetyMarginInMs; // in Millisecond. Default is 0.1ms
     float varianceFactor; // valid range [0.0,1.0]. Default is 0.1
     bool     allowHybridSpin; //Allows pacing spinlock to sleep. Default is false.
-    uint32_t hybridSpinTime;  //How long to spin if allowHybridSpin is true. Measured in timer resolution units. Not recommended to go below 2. Will result in frequent overshoots. Default is 2.
+    uint32_t hybridSpinTime;  //How long to spin if allowHybridSpin is true. Measured in timer resolution units. Not recommended to go below 2. Will result in frequent overshoots. Default is 2. Only the initial value, the spin time is calibrated to the measured sleep overshoot at runtime.
     bool     allowWaitForSingleObjectOnFence; //Allows WaitForSingleObject instead of spinning for fence value. Default is false.
 } FfxApiSwapchainFramePacingTuning;
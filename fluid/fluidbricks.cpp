@@ -0,0 +1,241 @@
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include "fluidbricks.h"
+#include "fluidworkerpool.h"
+
+constexpr uint32_t FluidBrickVolume::BrickSamples;
+constexpr uint32_t FluidBrickVolume::BrickCells;
+constexpr uint32_t FluidBrickVolume::AtlasBricksX;
+constexpr uint32_t FluidBrickVolume::AtlasBricksY;
+constexpr uint32_t FluidBrickVolume::MaxPageTableSize;
+constexpr uint32_t FluidBrickVolume::EmptyBrick;
+
+namespace
+{
+// Same smooth union as sdf.hlsl
+float smin(float a, float b, float k)
+{
+    if (k <= 0)
+        return std::min(a, b);
+
+    k *= 4.0f;
+    float h = std::max(k - std::abs(a - b), 0.0f) / k;
+    return std::min(a, b) - h * h * k * (1.0f / 4.0f);
+}
+
+// Bricks are filled in parallel, each one is 512 samples of work
+constexpr uint32_t BrickChunkSize = 4;
+}
+
+size_t FluidBrickVolume::GetAtlasOffset(uint32_t brick, uint32_t x, uint32_t y, uint32_t z) const
+{
+    uint32_t brickX = brick % AtlasBricksX;
+    uint32_t brickY = (brick / AtlasBricksX) % AtlasBricksY;
+    uint32_t brickZ = brick / (AtlasBricksX * AtlasBricksY);
+
+    size_t texelX = brickX * BrickSamples + x;
+    size_t texelY = brickY * BrickSamples + y;
+    size_t texelZ = brickZ * BrickSamples + z;
+    return (texelZ * GetAtlasHeight() + texelY) * GetAtlasWidth() + texelX;
+}
+
+void FluidBrickVolume::Build(const FluidBrickParams& params, const std::vector<GPUParticle>& particles, FluidWorkerPool& workers)
+{
+    m_params     = params;
+    m_brickCount = 0;
+
+    AllocateBricks(particles);
+
+    m_atlasBricksZ = (m_brickCount + AtlasBricksX * AtlasBricksY - 1) / (AtlasBricksX * AtlasBricksY);
+    m_atlas.resize(static_cast<size_t>(GetAtlasWidth()) * GetAtlasHeight() * GetAtlasDepth());
+
+    workers.ParallelFor(m_brickCount, BrickChunkSize, [&](uint32_t begin, uint32_t end)
+    {
+        for (uint32_t brick = begin; brick < end; brick++)
+            FillBrick(brick, particles);
+    });
+}
+
+void FluidBrickVolume::AllocateBricks(const std::vector<GPUParticle>& particles)
+{
+    // Past this distance a particle can neither reach the band nor change the smooth union inside it
+    auto getReach = [&](const Vec4& particle) { return particle.getW() * (1 + 4 * m_params.sdfBlend) + m_params.bandWidth; };
+
+    Vec3 boundsMin(FLT_MAX);
+    Vec3 boundsMax(-FLT_MAX);
+    for (const auto& particle : particles)
+    {
+        if (particle.posSize.getW() <= 0)
+            continue;
+
+        Vec3 reach(getReach(particle.posSize));
+        boundsMin = minPerElem(boundsMin, particle.posSize.getXYZ() - reach);
+        boundsMax = maxPerElem(boundsMax, particle.posSize.getXYZ() + reach);
+    }
+
+    m_pageTable.clear();
+    m_brickPages.clear();
+    m_brickParticlePairs.clear();
+    m_pageTableSize[0] = m_pageTableSize[1] = m_pageTableSize[2] = 0;
+    if (boundsMin.getX() > boundsMax.getX())
+        return;
+
+    // Coarsen the voxels when the particles spread too far for the page table
+    Vec3  extent   = boundsMax - boundsMin;
+    float maxBrick = maxElem(extent) / MaxPageTableSize;
+    m_voxelSize = std::max(m_params.voxelSize, maxBrick / BrickCells);
+    m_brickSize = m_voxelSize * BrickCells;
+    m_origin    = boundsMin;
+
+    for (int i = 0; i < 3; i++)
+        m_pageTableSize[i] = std::max(1, static_cast<int32_t>(std::ceil(extent[i] / m_brickSize)));
+    m_pageTable.assign(static_cast<size_t>(m_pageTableSize[0]) * m_pageTableSize[1] * m_pageTableSize[2], EmptyBrick);
+
+    // Pair every particle with the bricks its reach overlaps, the page table doubles as the allocation map
+    for (uint32_t i = 0; i < particles.size(); i++)
+    {
+        const Vec4& particle = particles[i].posSize;
+        if (particle.getW() <= 0)
+            continue;
+
+        Vec3 reach(getReach(particle));
+        Vec3 lo = (particle.getXYZ() - reach - m_origin) / m_brickSize;
+        Vec3 hi = (particle.getXYZ() + reach - m_origin) / m_brickSize;
+
+        int32_t minPage[3], maxPage[3];
+        for (int a = 0; a < 3; a++)
+        {
+            minPage[a] = std::max(static_cast<int32_t>(std::floor(lo[a])), 0);
+            maxPage[a] = std::min(static_cast<int32_t>(std::floor(hi[a])), m_pageTableSize[a] - 1);
+        }
+
+        for (int32_t z = minPage[2]; z <= maxPage[2]; z++)
+        {
+            for (int32_t y = minPage[1]; y <= maxPage[1]; y++)
+            {
+                for (int32_t x = minPage[0]; x <= maxPage[0]; x++)
+                {
+                    uint32_t page = GetPage(x, y, z);
+                    if (m_pageTable[page] == EmptyBrick)
+                    {
+                        m_pageTable[page] = m_brickCount++;
+                        m_brickPages.push_back(page);
+                    }
+                    m_brickParticlePairs.push_back(static_cast<uint64_t>(m_pageTable[page]) << 32 | i);
+                }
+            }
+        }
+    }
+
+    // Counting sort the pairs so every brick has a contiguous particle list in particle order
+    m_brickParticleStart.assign(m_brickCount + 1, 0);
+    for (uint64_t pair : m_brickParticlePairs)
+        m_brickParticleStart[(pair >> 32) + 1]++;
+    for (uint32_t brick = 0; brick < m_brickCount; brick++)
+        m_brickParticleStart[brick + 1] += m_brickParticleStart[brick];
+
+    m_brickParticles.resize(m_brickParticlePairs.size());
+    std::vector<uint32_t> cursor(m_brickParticleStart.begin(), m_brickParticleStart.end() - 1);
+    for (uint64_t pair : m_brickParticlePairs)
+        m_brickParticles[cursor[pair >> 32]++] = static_cast<uint32_t>(pair);
+}
+
+void FluidBrickVolume::FillBrick(uint32_t brick, const std::vector<GPUParticle>& particles)
+{
+    uint32_t page  = m_brickPages[brick];
+    int32_t  pageX = page % m_pageTableSize[0];
+    int32_t  pageY = (page / m_pageTableSize[0]) % m_pageTableSize[1];
+    int32_t  pageZ = page / (m_pageTableSize[0] * m_pageTableSize[1]);
+    Vec3     brickOrigin = m_origin + Vec3(static_cast<float>(pageX), static_cast<float>(pageY), static_cast<float>(pageZ)) * m_brickSize;
+
+    // Gather the brick's particles into flat arrays relative to the brick, the sample loop is the hot part
+    uint32_t first = m_brickParticleStart[brick];
+    uint32_t count = m_brickParticleStart[brick + 1] - first;
+
+    thread_local std::vector<float> local;
+    local.resize(count * 4);
+    float* px = local.data();
+    float* py = px + count;
+    float* pz = py + count;
+    float* pr = pz + count;
+    for (uint32_t i = 0; i < count; i++)
+    {
+        Vec4 particle = particles[m_brickParticles[first + i]].posSize;
+        Vec3 offset   = particle.getXYZ() - brickOrigin;
+        px[i] = offset.getX();
+        py[i] = offset.getY();
+        pz[i] = offset.getZ();
+        pr[i] = particle.getW();
+    }
+
+    for (uint32_t z = 0; z < BrickSamples; z++)
+    {
+        for (uint32_t y = 0; y < BrickSamples; y++)
+        {
+            for (uint32_t x = 0; x < BrickSamples; x++)
+            {
+                float sx = x * m_voxelSize;
+                float sy = y * m_voxelSize;
+                float sz = z * m_voxelSize;
+
+                float ret = 1e20f;
+                for (uint32_t i = 0; i < count; i++)
+                {
+                    float dx = sx - px[i];
+                    float dy = sy - py[i];
+                    float dz = sz - pz[i];
+                    float o  = std::sqrt(dx * dx + dy * dy + dz * dz) - pr[i];
+                    ret = smin(o, ret, pr[i] * m_params.sdfBlend);
+                }
+
+                // Map [-band, band] onto the full 16 bit range
+                float normalized = std::min(std::max(ret / m_params.bandWidth * .5f + .5f, 0.f), 1.f);
+                m_atlas[GetAtlasOffset(brick, x, y, z)] = static_cast<uint16_t>(normalized * 65535 + .5f);
+            }
+        }
+    }
+}
+
+float FluidBrickVolume::Sample(const Vec3& position) const
+{
+    if (m_pageTable.empty())
+        return m_params.bandWidth;
+
+    Vec3 local = (position - m_origin) / m_brickSize;
+    int32_t page[3];
+    for (int a = 0; a < 3; a++)
+    {
+        page[a] = static_cast<int32_t>(std::floor(local[a]));
+        if (page[a] < 0 || page[a] >= m_pageTableSize[a])
+            return m_params.bandWidth;
+    }
+
+    uint32_t brick = m_pageTable[GetPage(page[0], page[1], page[2])];
+    if (brick == EmptyBrick)
+        return m_params.bandWidth;
+
+    // Cell and weights inside the brick
+    uint32_t cell[3];
+    float    t[3];
+    for (int a = 0; a < 3; a++)
+    {
+        float f = (local[a] - page[a]) * BrickCells;
+        cell[a] = std::min(static_cast<uint32_t>(f), BrickCells - 1);
+        t[a]    = f - cell[a];
+    }
+
+    auto fetch = [&](uint32_t dx, uint32_t dy, uint32_t dz)
+    {
+        uint16_t value = m_atlas[GetAtlasOffset(brick, cell[0] + dx, cell[1] + dy, cell[2] + dz)];
+        return (value / 65535.f * 2 - 1) * m_params.bandWidth;
+    };
+
+    float c00 = fetch(0, 0, 0) + (fetch(1, 0, 0) - fetch(0, 0, 0)) * t[0];
+    float c10 = fetch(0, 1, 0) + (fetch(1, 1, 0) - fetch(0, 1, 0)) * t[0];
+    float c01 = fetch(0, 0, 1) + (fetch(1, 0, 1) - fetch(0, 0, 1)) * t[0];
+    float c11 = fetch(0, 1, 1) + (fetch(1, 1, 1) - fetch(0, 1, 1)) * t[0];
+    float c0  = c00 + (c10 - c00) * t[1];
+    float c1  = c01 + (c11 - c01) * t[1];
+    return c0 + (c1 - c0) * t[2];
+}
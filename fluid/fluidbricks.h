@@ -0,0 +1,73 @@
+#pragma once
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+#include "shaders/fluid.hlsli"
+
+class FluidWorkerPool;
+
+struct FluidBrickParams
+{
+    float voxelSize;
+    float sdfBlend;
+
+    // Distances are stored in [-bandWidth, bandWidth], anything further away is left out of the volume
+    float bandWidth;
+};
+
+// Sparse narrow band distance volume of the fluid surface, rebuilt from the particles every frame.
+// Occupied bricks live in an atlas laid out like a R16_UNORM 3D texture, a R32_UINT page table maps
+// the brick grid over the particle bounds to atlas slots. Bricks share their border samples so a
+// trilinear fetch never has to cross into a neighboring brick.
+class FluidBrickVolume
+{
+public:
+    static constexpr uint32_t BrickSamples   = 8;
+    static constexpr uint32_t BrickCells     = BrickSamples - 1;
+    static constexpr uint32_t AtlasBricksX   = 32;
+    static constexpr uint32_t AtlasBricksY   = 32;
+    static constexpr uint32_t MaxPageTableSize = 128;
+    static constexpr uint32_t EmptyBrick     = 0xFFFFFFFF;
+
+    void Build(const FluidBrickParams& params, const std::vector<GPUParticle>& particles, FluidWorkerPool& workers);
+
+    // Trilinear distance to the surface, positions away from any brick return the band width
+    float Sample(const Vec3& position) const;
+
+    uint32_t GetBrickCount() const { return m_brickCount; }
+
+    const std::vector<uint16_t>& GetAtlas() const { return m_atlas; }
+    uint32_t GetAtlasWidth() const { return AtlasBricksX * BrickSamples; }
+    uint32_t GetAtlasHeight() const { return AtlasBricksY * BrickSamples; }
+    uint32_t GetAtlasDepth() const { return m_atlasBricksZ * BrickSamples; }
+
+    const std::vector<uint32_t>& GetPageTable() const { return m_pageTable; }
+    const int32_t* GetPageTableSize() const { return m_pageTableSize; }
+    const Vec3& GetOrigin() const { return m_origin; }
+    float GetVoxelSize() const { return m_voxelSize; }
+
+private:
+    void AllocateBricks(const std::vector<GPUParticle>& particles);
+    void FillBrick(uint32_t brick, const std::vector<GPUParticle>& particles);
+
+    uint32_t GetPage(int32_t x, int32_t y, int32_t z) const { return (z * m_pageTableSize[1] + y) * m_pageTableSize[0] + x; }
+    size_t   GetAtlasOffset(uint32_t brick, uint32_t x, uint32_t y, uint32_t z) const;
+
+    FluidBrickParams m_params    = {};
+    float            m_voxelSize = 0;
+    float            m_brickSize = 0;
+    Vec3             m_origin    = Vec3(0);
+    int32_t          m_pageTableSize[3] = {};
+    uint32_t         m_brickCount   = 0;
+    uint32_t         m_atlasBricksZ = 0;
+
+    std::vector<uint32_t> m_pageTable;
+    std::vector<uint16_t> m_atlas;
+
+    // Page coordinates of every allocated brick and the particles touching it, grouped per brick
+    std::vector<uint32_t> m_brickPages;
+    std::vector<uint32_t> m_brickParticleStart;
+    std::vector<uint32_t> m_brickParticles;
+    std::vector<uint64_t> m_brickParticlePairs;
+};
@@ -63,7 +63,7 @@ void FluidDebugRenderModule::Execute(double dt, CommandList* pCmdList)
 
     BeginRaster(pCmdList, 1, &m_pColorRasterView);
 
-    m_sdfPS->SetBufferUAV(m_fluidRenderModule->GetShaderParticleBuffer(), 0);
+    m_sdfPS->SetBufferUAV(m_fluidRenderModule->GetTileBuffer(), 0);
     m_sdfPS->Bind(pCmdList, m_sdfPSO.get());
 
     const ResolutionInfo& resInfo = GetFramework()->GetResolutionInfo();
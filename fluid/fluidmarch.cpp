@@ -0,0 +1,223 @@
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include "fluidmarch.h"
+
+namespace
+{
+float AsFloat(uint32_t bits)
+{
+    float value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+float smin(float a, float b, float k)
+{
+    if (k <= 0)
+        return std::min(a, b);
+
+    k *= 4.0f;
+    float h = std::max(k - std::abs(a - b), 0.0f) / k;
+    return std::min(a, b) - h * h * k * (1.0f / 4.0f);
+}
+
+class SliceMarcher
+{
+public:
+    SliceMarcher(const FluidMarchParams& params, const std::vector<GPUParticle>& particles, const FluidTileBins& bins)
+        : m_params(params), m_particles(particles), m_bins(bins)
+    {
+    }
+
+    float Map(const SliceInfo& info, const Vec3& pos)
+    {
+        float ret = 1e20f;
+
+        for (uint32_t i = 0; i < info.particleCount; i++)
+        {
+            const Vec4& particle = m_particles[m_bins.indices[info.particleOffset + i]].posSize;
+
+            if (particle.getW() <= 0)
+                continue;
+            float o = length(pos - particle.getXYZ()) - particle.getW();
+            ret = smin(o, ret, particle.getW() * m_params.sdfBlend);
+            m_evaluations++;
+        }
+
+        return ret;
+    }
+
+    // Same depth slice range as the tiling bins the particle into
+    bool IsInSlice(const Vec4& particle, uint32_t slice) const
+    {
+        Vec4  view   = m_params.tiling.viewMatrix * Vec4(particle.getXYZ(), 1);
+        float dist   = length(view.getXYZ() / view.getW());
+        float radius = particle.getW() + m_params.tiling.overestimate;
+        return GetDepthSlice(m_params.tiling, dist - radius) <= slice && slice <= GetDepthSlice(m_params.tiling, dist + radius);
+    }
+
+    // Adds the particles of a neighbouring slice that the hit slice doesn't hold already
+    float MapNeighbour(const SliceInfo& info, uint32_t hitSlice, const Vec3& pos, float ret)
+    {
+        for (uint32_t i = 0; i < info.particleCount; i++)
+        {
+            const Vec4& particle = m_particles[m_bins.indices[info.particleOffset + i]].posSize;
+
+            if (particle.getW() <= 0 || IsInSlice(particle, hitSlice))
+                continue;
+            float o = length(pos - particle.getXYZ()) - particle.getW();
+            ret = smin(o, ret, particle.getW() * m_params.sdfBlend);
+            m_evaluations++;
+        }
+
+        return ret;
+    }
+
+    // The hit slice goes first, the smooth union depends on the order
+    float MapAround(uint32_t tileIndex, uint32_t slice, const Vec3& pos)
+    {
+        const SliceInfo* slices = &m_bins.slices[tileIndex * DEPTH_SLICES];
+
+        float ret = Map(slices[slice], pos);
+        if (slice > 0)
+            ret = MapNeighbour(slices[slice - 1], slice, pos, ret);
+        if (slice < DEPTH_SLICES - 1)
+            ret = MapNeighbour(slices[slice + 1], slice, pos, ret);
+        return ret;
+    }
+
+    // Keep in sync with normalAt in shaders/sdf.hlsl
+    Vec3 Normal(uint32_t tileIndex, uint32_t slice, const Vec3& pos)
+    {
+        float epsilon = 0.001f;
+
+        float s  = MapAround(tileIndex, slice, pos);
+        float dx = MapAround(tileIndex, slice, pos + Vec3(epsilon, 0, 0)) - s;
+        float dy = MapAround(tileIndex, slice, pos + Vec3(0, epsilon, 0)) - s;
+        float dz = MapAround(tileIndex, slice, pos + Vec3(0, 0, epsilon)) - s;
+
+        return normalize(Vec3(dx, dy, dz));
+    }
+
+    // Normal of the union of all particles, what the binned normal should match
+    Vec3 ReferenceNormal(const Vec3& pos) const
+    {
+        auto map = [this](const Vec3& p)
+        {
+            float ret = 1e20f;
+            for (const GPUParticle& particle : m_particles)
+            {
+                if (particle.posSize.getW() > 0)
+                    ret = smin(length(p - particle.posSize.getXYZ()) - particle.posSize.getW(), ret, particle.posSize.getW() * m_params.sdfBlend);
+            }
+            return ret;
+        };
+
+        float epsilon = 0.001f;
+        float s       = map(pos);
+        return normalize(Vec3(map(pos + Vec3(epsilon, 0, 0)) - s, map(pos + Vec3(0, epsilon, 0)) - s, map(pos + Vec3(0, 0, epsilon)) - s));
+    }
+
+    // Keep in sync with march in shaders/sdf.hlsl
+    float March(uint32_t tileIndex, const Vec3& offset, const Vec3& dir, float start, float farthest, uint32_t& slice)
+    {
+        float closest = 1e20f;
+        float d       = 0.01f;
+
+        slice = 0;
+        for (int t = 0; t < 256 && start + d < farthest; t++)
+        {
+            slice = std::max(slice, GetDepthSlice(m_params.tiling, start + d));
+            const SliceInfo& info = m_bins.slices[tileIndex * DEPTH_SLICES + slice];
+
+            Vec3  pos = offset + dir * d;
+            float ter = info.particleCount ? Map(info, pos) : 1e20f;
+
+            if (ter <= 0)
+                return d + ter;
+
+            if (ter < 0.001f)
+                return d - ter;
+
+            if (ter < closest)
+                closest = ter;
+
+            d += std::min(ter, GetDepthSliceEnd(m_params.tiling, slice) - start - d + 0.001f);
+        }
+
+        return -closest;
+    }
+
+    uint32_t TakeEvaluations()
+    {
+        uint32_t evaluations = m_evaluations;
+        m_evaluations = 0;
+        return evaluations;
+    }
+
+private:
+    const FluidMarchParams&         m_params;
+    const std::vector<GPUParticle>& m_particles;
+    const FluidTileBins&            m_bins;
+    uint32_t                        m_evaluations = 0;
+};
+}
+
+void MarchPixels(const FluidMarchParams& params, const std::vector<GPUParticle>& particles, const FluidTileBins& bins, FluidMarchStats& stats)
+{
+    const FluidTilingParams& tiling = params.tiling;
+
+    Mat4 invViewProjection = inverse(tiling.projectionMatrix * tiling.viewMatrix);
+    Vec3 cameraPos         = inverse(tiling.viewMatrix).getTranslation();
+
+    SliceMarcher marcher(params, particles, bins);
+
+    stats = FluidMarchStats();
+    stats.pixelEvaluations.assign(static_cast<size_t>(params.width) * params.height, 0);
+    for (int32_t y = 0; y < params.height; y++)
+    {
+        for (int32_t x = 0; x < params.width; x++)
+        {
+            float u = (x + 0.5f) / params.width;
+            float v = (y + 0.5f) / params.height;
+
+            uint32_t tileX     = static_cast<uint32_t>(u * tiling.tilesX);
+            uint32_t tileY     = static_cast<uint32_t>(v * tiling.tilesY);
+            uint32_t tileIndex = tileY * tiling.tilesX + tileX;
+
+            const TileInfo& info = bins.tiles[tileIndex];
+            if (info.particleCount == 0)
+                continue;
+
+            Vec4  far       = invViewProjection * Vec4(u * 2 - 1, 1 - v * 2, 1, 1);
+            Vec3  rayDir    = normalize(far.getXYZ() / far.getW() - cameraPos);
+            float closest   = AsFloat(info.closest);
+            Vec3  startPos  = cameraPos + rayDir * closest;
+
+            uint32_t slice;
+            float dist = marcher.March(tileIndex, startPos, rayDir, closest, AsFloat(info.farthest), slice);
+            if (dist >= 0)
+            {
+                Vec3 intersection = startPos + rayDir * dist;
+                Vec3 normal       = marcher.Normal(tileIndex, slice, intersection);
+                stats.hitPixels++;
+
+                if (params.checkNormals)
+                {
+                    float cosAngle = std::min(std::max(static_cast<float>(dot(normal, marcher.ReferenceNormal(intersection))), -1.f), 1.f);
+                    float error    = std::acos(cosAngle) * 57.29578f;
+                    stats.normalErrorSum += error;
+                    stats.maxNormalError  = std::max(stats.maxNormalError, error);
+                    stats.checkedNormals++;
+                }
+            }
+
+            uint32_t evaluations = marcher.TakeEvaluations();
+            stats.pixelEvaluations[y * params.width + x] = evaluations;
+            stats.sdfEvaluations += evaluations;
+            stats.maxEvaluations  = std::max(stats.maxEvaluations, evaluations);
+            stats.marchedPixels++;
+        }
+    }
+}
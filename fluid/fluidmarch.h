@@ -0,0 +1,35 @@
+#pragma once
+
+#include <vector>
+#include "fluidtiling.h"
+
+// CPU replica of the ray march in shaders/sdf.hlsl, used to measure how many particle SDFs a frame evaluates
+struct FluidMarchParams
+{
+    FluidTilingParams tiling;
+    float             sdfBlend;
+    int32_t           width;
+    int32_t           height;
+
+    // Compare every hit normal against one from all particles, costly
+    bool              checkNormals = false;
+};
+
+struct FluidMarchStats
+{
+    uint64_t marchedPixels    = 0;
+    uint64_t hitPixels        = 0;
+    uint64_t sdfEvaluations   = 0;
+    uint32_t maxEvaluations   = 0;
+
+    // Angles in degrees between the normals of the binned particles and of all particles, see checkNormals
+    uint64_t checkedNormals   = 0;
+    double   normalErrorSum   = 0;
+    float    maxNormalError   = 0;
+
+    // Particle SDF evaluations of every pixel, row major
+    std::vector<uint32_t> pixelEvaluations;
+};
+
+// Marches every pixel against the binned particles, there is no scene depth so rays only end on the fluid
+void MarchPixels(const FluidMarchParams& params, const std::vector<GPUParticle>& particles, const FluidTileBins& bins, FluidMarchStats& stats);
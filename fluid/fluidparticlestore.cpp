@@ -0,0 +1,173 @@
+#include <algorithm>
+#include <emmintrin.h>
+
+#include "fluidparticlestore.h"
+
+constexpr size_t   FluidParticleStore::Alignment;
+constexpr uint32_t FluidParticleStore::SimdWidth;
+
+void FluidParticleStore::Resize(uint32_t count)
+{
+    for (auto& stream : m_streams)
+        stream.resize(count);
+    m_ids.resize(count);
+    m_size = count;
+}
+
+void FluidParticleStore::Push(uint32_t id, float x, float y, float z, float vx, float vy, float vz, float radius, float age)
+{
+    m_streams[PositionX].push_back(x);
+    m_streams[PositionY].push_back(y);
+    m_streams[PositionZ].push_back(z);
+    m_streams[VelocityX].push_back(vx);
+    m_streams[VelocityY].push_back(vy);
+    m_streams[VelocityZ].push_back(vz);
+    m_streams[Radius].push_back(radius);
+    m_streams[Age].push_back(age);
+    m_ids.push_back(id);
+    m_size++;
+}
+
+uint32_t FluidParticleStore::Compact()
+{
+    const float* radius = R();
+
+    // Branchless: always copy, only advance the write cursor for live particles
+    uint32_t write = 0;
+    for (uint32_t read = 0; read < m_size; read++)
+    {
+        for (auto& stream : m_streams)
+            stream[write] = stream[read];
+        m_ids[write] = m_ids[read];
+        write += radius[read] > 0 ? 1 : 0;
+    }
+
+    uint32_t removed = m_size - write;
+    Resize(write);
+    return removed;
+}
+
+void FluidParticleStore::Gather(const FluidParticleStore& src, const uint32_t* order, uint32_t begin, uint32_t end)
+{
+    for (uint32_t s = 0; s < StreamCount; s++)
+    {
+        float*       dst  = m_streams[s].data();
+        const float* from = src.m_streams[s].data();
+        for (uint32_t i = begin; i < end; i++)
+            dst[i] = from[order[i]];
+    }
+
+    for (uint32_t i = begin; i < end; i++)
+        m_ids[i] = src.m_ids[order[i]];
+}
+
+namespace
+{
+void IntegrateScalar(FluidParticleStore& store, const float* ax, const float* ay, const float* az,
+                     const FluidIntegrateParams& params, uint32_t begin, uint32_t end)
+{
+    float* x  = store.X();
+    float* y  = store.Y();
+    float* z  = store.Z();
+    float* vx = store.VX();
+    float* vy = store.VY();
+    float* vz = store.VZ();
+    float* r  = store.R();
+    float* a  = store.A();
+
+    const float attenuation = std::max(1 - params.attenuation * params.dt, 0.f);
+    const float growth      = params.growthRate * params.dt;
+
+    for (uint32_t i = begin; i < end; i++)
+    {
+        a[i] += params.dt;
+
+        float velX = vx[i] + ax[i] * params.dt;
+        float velY = vy[i] + ay[i] * params.dt;
+        float velZ = vz[i] + az[i] * params.dt;
+
+        x[i] += velX * params.dt;
+        y[i] += velY * params.dt;
+        z[i] += velZ * params.dt;
+
+        vx[i] = velX * attenuation;
+        vy[i] = velY * attenuation;
+        vz[i] = velZ * attenuation;
+
+        // Intentionally ignore the radius, since the particles look better halfway into the floor
+        if (y[i] < 0)
+        {
+            y[i]  = 0;
+            vy[i] = 0;
+        }
+
+        r[i] = a[i] < params.lifeTime ? std::min(r[i] + growth, params.particleSize) : r[i] - growth;
+    }
+}
+
+uint32_t IntegrateSSE(FluidParticleStore& store, const float* ax, const float* ay, const float* az,
+                      const FluidIntegrateParams& params, uint32_t begin, uint32_t end)
+{
+    float* x  = store.X();
+    float* y  = store.Y();
+    float* z  = store.Z();
+    float* vx = store.VX();
+    float* vy = store.VY();
+    float* vz = store.VZ();
+    float* r  = store.R();
+    float* a  = store.A();
+
+    const __m128 zero        = _mm_setzero_ps();
+    const __m128 dt          = _mm_set1_ps(params.dt);
+    const __m128 attenuation = _mm_set1_ps(std::max(1 - params.attenuation * params.dt, 0.f));
+    const __m128 growth      = _mm_set1_ps(params.growthRate * params.dt);
+    const __m128 size        = _mm_set1_ps(params.particleSize);
+    const __m128 lifeTime    = _mm_set1_ps(params.lifeTime);
+
+    uint32_t i = begin;
+    for (; i + 4 <= end; i += 4)
+    {
+        __m128 age = _mm_add_ps(_mm_load_ps(a + i), dt);
+
+        __m128 velX = _mm_add_ps(_mm_load_ps(vx + i), _mm_mul_ps(_mm_load_ps(ax + i), dt));
+        __m128 velY = _mm_add_ps(_mm_load_ps(vy + i), _mm_mul_ps(_mm_load_ps(ay + i), dt));
+        __m128 velZ = _mm_add_ps(_mm_load_ps(vz + i), _mm_mul_ps(_mm_load_ps(az + i), dt));
+
+        __m128 posX = _mm_add_ps(_mm_load_ps(x + i), _mm_mul_ps(velX, dt));
+        __m128 posY = _mm_add_ps(_mm_load_ps(y + i), _mm_mul_ps(velY, dt));
+        __m128 posZ = _mm_add_ps(_mm_load_ps(z + i), _mm_mul_ps(velZ, dt));
+
+        velX = _mm_mul_ps(velX, attenuation);
+        velY = _mm_mul_ps(velY, attenuation);
+        velZ = _mm_mul_ps(velZ, attenuation);
+
+        __m128 belowFloor = _mm_cmplt_ps(posY, zero);
+        posY = _mm_andnot_ps(belowFloor, posY);
+        velY = _mm_andnot_ps(belowFloor, velY);
+
+        __m128 radius  = _mm_load_ps(r + i);
+        __m128 growing = _mm_cmplt_ps(age, lifeTime);
+        __m128 grown   = _mm_min_ps(_mm_add_ps(radius, growth), size);
+        __m128 shrunk  = _mm_sub_ps(radius, growth);
+        radius = _mm_or_ps(_mm_and_ps(growing, grown), _mm_andnot_ps(growing, shrunk));
+
+        _mm_store_ps(a + i, age);
+        _mm_store_ps(x + i, posX);
+        _mm_store_ps(y + i, posY);
+        _mm_store_ps(z + i, posZ);
+        _mm_store_ps(vx + i, velX);
+        _mm_store_ps(vy + i, velY);
+        _mm_store_ps(vz + i, velZ);
+        _mm_store_ps(r + i, radius);
+    }
+
+    return i;
+}
+}
+
+void IntegrateParticles(FluidParticleStore& store, const float* ax, const float* ay, const float* az,
+                        const FluidIntegrateParams& params, uint32_t begin, uint32_t end)
+{
+    uint32_t i = IntegrateSSE(store, ax, ay, az, params, begin, end);
+    IntegrateScalar(store, ax, ay, az, params, i, end);
+}
@@ -0,0 +1,118 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <vector>
+#include <xmmintrin.h>
+
+// Allocator that keeps every particle stream aligned to a full SIMD register
+template <typename T, size_t Alignment>
+struct AlignedAllocator
+{
+    using value_type = T;
+
+    template <typename U>
+    struct rebind { using other = AlignedAllocator<U, Alignment>; };
+
+    AlignedAllocator() = default;
+    template <typename U>
+    AlignedAllocator(const AlignedAllocator<U, Alignment>&) {}
+
+    T* allocate(size_t count)
+    {
+        void* memory = _mm_malloc(count * sizeof(T), Alignment);
+        if (!memory)
+            throw std::bad_alloc();
+        return static_cast<T*>(memory);
+    }
+
+    void deallocate(T* memory, size_t) { _mm_free(memory); }
+
+    template <typename U>
+    bool operator==(const AlignedAllocator<U, Alignment>&) const { return true; }
+    template <typename U>
+    bool operator!=(const AlignedAllocator<U, Alignment>&) const { return false; }
+};
+
+// Structure-of-arrays particle storage, every attribute lives in its own aligned stream
+// so the simulation kernels can process SimdWidth particles per instruction.
+class FluidParticleStore
+{
+public:
+    static constexpr size_t   Alignment = 16;
+    static constexpr uint32_t SimdWidth = 4;
+
+    using Stream = std::vector<float, AlignedAllocator<float, Alignment>>;
+
+    enum StreamType
+    {
+        PositionX,
+        PositionY,
+        PositionZ,
+        VelocityX,
+        VelocityY,
+        VelocityZ,
+        Radius,
+        Age,
+
+        StreamCount
+    };
+
+    uint32_t Size() const { return m_size; }
+    bool     Empty() const { return m_size == 0; }
+
+    void Resize(uint32_t count);
+    void Clear() { Resize(0); }
+
+    void Push(uint32_t id, float x, float y, float z, float vx, float vy, float vz, float radius, float age);
+
+    // Removes all particles whose radius dropped to zero, keeps the order of the remaining ones
+    uint32_t Compact();
+
+    // Fills this store with src[order[i]] for every i
+    void Gather(const FluidParticleStore& src, const uint32_t* order, uint32_t begin, uint32_t end);
+
+    float*       Data(StreamType stream)       { return m_streams[stream].data(); }
+    const float* Data(StreamType stream) const { return m_streams[stream].data(); }
+
+    float*       X()        { return Data(PositionX); }
+    float*       Y()        { return Data(PositionY); }
+    float*       Z()        { return Data(PositionZ); }
+    float*       VX()       { return Data(VelocityX); }
+    float*       VY()       { return Data(VelocityY); }
+    float*       VZ()       { return Data(VelocityZ); }
+    float*       R()        { return Data(Radius); }
+    float*       A()        { return Data(Age); }
+    const float* X()  const { return Data(PositionX); }
+    const float* Y()  const { return Data(PositionY); }
+    const float* Z()  const { return Data(PositionZ); }
+    const float* VX() const { return Data(VelocityX); }
+    const float* VY() const { return Data(VelocityY); }
+    const float* VZ() const { return Data(VelocityZ); }
+    const float* R()  const { return Data(Radius); }
+    const float* A()  const { return Data(Age); }
+
+    // Stable particle ids, the order of the streams changes every step
+    uint32_t*       Ids()       { return m_ids.data(); }
+    const uint32_t* Ids() const { return m_ids.data(); }
+
+private:
+    Stream                m_streams[StreamCount];
+    std::vector<uint32_t> m_ids;
+    uint32_t              m_size = 0;
+};
+
+struct FluidIntegrateParams
+{
+    float dt;
+    float attenuation;
+    float particleSize;
+    float growthRate;
+    float lifeTime;
+};
+
+// Integrates velocities and positions, resolves floor collisions and grows/shrinks radii of particles [begin, end).
+// begin must be a multiple of FluidParticleStore::SimdWidth, acceleration streams share the store's alignment.
+void IntegrateParticles(FluidParticleStore& store, const float* ax, const float* ay, const float* az,
+                        const FluidIntegrateParams& params, uint32_t begin, uint32_t end);
@@ -0,0 +1,202 @@
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <numeric>
+#include "fluidparticlestream.h"
+
+namespace
+{
+constexpr float QuantizedMax = 65535.f;
+
+uint64_t AlignOffset(uint64_t offset)
+{
+    return (offset + 7) & ~static_cast<uint64_t>(7);
+}
+
+uint16_t Quantize(float value, float min, float invScale)
+{
+    float q = (value - min) * invScale + .5f;
+    return static_cast<uint16_t>(std::min(std::max(q, 0.f), QuantizedMax));
+}
+}
+
+FluidStreamRecorder::~FluidStreamRecorder()
+{
+    Close();
+}
+
+bool FluidStreamRecorder::Open(const std::string& path)
+{
+    Close();
+
+    m_file.open(path, std::ios::binary | std::ios::trunc);
+    if (!m_file.is_open())
+        return false;
+
+    // The header is patched once the frame table has been written
+    FluidStreamHeader header = {};
+    m_file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    m_offset = sizeof(header);
+    m_frames.clear();
+    return m_file.good();
+}
+
+bool FluidStreamRecorder::Close()
+{
+    if (!m_file.is_open())
+        return false;
+
+    FluidStreamHeader header = {};
+    header.magic            = FluidStreamMagic;
+    header.version          = FluidStreamVersion;
+    header.frameCount       = static_cast<uint32_t>(m_frames.size());
+    header.frameTableOffset = m_offset;
+
+    m_file.write(reinterpret_cast<const char*>(m_frames.data()), m_frames.size() * sizeof(FluidStreamFrame));
+    m_file.seekp(0);
+    m_file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    bool good = m_file.good();
+    m_file.close();
+    m_frames.clear();
+    return good;
+}
+
+bool FluidStreamRecorder::AddFrame(const FluidParticleStore& particles)
+{
+    if (!m_file.is_open())
+        return false;
+
+    const float* streams[3] = {particles.X(), particles.Y(), particles.Z()};
+    const float* r = particles.R();
+
+    FluidStreamFrame frame = {};
+    frame.dataOffset = m_offset;
+
+    float boundsMin[3] = {FLT_MAX, FLT_MAX, FLT_MAX};
+    float boundsMax[3] = {-FLT_MAX, -FLT_MAX, -FLT_MAX};
+    float maxRadius    = 0;
+    for (uint32_t i = 0; i < particles.Size(); i++)
+    {
+        if (r[i] <= 0)
+            continue;
+
+        for (int a = 0; a < 3; a++)
+        {
+            boundsMin[a] = std::min(boundsMin[a], streams[a][i]);
+            boundsMax[a] = std::max(boundsMax[a], streams[a][i]);
+        }
+        maxRadius = std::max(maxRadius, r[i]);
+        frame.particleCount++;
+    }
+
+    float invScale[4];
+    for (int a = 0; a < 3; a++)
+    {
+        float extent = frame.particleCount ? boundsMax[a] - boundsMin[a] : 0;
+        frame.boundsMin[a]   = frame.particleCount ? boundsMin[a] : 0;
+        frame.boundsScale[a] = extent / QuantizedMax;
+        invScale[a]          = extent > 0 ? QuantizedMax / extent : 0;
+    }
+    frame.radiusScale = maxRadius / QuantizedMax;
+    invScale[3]       = maxRadius > 0 ? QuantizedMax / maxRadius : 0;
+
+    // Stream after stream so a frame decodes with straight loops
+    uint32_t count = frame.particleCount;
+    m_quantized.resize(AlignOffset(count * 4 * sizeof(uint16_t)) / sizeof(uint16_t), 0);
+    uint32_t write = 0;
+    for (uint32_t i = 0; i < particles.Size(); i++)
+    {
+        if (r[i] <= 0)
+            continue;
+
+        for (int a = 0; a < 3; a++)
+            m_quantized[a * count + write] = Quantize(streams[a][i], frame.boundsMin[a], invScale[a]);
+        m_quantized[3 * count + write] = Quantize(r[i], 0, invScale[3]);
+        write++;
+    }
+
+    m_file.write(reinterpret_cast<const char*>(m_quantized.data()), m_quantized.size() * sizeof(uint16_t));
+    m_offset += m_quantized.size() * sizeof(uint16_t);
+    m_frames.push_back(frame);
+    return m_file.good();
+}
+
+bool FluidStreamPlayer::Open(const std::string& path)
+{
+    Close();
+
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file.is_open())
+        return false;
+
+    uint64_t size = static_cast<uint64_t>(file.tellg());
+    if (size < sizeof(FluidStreamHeader))
+        return false;
+
+    m_storage.resize((size + 7) / 8);
+    file.seekg(0);
+    file.read(reinterpret_cast<char*>(m_storage.data()), size);
+    if (!file.good())
+    {
+        m_storage.clear();
+        return false;
+    }
+    m_size = size;
+
+    // Reject anything that would make frame reads go out of bounds
+    const FluidStreamHeader& header = GetHeader();
+    bool valid = header.magic == FluidStreamMagic && header.version == FluidStreamVersion &&
+                 header.frameTableOffset % 8 == 0 && header.frameTableOffset <= size &&
+                 (size - header.frameTableOffset) / sizeof(FluidStreamFrame) >= header.frameCount;
+
+    for (uint32_t i = 0; valid && i < header.frameCount; i++)
+    {
+        const FluidStreamFrame& frame = GetFrames()[i];
+        valid = frame.dataOffset % 8 == 0 && frame.dataOffset <= header.frameTableOffset &&
+                (header.frameTableOffset - frame.dataOffset) / (4 * sizeof(uint16_t)) >= frame.particleCount;
+    }
+
+    if (!valid)
+        Close();
+    return valid;
+}
+
+void FluidStreamPlayer::Close()
+{
+    m_storage.clear();
+    m_size = 0;
+}
+
+bool FluidStreamPlayer::ReadFrame(uint32_t frameIndex, FluidParticleStore& particles) const
+{
+    if (frameIndex >= GetFrameCount())
+        return false;
+
+    const FluidStreamFrame& frame = GetFrames()[frameIndex];
+    const uint16_t*         data  = reinterpret_cast<const uint16_t*>(GetData() + frame.dataOffset);
+    uint32_t                count = frame.particleCount;
+
+    particles.Resize(count);
+    float* streams[3] = {particles.X(), particles.Y(), particles.Z()};
+    for (int a = 0; a < 3; a++)
+    {
+        const uint16_t* q = data + a * count;
+        for (uint32_t i = 0; i < count; i++)
+            streams[a][i] = frame.boundsMin[a] + q[i] * frame.boundsScale[a];
+    }
+
+    const uint16_t* q = data + 3 * count;
+    float* r = particles.R();
+    for (uint32_t i = 0; i < count; i++)
+        r[i] = q[i] * frame.radiusScale;
+
+    std::fill(particles.VX(), particles.VX() + count, 0.f);
+    std::fill(particles.VY(), particles.VY() + count, 0.f);
+    std::fill(particles.VZ(), particles.VZ() + count, 0.f);
+    std::fill(particles.A(),  particles.A()  + count, 0.f);
+
+    // Recordings don't keep ids, every frame stands on its own
+    std::iota(particles.Ids(), particles.Ids() + count, 0u);
+    return true;
+}
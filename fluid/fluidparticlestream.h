@@ -0,0 +1,79 @@
+#pragma once
+
+#include <fstream>
+#include <string>
+#include <vector>
+#include "fluidparticlestore.h"
+
+// Recorded particle streams, used as fixed workloads for tiling and SDF benchmarks.
+//
+// File layout, every offset is 8 byte aligned so the file can be mapped and read in place:
+//   FluidStreamHeader
+//   per frame: uint16_t x[count], y[count], z[count], radius[count], padded to 8 bytes
+//   FluidStreamFrame[frameCount] at frameTableOffset
+// Positions are quantized to 16 bits inside the frame's bounds, radii to 16 bits of the frame's largest radius.
+struct FluidStreamHeader
+{
+    uint32_t magic;
+    uint32_t version;
+    uint32_t frameCount;
+    uint32_t reserved;
+    uint64_t frameTableOffset;
+};
+
+struct FluidStreamFrame
+{
+    uint64_t dataOffset;
+    uint32_t particleCount;
+    float    radiusScale;
+    float    boundsMin[3];
+    float    boundsScale[3];
+};
+
+constexpr uint32_t FluidStreamMagic   = 0x53504C46; // "FLPS"
+constexpr uint32_t FluidStreamVersion = 1;
+
+class FluidStreamRecorder
+{
+public:
+    ~FluidStreamRecorder();
+
+    bool Open(const std::string& path);
+
+    // Writes the frame table and patches the header, the stream is unreadable until this ran
+    bool Close();
+
+    bool IsOpen() const { return m_file.is_open(); }
+    uint32_t GetFrameCount() const { return static_cast<uint32_t>(m_frames.size()); }
+
+    // Records the live particles (radius > 0), velocities and ages aren't part of the stream
+    bool AddFrame(const FluidParticleStore& particles);
+
+private:
+    std::ofstream                 m_file;
+    uint64_t                      m_offset = 0;
+    std::vector<FluidStreamFrame> m_frames;
+    std::vector<uint16_t>         m_quantized;
+};
+
+class FluidStreamPlayer
+{
+public:
+    bool Open(const std::string& path);
+    void Close();
+
+    bool IsOpen() const { return m_size != 0; }
+    uint32_t GetFrameCount() const { return IsOpen() ? GetHeader().frameCount : 0; }
+
+    // Decodes a frame into positions and radii, the other streams are zeroed
+    bool ReadFrame(uint32_t frame, FluidParticleStore& particles) const;
+
+private:
+    const uint8_t*           GetData() const { return reinterpret_cast<const uint8_t*>(m_storage.data()); }
+    const FluidStreamHeader& GetHeader() const { return *reinterpret_cast<const FluidStreamHeader*>(GetData()); }
+    const FluidStreamFrame*  GetFrames() const { return reinterpret_cast<const FluidStreamFrame*>(GetData() + GetHeader().frameTableOffset); }
+
+    // Whole file in 8 byte aligned storage, laid out exactly like a mapped view would be
+    std::vector<uint64_t> m_storage;
+    uint64_t              m_size = 0;
+};
@@ -1,129 +1,383 @@
 #include <algorithm>
+#include <cfloat>
+#include <chrono>
 #include "fluidparticlesystem.h"
+#include "fluidworkerpool.h"
 
 namespace
 {
-float RandFloat(float min, float max)
-{
-    return min + (max - min) * rand() / (float)RAND_MAX;
+constexpr auto Gravity             = -1.f;
+constexpr auto VelocityAttenuation =  1.f;
+constexpr auto RadiusGrowthRate    = .2f;
+constexpr auto ParticleLifeTime    = 10.f;
+
+// Larger frames are split into sub-steps, SPH pressure gets unstable with big time steps.
+// Frames longer than all sub-steps together slow the simulation down rather than taking bigger steps.
+constexpr auto MaxStepTime         = 1 / 120.f;
+constexpr auto MaxSubSteps         = 8;
+
+// Particles handled per task, small enough to balance the neighbor loops across cores
+constexpr uint32_t ParticleChunkSize = 256;
 }
+
+constexpr uint64_t FluidParticleSystem::DefaultSeed;
+
+FluidParticleSystem::FluidParticleSystem(uint64_t seed) : m_random(seed)
+{
+    m_workers = std::make_unique<FluidWorkerPool>();
 }
 
-FluidParticleSystem::CPUParticle FluidParticleSystem::CreateParticle() const
+FluidParticleSystem::~FluidParticleSystem() = default;
+
+void FluidParticleSystem::CreateParticle()
 {
     Vec3 dir(1.5f, 0, 0);
 
-    return CPUParticle
-    ({
-        Point3(m_positionX, m_positionY, m_positionZ),
-        {
-            dir.getX() + RandFloat(-.5f, .5f),
-            dir.getY() + RandFloat(-.5f, .5f),
-            dir.getZ() + RandFloat(-.5f, .5f),
-        },
-        .001f,
-        RandFloat(0, 10)
-    });
+    // Spread spawns over a small nozzle, particles emitted on top of each other start out heavily compressed
+    float nozzle = m_particleSize * 2;
+
+    // Draw in a fixed order, argument evaluation order isn't specified
+    float y   = m_positionY + m_random.NextFloat(-nozzle, nozzle);
+    float z   = m_positionZ + m_random.NextFloat(-nozzle, nozzle);
+    float vx  = dir.getX() + m_random.NextFloat(-.5f, .5f);
+    float vy  = dir.getY() + m_random.NextFloat(-.5f, .5f);
+    float vz  = dir.getZ() + m_random.NextFloat(-.5f, .5f);
+    float age = m_random.NextFloat(0, ParticleLifeTime);
+
+    m_particles.Push(m_nextId++, m_positionX, y, z, vx, vy, vz, .001f, age);
 }
 
-void FluidParticleSystem::Update(float dt, Point3 cameraPos)
+void FluidParticleSystem::Update(float dt)
 {
-    m_cameraPos = cameraPos;
+    auto start = std::chrono::high_resolution_clock::now();
+
+    uint32_t maxParticles = static_cast<uint32_t>(std::max(m_maxParticles, 0));
+    if (m_particles.Size() > maxParticles)
+        m_particles.Resize(maxParticles);
 
-    dt *= m_updateSpeed;
+    dt = std::min(dt, MaxStepTime * MaxSubSteps);
+    int subSteps = std::min(static_cast<int>(std::ceil(dt / MaxStepTime)), MaxSubSteps);
+    float stepTime = subSteps > 0 ? dt / subSteps : 0;
 
-    if (m_particles.size() < m_maxParticles)
+    for (int i = 0; i < subSteps; i++)
     {
-        m_particles.push_back(CreateParticle());
+        SpawnParticles(stepTime);
+        Step(stepTime);
     }
-    else if (m_particles.size() > m_maxParticles)
+
+    auto end = std::chrono::high_resolution_clock::now();
+    m_lastUpdateMs = std::chrono::duration<float, std::milli>(end - start).count();
+}
+
+void FluidParticleSystem::SpawnParticles(float dt)
+{
+    m_spawnAccumulator += m_spawnRate * dt;
+
+    while (m_spawnAccumulator >= 1)
     {
-        m_particles.resize(m_maxParticles);
+        m_spawnAccumulator -= 1;
+        if (m_particles.Size() < static_cast<uint32_t>(m_maxParticles))
+            CreateParticle();
     }
+}
 
-    constexpr auto Gravity             = -1.f;
-    constexpr auto VelocityAttenuation =  1.f;
+void FluidParticleSystem::Step(float dt)
+{
+    if (m_particles.Empty())
+        return;
+
+    BuildNeighborGrid();
+
+    uint32_t count = m_particles.Size();
+    m_density.resize(count);
+    m_pressure.resize(count);
+    m_accelerationX.resize(count);
+    m_accelerationY.resize(count);
+    m_accelerationZ.resize(count);
 
-    for (auto& particle : m_particles)
+    m_workers->ParallelFor(count, ParticleChunkSize, [this](uint32_t begin, uint32_t end) { ComputeDensityPressure(begin, end); });
+    m_workers->ParallelFor(count, ParticleChunkSize, [this](uint32_t begin, uint32_t end) { ComputeAccelerations(begin, end); });
+
+    // Integrate whole SIMD blocks so every range starts on an aligned particle
+    FluidIntegrateParams params = {dt, VelocityAttenuation, m_particleSize, RadiusGrowthRate, ParticleLifeTime};
+    uint32_t blockCount = (count + FluidParticleStore::SimdWidth - 1) / FluidParticleStore::SimdWidth;
+    m_workers->ParallelFor(blockCount, ParticleChunkSize / FluidParticleStore::SimdWidth, [&](uint32_t begin, uint32_t end)
     {
-        particle.age += dt;
+        IntegrateParticles(m_particles, m_accelerationX.data(), m_accelerationY.data(), m_accelerationZ.data(), params,
+                           begin * FluidParticleStore::SimdWidth, std::min(end * FluidParticleStore::SimdWidth, count));
+    });
 
-        Vec3 velocity = particle.velocity;
-        velocity.setY(velocity.getY() + Gravity * dt);
+    // Drop particles that shrunk away, the spawner refills them
+    m_particles.Compact();
+}
 
-        particle.velocity = velocity * std::max(1 - VelocityAttenuation * dt, 0.f);
-        particle.position += velocity * dt;
+int32_t FluidParticleSystem::GetCellCoord(float v) const
+{
+    return static_cast<int32_t>(std::floor(v / m_smoothingLength));
+}
 
-        // Intentionally ignore the radius, since the particles look better halfway into the floor
-        if (particle.position.getY() < 0)
-        {
-            particle.position.setY(0);
-            particle.velocity.setY(0);
-        }
+uint32_t FluidParticleSystem::GetCellHash(int32_t x, int32_t y, int32_t z) const
+{
+    return ((static_cast<uint32_t>(x) * 73856093u) ^
+            (static_cast<uint32_t>(y) * 19349663u) ^
+            (static_cast<uint32_t>(z) * 83492791u)) & m_hashMask;
+}
 
-        if (particle.age < 10)
-        {
-            particle.radius += .2f * dt;
-            particle.radius = std::min(particle.radius, m_particleSize);
-        }
-        else
+uint32_t FluidParticleSystem::GatherNeighborCells(float px, float py, float pz, uint32_t (&cells)[27]) const
+{
+    int32_t cx = GetCellCoord(px);
+    int32_t cy = GetCellCoord(py);
+    int32_t cz = GetCellCoord(pz);
+
+    uint32_t count = 0;
+    for (int32_t z = cz - 1; z <= cz + 1; z++)
+    for (int32_t y = cy - 1; y <= cy + 1; y++)
+    for (int32_t x = cx - 1; x <= cx + 1; x++)
+    {
+        uint32_t hash = GetCellHash(x, y, z);
+
+        // Different cells can share a bucket, only visit it once
+        if (std::find(cells, cells + count, hash) == cells + count)
+            cells[count++] = hash;
+    }
+
+    return count;
+}
+
+void FluidParticleSystem::BuildNeighborGrid()
+{
+    uint32_t count = m_particles.Size();
+
+    // Smoothing length covers roughly two particle diameters, the mass makes a particle spacing of h / 2 match the rest density
+    m_smoothingLength = std::max(m_particleSize * 4, .01f);
+    m_particleMass    = m_restDensity * std::pow(m_smoothingLength * .5f, 3.f);
+
+    uint32_t tableSize = 64;
+    while (tableSize < count * 2)
+        tableSize *= 2;
+    m_hashMask = tableSize - 1;
+
+    m_particleCells.resize(count);
+    m_workers->ParallelFor(count, ParticleChunkSize * 4, [this](uint32_t begin, uint32_t end)
+    {
+        const float* x = m_particles.X();
+        const float* y = m_particles.Y();
+        const float* z = m_particles.Z();
+        for (uint32_t i = begin; i < end; i++)
+            m_particleCells[i] = GetCellHash(GetCellCoord(x[i]), GetCellCoord(y[i]), GetCellCoord(z[i]));
+    });
+
+    // Counting sort by cell, m_cellStart[cell] .. m_cellStart[cell + 1] is the range of particles in that cell
+    m_cellStart.assign(tableSize + 1, 0);
+    for (uint32_t cell : m_particleCells)
+        m_cellStart[cell + 1]++;
+
+    for (uint32_t i = 0; i < tableSize; i++)
+        m_cellStart[i + 1] += m_cellStart[i];
+
+    m_sortOrder.resize(count);
+    for (uint32_t i = 0; i < count; i++)
+        m_sortOrder[m_cellStart[m_particleCells[i]]++] = i;
+
+    // Filling shifted every start to the next cell's start
+    for (uint32_t i = tableSize; i > 0; i--)
+        m_cellStart[i] = m_cellStart[i - 1];
+    m_cellStart[0] = 0;
+
+    m_sortedParticles.Resize(count);
+    m_workers->ParallelFor(count, ParticleChunkSize * 4, [this](uint32_t begin, uint32_t end)
+    {
+        m_sortedParticles.Gather(m_particles, m_sortOrder.data(), begin, end);
+    });
+
+    std::swap(m_particles, m_sortedParticles);
+}
+
+void FluidParticleSystem::ComputeDensityPressure(uint32_t begin, uint32_t end)
+{
+    const float h2    = m_smoothingLength * m_smoothingLength;
+    const float poly6 = 315.f / (64.f * CAULDRON_PI * std::pow(m_smoothingLength, 9.f));
+
+    const float* x = m_particles.X();
+    const float* y = m_particles.Y();
+    const float* z = m_particles.Z();
+
+    uint32_t cells[27];
+    for (uint32_t i = begin; i < end; i++)
+    {
+        float density = 0;
+        uint32_t cellCount = GatherNeighborCells(x[i], y[i], z[i], cells);
+        for (uint32_t c = 0; c < cellCount; c++)
         {
-            particle.radius -= .2f * dt;
+            for (uint32_t j = m_cellStart[cells[c]]; j < m_cellStart[cells[c] + 1]; j++)
+            {
+                float dx = x[i] - x[j];
+                float dy = y[i] - y[j];
+                float dz = z[i] - z[j];
+                float r2 = dx * dx + dy * dy + dz * dz;
+                if (r2 < h2)
+                {
+                    float w = h2 - r2;
+                    density += w * w * w;
+                }
+            }
         }
 
-        if (particle.radius <= 0)
+        m_density[i]  = std::max(density * poly6 * m_particleMass, 1e-3f);
+        m_pressure[i] = std::max(m_stiffness * (m_density[i] - m_restDensity), 0.f);
+    }
+}
+
+void FluidParticleSystem::ComputeAccelerations(uint32_t begin, uint32_t end)
+{
+    const float h          = m_smoothingLength;
+    const float spikyGrad  = -45.f / (CAULDRON_PI * std::pow(h, 6.f));
+    const float viscLaplac =  45.f / (CAULDRON_PI * std::pow(h, 6.f));
+
+    const float* x  = m_particles.X();
+    const float* y  = m_particles.Y();
+    const float* z  = m_particles.Z();
+    const float* vx = m_particles.VX();
+    const float* vy = m_particles.VY();
+    const float* vz = m_particles.VZ();
+
+    uint32_t cells[27];
+    for (uint32_t i = begin; i < end; i++)
+    {
+        float pressureX  = 0, pressureY  = 0, pressureZ  = 0;
+        float viscosityX = 0, viscosityY = 0, viscosityZ = 0;
+
+        uint32_t cellCount = GatherNeighborCells(x[i], y[i], z[i], cells);
+        for (uint32_t c = 0; c < cellCount; c++)
         {
-            particle = CreateParticle();
+            for (uint32_t j = m_cellStart[cells[c]]; j < m_cellStart[cells[c] + 1]; j++)
+            {
+                float dx = x[i] - x[j];
+                float dy = y[i] - y[j];
+                float dz = z[i] - z[j];
+                float r  = std::sqrt(dx * dx + dy * dy + dz * dz);
+                if (r >= h || r < 1e-6f)
+                    continue;
+
+                float q = h - r;
+                float pressure  = m_particleMass * (m_pressure[i] + m_pressure[j]) / (2 * m_density[j]) * spikyGrad * q * q / r;
+                float viscosity = m_particleMass / m_density[j] * viscLaplac * q;
+
+                pressureX  -= dx * pressure;
+                pressureY  -= dy * pressure;
+                pressureZ  -= dz * pressure;
+                viscosityX += (vx[j] - vx[i]) * viscosity;
+                viscosityY += (vy[j] - vy[i]) * viscosity;
+                viscosityZ += (vz[j] - vz[i]) * viscosity;
+            }
         }
+
+        float invDensity = 1 / m_density[i];
+        m_accelerationX[i] = (pressureX + viscosityX * m_viscosity) * invDensity;
+        m_accelerationY[i] = (pressureY + viscosityY * m_viscosity) * invDensity + Gravity;
+        m_accelerationZ[i] = (pressureZ + viscosityZ * m_viscosity) * invDensity;
     }
 }
 
-std::vector<GPUParticle> FluidParticleSystem::CreateGPUParticles() const
+void FluidParticleSystem::CreateGPUParticles(const FluidParticleStore& particles, const Point3& cameraPos,
+                                             const FluidParticleStore* previous, float alpha)
 {
-    std::vector<GPUParticle> particles;
+    const float* r = particles.R();
 
-    for (const auto& particle : m_particles)
+    // Blended positions are needed for both the distances and the packed particles
+    m_blendedX.assign(particles.X(), particles.X() + particles.Size());
+    m_blendedY.assign(particles.Y(), particles.Y() + particles.Size());
+    m_blendedZ.assign(particles.Z(), particles.Z() + particles.Size());
+    float* x = m_blendedX.data();
+    float* y = m_blendedY.data();
+    float* z = m_blendedZ.data();
+
+    if (previous && !previous->Empty() && alpha < 1)
     {
-        if (particle.radius <= 0)
-            continue;
+        // Ids are handed out in spawn order and particles die of age, so the live ids span a small range
+        const uint32_t* previousIds = previous->Ids();
+        uint32_t minId = *std::min_element(previousIds, previousIds + previous->Size());
+        uint32_t maxId = *std::max_element(previousIds, previousIds + previous->Size());
+
+        m_previousSlots.assign(static_cast<size_t>(maxId - minId) + 1, UINT32_MAX);
+        for (uint32_t i = 0; i < previous->Size(); i++)
+            m_previousSlots[previousIds[i] - minId] = i;
 
-        particles.push_back
-        ({{
-            particle.position.getX(),
-            particle.position.getY(),
-            particle.position.getZ(),
-            particle.radius,
-        }});
+        const uint32_t* ids = particles.Ids();
+        for (uint32_t i = 0; i < particles.Size(); i++)
+        {
+            uint32_t slot = ids[i] >= minId && ids[i] <= maxId ? m_previousSlots[ids[i] - minId] : UINT32_MAX;
+            if (slot == UINT32_MAX)
+                continue;
+
+            x[i] = previous->X()[slot] + (x[i] - previous->X()[slot]) * alpha;
+            y[i] = previous->Y()[slot] + (y[i] - previous->Y()[slot]) * alpha;
+            z[i] = previous->Z()[slot] + (z[i] - previous->Z()[slot]) * alpha;
+        }
     }
 
-    // Sort by distance from camera for optimized SDF tracing
-    // We could do this on the GPU, but lets just do it CPU side for now
-    auto cam = m_cameraPos;
-    std::sort(std::begin(particles), std::end(particles), [cam](const GPUParticle& lhs, const GPUParticle& rhs)
+    // Precompute the camera distances once instead of inside the comparator
+    float camX = cameraPos.getX();
+    float camY = cameraPos.getY();
+    float camZ = cameraPos.getZ();
+    float minDist = FLT_MAX;
+    float maxDist = 0;
+
+    m_sortDistances.resize(particles.Size());
+    m_sortIndices.resize(particles.Size());
+    uint32_t count = 0;
+    for (uint32_t i = 0; i < particles.Size(); i++)
     {
-        float dist1 = distSqr(cam, Point3(lhs.posSize.getXYZ()));
-        float dist2 = distSqr(cam, Point3(rhs.posSize.getXYZ()));
-        return dist1 < dist2;
-    });
+        if (r[i] <= 0)
+            continue;
 
-    if (particles.size() > MAX_PARTICLES)
-        particles.resize(MAX_PARTICLES);
+        float dx = x[i] - camX;
+        float dy = y[i] - camY;
+        float dz = z[i] - camZ;
+        float dist = dx * dx + dy * dy + dz * dz;
 
-    return particles;
-}
+        minDist = std::min(minDist, dist);
+        maxDist = std::max(maxDist, dist);
+        m_sortDistances[count] = dist;
+        m_sortIndices[count] = i;
+        count++;
+    }
 
-float FluidParticleSystem::GetBiggestRadius(const std::vector<GPUParticle>& particles) const
-{
-    if (particles.empty())
-        return 0;
+    // Sort by distance from camera for optimized SDF tracing
+    // Radix sort on quantized distances, the order only needs to be roughly front to back
+    float scale = maxDist > minDist ? 65535.f / (maxDist - minDist) : 0;
+    m_sortKeys.resize(count);
+    for (uint32_t i = 0; i < count; i++)
+        m_sortKeys[i] = static_cast<uint16_t>((m_sortDistances[i] - minDist) * scale);
 
-    auto m = std::max_element(std::begin(particles), std::end(particles), [](auto const& lhs, auto const& rhs)
+    m_sortScratchKeys.resize(count);
+    m_sortScratchIndices.resize(count);
+    for (uint32_t shift = 0; shift < 16; shift += 8)
     {
-        float w1 = lhs.posSize.getW();
-        float w2 = rhs.posSize.getW();
-        return w1 < w2;
-    });
+        uint32_t offsets[257] = {};
+        for (uint32_t i = 0; i < count; i++)
+            offsets[((m_sortKeys[i] >> shift) & 0xff) + 1]++;
+        for (uint32_t i = 0; i < 256; i++)
+            offsets[i + 1] += offsets[i];
 
-    return m->posSize.getW();
-}
+        for (uint32_t i = 0; i < count; i++)
+        {
+            uint32_t dst = offsets[(m_sortKeys[i] >> shift) & 0xff]++;
+            m_sortScratchKeys[dst]    = m_sortKeys[i];
+            m_sortScratchIndices[dst] = m_sortIndices[i];
+        }
 
+        std::swap(m_sortKeys, m_sortScratchKeys);
+        std::swap(m_sortIndices, m_sortScratchIndices);
+    }
+
+    // Resizing within the previous capacity doesn't allocate
+    m_gpuParticles.resize(count);
+    m_biggestRadius = 0;
+    for (uint32_t i = 0; i < m_gpuParticles.size(); i++)
+    {
+        uint32_t index = m_sortIndices[i];
+        m_gpuParticles[i].posSize = Vec4(x[index], y[index], z[index], r[index]);
+        m_biggestRadius = std::max(m_biggestRadius, r[index]);
+    }
+}
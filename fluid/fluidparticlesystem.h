@@ -1,36 +1,100 @@
 #pragma once
 
+#include <memory>
 #include <vector>
 #include "shaders/fluid.hlsli"
+#include "fluidparticlestore.h"
+#include "fluidrandom.h"
+
+class FluidWorkerPool;
 
 class FluidParticleSystem
 {
 public:
-    struct CPUParticle
-    {
-        Point3 position;
-        Vec3   velocity;
-        float  radius;
-        float  age;
-    };
+    static constexpr uint64_t DefaultSeed = 0x2545F4914F6CDD1DULL;
+
+    // Spawns are driven by a seeded generator, the same seed and settings always give the same simulation
+    explicit FluidParticleSystem(uint64_t seed = DefaultSeed);
+    ~FluidParticleSystem();
+
+    void Update(float dt);
 
-    void Update(float dt, Point3 cameraPos);
+    const FluidParticleStore& GetParticles() const { return m_particles; }
 
-    std::vector<GPUParticle> CreateGPUParticles() const;
+    // Packs live particles front to back into a persistent buffer. With a previous state, positions are blended from it towards
+    // particles by alpha, matched by id. Particles that didn't exist yet keep their current position.
+    // Only touches the packing buffers, so it can run on another thread than Update as long as particles isn't being updated.
+    void CreateGPUParticles(const FluidParticleStore& particles, const Point3& cameraPos,
+                            const FluidParticleStore* previous = nullptr, float alpha = 1);
 
-    float GetBiggestRadius(const std::vector<GPUParticle>& particles) const;
+    const std::vector<GPUParticle>& GetGPUParticles() const { return m_gpuParticles; }
+    float GetBiggestRadius() const { return m_biggestRadius; }
+
+    // CPU time spent in the last call to Update
+    float GetLastUpdateMs() const { return m_lastUpdateMs; }
+    size_t GetParticleCount() const { return m_particles.Size(); }
 
     int32_t m_maxParticles = 128;
     float   m_particleSize = .1f;
-    float   m_updateSpeed  = 1;
+    float   m_spawnRate    = 30;
+
+    // SPH parameters, the smoothing length is derived from the particle size
+    float   m_restDensity = 1000;
+    float   m_stiffness   = 20;
+    float   m_viscosity   = .5f;
 
     float m_positionX = 0;
     float m_positionY = 1;
     float m_positionZ = 0;
 
 private:
-    std::vector<CPUParticle> m_particles;
-    Point3 m_cameraPos{};
+    void SpawnParticles(float dt);
+    void Step(float dt);
+
+    void BuildNeighborGrid();
+    void ComputeDensityPressure(uint32_t begin, uint32_t end);
+    void ComputeAccelerations(uint32_t begin, uint32_t end);
+
+    uint32_t GetCellHash(int32_t x, int32_t y, int32_t z) const;
+    int32_t  GetCellCoord(float v) const;
+    uint32_t GatherNeighborCells(float x, float y, float z, uint32_t (&cells)[27]) const;
+
+    FluidParticleStore m_particles;
+    FluidParticleStore m_sortedParticles;
+    FluidRandom        m_random;
+    float              m_spawnAccumulator = 0;
+    float              m_lastUpdateMs = 0;
+    uint32_t           m_nextId = 0;
+
+    // Per step intermediates, indexed like m_particles
+    FluidParticleStore::Stream m_density;
+    FluidParticleStore::Stream m_pressure;
+    FluidParticleStore::Stream m_accelerationX;
+    FluidParticleStore::Stream m_accelerationY;
+    FluidParticleStore::Stream m_accelerationZ;
+
+    // Spatial hash, particles are sorted by cell so every cell is a contiguous range in m_particles
+    std::vector<uint32_t> m_particleCells;
+    std::vector<uint32_t> m_sortOrder;
+    std::vector<uint32_t> m_cellStart;
+    uint32_t              m_hashMask = 0;
+    float                 m_smoothingLength = 0;
+    float                 m_particleMass = 0;
+
+    std::unique_ptr<FluidWorkerPool> m_workers;
+
+    // GPU packing, all buffers persist between frames so packing doesn't allocate. Only used by CreateGPUParticles
+    std::vector<GPUParticle>   m_gpuParticles;
+    FluidParticleStore::Stream m_blendedX;
+    FluidParticleStore::Stream m_blendedY;
+    FluidParticleStore::Stream m_blendedZ;
+    std::vector<uint32_t>      m_previousSlots;
+    std::vector<float>         m_sortDistances;
+    std::vector<uint16_t>      m_sortKeys;
+    std::vector<uint16_t>      m_sortScratchKeys;
+    std::vector<uint32_t>      m_sortIndices;
+    std::vector<uint32_t>      m_sortScratchIndices;
+    float                      m_biggestRadius = 0;
 
-    CPUParticle CreateParticle() const;
+    void CreateParticle();
 };
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cstdint>
+
+// PCG32 (XSH RR variant), small and fully deterministic for a given seed on every platform
+class FluidRandom
+{
+public:
+    explicit FluidRandom(uint64_t seed = 0x853c49e6748fea9bULL, uint64_t sequence = 0xda3e39cb94b95bdbULL)
+    {
+        Seed(seed, sequence);
+    }
+
+    void Seed(uint64_t seed, uint64_t sequence = 0xda3e39cb94b95bdbULL)
+    {
+        m_state     = 0;
+        m_increment = (sequence << 1) | 1;
+        Next();
+        m_state += seed;
+        Next();
+    }
+
+    uint32_t Next()
+    {
+        uint64_t state = m_state;
+        m_state = state * 6364136223846793005ULL + m_increment;
+
+        uint32_t xorShifted = static_cast<uint32_t>(((state >> 18) ^ state) >> 27);
+        uint32_t rotation   = static_cast<uint32_t>(state >> 59);
+        return (xorShifted >> rotation) | (xorShifted << ((32 - rotation) & 31));
+    }
+
+    // Uniform in [min, max), built from the top 24 bits so every value is exactly representable
+    float NextFloat(float min, float max)
+    {
+        return min + (max - min) * ((Next() >> 8) * (1.f / 16777216.f));
+    }
+
+private:
+    uint64_t m_state;
+    uint64_t m_increment;
+};
@@ -6,13 +6,32 @@
 #include <render/rasterview.h>
 #include <render/pipelineobject.h>
 #include <render/parameterset.h>
+#include <render/profiler.h>
 
 #include "shaders/fluid.hlsli"
-#include "fluidparticlesystem.h"
+#include "fluidsimulation.h"
+#include "fluidtiling.h"
 #include "fluidrendermodule.h"
 
 using namespace cauldron;
 
+static_assert(PREFIX_SUM_MAX_GROUPS <= PREFIX_SUM_THREADS, "The slice scan handles the group totals in a single group");
+
+namespace
+{
+constexpr int32_t  MaxParticlesUI      = 65536;
+constexpr uint32_t MinParticleCapacity = 1024;
+constexpr auto     ParticleStreamPath  = "fluid_particles.flps";
+
+uint32_t GrowCapacity(uint32_t capacity, uint32_t required)
+{
+    capacity = std::max(capacity, MinParticleCapacity);
+    while (capacity < required)
+        capacity *= 2;
+    return capacity;
+}
+}
+
 const std::array<std::tuple<std::experimental::filesystem::path, bool>, 4> TextureList
 {
     std::tuple<std::experimental::filesystem::path, bool>
@@ -25,7 +44,7 @@ const std::array<std::tuple<std::experimental::filesystem::path, bool>, 4> Textu
 FluidRenderModule::FluidRenderModule() : RenderModule(L"FluidRenderModule")
 {
     m_fluidInfoBuffer = std::make_unique<BufferAddressInfo>();
-    m_particles       = std::make_unique<FluidParticleSystem>();
+    m_simulation      = std::make_unique<FluidSimulation>();
 }
 
 FluidRenderModule::~FluidRenderModule()
@@ -56,20 +75,40 @@ void FluidRenderModule::InitResources()
 
     // Buffers
     {
-        uint32_t   bufferSize    = sizeof(GPUParticle) * TILE_MAX_PARTICLES * TILES_MAX_X * TILES_MAX_Y;
-        BufferDesc bufferSurface = BufferDesc::Data(L"SortedParticleBuffer", bufferSize, sizeof(GPUParticle), 0, ResourceFlags::AllowUnorderedAccess);
-        m_shaderParticleBuffer = std::unique_ptr<Buffer>(Buffer::CreateBufferResource(&bufferSurface, ResourceState::UnorderedAccess));
+        uint32_t   bufferSize    = sizeof(TileInfo) * TILES_MAX_X * TILES_MAX_Y;
+        BufferDesc bufferSurface = BufferDesc::Data(L"TileBuffer", bufferSize, sizeof(TileInfo), 0, ResourceFlags::AllowUnorderedAccess);
+        m_tileBuffer = std::unique_ptr<Buffer>(Buffer::CreateBufferResource(&bufferSurface, ResourceState::UnorderedAccess));
+
+        bufferSize    = sizeof(SliceInfo) * TILES_MAX_X * TILES_MAX_Y * DEPTH_SLICES;
+        bufferSurface = BufferDesc::Data(L"SliceBuffer", bufferSize, sizeof(SliceInfo), 0, ResourceFlags::AllowUnorderedAccess);
+        m_sliceBuffer = std::unique_ptr<Buffer>(Buffer::CreateBufferResource(&bufferSurface, ResourceState::UnorderedAccess));
+
+        bufferSize    = sizeof(uint32_t) * PREFIX_SUM_MAX_GROUPS;
+        bufferSurface = BufferDesc::Data(L"ScanBuffer", bufferSize, sizeof(uint32_t), 0, ResourceFlags::AllowUnorderedAccess);
+        m_scanBuffer  = std::unique_ptr<Buffer>(Buffer::CreateBufferResource(&bufferSurface, ResourceState::UnorderedAccess));
+
+        bufferSurface = BufferDesc::Data(L"TilingStatsBuffer", sizeof(TilingStats), sizeof(TilingStats), 0, ResourceFlags::AllowUnorderedAccess);
+        m_statsBuffer = std::unique_ptr<Buffer>(Buffer::CreateBufferResource(&bufferSurface, ResourceState::UnorderedAccess));
 
         auto bufferCount = GetFramework()->GetSwapChain()->GetBackBufferCount();
         // Framework is flaky sometimes (let's just assume tripple buffering)
         if (!bufferCount)
             bufferCount = 3;
-        for (int i = 0; i < bufferCount; i++)
+        m_particleBuffers.resize(bufferCount);
+
+        // The stats of a frame are read once its back buffer comes around again
+        m_statsReadbackBuffers.resize(bufferCount);
+        m_statsReadbackPending.assign(bufferCount, false);
+        for (size_t i = 0; i < m_statsReadbackBuffers.size(); i++)
         {
-            std::wstring name          = L"ParticlesBuffer" + std::to_wstring(i);
-            BufferDesc   bufferSurface = BufferDesc::Data(name.c_str(), sizeof(GPUParticle) * MAX_PARTICLES, sizeof(GPUParticle));
-            m_particleBuffers.push_back(std::unique_ptr<Buffer>(Buffer::CreateBufferResource(&bufferSurface, ResourceState::ShaderResource)));
+            std::wstring name = L"TilingStatsReadback" + std::to_wstring(i);
+            bufferSurface     = BufferDesc::Data(name.c_str(), sizeof(TilingStats), sizeof(TilingStats), 0, ResourceFlags::ReadbackBuffer);
+            m_statsReadbackBuffers[i] = std::unique_ptr<Buffer>(Buffer::CreateBufferResource(&bufferSurface, ResourceState::CopyDest));
         }
+
+        // Particle and tile index buffers follow the live particle count, see ResizeBuffers
+        CreateParticleBuffers(MinParticleCapacity);
+        CreateTileIndexBuffer(MinParticleCapacity);
     }
 
     // SDF shader
@@ -80,7 +119,10 @@ void FluidRenderModule::InitResources()
         linearSamplerDesc.AddressW = AddressMode::Wrap;
 
         RootSignatureDesc sdfRSDesc;
-        sdfRSDesc.AddBufferUAVSet(0, ShaderBindStage::Pixel, 1); // ParticleBuffer
+        sdfRSDesc.AddBufferSRVSet(0, ShaderBindStage::Pixel, 1); // ParticleBuffer
+        sdfRSDesc.AddBufferUAVSet(0, ShaderBindStage::Pixel, 1); // TileBuffer
+        sdfRSDesc.AddBufferUAVSet(1, ShaderBindStage::Pixel, 1); // TileIndexBuffer
+        sdfRSDesc.AddBufferUAVSet(2, ShaderBindStage::Pixel, 1); // SliceBuffer
         sdfRSDesc.AddTextureSRVSet(1, ShaderBindStage::Pixel, 1); // DepthTexture
         sdfRSDesc.AddTextureSRVSet(2, ShaderBindStage::Pixel, (uint32_t)TextureList.size()); // Material textures
         sdfRSDesc.AddStaticSamplers(0, ShaderBindStage::Pixel, 1, &linearSamplerDesc);
@@ -109,7 +151,8 @@ void FluidRenderModule::InitResources()
         for (int i = 0; i < TextureList.size(); i++)
             m_sdfPS->SetTextureSRV(GetContentManager()->GetTexture(std::get<0>(TextureList[i])), ViewDimension::Texture2D, i + 2);
 
-        m_sdfPS->SetBufferUAV(GetShaderParticleBuffer(), 0);
+        m_sdfPS->SetBufferUAV(GetTileBuffer(), 0);
+        m_sdfPS->SetBufferUAV(GetSliceBuffer(), 2);
         m_sdfPS->SetRootConstantBufferResource(GetDynamicBufferPool()->GetResource(), sizeof(SceneInformation), 0);
     }
 
@@ -119,42 +162,174 @@ void FluidRenderModule::InitResources()
         tilingRSDesc.AddConstantBufferView(0, ShaderBindStage::Compute, 1);
         tilingRSDesc.AddBufferSRVSet(0, ShaderBindStage::Compute, 1);
         tilingRSDesc.AddBufferUAVSet(0, ShaderBindStage::Compute, 1);
+        tilingRSDesc.AddBufferUAVSet(1, ShaderBindStage::Compute, 1);
+        tilingRSDesc.AddBufferUAVSet(2, ShaderBindStage::Compute, 1);
+        tilingRSDesc.AddBufferUAVSet(3, ShaderBindStage::Compute, 1);
+        tilingRSDesc.AddBufferUAVSet(4, ShaderBindStage::Compute, 1);
 
         m_tilingRS = std::unique_ptr<RootSignature>(RootSignature::CreateRootSignature(L"FluidTiling", tilingRSDesc));
 
-        PipelineDesc tilingPsoDesc;
-        tilingPsoDesc.SetRootSignature(m_tilingRS.get());
-        tilingPsoDesc.AddShaderDesc(ShaderBuildDesc::Compute(L"tiling.hlsl", L"TilingCS", ShaderModel::SM6_0, nullptr));
-        m_tilingPSO = std::unique_ptr<PipelineObject>(PipelineObject::CreatePipelineObject(L"FluidTiling", tilingPsoDesc));
+        auto createTilingPSO = [this](const wchar_t* name, const wchar_t* entryPoint)
+        {
+            PipelineDesc tilingPsoDesc;
+            tilingPsoDesc.SetRootSignature(m_tilingRS.get());
+            tilingPsoDesc.AddShaderDesc(ShaderBuildDesc::Compute(L"tiling.hlsl", entryPoint, ShaderModel::SM6_0, nullptr));
+            return std::unique_ptr<PipelineObject>(PipelineObject::CreatePipelineObject(name, tilingPsoDesc));
+        };
+        m_tilingClearPSO      = createTilingPSO(L"FluidTilingClear",      L"TilingClearCS");
+        m_tilingCountPSO      = createTilingPSO(L"FluidTilingCount",      L"TilingCountCS");
+        m_tilingScanSlicesPSO = createTilingPSO(L"FluidTilingScanSlices", L"TilingScanSlicesCS");
+        m_tilingScanGroupsPSO = createTilingPSO(L"FluidTilingScanGroups", L"TilingScanGroupsCS");
+        m_tilingScanApplyPSO  = createTilingPSO(L"FluidTilingScanApply",  L"TilingScanApplyCS");
+        m_tilingFillPSO       = createTilingPSO(L"FluidTilingFill",       L"TilingFillCS");
 
         m_tilingPS = std::unique_ptr<ParameterSet>(ParameterSet::CreateParameterSet(m_tilingRS.get()));
-        m_tilingPS->SetBufferUAV(GetShaderParticleBuffer(), 0);
+        m_tilingPS->SetBufferUAV(GetTileBuffer(), 0);
+        m_tilingPS->SetBufferUAV(GetSliceBuffer(), 2);
+        m_tilingPS->SetBufferUAV(m_scanBuffer.get(), 3);
+        m_tilingPS->SetBufferUAV(m_statsBuffer.get(), 4);
         m_tilingPS->SetRootConstantBufferResource(GetDynamicBufferPool()->GetResource(), sizeof(SceneInformation), 0);
     }
 
+    m_simulation->SetSettings(m_simulationSettings);
+    m_simulation->Start();
+
     SetModuleReady(true);
 }
 
+void FluidRenderModule::CreateParticleBuffers(uint32_t capacity)
+{
+    for (size_t i = 0; i < m_particleBuffers.size(); i++)
+    {
+        std::wstring name          = L"ParticlesBuffer" + std::to_wstring(i);
+        BufferDesc   bufferSurface = BufferDesc::Data(name.c_str(), sizeof(GPUParticle) * capacity, sizeof(GPUParticle));
+        m_particleBuffers[i] = std::unique_ptr<Buffer>(Buffer::CreateBufferResource(&bufferSurface, ResourceState::ShaderResource));
+    }
+    m_particleCapacity = capacity;
+}
+
+void FluidRenderModule::CreateTileIndexBuffer(uint32_t capacity)
+{
+    BufferDesc bufferSurface = BufferDesc::Data(L"TileIndexBuffer", sizeof(uint32_t) * capacity, sizeof(uint32_t), 0, ResourceFlags::AllowUnorderedAccess);
+    m_tileIndexBuffer   = std::unique_ptr<Buffer>(Buffer::CreateBufferResource(&bufferSurface, ResourceState::UnorderedAccess));
+    m_tileIndexCapacity = capacity;
+}
+
+void FluidRenderModule::ReadTilingStats()
+{
+    // m_frame advances before Execute, so this is the slot the coming tiling pass overwrites
+    // It was written a full swap chain cycle ago and that frame finished before its back buffer came around
+    size_t slot = (m_frame + 1) % m_statsReadbackBuffers.size();
+    if (!m_statsReadbackPending[slot])
+        return;
+    m_statsReadbackPending[slot] = false;
+
+    TilingStats stats = {};
+    m_statsReadbackBuffers[slot]->ReadData(&stats, sizeof(stats));
+
+    // That frame cut tile lists short, the index list grows below but a few frames in flight can still miss entries
+    if (stats.requiredIndices > stats.indexCapacity)
+        m_tileIndexOverflows++;
+    m_tileIndexRequired = stats.requiredIndices;
+}
+
+void FluidRenderModule::ResizeBuffers()
+{
+    const std::vector<GPUParticle>& gpuParticles = m_simulation->GetGPUParticles();
+
+    const CameraInformation& cameraInfo = GetScene()->GetSceneInfo().CameraInfo;
+    FluidTilingParams params = {cameraInfo.ViewMatrix, cameraInfo.ProjectionMatrix, m_tilesX, m_tilesY, GetTilingOverestimate(m_simulation->GetBiggestRadius(), m_sdfBlend)};
+    FitDepthSlices(params, gpuParticles, m_depthSlices);
+    m_sliceNear  = params.sliceNear;
+    m_sliceScale = params.sliceScale;
+
+    // The index list follows the entry count the GPU scan needed in a previous frame
+    ReadTilingStats();
+
+    uint32_t particleCount = static_cast<uint32_t>(gpuParticles.size());
+    if (particleCount <= m_particleCapacity && m_tileIndexRequired <= m_tileIndexCapacity)
+        return;
+
+    // Buffers are still referenced by frames in flight, growth is geometric so this is rare
+    GetDevice()->FlushAllCommandQueues();
+
+    if (particleCount > m_particleCapacity)
+        CreateParticleBuffers(GrowCapacity(m_particleCapacity, particleCount));
+    if (m_tileIndexRequired > m_tileIndexCapacity)
+        CreateTileIndexBuffer(GrowCapacity(m_tileIndexCapacity, m_tileIndexRequired));
+}
+
 void FluidRenderModule::InitUI(UISection* uiSection)
 {
-    m_UIElements.emplace_back(uiSection->RegisterUIElement<UISlider<int32_t>>("Max particles", m_particles->m_maxParticles, 0, MAX_PARTICLES));
+    m_UIElements.emplace_back(uiSection->RegisterUIElement<UISlider<int32_t>>("Max particles", m_simulationSettings.maxParticles, 0, MaxParticlesUI));
     m_UIElements.emplace_back(uiSection->RegisterUIElement<UISlider<int32_t>>("Tiles X", m_tilesX, 1, TILES_MAX_X));
     m_UIElements.emplace_back(uiSection->RegisterUIElement<UISlider<int32_t>>("Tiles Y", m_tilesY, 1, TILES_MAX_Y));
+    m_UIElements.emplace_back(uiSection->RegisterUIElement<UICheckBox>("Depth sliced tiles", m_depthSlices));
     m_UIElements.emplace_back(uiSection->RegisterUIElement<UISlider<float>>("SDF blend", m_sdfBlend, 0.f, 1.f));
-    m_UIElements.emplace_back(uiSection->RegisterUIElement<UISlider<float>>("Particle size", m_particles->m_particleSize, 0.f, 1.f));
-    m_UIElements.emplace_back(uiSection->RegisterUIElement<UISlider<float>>("Particle update speed", m_particles->m_updateSpeed, 0.f, 10.f));
-    m_UIElements.emplace_back(uiSection->RegisterUIElement<UISlider<float>>("Particle spawner X", m_particles->m_positionX, -10.f, 10.f));
-    m_UIElements.emplace_back(uiSection->RegisterUIElement<UISlider<float>>("Particle spawner Y", m_particles->m_positionY, -10.f, 10.f));
-    m_UIElements.emplace_back(uiSection->RegisterUIElement<UISlider<float>>("Particle spawner Z", m_particles->m_positionZ, -10.f, 10.f));
+    m_UIElements.emplace_back(uiSection->RegisterUIElement<UISlider<float>>("Particle size", m_simulationSettings.particleSize, 0.f, 1.f));
+    m_UIElements.emplace_back(uiSection->RegisterUIElement<UISlider<float>>("Particle update speed", m_simulationSettings.updateSpeed, 0.f, 10.f));
+    m_UIElements.emplace_back(uiSection->RegisterUIElement<UISlider<float>>("Particle spawn rate", m_simulationSettings.spawnRate, 0.f, 1000.f));
+    m_UIElements.emplace_back(uiSection->RegisterUIElement<UISlider<float>>("Fluid stiffness", m_simulationSettings.stiffness, 0.f, 100.f));
+    m_UIElements.emplace_back(uiSection->RegisterUIElement<UISlider<float>>("Fluid viscosity", m_simulationSettings.viscosity, 0.f, 10.f));
+    m_UIElements.emplace_back(uiSection->RegisterUIElement<UISlider<float>>("Particle spawner X", m_simulationSettings.positionX, -10.f, 10.f));
+    m_UIElements.emplace_back(uiSection->RegisterUIElement<UISlider<float>>("Particle spawner Y", m_simulationSettings.positionY, -10.f, 10.f));
+    m_UIElements.emplace_back(uiSection->RegisterUIElement<UISlider<float>>("Particle spawner Z", m_simulationSettings.positionZ, -10.f, 10.f));
     m_UIElements.emplace_back(uiSection->RegisterUIElement<UISlider<float>>("Triplanar blend", m_triplanarBlend, 0.f, 1.f));
     m_UIElements.emplace_back(uiSection->RegisterUIElement<UISlider<float>>("UV scaling", m_uvScaling, 0.f, 10.f));
+
+    m_UIElements.emplace_back(uiSection->RegisterUIElement<UICheckBox>("Record particle stream", m_recordParticles));
+    m_UIElements.emplace_back(uiSection->RegisterUIElement<UICheckBox>("Replay particle stream", m_replayParticles));
+
+    m_simulationTextElement = uiSection->RegisterUIElement<UIText>("");
+    m_UIElements.emplace_back(m_simulationTextElement);
 }
 
 void FluidRenderModule::UpdateUI(double dt)
 {
+    // The simulation ticks on its own thread, the frame only picks up its newest state
+    m_simulation->SetSettings(m_simulationSettings);
+
+    // Checkboxes drop back if the stream can't be opened
+    if (m_recordParticles != m_simulation->IsRecording())
+    {
+        if (m_recordParticles)
+            m_recordParticles = m_simulation->StartRecording(ParticleStreamPath);
+        else
+            m_simulation->StopRecording();
+    }
+    if (m_replayParticles != m_simulation->IsReplaying())
+    {
+        if (m_replayParticles)
+            m_replayParticles = m_simulation->StartReplay(ParticleStreamPath);
+        else
+            m_simulation->StopReplay();
+    }
+
     auto cameraPos = GetScene()->GetCurrentCamera()->GetCameraPos();
-    m_particles->Update(static_cast<float>(dt), Point3(cameraPos));
-    m_gpuParticles = m_particles->CreateGPUParticles();
+    {
+        CPUScopedProfileCapture marker(L"Fluid particle packing");
+        m_simulation->CreateGPUParticles(Point3(cameraPos));
+    }
+    ResizeBuffers();
+
+    if (m_simulationTextElement)
+    {
+        const FluidSnapshot& snapshot = m_simulation->GetSnapshot();
+
+        char buffer[128];
+        if (m_simulation->IsReplaying())
+            snprintf(buffer, sizeof(buffer), "Replay: %6zu particles", m_simulation->GetGPUParticles().size());
+        else
+            snprintf(buffer, sizeof(buffer), "Simulation: %6u particles, %6.2f ms per tick", snapshot.particles.Size(), snapshot.updateMs);
+
+        std::string desc = buffer;
+        if (m_tileIndexOverflows)
+        {
+            snprintf(buffer, sizeof(buffer), "\nTile index overflow in %u frames", m_tileIndexOverflows);
+            desc += buffer;
+        }
+        m_simulationTextElement->SetDesc(desc.c_str());
+    }
 
     m_frame++;
 }
@@ -163,20 +338,25 @@ void FluidRenderModule::UpdateFluidInfoBuffer()
 {
     FluidInfo fluidInfo      = {};
     fluidInfo.SceneInfo      = GetScene()->GetSceneInfo();
-    fluidInfo.ParticleCount  = static_cast<int>(m_gpuParticles.size());
+    fluidInfo.ParticleCount  = static_cast<int>(m_simulation->GetGPUParticles().size());
     fluidInfo.TilesX         = m_tilesX;
     fluidInfo.TilesY         = m_tilesY;
-    fluidInfo.BiggestRadius  = m_particles->GetBiggestRadius(m_gpuParticles);
+    fluidInfo.BiggestRadius  = m_simulation->GetBiggestRadius();
     fluidInfo.SDFBlend       = m_sdfBlend;
     fluidInfo.TriplanarBlend = m_triplanarBlend;
     fluidInfo.UVScaling      = m_uvScaling;
+    fluidInfo.TileOverestimate = GetTilingOverestimate(fluidInfo.BiggestRadius, m_sdfBlend);
+    fluidInfo.IndexCapacity    = m_tileIndexCapacity;
+    fluidInfo.SliceNear        = m_sliceNear;
+    fluidInfo.SliceScale       = m_sliceScale;
 
     *m_fluidInfoBuffer = GetDynamicBufferPool()->AllocConstantBuffer(sizeof(fluidInfo), &fluidInfo);
 }
 
 void FluidRenderModule::UpdateParticleBuffer(CommandList* pCmdList)
 {
-    if (m_gpuParticles.empty())
+    const std::vector<GPUParticle>& gpuParticles = m_simulation->GetGPUParticles();
+    if (gpuParticles.empty())
         return;
 
     auto particleBuffer = GetCurrentParticleBuffer();
@@ -184,7 +364,7 @@ void FluidRenderModule::UpdateParticleBuffer(CommandList* pCmdList)
     Barrier b = Barrier::Transition(particleBuffer->GetResource(), ResourceState::ShaderResource, ResourceState::CopyDest);
     ResourceBarrier(pCmdList, 1, &b);
 
-    particleBuffer->CopyData(m_gpuParticles.data(), sizeof(GPUParticle) * m_gpuParticles.size());
+    particleBuffer->CopyData(gpuParticles.data(), sizeof(GPUParticle) * gpuParticles.size());
 
     b = Barrier::Transition(particleBuffer->GetResource(), ResourceState::CopyDest, ResourceState::ShaderResource);
     ResourceBarrier(pCmdList, 1, &b);
@@ -194,15 +374,82 @@ void FluidRenderModule::DispatchTiling(CommandList* pCmdList)
 {
     m_tilingPS->UpdateRootConstantBuffer(GetFluidInfoBuffer(), 0);
     m_tilingPS->SetBufferSRV(GetCurrentParticleBuffer(), 0);
-    m_tilingPS->Bind(pCmdList, m_tilingPSO.get());
-    SetPipelineState(pCmdList, m_tilingPSO.get());
+    m_tilingPS->SetBufferUAV(GetTileIndexBuffer(), 1);
+
+    uint32_t numGroupX         = DivideRoundingUp(m_tilesX, TILING_THREAD_X);
+    uint32_t numGroupY         = DivideRoundingUp(m_tilesY, TILING_THREAD_Y);
+    uint32_t numParticleGroups = DivideRoundingUp(static_cast<uint32_t>(m_simulation->GetGPUParticles().size()), TILING_PARTICLE_THREADS);
+    uint32_t numScanGroups     = DivideRoundingUp(static_cast<uint32_t>(m_tilesX * m_tilesY * DEPTH_SLICES), PREFIX_SUM_THREADS);
+
+    std::array<Barrier, 3> b
+    {
+        Barrier::UAV(GetTileBuffer()->GetResource()),
+        Barrier::UAV(GetSliceBuffer()->GetResource()),
+        Barrier::UAV(m_scanBuffer->GetResource()),
+    };
 
-    uint32_t numGroupX = DivideRoundingUp(m_tilesX, TILING_THREAD_X);
-    uint32_t numGroupY = DivideRoundingUp(m_tilesY, TILING_THREAD_Y);
+    // Reset the tiles
+    m_tilingPS->Bind(pCmdList, m_tilingClearPSO.get());
+    SetPipelineState(pCmdList, m_tilingClearPSO.get());
     Dispatch(pCmdList, numGroupX, numGroupY, 1);
+    ResourceBarrier(pCmdList, (uint32_t)b.size(), b.data());
 
-    Barrier b = Barrier::UAV(GetShaderParticleBuffer()->GetResource());
-    ResourceBarrier(pCmdList, 1, &b);
+    // Every particle counts itself into the tiles its projected bounds overlap
+    if (numParticleGroups)
+    {
+        m_tilingPS->Bind(pCmdList, m_tilingCountPSO.get());
+        SetPipelineState(pCmdList, m_tilingCountPSO.get());
+        Dispatch(pCmdList, numParticleGroups, 1, 1);
+        ResourceBarrier(pCmdList, (uint32_t)b.size(), b.data());
+    }
+
+    // Turn the counts into offsets in the compact index list, scanning within groups first and then over the group totals
+    m_tilingPS->Bind(pCmdList, m_tilingScanSlicesPSO.get());
+    SetPipelineState(pCmdList, m_tilingScanSlicesPSO.get());
+    Dispatch(pCmdList, numScanGroups, 1, 1);
+    ResourceBarrier(pCmdList, (uint32_t)b.size(), b.data());
+
+    m_tilingPS->Bind(pCmdList, m_tilingScanGroupsPSO.get());
+    SetPipelineState(pCmdList, m_tilingScanGroupsPSO.get());
+    Dispatch(pCmdList, 1, 1, 1);
+    ResourceBarrier(pCmdList, (uint32_t)b.size(), b.data());
+
+    m_tilingPS->Bind(pCmdList, m_tilingScanApplyPSO.get());
+    SetPipelineState(pCmdList, m_tilingScanApplyPSO.get());
+    Dispatch(pCmdList, numScanGroups, 1, 1);
+    ResourceBarrier(pCmdList, (uint32_t)b.size(), b.data());
+
+    // Hand the unclamped entry count back to the CPU, see ReadTilingStats
+    {
+        size_t slot = m_frame % m_statsReadbackBuffers.size();
+
+        Barrier statsBarrier = Barrier::Transition(m_statsBuffer->GetResource(), ResourceState::UnorderedAccess, ResourceState::CopySource);
+        ResourceBarrier(pCmdList, 1, &statsBarrier);
+
+        BufferCopyDesc copyDesc(m_statsBuffer->GetResource(), m_statsReadbackBuffers[slot]->GetResource());
+        CopyBufferRegion(pCmdList, &copyDesc);
+
+        statsBarrier = Barrier::Transition(m_statsBuffer->GetResource(), ResourceState::CopySource, ResourceState::UnorderedAccess);
+        ResourceBarrier(pCmdList, 1, &statsBarrier);
+
+        m_statsReadbackPending[slot] = true;
+    }
+
+    // Scatter the particle indices into the tile lists
+    if (numParticleGroups)
+    {
+        m_tilingPS->Bind(pCmdList, m_tilingFillPSO.get());
+        SetPipelineState(pCmdList, m_tilingFillPSO.get());
+        Dispatch(pCmdList, numParticleGroups, 1, 1);
+    }
+
+    std::array<Barrier, 3> barriers
+    {
+        Barrier::UAV(GetTileBuffer()->GetResource()),
+        Barrier::UAV(GetSliceBuffer()->GetResource()),
+        Barrier::UAV(GetTileIndexBuffer()->GetResource()),
+    };
+    ResourceBarrier(pCmdList, (uint32_t)barriers.size(), barriers.data());
 }
 
 void FluidRenderModule::RenderSDF(CommandList* pCmdList)
@@ -219,6 +466,8 @@ void FluidRenderModule::RenderSDF(CommandList* pCmdList)
     BeginRaster(pCmdList, (uint32_t)rasters.size(), rasters.data(), m_pDepthRasterView);
 
     m_sdfPS->UpdateRootConstantBuffer(GetFluidInfoBuffer(), 0);
+    m_sdfPS->SetBufferSRV(GetCurrentParticleBuffer(), 0);
+    m_sdfPS->SetBufferUAV(GetTileIndexBuffer(), 1);
     m_sdfPS->Bind(pCmdList, m_sdfPSO.get());
 
     const ResolutionInfo& resInfo = GetFramework()->GetResolutionInfo();
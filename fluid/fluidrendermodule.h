@@ -1,6 +1,7 @@
 #pragma once
 
 #include <render/rendermodule.h>
+#include "fluidsimulation.h"
 
 namespace cauldron
 {
@@ -16,8 +17,6 @@ namespace cauldron
     class UIElement;
 }
 
-class FluidParticleSystem;
-struct GPUParticle;
 
 class FluidRenderModule : public cauldron::RenderModule
 {
@@ -34,14 +33,20 @@ public:
 
 private:
     void InitResources();
+    void CreateParticleBuffers(uint32_t capacity);
+    void CreateTileIndexBuffer(uint32_t capacity);
+    void ReadTilingStats();
+    void ResizeBuffers();
 
     void UpdateFluidInfoBuffer();
     void UpdateParticleBuffer(cauldron::CommandList* pCmdList);
     void DispatchTiling(cauldron::CommandList* pCmdList);
     void RenderSDF(cauldron::CommandList* pCmdList);
 
-    std::unique_ptr<FluidParticleSystem> m_particles;
-    std::vector<GPUParticle> m_gpuParticles;
+    std::unique_ptr<FluidSimulation> m_simulation;
+    FluidSimulationSettings          m_simulationSettings;
+    bool                             m_recordParticles = false;
+    bool                             m_replayParticles = false;
 
     uint32_t m_frame = 0;
     int32_t m_tilesX = 96;
@@ -49,6 +54,9 @@ private:
     float m_sdfBlend = .25f;
     float m_triplanarBlend = 0.3f;
     float m_uvScaling = 2;
+    bool  m_depthSlices = true;
+    float m_sliceNear = 0.01f;
+    float m_sliceScale = 0;
 
     const cauldron::Texture* m_pColorTarget         = nullptr;
     const cauldron::Texture* m_pAlbedoTarget        = nullptr;
@@ -65,17 +73,35 @@ private:
     std::unique_ptr<cauldron::PipelineObject> m_sdfPSO;
     std::unique_ptr<cauldron::ParameterSet>   m_tilingPS;
     std::unique_ptr<cauldron::RootSignature>  m_tilingRS;
-    std::unique_ptr<cauldron::PipelineObject> m_tilingPSO;
+    std::unique_ptr<cauldron::PipelineObject> m_tilingClearPSO;
+    std::unique_ptr<cauldron::PipelineObject> m_tilingCountPSO;
+    std::unique_ptr<cauldron::PipelineObject> m_tilingScanSlicesPSO;
+    std::unique_ptr<cauldron::PipelineObject> m_tilingScanGroupsPSO;
+    std::unique_ptr<cauldron::PipelineObject> m_tilingScanApplyPSO;
+    std::unique_ptr<cauldron::PipelineObject> m_tilingFillPSO;
 
     std::unique_ptr<cauldron::BufferAddressInfo>   m_fluidInfoBuffer;
-    std::unique_ptr<cauldron::Buffer>              m_shaderParticleBuffer;
+    std::unique_ptr<cauldron::Buffer>              m_tileBuffer;
+    std::unique_ptr<cauldron::Buffer>              m_tileIndexBuffer;
+    std::unique_ptr<cauldron::Buffer>              m_sliceBuffer;
+    std::unique_ptr<cauldron::Buffer>              m_scanBuffer;
+    std::unique_ptr<cauldron::Buffer>              m_statsBuffer;
+    std::vector<std::unique_ptr<cauldron::Buffer>> m_statsReadbackBuffers;
+    std::vector<bool>                              m_statsReadbackPending;
     std::vector<std::unique_ptr<cauldron::Buffer>> m_particleBuffers;
+    uint32_t                                       m_particleCapacity   = 0;
+    uint32_t                                       m_tileIndexCapacity  = 0;
+    uint32_t                                       m_tileIndexRequired  = 0;
+    uint32_t                                       m_tileIndexOverflows = 0;
 
     std::vector<cauldron::UIElement*> m_UIElements;
+    cauldron::UIElement*              m_simulationTextElement = nullptr;
 
     cauldron::Buffer* GetCurrentParticleBuffer() const { return m_particleBuffers[m_frame % m_particleBuffers.size()].get(); }
 
 public:
     const cauldron::BufferAddressInfo* GetFluidInfoBuffer() const { return m_fluidInfoBuffer.get(); }
-    const cauldron::Buffer* GetShaderParticleBuffer() const { return m_shaderParticleBuffer.get(); }
+    const cauldron::Buffer* GetTileBuffer() const { return m_tileBuffer.get(); }
+    const cauldron::Buffer* GetTileIndexBuffer() const { return m_tileIndexBuffer.get(); }
+    const cauldron::Buffer* GetSliceBuffer() const { return m_sliceBuffer.get(); }
 };
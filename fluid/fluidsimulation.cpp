@@ -0,0 +1,192 @@
+#include <algorithm>
+#include "fluidsimulation.h"
+
+constexpr float    FluidSimulation::TickTime;
+constexpr uint32_t FluidSimulation::SnapshotDirty;
+
+namespace
+{
+// Don't try to catch up more than this after a stall, the simulation slows down instead
+constexpr uint32_t MaxTicksPerUpdate = 8;
+}
+
+FluidSimulation::FluidSimulation()
+{
+    m_particles = std::make_unique<FluidParticleSystem>();
+}
+
+FluidSimulation::~FluidSimulation()
+{
+    Stop();
+}
+
+void FluidSimulation::Start()
+{
+    if (m_running.exchange(true))
+        return;
+
+    m_thread = std::thread(&FluidSimulation::ThreadLoop, this);
+}
+
+void FluidSimulation::Stop()
+{
+    if (!m_running.exchange(false))
+        return;
+
+    m_thread.join();
+}
+
+void FluidSimulation::SetSettings(const FluidSimulationSettings& settings)
+{
+    std::lock_guard<std::mutex> lock(m_settingsMutex);
+    m_pendingSettings = settings;
+    m_displayUpdateSpeed = settings.updateSpeed;
+}
+
+void FluidSimulation::RunTicks(uint32_t tickCount)
+{
+    for (uint32_t i = 0; i < tickCount; i++)
+        Tick();
+    Publish();
+}
+
+void FluidSimulation::ThreadLoop()
+{
+    using Clock = FluidSnapshot::Clock;
+
+    auto   last        = Clock::now();
+    double accumulator = 0;
+    while (m_running.load(std::memory_order_relaxed))
+    {
+        auto now = Clock::now();
+        accumulator += std::chrono::duration<double>(now - last).count() * m_settings.updateSpeed;
+        accumulator  = std::min(accumulator, static_cast<double>(TickTime * MaxTicksPerUpdate));
+        last = now;
+
+        bool ticked = false;
+        while (accumulator >= TickTime)
+        {
+            Tick();
+            accumulator -= TickTime;
+            ticked = true;
+        }
+
+        if (ticked)
+            Publish();
+
+        // Wake up around the next tick, a paused simulation still polls for new settings
+        double wait = m_settings.updateSpeed > 0 ? (TickTime - accumulator) / m_settings.updateSpeed : TickTime;
+        std::this_thread::sleep_for(std::chrono::duration<double>(std::min(wait, static_cast<double>(TickTime))));
+    }
+}
+
+void FluidSimulation::Tick()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_settingsMutex);
+        m_settings = m_pendingSettings;
+    }
+
+    m_particles->m_maxParticles = m_settings.maxParticles;
+    m_particles->m_particleSize = m_settings.particleSize;
+    m_particles->m_spawnRate    = m_settings.spawnRate;
+    m_particles->m_restDensity  = m_settings.restDensity;
+    m_particles->m_stiffness    = m_settings.stiffness;
+    m_particles->m_viscosity    = m_settings.viscosity;
+    m_particles->m_positionX    = m_settings.positionX;
+    m_particles->m_positionY    = m_settings.positionY;
+    m_particles->m_positionZ    = m_settings.positionZ;
+
+    m_particles->Update(TickTime);
+    m_tick++;
+}
+
+void FluidSimulation::Publish()
+{
+    FluidSnapshot& snapshot = m_snapshots[m_writeIndex];
+
+    // Assigning into the old snapshot reuses its streams
+    snapshot.particles     = m_particles->GetParticles();
+    snapshot.tick        = m_tick;
+    snapshot.updateMs    = m_particles->GetLastUpdateMs();
+    snapshot.publishTime = FluidSnapshot::Clock::now();
+
+    m_writeIndex = m_sharedIndex.exchange(m_writeIndex | SnapshotDirty, std::memory_order_acq_rel) & ~SnapshotDirty;
+}
+
+const FluidSnapshot& FluidSimulation::AcquireSnapshot()
+{
+    if (m_sharedIndex.load(std::memory_order_relaxed) & SnapshotDirty)
+    {
+        // The writer overwrites the released snapshot completely, so its streams can be swapped out instead of copied
+        FluidSnapshot& released = m_snapshots[m_readIndex];
+        std::swap(m_previousParticles, released.particles);
+        m_previousTick = released.tick;
+
+        m_readIndex = m_sharedIndex.exchange(m_readIndex, std::memory_order_acq_rel) & ~SnapshotDirty;
+    }
+
+    return m_snapshots[m_readIndex];
+}
+
+void FluidSimulation::CreateGPUParticles(const Point3& cameraPos)
+{
+    const FluidSnapshot& snapshot = AcquireSnapshot();
+
+    if (m_player.IsOpen())
+    {
+        m_player.ReadFrame(m_replayFrame, m_replayParticles);
+        m_replayFrame = (m_replayFrame + 1) % m_player.GetFrameCount();
+
+        m_particles->CreateGPUParticles(m_replayParticles, cameraPos);
+        return;
+    }
+
+    if (m_recorder.IsOpen() && snapshot.tick != m_recordedTick)
+    {
+        m_recorder.AddFrame(snapshot.particles);
+        m_recordedTick = snapshot.tick;
+    }
+
+    // Display one batch behind the newest state, blending from the previous snapshot towards it over the ticks between them
+    float alpha = 1;
+    if (m_running.load(std::memory_order_relaxed) && snapshot.tick > m_previousTick)
+    {
+        float elapsed = std::chrono::duration<float>(FluidSnapshot::Clock::now() - snapshot.publishTime).count();
+        float span    = (snapshot.tick - m_previousTick) * TickTime;
+        alpha = std::min(std::max(elapsed * m_displayUpdateSpeed / span, 0.f), 1.f);
+    }
+
+    m_particles->CreateGPUParticles(snapshot.particles, cameraPos, &m_previousParticles, alpha);
+}
+
+bool FluidSimulation::StartRecording(const std::string& path)
+{
+    m_recordedTick = 0;
+    return m_recorder.Open(path);
+}
+
+void FluidSimulation::StopRecording()
+{
+    m_recorder.Close();
+}
+
+bool FluidSimulation::StartReplay(const std::string& path)
+{
+    m_replayFrame = 0;
+    if (!m_player.Open(path))
+        return false;
+
+    // Nothing to play back
+    if (!m_player.GetFrameCount())
+    {
+        m_player.Close();
+        return false;
+    }
+    return true;
+}
+
+void FluidSimulation::StopReplay()
+{
+    m_player.Close();
+}
@@ -0,0 +1,107 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include "fluidparticlestream.h"
+#include "fluidparticlesystem.h"
+
+// Values the UI edits, picked up by the simulation at the start of every tick
+struct FluidSimulationSettings
+{
+    int32_t maxParticles = 128;
+    float   particleSize = .1f;
+    float   updateSpeed  = 1;
+    float   spawnRate    = 30;
+    float   restDensity  = 1000;
+    float   stiffness    = 20;
+    float   viscosity    = .5f;
+    float   positionX    = 0;
+    float   positionY    = 1;
+    float   positionZ    = 0;
+};
+
+// State of the simulation after a tick
+struct FluidSnapshot
+{
+    using Clock = std::chrono::steady_clock;
+
+    FluidParticleStore particles;
+    uint64_t           tick     = 0;
+    float              updateMs = 0;
+    Clock::time_point  publishTime;
+};
+
+// Runs the particle simulation at a fixed tick, either on its own thread or headless through RunTicks.
+// Every batch of ticks publishes a snapshot into a lock free triple buffer, the render side always picks up the newest one,
+// keeps the one it had before and draws the particles interpolated between the two.
+class FluidSimulation
+{
+public:
+    static constexpr float TickTime = 1 / 120.f;
+
+    FluidSimulation();
+    ~FluidSimulation();
+
+    void Start();
+    void Stop();
+
+    void SetSettings(const FluidSimulationSettings& settings);
+
+    // Advances exactly tickCount ticks on the calling thread, only valid while the thread isn't running
+    void RunTicks(uint32_t tickCount);
+
+    // Render side: grabs the newest snapshot and packs it for the GPU
+    void CreateGPUParticles(const Point3& cameraPos);
+
+    // Render side: records every new snapshot the frames pick up, or replaces the simulation with a recorded
+    // stream advancing one recorded frame per rendered frame so the GPU sees the same workload on every run
+    bool StartRecording(const std::string& path);
+    void StopRecording();
+    bool StartReplay(const std::string& path);
+    void StopReplay();
+    bool IsRecording() const { return m_recorder.IsOpen(); }
+    bool IsReplaying() const { return m_player.IsOpen(); }
+
+    const std::vector<GPUParticle>& GetGPUParticles() const { return m_particles->GetGPUParticles(); }
+    float GetBiggestRadius() const { return m_particles->GetBiggestRadius(); }
+
+    // Newest snapshot picked up by the render side
+    const FluidSnapshot& GetSnapshot() const { return m_snapshots[m_readIndex]; }
+
+private:
+    void ThreadLoop();
+    void Tick();
+    void Publish();
+    const FluidSnapshot& AcquireSnapshot();
+
+    std::unique_ptr<FluidParticleSystem> m_particles;
+
+    FluidStreamRecorder m_recorder;
+    FluidStreamPlayer   m_player;
+    FluidParticleStore  m_replayParticles;
+    uint32_t            m_replayFrame = 0;
+    uint64_t            m_recordedTick = 0;
+
+    std::mutex              m_settingsMutex;
+    FluidSimulationSettings m_pendingSettings;
+    FluidSimulationSettings m_settings;
+    float                   m_displayUpdateSpeed = 1;
+    uint64_t                m_tick = 0;
+
+    std::thread       m_thread;
+    std::atomic<bool> m_running{false};
+
+    // Triple buffer, the writer owns m_writeIndex, the reader m_readIndex and the third one is parked in m_sharedIndex
+    static constexpr uint32_t SnapshotDirty = 4;
+    FluidSnapshot             m_snapshots[3];
+    uint32_t                  m_writeIndex = 0;
+    uint32_t                  m_readIndex  = 1;
+    std::atomic<uint32_t>     m_sharedIndex{2};
+
+    // Render side copy of the snapshot picked up before the newest one
+    FluidParticleStore m_previousParticles;
+    uint64_t           m_previousTick = 0;
+};
@@ -0,0 +1,325 @@
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include "fluidtiling.h"
+
+float GetTilingOverestimate(float biggestRadius, float sdfBlend)
+{
+    return biggestRadius * std::pow(sdfBlend, 0.75f) * 4;
+}
+
+uint32_t GetDepthSlice(const FluidTilingParams& params, float dist)
+{
+    float slice = std::floor(std::log(std::max(dist, params.sliceNear) / params.sliceNear) * params.sliceScale);
+    return static_cast<uint32_t>(std::min(slice, static_cast<float>(DEPTH_SLICES - 1)));
+}
+
+float GetDepthSliceEnd(const FluidTilingParams& params, uint32_t slice)
+{
+    if (slice >= DEPTH_SLICES - 1 || params.sliceScale <= 0)
+        return 1e20f;
+    return params.sliceNear * std::exp((slice + 1) / params.sliceScale);
+}
+
+void FitDepthSlices(FluidTilingParams& params, const std::vector<GPUParticle>& particles, bool enabled)
+{
+    float nearest  = 1e20f;
+    float farthest = 0;
+    for (const auto& particle : particles)
+    {
+        FluidTileRect rect;
+        Vec3          viewParticle;
+        float         radius;
+        if (!GetParticleTileRect(params, particle.posSize, rect, viewParticle, radius))
+            continue;
+
+        float dist = length(viewParticle);
+        nearest  = std::min(nearest,  dist - radius);
+        farthest = std::max(farthest, dist + radius);
+    }
+
+    // A zero scale puts everything in the first slice
+    params.sliceNear  = std::max(nearest, 0.01f);
+    params.sliceScale = 0;
+    if (enabled && farthest > params.sliceNear)
+        params.sliceScale = DEPTH_SLICES / std::log(farthest / params.sliceNear);
+}
+
+namespace
+{
+// Projects the two points where planes through the eye touch the sphere along one screen axis
+void GetProjectedBounds(const Mat4& projection, const Vec3& center, float radius, bool xAxis, float& minNDC, float& maxNDC)
+{
+    float c     = xAxis ? center.getX() : center.getY();
+    float cz    = center.getZ();
+    float len2  = c * c + cz * cz;
+    float t     = std::sqrt(len2 - radius * radius);
+    float scale = t / len2;
+
+    minNDC =  1e20f;
+    maxNDC = -1e20f;
+    for (float side = -1; side <= 1; side += 2)
+    {
+        // Rotate (c, cz) by +-asin(radius / len) and scale it down onto the tangent point
+        float tc = (c * t - side * cz * radius) * scale;
+        float tz = (cz * t + side * c * radius) * scale;
+
+        Vec4 point = xAxis ? Vec4(tc, center.getY(), tz, 1) : Vec4(center.getX(), tc, tz, 1);
+        Vec4 clip  = projection * point;
+        float ndc  = (xAxis ? clip.getX() : clip.getY()) / clip.getW();
+
+        minNDC = std::min(minNDC, ndc);
+        maxNDC = std::max(maxNDC, ndc);
+    }
+}
+
+uint32_t AsUint(float value)
+{
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+void ClearTiles(const FluidTilingParams& params, FluidTileBins& bins)
+{
+    TileInfo  emptyTile  = {0, AsUint(1e20f), 0};
+    SliceInfo emptySlice = {0, 0, 0};
+    bins.tiles.assign(static_cast<size_t>(params.tilesX) * params.tilesY, emptyTile);
+    bins.slices.assign(bins.tiles.size() * DEPTH_SLICES, emptySlice);
+}
+
+void AddToTile(const FluidTilingParams& params, uint32_t tileIndex, const Vec3& viewParticle, float radius, FluidTileBins& bins)
+{
+    TileInfo& info = bins.tiles[tileIndex];
+    float     dist = length(viewParticle);
+
+    // Both distances are non-negative, so their bit patterns order like the floats
+    info.particleCount++;
+    info.closest  = std::min(info.closest,  AsUint(dist - radius));
+    info.farthest = std::max(info.farthest, AsUint(dist + radius));
+
+    uint32_t lastSlice = GetDepthSlice(params, dist + radius);
+    for (uint32_t slice = GetDepthSlice(params, dist - radius); slice <= lastSlice; slice++)
+        bins.slices[tileIndex * DEPTH_SLICES + slice].particleCount++;
+}
+
+// Same as the TilingScan passes, a serial scan gives the same offsets
+void AssignSliceOffsets(uint32_t indexCapacity, FluidTileBins& bins)
+{
+    uint32_t offset = 0;
+    for (auto& info : bins.slices)
+    {
+        uint32_t count = std::min(info.particleCount, indexCapacity - std::min(offset, indexCapacity));
+
+        info.particleCount  = count;
+        info.particleOffset = offset;
+        offset += count;
+    }
+    bins.indices.assign(offset, 0);
+}
+
+void AppendToTile(const FluidTilingParams& params, uint32_t tileIndex, const Vec3& viewParticle, float radius, uint32_t particleIndex, FluidTileBins& bins)
+{
+    float    dist      = length(viewParticle);
+    uint32_t lastSlice = GetDepthSlice(params, dist + radius);
+    for (uint32_t slice = GetDepthSlice(params, dist - radius); slice <= lastSlice; slice++)
+    {
+        SliceInfo& info = bins.slices[tileIndex * DEPTH_SLICES + slice];
+
+        uint32_t slot = info.fillCount++;
+        if (slot < info.particleCount)
+            bins.indices[info.particleOffset + slot] = particleIndex;
+    }
+}
+
+// Inward facing side planes of a tile frustum, mirrors GetTileFrustum of the old tiling shader
+struct TileFrustum
+{
+    Vec3 normals[4];
+};
+
+Vec3 ScreenToView(const Mat4& invProjection, float x, float y)
+{
+    Vec4 view = invProjection * Vec4(x, y, 1, 1);
+    return view.getXYZ() / view.getW();
+}
+
+TileFrustum GetTileFrustum(const FluidTilingParams& params, const Mat4& invProjection, int32_t tileX, int32_t tileY)
+{
+    float left   = tileX       / static_cast<float>(params.tilesX) * 2 - 1;
+    float right  = (tileX + 1) / static_cast<float>(params.tilesX) * 2 - 1;
+    float top    = -((tileY + 1) / static_cast<float>(params.tilesY) * 2 - 1);
+    float bottom = -(tileY       / static_cast<float>(params.tilesY) * 2 - 1);
+
+    Vec3 topLeft     = normalize(ScreenToView(invProjection, left,  top));
+    Vec3 bottomLeft  = normalize(ScreenToView(invProjection, left,  bottom));
+    Vec3 bottomRight = normalize(ScreenToView(invProjection, right, bottom));
+    Vec3 topRight    = normalize(ScreenToView(invProjection, right, top));
+
+    TileFrustum frustum;
+    frustum.normals[0] = normalize(cross(topRight,    bottomRight));
+    frustum.normals[1] = normalize(cross(bottomLeft,  topLeft));
+    frustum.normals[2] = normalize(cross(topLeft,     topRight));
+    frustum.normals[3] = normalize(cross(bottomRight, bottomLeft));
+    return frustum;
+}
+
+bool ParticleInTile(const TileFrustum& frustum, const Vec3& viewParticle, float radius)
+{
+    return dot(frustum.normals[0], viewParticle) <= radius &&
+           dot(frustum.normals[1], viewParticle) <= radius &&
+           dot(frustum.normals[2], viewParticle) <= radius &&
+           dot(frustum.normals[3], viewParticle) <= radius;
+}
+}
+
+bool GetParticleTileRect(const FluidTilingParams& params, const Vec4& particle, FluidTileRect& rect)
+{
+    Vec3  viewParticle;
+    float radius;
+    return GetParticleTileRect(params, particle, rect, viewParticle, radius);
+}
+
+bool GetParticleTileRect(const FluidTilingParams& params, const Vec4& particle, FluidTileRect& rect, Vec3& viewParticle, float& radius)
+{
+    Vec4 view = params.viewMatrix * Vec4(particle.getXYZ(), 1);
+    viewParticle = view.getXYZ() / view.getW();
+
+    radius = particle.getW() + params.overestimate;
+    if (radius <= 0)
+        return false;
+
+    const Vec3& center = viewParticle;
+
+    // Same as the GPU, spheres touching the camera plane are skipped
+    if (-center.getZ() < radius)
+        return false;
+
+    float minX, maxX, minY, maxY;
+    GetProjectedBounds(params.projectionMatrix, center, radius, true,  minX, maxX);
+    GetProjectedBounds(params.projectionMatrix, center, radius, false, minY, maxY);
+
+    if (maxX < -1 || minX > 1 || maxY < -1 || minY > 1)
+        return false;
+
+    // NDC y points up, tile rows go down the screen
+    rect.minX = static_cast<int32_t>(std::floor((minX * .5f + .5f) * params.tilesX));
+    rect.maxX = static_cast<int32_t>(std::floor((maxX * .5f + .5f) * params.tilesX));
+    rect.minY = static_cast<int32_t>(std::floor((.5f - maxY * .5f) * params.tilesY));
+    rect.maxY = static_cast<int32_t>(std::floor((.5f - minY * .5f) * params.tilesY));
+
+    rect.minX = std::max(rect.minX, 0);
+    rect.minY = std::max(rect.minY, 0);
+    rect.maxX = std::min(rect.maxX, params.tilesX - 1);
+    rect.maxY = std::min(rect.maxY, params.tilesY - 1);
+
+    return rect.minX <= rect.maxX && rect.minY <= rect.maxY;
+}
+
+uint32_t CountTileOverlaps(const FluidTilingParams& params, const std::vector<GPUParticle>& particles)
+{
+    uint32_t count = 0;
+    for (const auto& particle : particles)
+    {
+        FluidTileRect rect;
+        Vec3          viewParticle;
+        float         radius;
+        if (!GetParticleTileRect(params, particle.posSize, rect, viewParticle, radius))
+            continue;
+
+        float    dist   = length(viewParticle);
+        uint32_t slices = GetDepthSlice(params, dist + radius) - GetDepthSlice(params, dist - radius) + 1;
+        count += rect.GetTileCount() * slices;
+    }
+
+    return count;
+}
+
+void BinParticles(const FluidTilingParams& params, const std::vector<GPUParticle>& particles, uint32_t indexCapacity, FluidTileBins& bins)
+{
+    ClearTiles(params, bins);
+
+    std::vector<FluidTileRect> rects(particles.size());
+    std::vector<uint8_t>       visible(particles.size());
+    std::vector<Vec3>          viewParticles(particles.size());
+    std::vector<float>         radii(particles.size());
+
+    for (size_t i = 0; i < particles.size(); i++)
+    {
+        Vec3  viewParticle;
+        float radius;
+        visible[i] = GetParticleTileRect(params, particles[i].posSize, rects[i], viewParticle, radius);
+        if (!visible[i])
+            continue;
+
+        const FluidTileRect& rect = rects[i];
+        for (int32_t y = rect.minY; y <= rect.maxY; y++)
+            for (int32_t x = rect.minX; x <= rect.maxX; x++)
+                AddToTile(params, y * params.tilesX + x, viewParticle, radius, bins);
+
+        viewParticles[i] = viewParticle;
+        radii[i]         = radius;
+    }
+
+    AssignSliceOffsets(indexCapacity, bins);
+
+    for (size_t i = 0; i < particles.size(); i++)
+    {
+        if (!visible[i])
+            continue;
+
+        const FluidTileRect& rect = rects[i];
+        for (int32_t y = rect.minY; y <= rect.maxY; y++)
+            for (int32_t x = rect.minX; x <= rect.maxX; x++)
+                AppendToTile(params, y * params.tilesX + x, viewParticles[i], radii[i], static_cast<uint32_t>(i), bins);
+    }
+}
+
+void BinParticlesBruteForce(const FluidTilingParams& params, const std::vector<GPUParticle>& particles, uint32_t indexCapacity, FluidTileBins& bins)
+{
+    ClearTiles(params, bins);
+
+    // Transform once, the GPU version redid this for every tile
+    std::vector<Vec3>  viewParticles(particles.size());
+    std::vector<float> radii(particles.size());
+    for (size_t i = 0; i < particles.size(); i++)
+    {
+        Vec4 view = params.viewMatrix * Vec4(particles[i].posSize.getXYZ(), 1);
+        viewParticles[i] = view.getXYZ() / view.getW();
+        radii[i]         = particles[i].posSize.getW() + params.overestimate;
+    }
+
+    auto forEachParticleInTile = [&](const TileFrustum& frustum, auto&& func)
+    {
+        for (size_t i = 0; i < particles.size(); i++)
+        {
+            if (radii[i] <= 0 || -viewParticles[i].getZ() < radii[i])
+                continue;
+            if (ParticleInTile(frustum, viewParticles[i], radii[i]))
+                func(static_cast<uint32_t>(i));
+        }
+    };
+
+    Mat4 invProjection = inverse(params.projectionMatrix);
+    std::vector<TileFrustum> frustums(bins.tiles.size());
+    for (int32_t y = 0; y < params.tilesY; y++)
+    {
+        for (int32_t x = 0; x < params.tilesX; x++)
+        {
+            uint32_t tileIndex = y * params.tilesX + x;
+            frustums[tileIndex] = GetTileFrustum(params, invProjection, x, y);
+            forEachParticleInTile(frustums[tileIndex], [&](uint32_t i) { AddToTile(params, tileIndex, viewParticles[i], radii[i], bins); });
+        }
+    }
+
+    AssignSliceOffsets(indexCapacity, bins);
+
+    for (int32_t y = 0; y < params.tilesY; y++)
+    {
+        for (int32_t x = 0; x < params.tilesX; x++)
+        {
+            uint32_t tileIndex = y * params.tilesX + x;
+            forEachParticleInTile(frustums[tileIndex], [&](uint32_t i) { AppendToTile(params, tileIndex, viewParticles[i], radii[i], i, bins); });
+        }
+    }
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include "shaders/fluid.hlsli"
+
+// CPU side of the screen tile binning, mirrors the math in shaders/tiling.hlsl
+struct FluidTilingParams
+{
+    Mat4    viewMatrix;
+    Mat4    projectionMatrix;
+    int32_t tilesX;
+    int32_t tilesY;
+    float   overestimate;
+
+    // Exponential depth slices, see FitDepthSlices
+    float   sliceNear;
+    float   sliceScale;
+};
+
+// Inclusive tile range covered by a particle
+struct FluidTileRect
+{
+    int32_t minX;
+    int32_t minY;
+    int32_t maxX;
+    int32_t maxY;
+
+    uint32_t GetTileCount() const { return static_cast<uint32_t>((maxX - minX + 1) * (maxY - minY + 1)); }
+};
+
+// Rough extra radius accounting for the smooth union pulling the surface outwards
+float GetTilingOverestimate(float biggestRadius, float sdfBlend);
+
+// Depth slice a view distance falls into and the view distance where a slice ends, mirrors fluid.hlsli
+uint32_t GetDepthSlice(const FluidTilingParams& params, float dist);
+float GetDepthSliceEnd(const FluidTilingParams& params, uint32_t slice);
+
+// Spreads the depth slices over the view distances the visible particles cover
+void FitDepthSlices(FluidTilingParams& params, const std::vector<GPUParticle>& particles, bool enabled);
+
+// Conservative screen tile bounds of a particle sphere, returns false if it doesn't touch any tile
+bool GetParticleTileRect(const FluidTilingParams& params, const Vec4& particle, FluidTileRect& rect);
+bool GetParticleTileRect(const FluidTilingParams& params, const Vec4& particle, FluidTileRect& rect, Vec3& viewParticle, float& radius);
+
+// Tile list entries needed to bin all particles, matches the count the GPU slice scan reports
+uint32_t CountTileOverlaps(const FluidTilingParams& params, const std::vector<GPUParticle>& particles);
+
+// Result of binning, laid out like TileBuffer and TileIndexBuffer on the GPU
+struct FluidTileBins
+{
+    std::vector<TileInfo>  tiles;
+    std::vector<SliceInfo> slices;
+    std::vector<uint32_t>  indices;
+};
+
+// Reference of the scatter binning in shaders/tiling.hlsl, particles are appended in order
+// so the lists match what the GPU produces up to the order of its atomics
+void BinParticles(const FluidTilingParams& params, const std::vector<GPUParticle>& particles, uint32_t indexCapacity, FluidTileBins& bins);
+
+// The previous binning that tests every particle against the frustum planes of every tile, kept for comparisons
+void BinParticlesBruteForce(const FluidTilingParams& params, const std::vector<GPUParticle>& particles, uint32_t indexCapacity, FluidTileBins& bins);
@@ -0,0 +1,94 @@
+#include <algorithm>
+#include "fluidworkerpool.h"
+
+FluidWorkerPool::FluidWorkerPool(uint32_t workerCount)
+{
+    // The calling thread is the first worker
+    workerCount = std::max(workerCount, 1u) - 1;
+
+    for (uint32_t i = 0; i < workerCount; i++)
+        m_workers.emplace_back([this]() { WorkerLoop(); });
+}
+
+FluidWorkerPool::~FluidWorkerPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_shuttingDown = true;
+    }
+    m_wakeCondition.notify_all();
+
+    for (auto& worker : m_workers)
+        worker.join();
+}
+
+void FluidWorkerPool::ParallelFor(uint32_t count, uint32_t minChunkSize, const RangeFunc& func)
+{
+    if (count == 0)
+        return;
+
+    // Aim for a few chunks per thread so uneven chunks (e.g. dense neighborhoods) balance out
+    uint32_t chunkSize = std::max(minChunkSize, (count + GetThreadCount() * 4 - 1) / (GetThreadCount() * 4));
+    chunkSize          = std::max(chunkSize, 1u);
+
+    if (m_workers.empty() || count <= chunkSize)
+    {
+        func(0, count);
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_func      = &func;
+        m_count     = count;
+        m_chunkSize = chunkSize;
+        m_nextChunk = 0;
+        m_busyWorkers = static_cast<uint32_t>(m_workers.size());
+        m_generation++;
+    }
+    m_wakeCondition.notify_all();
+
+    RunChunks();
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_doneCondition.wait(lock, [this]() { return m_busyWorkers == 0; });
+    m_func = nullptr;
+}
+
+void FluidWorkerPool::RunChunks()
+{
+    while (true)
+    {
+        uint32_t begin = m_nextChunk.fetch_add(m_chunkSize);
+        if (begin >= m_count)
+            break;
+
+        (*m_func)(begin, std::min(begin + m_chunkSize, m_count));
+    }
+}
+
+void FluidWorkerPool::WorkerLoop()
+{
+    uint64_t generation = 0;
+
+    while (true)
+    {
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_wakeCondition.wait(lock, [&]() { return m_shuttingDown || m_generation != generation; });
+
+            if (m_shuttingDown)
+                return;
+
+            generation = m_generation;
+        }
+
+        RunChunks();
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (--m_busyWorkers == 0)
+                m_doneCondition.notify_one();
+        }
+    }
+}
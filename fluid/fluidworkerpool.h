@@ -0,0 +1,46 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Small persistent thread pool used to split the per-particle simulation passes across cores.
+// The calling thread takes part in the work, so a pool with 0 workers just runs everything inline.
+class FluidWorkerPool
+{
+public:
+    using RangeFunc = std::function<void(uint32_t begin, uint32_t end)>;
+
+    explicit FluidWorkerPool(uint32_t workerCount = std::thread::hardware_concurrency());
+    ~FluidWorkerPool();
+
+    FluidWorkerPool(const FluidWorkerPool&) = delete;
+    FluidWorkerPool& operator=(const FluidWorkerPool&) = delete;
+
+    // Calls func on disjoint [begin, end) ranges covering [0, count), returns once all ranges are done
+    void ParallelFor(uint32_t count, uint32_t minChunkSize, const RangeFunc& func);
+
+    uint32_t GetThreadCount() const { return static_cast<uint32_t>(m_workers.size()) + 1; }
+
+private:
+    void WorkerLoop();
+    void RunChunks();
+
+    std::vector<std::thread> m_workers;
+
+    std::mutex              m_mutex;
+    std::condition_variable m_wakeCondition;
+    std::condition_variable m_doneCondition;
+    uint64_t                m_generation = 0;
+    uint32_t                m_busyWorkers = 0;
+    bool                    m_shuttingDown = false;
+
+    const RangeFunc*      m_func       = nullptr;
+    uint32_t              m_count      = 0;
+    uint32_t              m_chunkSize  = 0;
+    std::atomic<uint32_t> m_nextChunk{0};
+};
@@ -6,13 +6,22 @@
 #include "shadercommon.h"
 #endif
 
-#define TILES_MAX_X         128
-#define TILES_MAX_Y         128
-#define TILE_MAX_PARTICLES   64
-#define MAX_PARTICLES      1024
+#define TILES_MAX_X         256
+#define TILES_MAX_Y         256
 
 #define TILING_THREAD_X       8
 #define TILING_THREAD_Y       8
+#define TILING_PARTICLE_THREADS 64
+#define PREFIX_SUM_THREADS 1024
+
+// The slice scan runs in two levels, one group per PREFIX_SUM_THREADS slices and one group over the group totals
+#define PREFIX_SUM_MAX_GROUPS ((TILES_MAX_X * TILES_MAX_Y * DEPTH_SLICES + PREFIX_SUM_THREADS - 1) / PREFIX_SUM_THREADS)
+
+// Every tile list is split into this many depth slices, spaced exponentially like clustered shading
+#define DEPTH_SLICES         16
+
+// Tiles with this many particles show up saturated in the tile debug view
+#define TILE_DEBUG_MAX_PARTICLES 64
 
 struct GPUParticle
 {
@@ -24,6 +33,48 @@ struct GPUParticle
 #endif
 };
 
+// Particles overlapping a tile and the depth range they cover
+// The depth range holds the bits of non-negative view distances so it can be updated with atomics
+struct TileInfo
+{
+#if __cplusplus
+    uint32_t particleCount;
+    uint32_t closest;
+    uint32_t farthest;
+#else
+    uint     particleCount;
+    uint     closest;
+    uint     farthest;
+#endif
+};
+
+// Depth slices of a tile reference a range of the compact tile index list
+struct SliceInfo
+{
+#if __cplusplus
+    uint32_t particleCount;
+    uint32_t particleOffset;
+    uint32_t fillCount;
+#else
+    uint     particleCount;
+    uint     particleOffset;
+    uint     fillCount;
+#endif
+};
+
+// Written by the slice scan and read back to size the tile index list
+// A frame dropped tile entries if it needed more indices than the capacity it ran with
+struct TilingStats
+{
+#if __cplusplus
+    uint32_t requiredIndices;
+    uint32_t indexCapacity;
+#else
+    uint     requiredIndices;
+    uint     indexCapacity;
+#endif
+};
+
 struct FluidInfo
 {
     SceneInformation SceneInfo;
@@ -36,6 +87,15 @@ struct FluidInfo
     float            SDFBlend;
     float            TriplanarBlend;
     float            UVScaling;
+    float            TileOverestimate;
+
+#if __cplusplus
+    uint32_t         IndexCapacity;
+#else
+    uint             IndexCapacity;
+#endif
+    float            SliceNear;
+    float            SliceScale;
     float            Padding;
 };
 
@@ -45,11 +105,36 @@ cbuffer CBFluidInformation : register(b0)
     FluidInfo Info;
 };
 
-RWBuffer<float4> ParticleBuffer : register(u0);
+Buffer<float4>                  ParticleBuffer  : register(t0);
+RWStructuredBuffer<TileInfo>    TileBuffer      : register(u0);
+RWStructuredBuffer<uint>        TileIndexBuffer : register(u1);
+RWStructuredBuffer<SliceInfo>   SliceBuffer     : register(u2);
+RWStructuredBuffer<uint>        ScanBuffer      : register(u3);
+RWStructuredBuffer<TilingStats> StatsBuffer     : register(u4);
+
+uint GetTileIndex(uint2 tile)
+{
+    return tile.y * Info.TilesX + tile.x;
+}
+
+uint GetSliceIndex(uint tileIndex, uint slice)
+{
+    return tileIndex * DEPTH_SLICES + slice;
+}
+
+// Keep in sync with GetDepthSlice in fluidtiling.cpp
+uint GetDepthSlice(float dist)
+{
+    float slice = floor(log(max(dist, Info.SliceNear) / Info.SliceNear) * Info.SliceScale);
+    return uint(min(slice, DEPTH_SLICES - 1));
+}
 
-uint GetTileBufferOffset(uint2 tile)
+// View distance where a slice ends, particles in later slices are all beyond it
+float GetDepthSliceEnd(uint slice)
 {
-    return (tile.y * Info.TilesX + tile.x) * TILE_MAX_PARTICLES;
+    if (slice >= DEPTH_SLICES - 1 || Info.SliceScale <= 0)
+        return 1e20;
+    return Info.SliceNear * exp((slice + 1) / Info.SliceScale);
 }
 
 uint2 GetTileFromUV(float2 uv)
@@ -9,14 +9,6 @@ Texture2D<float4>  RoughnessTexture : register(t5);
 
 SamplerState linearSampler : register(s0);
 
-struct TileInfo
-{
-    uint  particleCount;
-    uint  tileOffset;
-    float closest;
-    float farthest;
-};
-
 struct PixelIn
 {
     float4 position : SV_Position;
@@ -51,13 +43,13 @@ float opS(float d1, float d2, float k)
     return smin(d1, d2, k);
 }
 
-float map(TileInfo info, float3 pos)
+float map(SliceInfo info, float3 pos)
 {
     float ret = 1e20;
 
     for (uint i = 0; i < info.particleCount; i++)
     {
-        float4 particle = ParticleBuffer[info.tileOffset + i];
+        float4 particle = ParticleBuffer[TileIndexBuffer[info.particleOffset + i]];
 
         if (particle.w <= 0)
             continue;
@@ -68,27 +60,69 @@ float map(TileInfo info, float3 pos)
     return ret;
 }
 
-float3 normalAt(TileInfo info, float3 pos)
+// Same depth slice range as TilingCountCS bins the particle into
+bool IsInSlice(float4 particle, uint slice)
+{
+    float radius = particle.w + Info.TileOverestimate;
+    float dist   = length(WorldToView(particle.xyz));
+    return GetDepthSlice(dist - radius) <= slice && slice <= GetDepthSlice(dist + radius);
+}
+
+// Adds the particles of a neighbouring slice that the hit slice doesn't hold already
+float mapNeighbour(SliceInfo info, uint hitSlice, float3 pos, float ret)
+{
+    for (uint i = 0; i < info.particleCount; i++)
+    {
+        float4 particle = ParticleBuffer[TileIndexBuffer[info.particleOffset + i]];
+
+        if (particle.w <= 0 || IsInSlice(particle, hitSlice))
+            continue;
+        float o = sdSphere(pos - particle.xyz, particle.w);
+        ret = opS(o, ret, particle.w * Info.SDFBlend);
+    }
+
+    return ret;
+}
+
+// The hit slice goes first, the smooth union depends on the order and the neighbours only change it where they reach the surface
+float mapAround(uint tileIndex, uint slice, float3 pos)
+{
+    float ret = map(SliceBuffer[GetSliceIndex(tileIndex, slice)], pos);
+    if (slice > 0)
+        ret = mapNeighbour(SliceBuffer[GetSliceIndex(tileIndex, slice - 1)], slice, pos, ret);
+    if (slice < DEPTH_SLICES - 1)
+        ret = mapNeighbour(SliceBuffer[GetSliceIndex(tileIndex, slice + 1)], slice, pos, ret);
+    return ret;
+}
+
+// The gradient also takes the neighbouring slices, with the hit slice alone the normals can show seams at slice borders
+float3 normalAt(uint tileIndex, uint slice, float3 pos)
 {
     float epsilon = 0.001;
 
-    float s  = map(info, pos);
-    float dx = map(info, float3(pos.x + epsilon, pos.y, pos.z)) - s;
-    float dy = map(info, float3(pos.x, pos.y + epsilon, pos.z)) - s;
-    float dz = map(info, float3(pos.x, pos.y, pos.z + epsilon)) - s;
+    float s  = mapAround(tileIndex, slice, pos);
+    float dx = mapAround(tileIndex, slice, float3(pos.x + epsilon, pos.y, pos.z)) - s;
+    float dy = mapAround(tileIndex, slice, float3(pos.x, pos.y + epsilon, pos.z)) - s;
+    float dz = mapAround(tileIndex, slice, float3(pos.x, pos.y, pos.z + epsilon)) - s;
 
     return normalize(float3(dx, dy, dz));
 }
 
-float march(TileInfo info, float3 offset, float3 dir)
+// Keep in sync with MarchTile in fluidmarch.cpp
+float march(uint tileIndex, float3 offset, float3 dir, float start, float farthest, out uint slice)
 {
     float closest = 1e20;
     float d = 0.01;
-    
-    for (int t = 0; t < 256 && d < info.farthest; t++)
+
+    slice = 0;
+    for (int t = 0; t < 256 && start + d < farthest; t++)
     {
+        // Particles of earlier slices are entirely behind the ray, only the current slice can be hit
+        slice = max(slice, GetDepthSlice(start + d));
+        SliceInfo info = SliceBuffer[GetSliceIndex(tileIndex, slice)];
+
         float3 pos = offset + dir * d;
-        float ter = map(info, pos);
+        float ter = info.particleCount ? map(info, pos) : 1e20;
         
         if (ter <= 0)
             return d + ter;
@@ -99,7 +133,8 @@ float march(TileInfo info, float3 offset, float3 dir)
         if (ter < closest)
             closest = ter;
         
-        d += ter;
+        // Particles of later slices are at least as far as the end of this one
+        d += min(ter, GetDepthSliceEnd(slice) - start - d + 0.001);
     }
     
     return -closest;
@@ -179,29 +214,29 @@ TriplanarData GetTriplanar(float3 worldPos, float3 normal)
 
 GBuffer ps_main(PixelIn input)
 {
-    uint2 tile = GetTileFromUV(input.texcoord);
+    uint2 tile      = GetTileFromUV(input.texcoord);
+    uint  tileIndex = GetTileIndex(tile);
 
-    uint   tileOffset   = GetTileBufferOffset(tile);
-    float4 tileInfoData = ParticleBuffer[tileOffset];
-
-    TileInfo info;
-    info.tileOffset    = tileOffset + 1; // First particle is the tile info
-    info.particleCount = (uint)tileInfoData.x;
-    info.closest       =       tileInfoData.y;
-    info.farthest      =       tileInfoData.z;
+    TileInfo info = TileBuffer[tileIndex];
+    if (info.particleCount == 0) discard;
 
     float2 xy = input.texcoord * float2(2, -2) + float2(-1, 1);
     float depth = DepthTexture.SampleLevel(linearSampler, input.texcoord, 0).x;
 
+    float tileClosest  = asfloat(info.closest);
+    float tileFarthest = asfloat(info.farthest);
+
     float viewDepth = length(ScreenToView(xy, depth));
-    if (viewDepth < info.closest) discard;
+    if (viewDepth < tileClosest) discard;
 
-    info.farthest = min(info.farthest, viewDepth);
+    tileFarthest = min(tileFarthest, viewDepth);
 
     float3 cameraPos = Info.SceneInfo.CameraInfo.CameraPos.xyz;
     float3 rayDir    = normalize(ScreenToWorld(xy, 1) - cameraPos);
-    float3 startPos  = cameraPos + rayDir * info.closest;
-    float  dist      = march(info, startPos, rayDir);
+    float3 startPos  = cameraPos + rayDir * tileClosest;
+
+    uint slice;
+    float dist = march(tileIndex, startPos, rayDir, tileClosest, tileFarthest, slice);
 
     if (dist < 0) discard;
 
@@ -210,7 +245,7 @@ GBuffer ps_main(PixelIn input)
     float intersectionDepth = WorldToScreen(intersection).z;
     if (intersectionDepth < depth) discard;
 
-    TriplanarData triplanar = GetTriplanar(intersection, normalAt(info, intersection));
+    TriplanarData triplanar = GetTriplanar(intersection, normalAt(tileIndex, slice, intersection));
 
     GBuffer buffer;
 
@@ -15,14 +15,12 @@ float4 ps_main(PixelIn input) : SV_Target0
 {
     uint2 tile = GetTileFromUV(input.texcoord);
 
-    uint    tileOffset   = GetTileBufferOffset(tile);
-    float4  tileInfoData = ParticleBuffer[tileOffset];
-    uint   particleCount = (uint)tileInfoData.x;
+    uint particleCount = TileBuffer[GetTileIndex(tile)].particleCount;
 
     if (particleCount == 0) discard;
 
     float alpha    = 0.5;
-    float strength = particleCount / float(TILE_MAX_PARTICLES - 1);
+    float strength = particleCount / float(TILE_DEBUG_MAX_PARTICLES);
 
     float3 color = float3(0, 0, 0.5);
 
@@ -1,75 +1,229 @@
 #include "fluid.hlsli"
 
-Buffer<float4> InputParticleBuffer : register(t0);
+// Keep in sync with GetParticleTileRect in fluidtiling.cpp, the CPU reference relies on the same operation order
 
-void CreateList(uint2 tile)
+// Projects the two points where planes through the eye touch the sphere along one screen axis
+float2 GetProjectedBounds(float3 center, float radius, bool xAxis)
 {
-    uint tileOffset = GetTileBufferOffset(tile);
+    float c     = xAxis ? center.x : center.y;
+    float cz    = center.z;
+    float len2  = c * c + cz * cz;
+    float t     = sqrt(len2 - radius * radius);
+    float scale = t / len2;
+
+    float2 bounds = float2(1e20, -1e20);
+    for (float side = -1; side <= 1; side += 2)
+    {
+        // Rotate (c, cz) by +-asin(radius / len) and scale it down onto the tangent point
+        float tc = (c * t - side * cz * radius) * scale;
+        float tz = (cz * t + side * c * radius) * scale;
+
+        float4 tangent = xAxis ? float4(tc, center.y, tz, 1) : float4(center.x, tc, tz, 1);
+        float4 clip    = mul(Info.SceneInfo.CameraInfo.ProjectionMatrix, tangent);
+        float  ndc     = (xAxis ? clip.x : clip.y) / clip.w;
+
+        bounds.x = min(bounds.x, ndc);
+        bounds.y = max(bounds.y, ndc);
+    }
+    return bounds;
+}
+
+// Conservative inclusive tile rectangle (min.xy, max.xy) of a particle sphere
+bool GetParticleTileRect(float4 particle, out int4 rect, out float3 viewParticle, out float radius)
+{
+    rect = 0;
 
-    float2 xyTL = tile       / float2(Info.TilesX, Info.TilesY) * 2 - 1;
-    float2 xyBR = (tile + 1) / float2(Info.TilesX, Info.TilesY) * 2 - 1;
+    // Roughly account for smoothing
+    radius = particle.w + Info.TileOverestimate;
+    viewParticle = WorldToView(particle.xyz);
 
-    // swizzle into correct positions
-    float tmp = xyTL.y;
-    xyTL.y = -xyBR.y;
-    xyBR.y = -tmp;
+    if (radius <= 0)
+        return false;
 
-    float3 viewPoints[4];
-    viewPoints[0] = normalize(ScreenToView(float2(xyTL.x, xyTL.y), 1)); // TL
-    viewPoints[1] = normalize(ScreenToView(float2(xyTL.x, xyBR.y), 1)); // BL
-    viewPoints[2] = normalize(ScreenToView(float2(xyBR.x, xyBR.y), 1)); // BR
-    viewPoints[3] = normalize(ScreenToView(float2(xyBR.x, xyTL.y), 1)); // TR
+    // Spheres touching the camera plane are skipped
+    if (-viewParticle.z < radius)
+        return false;
 
-    float3 viewNormals[4];
-    viewNormals[0] = normalize(cross(viewPoints[3], viewPoints[2])); // right
-    viewNormals[1] = normalize(cross(viewPoints[1], viewPoints[0])); // left
-    viewNormals[2] = normalize(cross(viewPoints[0], viewPoints[3])); // top
-    viewNormals[3] = normalize(cross(viewPoints[2], viewPoints[1])); // bottom
+    float2 boundsX = GetProjectedBounds(viewParticle, radius, true);
+    float2 boundsY = GetProjectedBounds(viewParticle, radius, false);
+
+    if (boundsX.y < -1 || boundsX.x > 1 || boundsY.y < -1 || boundsY.x > 1)
+        return false;
+
+    // NDC y points up, tile rows go down the screen
+    rect.x = int(floor((boundsX.x * .5 + .5) * Info.TilesX));
+    rect.z = int(floor((boundsX.y * .5 + .5) * Info.TilesX));
+    rect.y = int(floor((.5 - boundsY.y * .5) * Info.TilesY));
+    rect.w = int(floor((.5 - boundsY.x * .5) * Info.TilesY));
+
+    rect.xy = max(rect.xy, 0);
+    rect.zw = min(rect.zw, int2(Info.TilesX, Info.TilesY) - 1);
+
+    return all(rect.xy <= rect.zw);
+}
+
+// Pass 1: reset every tile
+[numthreads(TILING_THREAD_X, TILING_THREAD_Y, 1)]
+void TilingClearCS(uint3 DTid : SV_DispatchThreadID)
+{
+    uint2 tile = DTid.xy;
+    if (tile.x >= Info.TilesX || tile.y >= Info.TilesY)
+        return;
+
+    uint tileIndex = GetTileIndex(tile);
+
+    TileInfo info;
+    info.particleCount = 0;
+    info.closest       = asuint(1e20);
+    info.farthest      = 0;
+    TileBuffer[tileIndex] = info;
+
+    SliceInfo slice;
+    slice.particleCount  = 0;
+    slice.particleOffset = 0;
+    slice.fillCount      = 0;
+    for (uint i = 0; i < DEPTH_SLICES; i++)
+        SliceBuffer[GetSliceIndex(tileIndex, i)] = slice;
+}
+
+// Pass 2: every particle bumps the counts and depth range of the tiles and slices it overlaps
+[numthreads(TILING_PARTICLE_THREADS, 1, 1)]
+void TilingCountCS(uint3 DTid : SV_DispatchThreadID)
+{
+    if (DTid.x >= Info.ParticleCount)
+        return;
+
+    int4   rect;
+    float3 viewParticle;
+    float  radius;
+    if (!GetParticleTileRect(ParticleBuffer.Load(DTid.x), rect, viewParticle, radius))
+        return;
 
-    float closest = 1e20;
-    float farthest = -1e20;
+    // Both distances are non-negative, so their bit patterns order like the floats
+    float dist       = length(viewParticle);
+    uint  closest    = asuint(dist - radius);
+    uint  farthest   = asuint(dist + radius);
+    uint  firstSlice = GetDepthSlice(dist - radius);
+    uint  lastSlice  = GetDepthSlice(dist + radius);
 
-    uint outIndex = 1;
-    for (int i = 0; i < Info.ParticleCount && outIndex < TILE_MAX_PARTICLES; i++)
+    for (int y = rect.y; y <= rect.w; y++)
     {
-        float4 particle = InputParticleBuffer.Load(i);
+        for (int x = rect.x; x <= rect.z; x++)
+        {
+            uint tileIndex = GetTileIndex(uint2(x, y));
+            InterlockedAdd(TileBuffer[tileIndex].particleCount, 1);
+            InterlockedMin(TileBuffer[tileIndex].closest, closest);
+            InterlockedMax(TileBuffer[tileIndex].farthest, farthest);
+
+            for (uint slice = firstSlice; slice <= lastSlice; slice++)
+                InterlockedAdd(SliceBuffer[GetSliceIndex(tileIndex, slice)].particleCount, 1);
+        }
+    }
+}
 
-        // Roughly account for smoothing
-        float overestimate = Info.BiggestRadius * pow(Info.SDFBlend, 0.75) * 4;
-        float radius = particle.w + overestimate;
+groupshared uint PrefixSums[PREFIX_SUM_THREADS];
 
-        if (radius <= 0)
-            continue;
+// Inclusive prefix sum of one value per thread over the whole group
+uint GroupInclusiveScan(uint GI, uint value)
+{
+    PrefixSums[GI] = value;
+    GroupMemoryBarrierWithGroupSync();
 
-        float3 viewParticle = WorldToView(particle.xyz);
+    for (uint stride = 1; stride < PREFIX_SUM_THREADS; stride *= 2)
+    {
+        uint add = GI >= stride ? PrefixSums[GI - stride] : 0;
+        GroupMemoryBarrierWithGroupSync();
+        PrefixSums[GI] += add;
+        GroupMemoryBarrierWithGroupSync();
+    }
+    return PrefixSums[GI];
+}
 
-        if (-viewParticle.z < radius)
-            continue;
+uint GetSliceCount()
+{
+    return Info.TilesX * Info.TilesY * DEPTH_SLICES;
+}
+
+// Pass 3a: exclusive prefix sum of the slice counts within every group, the group totals go to the scan buffer
+[numthreads(PREFIX_SUM_THREADS, 1, 1)]
+void TilingScanSlicesCS(uint3 DTid : SV_DispatchThreadID, uint3 Gid : SV_GroupID, uint GI : SV_GroupIndex)
+{
+    uint sliceCount = GetSliceCount();
+    uint count      = DTid.x < sliceCount ? SliceBuffer[DTid.x].particleCount : 0;
+    uint sum        = GroupInclusiveScan(GI, count);
+
+    if (DTid.x < sliceCount)
+        SliceBuffer[DTid.x].particleOffset = sum - count;
+    if (GI == PREFIX_SUM_THREADS - 1)
+        ScanBuffer[Gid.x] = sum;
+}
 
-        if (dot(viewNormals[0], viewParticle) > radius ||
-            dot(viewNormals[1], viewParticle) > radius ||
-            dot(viewNormals[2], viewParticle) > radius ||
-            dot(viewNormals[3], viewParticle) > radius)
-            continue;
+// Pass 3b: exclusive prefix sum of the group totals in a single group, the grand total is the unclamped index count
+[numthreads(PREFIX_SUM_THREADS, 1, 1)]
+void TilingScanGroupsCS(uint GI : SV_GroupIndex)
+{
+    uint groupCount = (GetSliceCount() + PREFIX_SUM_THREADS - 1) / PREFIX_SUM_THREADS;
+    uint total      = GI < groupCount ? ScanBuffer[GI] : 0;
+    uint sum        = GroupInclusiveScan(GI, total);
 
-        float dist = length(viewParticle);
-        if (dist - radius < closest)  closest  = dist - radius;
-        if (dist + radius > farthest) farthest = dist + radius;
+    if (GI < groupCount)
+        ScanBuffer[GI] = sum - total;
 
-        ParticleBuffer[tileOffset + outIndex] = particle;
-        outIndex++;
+    if (GI == PREFIX_SUM_THREADS - 1)
+    {
+        TilingStats stats;
+        stats.requiredIndices = sum;
+        stats.indexCapacity   = Info.IndexCapacity;
+        StatsBuffer[0] = stats;
     }
+}
+
+// Pass 3c: add the group offsets, slices that run past the index list are cut short and the stats report the overflow
+[numthreads(PREFIX_SUM_THREADS, 1, 1)]
+void TilingScanApplyCS(uint3 DTid : SV_DispatchThreadID, uint3 Gid : SV_GroupID)
+{
+    if (DTid.x >= GetSliceCount())
+        return;
 
-    // Store tile info in the first particle
-    ParticleBuffer[tileOffset] = float4(outIndex - 1, closest, farthest, 0);
+    uint offset = SliceBuffer[DTid.x].particleOffset + ScanBuffer[Gid.x];
+    uint count  = min(SliceBuffer[DTid.x].particleCount, Info.IndexCapacity - min(offset, Info.IndexCapacity));
+
+    SliceBuffer[DTid.x].particleCount  = count;
+    SliceBuffer[DTid.x].particleOffset = offset;
 }
 
-[numthreads(TILING_THREAD_X, TILING_THREAD_Y, 1)]
-void TilingCS(uint3 DTid : SV_DispatchThreadID)
+// Pass 4: every particle appends itself to the lists of the tile slices it overlaps
+[numthreads(TILING_PARTICLE_THREADS, 1, 1)]
+void TilingFillCS(uint3 DTid : SV_DispatchThreadID)
 {
-    uint2 tile = DTid.xy;
-    if (tile.x >= Info.TilesX || tile.y >= Info.TilesY)
+    if (DTid.x >= Info.ParticleCount)
+        return;
+
+    int4   rect;
+    float3 viewParticle;
+    float  radius;
+    if (!GetParticleTileRect(ParticleBuffer.Load(DTid.x), rect, viewParticle, radius))
         return;
 
-    CreateList(tile);
+    float dist       = length(viewParticle);
+    uint  firstSlice = GetDepthSlice(dist - radius);
+    uint  lastSlice  = GetDepthSlice(dist + radius);
+
+    for (int y = rect.y; y <= rect.w; y++)
+    {
+        for (int x = rect.x; x <= rect.z; x++)
+        {
+            uint tileIndex = GetTileIndex(uint2(x, y));
+
+            for (uint slice = firstSlice; slice <= lastSlice; slice++)
+            {
+                uint sliceIndex = GetSliceIndex(tileIndex, slice);
+
+                uint slot;
+                InterlockedAdd(SliceBuffer[sliceIndex].fillCount, 1, slot);
+                if (slot < SliceBuffer[sliceIndex].particleCount)
+                    TileIndexBuffer[SliceBuffer[sliceIndex].particleOffset + slot] = DTid.x;
+            }
+        }
+    }
 }
@@ -0,0 +1,100 @@
+#include <cstdio>
+#include <set>
+
+#include "fluidrandom.h"
+#include "fluidtiling.h"
+#include "fluid_bench.h"
+
+namespace
+{
+// Set of particles binned into one tile slice
+std::set<uint32_t> GetSliceParticles(const FluidTileBins& bins, size_t slice)
+{
+    const SliceInfo& info  = bins.slices[slice];
+    auto             first = bins.indices.begin() + info.particleOffset;
+    return std::set<uint32_t>(first, first + info.particleCount);
+}
+}
+
+// Times the scatter binning against the per tile frustum tests it replaced, checks that both bin the same
+// particles and that the entry count matches CountTileOverlaps
+int BenchBinning(int argc, char** argv)
+{
+    int32_t particles  = 16384;
+    int32_t tilesX     = 96;
+    int32_t tilesY     = 54;
+    int32_t iterations = 3;
+
+    for (int arg = 0; arg < argc; arg++)
+    {
+        const char* value = nullptr;
+        if (ParseOption(argv[arg], "-particles=", &value))
+            particles = atoi(value);
+        else if (ParseOption(argv[arg], "-tilesx=", &value))
+            tilesX = atoi(value);
+        else if (ParseOption(argv[arg], "-tilesy=", &value))
+            tilesY = atoi(value);
+        else if (ParseOption(argv[arg], "-iterations=", &value))
+            iterations = atoi(value);
+        else
+        {
+            fprintf(stderr, "Unknown option \"%s\"!\n", argv[arg]);
+            return 1;
+        }
+    }
+
+    if (particles <= 0 || iterations <= 0 || tilesX <= 0 || tilesX > TILES_MAX_X || tilesY <= 0 || tilesY > TILES_MAX_Y)
+    {
+        fprintf(stderr, "Invalid particle count, tile count or iteration count!\n");
+        return 1;
+    }
+
+    // A box of particles in front of the camera, partly off screen
+    FluidRandom              random;
+    std::vector<GPUParticle> gpuParticles(particles);
+    for (GPUParticle& particle : gpuParticles)
+        particle.posSize = Vec4(random.NextFloat(-3, 3), random.NextFloat(-1, 3), random.NextFloat(-3, 3), random.NextFloat(.02f, .08f));
+
+    FluidTilingParams params = {Mat4::lookAt(Point3(0, 1, 6), Point3(0, 1, 0), Vec3(0, 1, 0)), Mat4::perspective(1.f, 16.f / 9, .1f, 100.f),
+                                tilesX, tilesY, GetTilingOverestimate(.08f, .25f)};
+    FitDepthSlices(params, gpuParticles, true);
+
+    const uint32_t indexCapacity = CountTileOverlaps(params, gpuParticles);
+
+    FluidTileBins       scatter;
+    std::vector<double> scatterMs;
+    for (int32_t iteration = 0; iteration < iterations; iteration++)
+    {
+        FluidBenchTimer timer;
+        BinParticles(params, gpuParticles, indexCapacity, scatter);
+        scatterMs.push_back(timer.GetMs());
+    }
+
+    FluidTileBins       bruteForce;
+    std::vector<double> bruteForceMs;
+    for (int32_t iteration = 0; iteration < iterations; iteration++)
+    {
+        FluidBenchTimer timer;
+        BinParticlesBruteForce(params, gpuParticles, indexCapacity, bruteForce);
+        bruteForceMs.push_back(timer.GetMs());
+    }
+
+    // The projected rectangles are at least as tight as the tile frustums, so scatter never bins a particle brute force misses
+    size_t missing = 0;
+    size_t extra   = 0;
+    for (size_t slice = 0; slice < scatter.slices.size(); slice++)
+    {
+        std::set<uint32_t> scatterSet    = GetSliceParticles(scatter, slice);
+        std::set<uint32_t> bruteForceSet = GetSliceParticles(bruteForce, slice);
+        for (uint32_t index : bruteForceSet)
+            missing += scatterSet.count(index) ? 0 : 1;
+        for (uint32_t index : scatterSet)
+            extra += bruteForceSet.count(index) ? 0 : 1;
+    }
+
+    printf("Particles:   %d on %dx%d tiles, %u tile entries\n", particles, tilesX, tilesY, indexCapacity);
+    printf("Scatter:     %.3f ms mean, %.3f ms p50, %zu entries\n", Average(scatterMs), Percentile(scatterMs, .5), scatter.indices.size());
+    printf("Brute force: %.3f ms mean, %.3f ms p50, %zu entries\n", Average(bruteForceMs), Percentile(bruteForceMs, .5), bruteForce.indices.size());
+    printf("Difference:  %zu missing from scatter, %zu extra\n", missing, extra);
+    return scatter.indices.size() == indexCapacity && extra == 0 ? 0 : 1;
+}
@@ -0,0 +1,119 @@
+#include <cmath>
+#include <cstdio>
+
+#include "fluidbricks.h"
+#include "fluidrandom.h"
+#include "fluidworkerpool.h"
+#include "fluid_bench.h"
+
+namespace
+{
+// Same smooth union as sdf.hlsl
+float smin(float a, float b, float k)
+{
+    if (k <= 0)
+        return std::min(a, b);
+
+    k *= 4.0f;
+    float h = std::max(k - std::abs(a - b), 0.0f) / k;
+    return std::min(a, b) - h * h * k * (1.0f / 4.0f);
+}
+
+float EvaluateParticles(const std::vector<GPUParticle>& particles, const Vec3& position, float sdfBlend)
+{
+    float ret = 1e20f;
+    for (const GPUParticle& particle : particles)
+        ret = smin(length(position - particle.posSize.getXYZ()) - particle.posSize.getW(), ret, particle.posSize.getW() * sdfBlend);
+    return ret;
+}
+}
+
+// Times building the narrow band brick volume and sampling it against evaluating every particle,
+// checks the sampled distances inside the band against the exact ones
+int BenchBricks(int argc, char** argv)
+{
+    int32_t particles  = 5000;
+    int32_t samples    = 20000;
+    int32_t iterations = 3;
+    float   voxelSize  = .02f;
+
+    for (int arg = 0; arg < argc; arg++)
+    {
+        const char* value = nullptr;
+        if (ParseOption(argv[arg], "-particles=", &value))
+            particles = atoi(value);
+        else if (ParseOption(argv[arg], "-samples=", &value))
+            samples = atoi(value);
+        else if (ParseOption(argv[arg], "-iterations=", &value))
+            iterations = atoi(value);
+        else if (ParseOption(argv[arg], "-voxel=", &value))
+            voxelSize = static_cast<float>(atof(value));
+        else
+        {
+            fprintf(stderr, "Unknown option \"%s\"!\n", argv[arg]);
+            return 1;
+        }
+    }
+
+    if (particles <= 0 || samples <= 0 || iterations <= 0 || voxelSize <= 0)
+    {
+        fprintf(stderr, "Invalid particle count, sample count, iteration count or voxel size!\n");
+        return 1;
+    }
+
+    FluidRandom              random;
+    std::vector<GPUParticle> gpuParticles(particles);
+    for (GPUParticle& particle : gpuParticles)
+        particle.posSize = Vec4(random.NextFloat(-1.5f, 1.5f), random.NextFloat(0, .6f), random.NextFloat(-1, 1), random.NextFloat(.05f, .08f));
+
+    FluidBrickParams params = {voxelSize, .25f, voxelSize * 4};
+    FluidWorkerPool  workers;
+    FluidBrickVolume volume;
+
+    std::vector<double> buildMs;
+    for (int32_t iteration = 0; iteration < iterations; iteration++)
+    {
+        FluidBenchTimer timer;
+        volume.Build(params, gpuParticles, workers);
+        buildMs.push_back(timer.GetMs());
+    }
+
+    std::vector<Vec3> positions(samples);
+    for (Vec3& position : positions)
+        position = Vec3(random.NextFloat(-1.6f, 1.6f), random.NextFloat(-.1f, .8f), random.NextFloat(-1.1f, 1.1f));
+
+    std::vector<float> sampled(samples);
+    FluidBenchTimer    sampleTimer;
+    for (int32_t i = 0; i < samples; i++)
+        sampled[i] = volume.Sample(positions[i]);
+    double sampleNs = sampleTimer.GetMs() * 1e6 / samples;
+
+    std::vector<float> exact(samples);
+    FluidBenchTimer    exactTimer;
+    for (int32_t i = 0; i < samples; i++)
+        exact[i] = EvaluateParticles(gpuParticles, positions[i], params.sdfBlend);
+    double exactNs = exactTimer.GetMs() * 1e6 / samples;
+
+    // Trilinear filtering of a distance field is off by less than a voxel, outside the band only the sign matters
+    int32_t inBand    = 0;
+    int32_t wrongSign = 0;
+    float   maxError  = 0;
+    for (int32_t i = 0; i < samples; i++)
+    {
+        if (std::abs(exact[i]) < params.bandWidth - voxelSize)
+        {
+            maxError = std::max(maxError, std::abs(exact[i] - sampled[i]));
+            inBand++;
+        }
+        else if (exact[i] > params.bandWidth && sampled[i] < 0)
+            wrongSign++;
+    }
+
+    const int32_t* pageTableSize = volume.GetPageTableSize();
+    printf("Volume:      %u bricks, %dx%dx%d pages, %ux%ux%u atlas\n", volume.GetBrickCount(), pageTableSize[0], pageTableSize[1], pageTableSize[2],
+           volume.GetAtlasWidth(), volume.GetAtlasHeight(), volume.GetAtlasDepth());
+    printf("Build:       %.3f ms mean, %.3f ms p50 on %u threads\n", Average(buildMs), Percentile(buildMs, .5), workers.GetThreadCount());
+    printf("Sample:      %.1f ns, every particle %.1f ns\n", sampleNs, exactNs);
+    printf("Error:       %.5f max over %d samples in the band, %d outside with the wrong sign\n", maxError, inBand, wrongSign);
+    return maxError < voxelSize && wrongSign == 0 ? 0 : 1;
+}
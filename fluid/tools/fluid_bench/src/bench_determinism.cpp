@@ -0,0 +1,133 @@
+#include <array>
+#include <cstdio>
+
+#include "fluidsimulation.h"
+#include "fluid_bench.h"
+
+namespace
+{
+// FNV-1a over every stream and the ids of the store
+uint32_t HashParticles(const FluidParticleStore& particles)
+{
+    uint32_t hash = 2166136261u;
+    auto     add  = [&hash](const void* data, size_t size)
+    {
+        const unsigned char* bytes = static_cast<const unsigned char*>(data);
+        for (size_t i = 0; i < size; i++)
+            hash = (hash ^ bytes[i]) * 16777619u;
+    };
+
+    for (uint32_t stream = 0; stream < FluidParticleStore::StreamCount; stream++)
+        add(particles.Data(static_cast<FluidParticleStore::StreamType>(stream)), particles.Size() * sizeof(float));
+    add(particles.Ids(), particles.Size() * sizeof(uint32_t));
+    return hash;
+}
+
+// Packs the state after a step blended fully back to the state before it, every surviving particle has to come out
+// where it was before the step and every spawned one where it spawned
+bool CheckInterpolation(FluidSimulationSettings settings, int32_t ticks)
+{
+    FluidParticleSystem system;
+    system.m_maxParticles = settings.maxParticles;
+    system.m_spawnRate    = settings.spawnRate;
+    for (int32_t tick = 0; tick < ticks; tick++)
+        system.Update(FluidSimulation::TickTime);
+
+    FluidParticleStore previous = system.GetParticles();
+    system.Update(FluidSimulation::TickTime);
+    const FluidParticleStore& particles = system.GetParticles();
+
+    std::vector<std::array<float, 3>> expected;
+    for (uint32_t i = 0; i < particles.Size(); i++)
+    {
+        if (particles.R()[i] <= 0)
+            continue;
+
+        std::array<float, 3> position = {particles.X()[i], particles.Y()[i], particles.Z()[i]};
+        for (uint32_t j = 0; j < previous.Size(); j++)
+        {
+            if (previous.Ids()[j] == particles.Ids()[i])
+                position = {previous.X()[j], previous.Y()[j], previous.Z()[j]};
+        }
+        expected.push_back(position);
+    }
+
+    system.CreateGPUParticles(particles, Point3(0, 1, 5), &previous, 0);
+
+    std::vector<std::array<float, 3>> packed;
+    for (const GPUParticle& particle : system.GetGPUParticles())
+        packed.push_back({particle.posSize.getX(), particle.posSize.getY(), particle.posSize.getZ()});
+
+    std::sort(expected.begin(), expected.end());
+    std::sort(packed.begin(), packed.end());
+    return expected == packed;
+}
+}
+
+// Runs the same number of simulation ticks in differently sized batches, like render frames at different frame rates
+// pick them up, and checks that every batching ends in the same state. Also checks the interpolation between snapshots.
+int BenchDeterminism(int argc, char** argv)
+{
+    int32_t particles = 2000;
+    int32_t ticks     = 600;
+
+    for (int arg = 0; arg < argc; arg++)
+    {
+        const char* value = nullptr;
+        if (ParseOption(argv[arg], "-particles=", &value))
+            particles = atoi(value);
+        else if (ParseOption(argv[arg], "-ticks=", &value))
+            ticks = atoi(value);
+        else
+        {
+            fprintf(stderr, "Unknown option \"%s\"!\n", argv[arg]);
+            return 1;
+        }
+    }
+
+    if (particles <= 0 || ticks <= 0)
+    {
+        fprintf(stderr, "Invalid particle count or tick count!\n");
+        return 1;
+    }
+
+    FluidSimulationSettings settings;
+    settings.maxParticles = particles;
+    settings.spawnRate    = particles / 5.f;
+
+    // Ticks per batch, repeated until all ticks ran: 120, 60 and 24 fps and an uneven frame rate
+    const int32_t patterns[][3] = {{1, 1, 1}, {2, 2, 2}, {5, 5, 5}, {1, 7, 3}};
+
+    int      result    = 0;
+    uint32_t reference = 0;
+    for (const auto& pattern : patterns)
+    {
+        FluidSimulation simulation;
+        simulation.SetSettings(settings);
+
+        FluidBenchTimer timer;
+        int32_t         done  = 0;
+        for (int32_t batch = 0; done < ticks; batch++)
+        {
+            int32_t count = std::min(pattern[batch % 3], ticks - done);
+            simulation.RunTicks(count);
+            simulation.CreateGPUParticles(Point3(0, 1, 5));
+            done += count;
+        }
+        double runMs = timer.GetMs();
+
+        const FluidSnapshot& snapshot = simulation.GetSnapshot();
+        uint32_t             hash     = HashParticles(snapshot.particles);
+        if (&pattern == &patterns[0])
+            reference = hash;
+        else if (hash != reference)
+            result = 1;
+
+        printf("Batches %d,%d,%d: tick %llu, %u particles, hash %08x, %.0f ms%s\n", pattern[0], pattern[1], pattern[2],
+               static_cast<unsigned long long>(snapshot.tick), snapshot.particles.Size(), hash, runMs, hash != reference ? " MISMATCH" : "");
+    }
+
+    bool interpolated = CheckInterpolation(settings, ticks);
+    printf("Interpolation: %s\n", interpolated ? "previous positions restored" : "MISMATCH");
+    return result == 0 && interpolated ? 0 : 1;
+}
@@ -0,0 +1,83 @@
+#include <cstdio>
+
+#include "fluidmarch.h"
+#include "fluidrandom.h"
+#include "fluid_bench.h"
+
+// Replays the SDF ray march on the CPU and reports how many particle SDFs it evaluates with and without depth slices,
+// optionally checking the hit normals against the union of all particles
+int BenchMarch(int argc, char** argv)
+{
+    int32_t particles    = 3000;
+    int32_t width        = 320;
+    int32_t height       = 180;
+    bool    checkNormals = false;
+
+    for (int arg = 0; arg < argc; arg++)
+    {
+        const char* value = nullptr;
+        if (ParseOption(argv[arg], "-particles=", &value))
+            particles = atoi(value);
+        else if (ParseOption(argv[arg], "-width=", &value))
+            width = atoi(value);
+        else if (ParseOption(argv[arg], "-height=", &value))
+            height = atoi(value);
+        else if (ParseOption(argv[arg], "-normals=", &value))
+            checkNormals = atoi(value) != 0;
+        else
+        {
+            fprintf(stderr, "Unknown option \"%s\"!\n", argv[arg]);
+            return 1;
+        }
+    }
+
+    if (particles <= 0 || width <= 0 || height <= 0)
+    {
+        fprintf(stderr, "Invalid particle count or resolution!\n");
+        return 1;
+    }
+
+    // A shallow pool seen from above at an angle, so rays cross many depth slices
+    FluidRandom              random;
+    std::vector<GPUParticle> gpuParticles(particles);
+    for (GPUParticle& particle : gpuParticles)
+        particle.posSize = Vec4(random.NextFloat(-1, 1), random.NextFloat(0, .6f), random.NextFloat(-1, 1), .05f);
+
+    // Normals within this angle of the reference are counted as matching, the tile lists only hold nearby particles
+    const float MaxNormalError = 5;
+
+    int result = 0;
+    for (bool sliced : {false, true})
+    {
+        FluidMarchParams params = {};
+        params.tiling       = {Mat4::lookAt(Point3(0, 1.5f, 3), Point3(0, .3f, 0), Vec3(0, 1, 0)), Mat4::perspective(1.f, 16.f / 9, .1f, 100.f),
+                               60, 34, GetTilingOverestimate(.05f, .3f)};
+        params.sdfBlend     = .3f;
+        params.width        = width;
+        params.height       = height;
+        params.checkNormals = checkNormals;
+        FitDepthSlices(params.tiling, gpuParticles, sliced);
+
+        FluidTileBins bins;
+        BinParticles(params.tiling, gpuParticles, CountTileOverlaps(params.tiling, gpuParticles), bins);
+
+        FluidMarchStats stats;
+        FluidBenchTimer timer;
+        MarchPixels(params, gpuParticles, bins, stats);
+        double marchMs = timer.GetMs();
+
+        printf("%s %zu tile entries, %llu of %llu pixels hit, %.1f SDFs per pixel, %u max, %.0f ms\n", sliced ? "Sliced:   " : "Unsliced: ",
+               bins.indices.size(), static_cast<unsigned long long>(stats.hitPixels), static_cast<unsigned long long>(stats.marchedPixels),
+               stats.marchedPixels ? static_cast<double>(stats.sdfEvaluations) / stats.marchedPixels : 0., stats.maxEvaluations, marchMs);
+
+        if (checkNormals)
+        {
+            printf("           normals %.3f degrees mean, %.3f max error\n",
+                   stats.checkedNormals ? stats.normalErrorSum / stats.checkedNormals : 0., stats.maxNormalError);
+            if (stats.maxNormalError > MaxNormalError)
+                result = 1;
+        }
+    }
+
+    return result;
+}
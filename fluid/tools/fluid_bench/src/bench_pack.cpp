@@ -0,0 +1,97 @@
+#include <cstdio>
+
+#include "fluidparticlesystem.h"
+#include "fluid_bench.h"
+
+namespace
+{
+// The packing CreateGPUParticles replaced: a fresh vector sorted by a comparator computing both distances
+void PackWithSort(const FluidParticleStore& particles, const Point3& cameraPos, std::vector<GPUParticle>& gpuParticles)
+{
+    gpuParticles.clear();
+    for (uint32_t i = 0; i < particles.Size(); i++)
+    {
+        if (particles.R()[i] > 0)
+            gpuParticles.push_back({Vec4(particles.X()[i], particles.Y()[i], particles.Z()[i], particles.R()[i])});
+    }
+
+    std::sort(gpuParticles.begin(), gpuParticles.end(), [&cameraPos](const GPUParticle& a, const GPUParticle& b)
+    {
+        return distSqr(cameraPos, Point3(a.posSize.getXYZ())) < distSqr(cameraPos, Point3(b.posSize.getXYZ()));
+    });
+}
+}
+
+// Times packing a filled particle system for the GPU against the std::sort it replaced and checks the order
+int BenchPack(int argc, char** argv)
+{
+    int32_t particles  = 16384;
+    int32_t iterations = 200;
+
+    for (int arg = 0; arg < argc; arg++)
+    {
+        const char* value = nullptr;
+        if (ParseOption(argv[arg], "-particles=", &value))
+            particles = atoi(value);
+        else if (ParseOption(argv[arg], "-iterations=", &value))
+            iterations = atoi(value);
+        else
+        {
+            fprintf(stderr, "Unknown option \"%s\"!\n", argv[arg]);
+            return 1;
+        }
+    }
+
+    if (particles <= 0 || iterations <= 0)
+    {
+        fprintf(stderr, "Invalid particle count or iteration count!\n");
+        return 1;
+    }
+
+    FluidParticleSystem system;
+    system.m_maxParticles = particles;
+    system.m_spawnRate    = particles / 2.f;
+    for (int32_t frame = 0; frame < 1000 && system.GetParticleCount() < static_cast<size_t>(particles) * 9 / 10; frame++)
+        system.Update(1 / 60.f);
+
+    const Point3              cameraPos(0, 1, -5);
+    const FluidParticleStore& store = system.GetParticles();
+
+    std::vector<double> radixMs;
+    for (int32_t iteration = 0; iteration < iterations; iteration++)
+    {
+        FluidBenchTimer timer;
+        system.CreateGPUParticles(store, cameraPos);
+        radixMs.push_back(timer.GetMs());
+    }
+
+    std::vector<GPUParticle> sorted;
+    std::vector<double>      sortMs;
+    for (int32_t iteration = 0; iteration < iterations; iteration++)
+    {
+        FluidBenchTimer timer;
+        PackWithSort(store, cameraPos, sorted);
+        sortMs.push_back(timer.GetMs());
+    }
+
+    // Keys are quantized to 16 bits of the distance range, only larger steps backwards are out of order
+    const std::vector<GPUParticle>& packed = system.GetGPUParticles();
+    float minDist = packed.empty() ? 0 : distSqr(cameraPos, Point3(sorted.front().posSize.getXYZ()));
+    float maxDist = packed.empty() ? 0 : distSqr(cameraPos, Point3(sorted.back().posSize.getXYZ()));
+    float keyStep = (maxDist - minDist) / 65535;
+
+    uint32_t outOfOrder = 0;
+    float    farthest   = 0;
+    for (const GPUParticle& particle : packed)
+    {
+        float dist = distSqr(cameraPos, Point3(particle.posSize.getXYZ()));
+        if (dist + keyStep < farthest)
+            outOfOrder++;
+        farthest = std::max(farthest, dist);
+    }
+
+    printf("Particles:   %zu packed of %u, %u out of order\n", packed.size(), store.Size(), outOfOrder);
+    printf("Radix sort:  %.3f ms mean, %.3f ms p50\n", Average(radixMs), Percentile(radixMs, .5));
+    printf("std::sort:   %.3f ms mean, %.3f ms p50\n", Average(sortMs), Percentile(sortMs, .5));
+    return packed.size() == sorted.size() && outOfOrder == 0 ? 0 : 1;
+}
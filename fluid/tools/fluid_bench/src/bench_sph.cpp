@@ -0,0 +1,74 @@
+#include <cstdio>
+
+#include "fluidparticlesystem.h"
+#include "fluid_bench.h"
+
+// Fills the particle system up to the particle limit, then times Update with a fixed frame time.
+// Frames longer than the maximum step are split into sub-steps by Update, like they are in the sample.
+int BenchSPH(int argc, char** argv)
+{
+    int32_t particles = 8192;
+    int32_t frames    = 300;
+    float   dt        = 1 / 60.f;
+    float   stiffness = 20;
+    float   viscosity = .5f;
+
+    for (int arg = 0; arg < argc; arg++)
+    {
+        const char* value = nullptr;
+        if (ParseOption(argv[arg], "-particles=", &value))
+            particles = atoi(value);
+        else if (ParseOption(argv[arg], "-frames=", &value))
+            frames = atoi(value);
+        else if (ParseOption(argv[arg], "-dt=", &value))
+            dt = static_cast<float>(atof(value));
+        else if (ParseOption(argv[arg], "-stiffness=", &value))
+            stiffness = static_cast<float>(atof(value));
+        else if (ParseOption(argv[arg], "-viscosity=", &value))
+            viscosity = static_cast<float>(atof(value));
+        else
+        {
+            fprintf(stderr, "Unknown option \"%s\"!\n", argv[arg]);
+            return 1;
+        }
+    }
+
+    if (particles <= 0 || frames <= 0 || dt <= 0)
+    {
+        fprintf(stderr, "Invalid particle count, frame count or frame time!\n");
+        return 1;
+    }
+
+    FluidParticleSystem system;
+    system.m_maxParticles = particles;
+    system.m_stiffness    = stiffness;
+    system.m_viscosity    = viscosity;
+
+    // Spawn the whole limit within about two seconds, particles die and respawn from then on
+    system.m_spawnRate = particles / 2.f;
+    int32_t warmupFrames = 0;
+    while (system.GetParticleCount() < static_cast<size_t>(particles) * 9 / 10 && warmupFrames < 10000)
+    {
+        system.Update(dt);
+        warmupFrames++;
+    }
+
+    std::vector<double> updateMs;
+    std::vector<double> particleCounts;
+    for (int32_t frame = 0; frame < frames; frame++)
+    {
+        FluidBenchTimer timer;
+        system.Update(dt);
+        updateMs.push_back(timer.GetMs());
+        particleCounts.push_back(static_cast<double>(system.GetParticleCount()));
+    }
+
+    double averageParticles = Average(particleCounts);
+    double averageMs        = Average(updateMs);
+    printf("Warmup:      %d frames of %.2f ms\n", warmupFrames, dt * 1000);
+    printf("Particles:   %.0f average, %d limit\n", averageParticles, particles);
+    printf("Update:      %.3f ms mean, %.3f ms p50, %.3f ms p95, %.3f ms max\n",
+           averageMs, Percentile(updateMs, .5), Percentile(updateMs, .95), Percentile(updateMs, 1));
+    printf("Throughput:  %.1f us per 1000 particles per frame\n", averageParticles > 0 ? averageMs * 1000 / (averageParticles / 1000) : 0.);
+    return 0;
+}
@@ -0,0 +1,25 @@
+#pragma once
+
+// libstdc++ doesn't declare the C float math functions in std, the vector math library expects them there like MSVC
+#include <cmath>
+
+#if !defined(_MSC_VER)
+namespace std
+{
+    using ::acosf;
+    using ::asinf;
+    using ::atan2f;
+    using ::atanf;
+    using ::ceilf;
+    using ::cosf;
+    using ::expf;
+    using ::fabsf;
+    using ::floorf;
+    using ::fmodf;
+    using ::logf;
+    using ::powf;
+    using ::sinf;
+    using ::sqrtf;
+    using ::tanf;
+}
+#endif
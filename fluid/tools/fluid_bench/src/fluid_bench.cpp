@@ -0,0 +1,54 @@
+// Headless benchmarks of the CPU side of the fluid sample, runs without a device so the numbers quoted in the
+// changes to the simulation and the tiling can be reproduced on any machine.
+//
+// Usage: FluidBench <benchmark> [options]
+//
+// Benchmarks:
+//   sph        time FluidParticleSystem::Update on a filled particle system
+//   pack       time packing the particles front to back for the GPU against a std::sort
+//   binning    time the scatter tile binning against the per tile frustum tests and compare their lists
+//   march      count the particle SDFs the ray march evaluates with and without depth slices, check its normals
+//   bricks     time building and sampling the narrow band brick volume and check it against the particles
+//   determinism  check that batching the simulation ticks differently gives the same state, and the snapshot interpolation
+
+#include <cstdio>
+#include <cstring>
+
+#include "fluid_bench.h"
+
+namespace
+{
+struct FluidBenchmark
+{
+    const char*    name;
+    const char*    options;
+    FluidBenchFunc func;
+};
+
+const FluidBenchmark Benchmarks[] =
+{
+    {"sph",  "-particles=<n> -frames=<n> -dt=<s> -stiffness=<f> -viscosity=<f>", BenchSPH},
+    {"pack", "-particles=<n> -iterations=<n>", BenchPack},
+    {"binning", "-particles=<n> -tilesx=<n> -tilesy=<n> -iterations=<n>", BenchBinning},
+    {"march", "-particles=<n> -width=<n> -height=<n> -normals=<0|1>", BenchMarch},
+    {"bricks", "-particles=<n> -samples=<n> -iterations=<n> -voxel=<size>", BenchBricks},
+    {"determinism", "-particles=<n> -ticks=<n>", BenchDeterminism},
+};
+}
+
+int main(int argc, char** argv)
+{
+    if (argc >= 2)
+    {
+        for (const FluidBenchmark& benchmark : Benchmarks)
+        {
+            if (strcmp(argv[1], benchmark.name) == 0)
+                return benchmark.func(argc - 2, argv + 2);
+        }
+    }
+
+    fprintf(stderr, "Usage: %s <benchmark> [options]\n", argv[0]);
+    for (const FluidBenchmark& benchmark : Benchmarks)
+        fprintf(stderr, "       %s %s %s\n", argv[0], benchmark.name, benchmark.options);
+    return 1;
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+// Every benchmark parses its own options from argv and returns the process exit code
+using FluidBenchFunc = int (*)(int argc, char** argv);
+
+int BenchSPH(int argc, char** argv);
+int BenchPack(int argc, char** argv);
+int BenchBinning(int argc, char** argv);
+int BenchMarch(int argc, char** argv);
+int BenchBricks(int argc, char** argv);
+int BenchDeterminism(int argc, char** argv);
+
+// Matches "-name=" options, value points behind the '='
+inline bool ParseOption(const char* arg, const char* name, const char** value)
+{
+    size_t length = strlen(name);
+    if (strncmp(arg, name, length) != 0)
+        return false;
+
+    *value = arg + length;
+    return true;
+}
+
+inline double Percentile(std::vector<double> values, double percentile)
+{
+    if (values.empty())
+        return 0;
+
+    std::sort(values.begin(), values.end());
+    size_t index = std::min(values.size() - 1, static_cast<size_t>(percentile * (values.size() - 1) + .5));
+    return values[index];
+}
+
+inline double Average(const std::vector<double>& values)
+{
+    double sum = 0;
+    for (double value : values)
+        sum += value;
+    return values.empty() ? 0 : sum / values.size();
+}
+
+class FluidBenchTimer
+{
+public:
+    FluidBenchTimer() : m_start(std::chrono::steady_clock::now()) {}
+
+    double GetMs() const { return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - m_start).count(); }
+
+private:
+    std::chrono::steady_clock::time_point m_start;
+};
@@ -25,6 +25,7 @@
 #include "core/entity.h"
 #include "misc/helpers.h"
 
+#include <functional>
 #include <vector>
 
 namespace cauldron
@@ -47,6 +48,25 @@ namespace cauldron
     struct ComponentData
     {
     };
+
+    /**
+     * @enum ComponentUpdateAccess
+     *
+     * Shared data a <c><i>ComponentMgr</i></c> reads or writes while updating its components. Managers whose
+     * accesses don't conflict are updated in parallel, the others keep their registration order.
+     *
+     * @ingroup CauldronComponent
+     */
+    enum class ComponentUpdateAccess : uint32_t
+    {
+        None                = 0,
+        EntityTransforms    = 0x1 << 0,     ///< <c><i>Entity</i></c> transforms.
+        RayTracingInstances = 0x1 << 1,     ///< Instances queued on the scene's acceleration structure manager.
+        Cameras             = 0x1 << 2,     ///< <c><i>CameraComponent</i></c> matrices.
+
+        All                 = 0xffffffff,   ///< Anything. Default for managers not declaring their accesses, orders them against all other managers.
+    };
+    ENUM_FLAG_OPERATORS(ComponentUpdateAccess)
     
     /**
      * @class Component
@@ -170,6 +190,22 @@ namespace cauldron
          */
         virtual void UpdateComponents(double deltaTime);
 
+        /**
+         * @brief   Shared data read by UpdateComponents. Override when the update doesn't need everything.
+         */
+        virtual ComponentUpdateAccess GetUpdateReads() const { return ComponentUpdateAccess::All; }
+
+        /**
+         * @brief   Shared data written by UpdateComponents. Override when the update doesn't touch everything.
+         */
+        virtual ComponentUpdateAccess GetUpdateWrites() const { return ComponentUpdateAccess::All; }
+
+        /**
+         * @brief   Override to return true when the components can be updated in any order and concurrently,
+         *          in which case the default UpdateComponents spreads them over the task manager's threads.
+         */
+        virtual bool HasIndependentComponentUpdates() const { return false; }
+
         /**
          * @brief   Indicates the ComponentMgr should start managing the passed in <c><i>Component</i></c>.
          */
@@ -197,7 +233,17 @@ namespace cauldron
         NO_MOVE(ComponentMgr);
 
     protected:
+
+        // Below this many components, updates aren't worth spreading over threads
+        static constexpr uint32_t s_MinComponentsPerTask = 32;
+
+        /**
+         * @brief   Calls updateFunc for every index in [begin, end), in parallel when parallel component updates are enabled.
+         */
+        void ForEachComponent(uint32_t begin, uint32_t end, const std::function<void(uint32_t)>& updateFunc);
+
         std::vector<Component*> m_ManagedComponents;
+        uint32_t                m_ComponentListVersion = 0;     // Bumped whenever components are added or removed
     };
 
 } // namespace cauldron
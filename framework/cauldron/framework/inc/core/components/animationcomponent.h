@@ -92,6 +92,16 @@ namespace cauldron
          */
         void UpdateComponents(double deltaTime) override;
 
+        /**
+         * @brief   Animation reads parent transforms while computing global transforms.
+         */
+        ComponentUpdateAccess GetUpdateReads() const override { return ComponentUpdateAccess::EntityTransforms; }
+
+        /**
+         * @brief   Animation writes the transforms of animated entities.
+         */
+        ComponentUpdateAccess GetUpdateWrites() const override { return ComponentUpdateAccess::EntityTransforms; }
+
         /**
          * @brief   Component manager instance accessor.
          */
@@ -106,8 +116,18 @@ namespace cauldron
         }
 
     private:
+        void BuildHierarchyLevels();
+        void UpdateGlobalTransform(AnimationComponent* pComponent);
+        void UpdateSkinning(AnimationComponent* pComponent);
+
         // <ModelID, SkinningData>
         std::unordered_map<uint32_t, SkinningData>     m_skinningData = {};
+
+        // Components sorted by their depth in the animated hierarchy. Animated parents are always in an earlier
+        // level than their children, so all components of a level can compute their global transform concurrently
+        std::vector<AnimationComponent*>    m_HierarchyOrder = {};
+        std::vector<uint32_t>               m_HierarchyLevelStarts = {};
+        uint32_t                            m_HierarchyListVersion = 0xffffffff;
         static AnimationComponentMgr* s_pComponentManager;
 
         friend class GLTFLoader;
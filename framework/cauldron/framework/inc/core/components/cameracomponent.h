@@ -68,6 +68,16 @@ namespace cauldron
          */
         virtual const wchar_t* ComponentType() const override { return s_ComponentName; }
 
+        /**
+         * @brief   Cameras read their owner's transform and the current camera state.
+         */
+        virtual ComponentUpdateAccess GetUpdateReads() const override { return ComponentUpdateAccess::EntityTransforms | ComponentUpdateAccess::Cameras; }
+
+        /**
+         * @brief   Cameras write their owner's transform and their matrices.
+         */
+        virtual ComponentUpdateAccess GetUpdateWrites() const override { return ComponentUpdateAccess::EntityTransforms | ComponentUpdateAccess::Cameras; }
+
         /**
          * @brief   Initializes the component manager.
          */
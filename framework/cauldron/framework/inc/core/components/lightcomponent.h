@@ -72,6 +72,21 @@ namespace cauldron
          */
         virtual const wchar_t* ComponentType() const override { return s_ComponentName; }
 
+        /**
+         * @brief   Lights read their owner's transform and the current camera to fit shadow cascades.
+         */
+        virtual ComponentUpdateAccess GetUpdateReads() const override { return ComponentUpdateAccess::EntityTransforms | ComponentUpdateAccess::Cameras; }
+
+        /**
+         * @brief   Lights only write their own matrices.
+         */
+        virtual ComponentUpdateAccess GetUpdateWrites() const override { return ComponentUpdateAccess::None; }
+
+        /**
+         * @brief   Lights only touch their own state, so they are updated concurrently.
+         */
+        virtual bool HasIndependentComponentUpdates() const override { return true; }
+
         /**
          * @brief   Initializes the component manager.
          */
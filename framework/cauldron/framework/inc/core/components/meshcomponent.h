@@ -69,6 +69,16 @@ namespace cauldron
          */
         virtual const wchar_t* ComponentType() const override { return s_ComponentName; }
 
+        /**
+         * @brief   Meshes read their owner's transform.
+         */
+        virtual ComponentUpdateAccess GetUpdateReads() const override { return ComponentUpdateAccess::EntityTransforms; }
+
+        /**
+         * @brief   Meshes queue their instances for the acceleration structure.
+         */
+        virtual ComponentUpdateAccess GetUpdateWrites() const override { return ComponentUpdateAccess::RayTracingInstances; }
+
         /**
          * @brief   Initializes the component manager.
          */
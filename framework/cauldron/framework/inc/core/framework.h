@@ -161,6 +161,9 @@ namespace cauldron
         // Acceleration Structure
         bool BuildRayTracingAccelerationStructure : 1;
 
+        // Component updates
+        bool ParallelComponentUpdates : 1;
+
         //////////////////////////////////////////////////////////////////////////
         // Non-binary data
 
@@ -722,6 +725,7 @@ namespace cauldron
 
         void BeginFrame();
         void EndFrame();
+        void UpdateComponentManagers();
 
         // Members
         CauldronConfig          m_Config = {};
@@ -793,6 +797,7 @@ namespace cauldron
         std::vector<RenderModule*>              m_RenderModules = {};
         std::vector<ExecutionTuple>             m_ExecutionCallbacks = {};
         std::map<std::wstring, ComponentMgr*>   m_ComponentManagers = {};
+        std::vector<ComponentMgr*>              m_ComponentUpdateOrder = {};     // Reused every frame to build the update graph
     };
 
     /**
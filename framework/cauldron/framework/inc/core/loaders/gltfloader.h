@@ -54,12 +54,10 @@ namespace cauldron
         std::vector<LightComponentData>         LightData;                      ///< Loaded <c><i>LightComponentData</i></c>.
         std::vector<CameraComponentData>        CameraData;                     ///< Loaded <c><i>CameraComponentData</i></c>.
 
-        // To synchronize data loading and initialization
-        bool                                    BuffersLoaded = false;          ///< Buffer load status. True if buffer loading is completed.
-        bool                                    TexturesLoaded = false;         ///< Texture load status. True if buffer loading is completed.
+        // To synchronize texture loading and initialization (buffer loads are ordered by the loading task graph)
+        bool                                    TexturesLoaded = false;         ///< Texture load status. True if texture loading is completed.
 
         std::mutex                              CriticalSection;                ///< Mutex for syncing structure data changes.
-        std::condition_variable                 BufferCV;                       ///< Condition variable for syncing structure buffer data changes.
         std::condition_variable                 TextureCV;                      ///< Condition variable for syncing structure texture data changes.
 
         // Content block being built up as we are loading various things
@@ -116,12 +114,11 @@ namespace cauldron
 
         static void InitSkinningData(const Mesh* pMesh, AnimationComponentData* pComponentData);
 
-        static void LoadGLTFBuffer(void* pParam);
-        static void LoadGLTFBuffersCompleted(void* pParam);
-        static void LoadGLTFMesh(void* pParam);
-        static void LoadGLTFAnimation(void* pParam);
-        static void LoadGLTFSkin(void* pParam);
-        static void GLTFAllBufferAssetLoadsCompleted(void* pParam);
+        // Run as parallel fors of the loading task graph, pParam is the GLTFDataRep
+        static void LoadGLTFBuffer(uint32_t bufferIndex, void* pParam);
+        static void LoadGLTFMesh(uint32_t meshIndex, void* pParam);
+        static void LoadGLTFAnimation(uint32_t animationIndex, void* pParam);
+        static void LoadGLTFSkin(uint32_t skinIndex, void* pParam);
 
         // Parameter struct for Buffer-related loads
         struct GLTFBufferLoadParams
@@ -132,6 +129,7 @@ namespace cauldron
             UploadContext* pUploadCtx = nullptr;
         };
 
+        static std::wstring GetGLTFAssetName(const GLTFDataRep* pGLTFData, const json& assetEntry, const wchar_t* defaultPrefix, uint32_t assetIndex);
         static const json* LoadVertexBuffer(const json& attributes, const char* attributeName, const json& accessors, const json& bufferViews, const json& buffers, const GLTFBufferLoadParams& params, VertexBufferInformation& info, bool forceConversionToFloat);
         static void LoadIndexBuffer(const json& primitive, const json& accessors, const json& bufferViews, const json& buffers, const GLTFBufferLoadParams& params, IndexBufferInformation& info);
         static void LoadAnimInterpolant(AnimInterpolants& animInterpolant, const json& gltfData, int32_t interpAccessorID, const GLTFBufferLoadParams* pBufferLoadParams);
@@ -23,17 +23,176 @@
 #pragma once
 
 #include "misc/helpers.h"
+#include "misc/object_pool.h"
 #include "misc/threadsafe_queue.h"
+#include "misc/workstealing_queue.h"
 
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
 #include <functional>
 #include <queue>
 #include <memory>
+#include <mutex>
+#include <new>
 #include <thread>
+#include <type_traits>
 #include <vector>
 
 namespace cauldron
 {
-    typedef std::function<void(void*)> TaskFunc;
+    /**
+     * @class TaskFunc
+     *
+     * Type-erased <c>void(void*)</c> callable used by tasks. Function pointers, bound member functions
+     * and small lambdas are stored inline, only callables larger than the inline buffer go to the heap.
+     *
+     * @ingroup CauldronCore
+     */
+    class TaskFunc
+    {
+    public:
+        static constexpr size_t InlineSize = 48;    ///< Callables up to this size (and alignment) are stored without allocating
+
+        /**
+         * @brief   Constructs an empty function.
+         */
+        TaskFunc() = default;
+        TaskFunc(std::nullptr_t) {}
+
+        /**
+         * @brief   Constructs from any callable taking a void pointer. Null function pointers and empty std::functions result in an empty TaskFunc.
+         */
+        template<typename F, typename = typename std::enable_if<!std::is_same<typename std::decay<F>::type, TaskFunc>::value>::type>
+        TaskFunc(F&& func)
+        {
+            if (!IsEmptyCallable(func))
+                Assign<typename std::decay<F>::type>(std::forward<F>(func));
+        }
+
+        TaskFunc(const TaskFunc& other) { CopyFrom(other); }
+        TaskFunc(TaskFunc&& other) noexcept { MoveFrom(other); }
+        ~TaskFunc() { Reset(); }
+
+        TaskFunc& operator=(const TaskFunc& other)
+        {
+            if (this != &other)
+            {
+                Reset();
+                CopyFrom(other);
+            }
+            return *this;
+        }
+
+        TaskFunc& operator=(TaskFunc&& other) noexcept
+        {
+            if (this != &other)
+            {
+                Reset();
+                MoveFrom(other);
+            }
+            return *this;
+        }
+
+        /**
+         * @brief   Invokes the callable.
+         */
+        void operator()(void* pParam) const { m_pOps->Invoke(m_Storage, pParam); }
+
+        /**
+         * @brief   True if a callable is held.
+         */
+        explicit operator bool() const { return m_pOps != nullptr; }
+
+    private:
+
+        struct Ops
+        {
+            void (*Invoke)(void* pStorage, void* pParam);
+            void (*Copy)(void* pDst, const void* pSrc);
+            void (*Move)(void* pDst, void* pSrc);
+            void (*Destroy)(void* pStorage);
+        };
+
+        template<typename F>
+        struct InlineOps
+        {
+            static void Invoke(void* pStorage, void* pParam)    { (*static_cast<F*>(pStorage))(pParam); }
+            static void Copy(void* pDst, const void* pSrc)      { new (pDst) F(*static_cast<const F*>(pSrc)); }
+            static void Move(void* pDst, void* pSrc)            { new (pDst) F(std::move(*static_cast<F*>(pSrc))); static_cast<F*>(pSrc)->~F(); }
+            static void Destroy(void* pStorage)                 { static_cast<F*>(pStorage)->~F(); }
+            static const Ops Table;
+        };
+
+        template<typename F>
+        struct HeapOps
+        {
+            static F*& Get(void* pStorage)                      { return *static_cast<F**>(pStorage); }
+            static void Invoke(void* pStorage, void* pParam)    { (*Get(pStorage))(pParam); }
+            static void Copy(void* pDst, const void* pSrc)      { Get(pDst) = new F(*Get(const_cast<void*>(pSrc))); }
+            static void Move(void* pDst, void* pSrc)            { Get(pDst) = Get(pSrc); }
+            static void Destroy(void* pStorage)                 { delete Get(pStorage); }
+            static const Ops Table;
+        };
+
+        template<typename F>
+        static bool IsEmptyCallable(const F&) { return false; }
+        template<typename R, typename... Args>
+        static bool IsEmptyCallable(R (* const& pFunc)(Args...)) { return pFunc == nullptr; }
+        template<typename Signature>
+        static bool IsEmptyCallable(const std::function<Signature>& func) { return !func; }
+
+        template<typename F>
+        struct FitsInline : std::integral_constant<bool, sizeof(F) <= InlineSize && alignof(F) <= alignof(std::max_align_t) && std::is_nothrow_move_constructible<F>::value> {};
+
+        template<typename F, typename Arg>
+        void Assign(Arg&& func) { Assign<F>(std::forward<Arg>(func), FitsInline<F>()); }
+
+        template<typename F, typename Arg>
+        void Assign(Arg&& func, std::true_type)
+        {
+            new (m_Storage) F(std::forward<Arg>(func));
+            m_pOps = &InlineOps<F>::Table;
+        }
+
+        template<typename F, typename Arg>
+        void Assign(Arg&& func, std::false_type)
+        {
+            HeapOps<F>::Get(m_Storage) = new F(std::forward<Arg>(func));
+            m_pOps = &HeapOps<F>::Table;
+        }
+
+        void CopyFrom(const TaskFunc& other)
+        {
+            if (other.m_pOps)
+                other.m_pOps->Copy(m_Storage, other.m_Storage);
+            m_pOps = other.m_pOps;
+        }
+
+        void MoveFrom(TaskFunc& other)
+        {
+            if (other.m_pOps)
+                other.m_pOps->Move(m_Storage, other.m_Storage);
+            m_pOps = other.m_pOps;
+            other.m_pOps = nullptr;
+        }
+
+        void Reset()
+        {
+            if (m_pOps)
+                m_pOps->Destroy(m_Storage);
+            m_pOps = nullptr;
+        }
+
+        alignas(std::max_align_t) mutable unsigned char m_Storage[InlineSize];
+        const Ops* m_pOps = nullptr;
+    };
+
+    template<typename F>
+    const TaskFunc::Ops TaskFunc::InlineOps<F>::Table = { &InlineOps<F>::Invoke, &InlineOps<F>::Copy, &InlineOps<F>::Move, &InlineOps<F>::Destroy };
+
+    template<typename F>
+    const TaskFunc::Ops TaskFunc::HeapOps<F>::Table = { &HeapOps<F>::Invoke, &HeapOps<F>::Copy, &HeapOps<F>::Move, &HeapOps<F>::Destroy };
 
     struct TaskCompletionCallback;
 
@@ -51,10 +210,11 @@ namespace cauldron
         TaskCompletionCallback* pTaskCompletionCallback;    ///< If this task is part of a larger group of tasks that require post-completion synchronization, they will be associated with a task sync primitive
 
         Task(TaskFunc pTaskFunction, void* pTaskParam = nullptr, TaskCompletionCallback* pCompletionCallback = nullptr) :
-            pTaskFunction(pTaskFunction), pTaskParam(pTaskParam), pTaskCompletionCallback(pCompletionCallback) {}
+            pTaskFunction(std::move(pTaskFunction)), pTaskParam(pTaskParam), pTaskCompletionCallback(pCompletionCallback) {}
 
     private:
         friend class TaskManager;
+        friend struct TaskCompletionCallback;
         Task() {};
     };
 
@@ -65,6 +225,9 @@ namespace cauldron
      * Ensures we don't have to Wait() on tasks to complete so that we can fully
      * use all our threads at all times (as long as work is available)
      *
+     * Callbacks are pooled, create them with <c><i>TaskManager::CreateCompletionCallback</i></c>. They are
+     * returned to the pool once the completion task was picked up.
+     *
      * @ingroup CauldronCore
      */
     struct TaskCompletionCallback
@@ -72,18 +235,167 @@ namespace cauldron
         Task                    CompletionTask;     ///< The task to execute once the task count reaches 0
         std::atomic_uint        TaskCount;          ///< Number of tasks this callback is paired with. Count will tick down upon completion of each dependent task.
 
-        TaskCompletionCallback(Task completionTask, uint32_t taskCount = 1) :
-            CompletionTask(completionTask), TaskCount(taskCount) {}
+    private:
+        friend class ObjectPool<TaskCompletionCallback>;
+        TaskCompletionCallback() : CompletionTask(), TaskCount(0) {}
+    };
+
+    class TaskGraph;
+    class TaskManager;
+
+    /**
+     * @brief   Function run for every index of a parallel for.
+     */
+    typedef std::function<void(uint32_t index, void* pParam)> ParallelForFunc;
+
+    /**
+     * @class TaskHandle
+     *
+     * Waitable reference to a submitted <c><i>TaskGraph</i></c>. The graph stays alive as long as a handle references it.
+     *
+     * @ingroup CauldronCore
+     */
+    class TaskHandle
+    {
+    public:
+        TaskHandle() = default;
+        TaskHandle(const TaskHandle& other);
+        TaskHandle(TaskHandle&& other) noexcept;
+        ~TaskHandle();
+
+        TaskHandle& operator=(const TaskHandle& other);
+        TaskHandle& operator=(TaskHandle&& other) noexcept;
+
+        /**
+         * @brief   True if the handle references a graph.
+         */
+        bool IsValid() const { return m_pGraph != nullptr; }
+
+        /**
+         * @brief   True once every task of the graph has run. Invalid handles are always complete.
+         */
+        bool IsComplete() const;
+
+        /**
+         * @brief   Blocks until every task of the graph has run. Called from a worker thread, it executes
+         *          other tasks while waiting so waiting from within a task can't starve the pool.
+         */
+        void Wait() const;
+
+        /**
+         * @brief   Drops the reference to the graph.
+         */
+        void Reset();
+
+    private:
+        friend class TaskManager;
+        explicit TaskHandle(TaskGraph* pGraph) : m_pGraph(pGraph) {}
+
+        TaskGraph* m_pGraph = nullptr;
+    };
+
+    /**
+     * @class TaskGraph
+     *
+     * A set of tasks and parallel fors with explicit dependencies, submitted to the <c><i>TaskManager</i></c> as a whole.
+     * A node is dispatched as soon as all the nodes it depends on are done, so no thread ever blocks on a dependency.
+     *
+     * Graphs and their nodes come from pools owned by the <c><i>TaskManager</i></c>, create them with
+     * <c><i>TaskManager::CreateTaskGraph</i></c>. Once submitted a graph can't be modified anymore and is
+     * returned to the pool when it's done and no <c><i>TaskHandle</i></c> references it.
+     *
+     * @ingroup CauldronCore
+     */
+    class TaskGraph
+    {
+    public:
+        typedef uint32_t NodeID;
+        static constexpr NodeID InvalidNode = ~0u;
+
+        /**
+         * @brief   Adds a single task. Names must outlive the graph (string literals are expected).
+         */
+        NodeID AddTask(const wchar_t* name, TaskFunc taskFunc, void* pParam = nullptr);
+
+        /**
+         * @brief   Adds a parallel for calling forFunc for every index in [0, count). Indices are split into
+         *          chunks of at least minChunkSize, sized automatically to the number of worker threads.
+         */
+        NodeID AddParallelFor(const wchar_t* name, uint32_t count, ParallelForFunc forFunc, void* pParam = nullptr, uint32_t minChunkSize = 1);
+
+        /**
+         * @brief   Makes node wait for dependency. Dependencies have to be added to the graph before the nodes that depend
+         *          on them, which keeps the graph free of cycles.
+         */
+        void AddDependency(NodeID node, NodeID dependency);
+
+        /**
+         * @brief   Logs the critical path (the chain of dependent nodes that took the longest) once the graph is done.
+         */
+        void SetReportCriticalPath(bool report) { m_ReportCriticalPath = report; }
+
+        /**
+         * @brief   Returns the graph's name.
+         */
+        const wchar_t* GetName() const { return m_pName; }
 
     private:
-        TaskCompletionCallback() = delete;
+        friend class TaskManager;
+        friend class TaskHandle;
+        friend class ObjectPool<TaskGraph>;
+
+        TaskGraph() = default;
+        NO_COPY(TaskGraph);
+        NO_MOVE(TaskGraph);
+
+        struct Node
+        {
+            const wchar_t*          pName = nullptr;
+            TaskFunc                TaskFunction;
+            ParallelForFunc         ForFunction;
+            void*                   pParam = nullptr;
+            TaskGraph*              pGraph = nullptr;
+
+            // Parallel for range, split in ChunkCount chunks claimed by whichever thread gets to them first
+            bool                    IsParallelFor = false;
+            uint32_t                Count = 0;
+            uint32_t                ChunkSize = 1;
+            uint32_t                ChunkCount = 0;
+            std::atomic<uint32_t>   NextChunk = { 0 };
+            std::atomic<uint32_t>   CompletedChunks = { 0 };
+
+            uint32_t                DependencyCount = 0;
+            std::atomic<uint32_t>   PendingDependencies = { 0 };
+            std::vector<NodeID>     Successors = {};
+
+            // Timings in nanoseconds, used for the critical path
+            std::atomic<int64_t>    StartTime = { 0 };
+            int64_t                 EndTime = 0;
+        };
+
+        TaskManager*            m_pTaskManager = nullptr;
+        const wchar_t*          m_pName = nullptr;
+        std::vector<Node*>      m_Nodes = {};
+        bool                    m_ReportCriticalPath = false;
+        bool                    m_Submitted = false;
+        int64_t                 m_SubmitTime = 0;
+
+        std::atomic<uint32_t>   m_RemainingNodes = { 0 };
+        std::atomic<uint32_t>   m_RefCount = { 0 };
+        std::atomic<bool>       m_Complete = { false };
+        std::mutex              m_CompleteMutex;
+        std::condition_variable m_CompleteCondition;
     };
 
     /**
      * @class TaskManager
      *
-     * The TaskManager instance manages our thread pool. Currently, only loading of content is handled
-     * asynchronously (the main loop is single threaded).
+     * The TaskManager instance manages our thread pool. Content loading runs asynchronously, and the main loop
+     * spreads component updates over the pool each frame (see <c><i>Framework::UpdateComponentManagers</i></c>).
+     *
+     * Every worker owns a work-stealing deque. Tasks added from a worker go to its own deque, tasks added from
+     * any other thread go to a shared injection queue. Idle workers drain the injection queue and steal from each
+     * other before going to sleep, and submission only wakes as many sleeping workers as there are new tasks.
      *
      * @ingroup CauldronCore
      */
@@ -117,23 +429,111 @@ namespace cauldron
         void AddTask(Task& newTask);
 
         /**
-         * @brief   Enqueues multiple tasks for execution.
+         * @brief   Enqueues multiple tasks for execution as a single batch.
          */
         void AddTaskList(std::queue<Task>& newTaskList);
 
+        /**
+         * @brief   Returns the number of worker threads.
+         */
+        uint32_t GetThreadCount() const { return static_cast<uint32_t>(m_ThreadPool.size()); }
+
+        /**
+         * @brief   Gets a pooled completion callback that runs completionTask once taskCount tasks referencing it have run.
+         */
+        TaskCompletionCallback* CreateCompletionCallback(Task completionTask, uint32_t taskCount = 1);
+
+        /**
+         * @brief   Gets an empty pooled task graph to fill in and submit. Names must outlive the graph.
+         */
+        TaskGraph* CreateTaskGraph(const wchar_t* name);
+
+        /**
+         * @brief   Starts executing a graph. The graph can't be modified after this, and is returned to the pool once it's
+         *          done and all handles to it are gone.
+         */
+        TaskHandle Submit(TaskGraph* pGraph);
+
+        /**
+         * @brief   Submits a graph and returns once it completed. The calling thread runs nodes of the graph as they
+         *          become ready, but never unrelated tasks, so it can't get stuck behind long running background work.
+         */
+        void Execute(TaskGraph* pGraph);
+
+        /**
+         * @brief   Calls forFunc for every index in [0, count) across the worker threads and returns once all are done.
+         *          The calling thread works on the range as well and never runs unrelated tasks while waiting.
+         */
+        void ParallelFor(uint32_t count, ParallelForFunc forFunc, void* pParam = nullptr, uint32_t minChunkSize = 1);
+
     private:
+        friend class TaskGraph;
+        friend class TaskHandle;
 
         // No Copy, No Move
         NO_COPY(TaskManager);
         NO_MOVE(TaskManager);
 
-        void TaskExecutor();
+        // Tasks are moved into pooled nodes once, the queues only pass pointers around
+        struct TaskNode
+        {
+            Task        NodeTask;
+            TaskNode*   pNext = nullptr;
+        };
+
+        struct Worker
+        {
+            WorkStealingQueue<TaskNode> Queue;
+            TaskNode*                   pFreeNodes = nullptr;
+            uint32_t                    FreeNodeCount = 0;
+            uint32_t                    StealSeed = 0;
+        };
+
+        void TaskExecutor(uint32_t workerIndex);
+        void ExecuteTask(Task& task);
+        bool ExecuteOneTask();
+
+        // Task graph execution
+        void DispatchNodes(TaskGraph::Node** ppNodes, uint32_t count, uint32_t callerChunks);
+        void RunNode(TaskGraph::Node* pNode);
+        bool RunNodeChunks(TaskGraph::Node* pNode);
+        void CompleteNode(TaskGraph::Node* pNode);
+        void CompleteGraph(TaskGraph* pGraph);
+        void ReleaseGraph(TaskGraph* pGraph);
+        void ReportCriticalPath(TaskGraph* pGraph);
+
+        TaskNode* AllocateNode(Worker* pWorker);
+        void FreeNode(Worker* pWorker, TaskNode* pNode);
+        TaskNode* AllocateNodeShared();
+        void AllocateNodeChunk();
+
+        void SubmitNodes(TaskNode** ppNodes, uint32_t count);
+        TaskNode* FindTask(uint32_t workerIndex);
+        Worker* GetCurrentWorker();
+
+        std::atomic<bool>                       m_ShuttingDown = { false };
+        std::vector<std::thread>                m_ThreadPool = {};
+        std::vector<std::unique_ptr<Worker>>    m_Workers = {};
+
+        // Tasks submitted from threads outside the pool
+        std::mutex                  m_InjectionMutex;
+        std::vector<TaskNode*>      m_InjectionQueue = {};
+        size_t                      m_InjectionHead = 0;
+
+        // Number of tasks waiting in any queue, sleeping workers only wake up when it's non zero
+        std::atomic<int64_t>        m_QueuedTasks = { 0 };
+        std::atomic<uint32_t>       m_SleepingWorkers = { 0 };
+        std::mutex                  m_SleepMutex;
+        std::condition_variable     m_SleepCondition;
+
+        // Node pool, workers keep a local free list and exchange nodes with the shared list in batches
+        std::mutex                                  m_NodePoolMutex;
+        TaskNode*                                   m_pFreeNodes = nullptr;
+        std::vector<std::unique_ptr<TaskNode[]>>    m_NodeChunks = {};
 
-        bool                        m_ShuttingDown = false;
-        std::vector<std::thread>    m_ThreadPool = {};
-        std::queue<Task>            m_TaskQueue = {};
-        std::mutex                  m_CriticalSection;
-        std::condition_variable     m_QueueCondition;
+        ObjectPool<TaskCompletionCallback>          m_CompletionCallbackPool;
+        ObjectPool<TaskGraph>                       m_GraphPool;
+        ObjectPool<TaskGraph::Node, 256>            m_GraphNodePool;
     };
 
 } // namespace cauldron
@@ -0,0 +1,89 @@
+// This file is part of the FidelityFX SDK.
+//
+// Copyright (C) 2024 Advanced Micro Devices, Inc.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace cauldron
+{
+    /**
+     * @class ObjectPool
+     *
+     * Thread safe pool of reusable objects, allocated in chunks. Objects are default constructed once and never
+     * destroyed until the pool is, so whatever they own (i.e. vector capacity) carries over between uses.
+     * Acquired objects are in the state they were released in, callers are responsible for resetting them.
+     *
+     * Types with private constructors can befriend <c><i>ObjectPool</i></c> to only be creatable through a pool.
+     *
+     * @ingroup CauldronMisc
+     */
+    template<typename T, size_t ChunkSize = 64>
+    class ObjectPool
+    {
+    public:
+
+        /**
+         * @brief   Gets an object from the pool, allocating a new chunk if none are free.
+         */
+        T* Acquire()
+        {
+            std::unique_lock<std::mutex> lock(m_Mutex);
+            if (m_FreeObjects.empty())
+            {
+                m_Chunks.push_back(std::unique_ptr<T[]>(new T[ChunkSize]));
+                for (size_t i = 0; i < ChunkSize; ++i)
+                    m_FreeObjects.push_back(&m_Chunks.back()[ChunkSize - 1 - i]);
+            }
+
+            T* pObject = m_FreeObjects.back();
+            m_FreeObjects.pop_back();
+            return pObject;
+        }
+
+        /**
+         * @brief   Returns an object to the pool.
+         */
+        void Release(T* pObject)
+        {
+            std::unique_lock<std::mutex> lock(m_Mutex);
+            m_FreeObjects.push_back(pObject);
+        }
+
+        /**
+         * @brief   Number of objects the pool has allocated so far.
+         */
+        size_t GetCapacity()
+        {
+            std::unique_lock<std::mutex> lock(m_Mutex);
+            return m_Chunks.size() * ChunkSize;
+        }
+
+    private:
+        std::mutex                          m_Mutex;
+        std::vector<std::unique_ptr<T[]>>   m_Chunks = {};
+        std::vector<T*>                     m_FreeObjects = {};
+    };
+
+} // namespace cauldron
@@ -0,0 +1,163 @@
+// This file is part of the FidelityFX SDK.
+//
+// Copyright (C) 2024 Advanced Micro Devices, Inc.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace cauldron
+{
+    /**
+     * @class WorkStealingQueue
+     *
+     * Chase-Lev work-stealing deque of pointers. The owning thread pushes and pops at the bottom
+     * without taking locks, any other thread can steal from the top. Used to back the <c><i>TaskManager</i></c> workers.
+     *
+     * Grown buffers are kept alive until the queue is destroyed, as a thief may still be reading from one.
+     *
+     * @ingroup CauldronMisc
+     */
+    template<typename T>
+    class WorkStealingQueue
+    {
+    public:
+
+        /**
+         * @brief   Construction with an initial capacity (rounded up to a power of 2).
+         */
+        explicit WorkStealingQueue(int64_t initialCapacity = 256)
+        {
+            int64_t capacity = 1;
+            while (capacity < initialCapacity)
+                capacity *= 2;
+
+            m_Buffers.push_back(std::make_unique<Buffer>(capacity));
+            m_pBuffer.store(m_Buffers.back().get(), std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief   Pushes an item at the bottom of the queue. Owner thread only.
+         */
+        void Push(T* pItem)
+        {
+            int64_t bottom  = m_Bottom.load(std::memory_order_relaxed);
+            int64_t top     = m_Top.load(std::memory_order_acquire);
+            Buffer* pBuffer = m_pBuffer.load(std::memory_order_relaxed);
+
+            if (bottom - top > pBuffer->Mask)
+                pBuffer = Grow(pBuffer, top, bottom);
+
+            pBuffer->Put(bottom, pItem);
+            std::atomic_thread_fence(std::memory_order_release);
+            m_Bottom.store(bottom + 1, std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief   Pops the most recently pushed item. Owner thread only, returns nullptr if the queue is empty.
+         */
+        T* Pop()
+        {
+            int64_t bottom  = m_Bottom.load(std::memory_order_relaxed) - 1;
+            Buffer* pBuffer = m_pBuffer.load(std::memory_order_relaxed);
+            m_Bottom.store(bottom, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            int64_t top = m_Top.load(std::memory_order_relaxed);
+
+            if (top > bottom)
+            {
+                // Was already empty
+                m_Bottom.store(bottom + 1, std::memory_order_relaxed);
+                return nullptr;
+            }
+
+            T* pItem = pBuffer->Get(bottom);
+            if (top == bottom)
+            {
+                // Last item, race the thieves for it
+                if (!m_Top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+                    pItem = nullptr;
+                m_Bottom.store(bottom + 1, std::memory_order_relaxed);
+            }
+            return pItem;
+        }
+
+        /**
+         * @brief   Steals the oldest item. Callable from any thread, returns nullptr if the queue is empty or the steal lost a race.
+         */
+        T* Steal()
+        {
+            int64_t top = m_Top.load(std::memory_order_acquire);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            int64_t bottom = m_Bottom.load(std::memory_order_acquire);
+
+            if (top >= bottom)
+                return nullptr;
+
+            Buffer* pBuffer = m_pBuffer.load(std::memory_order_acquire);
+            T*      pItem   = pBuffer->Get(top);
+            if (!m_Top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+                return nullptr;
+            return pItem;
+        }
+
+        /**
+         * @brief   Approximate number of items, only meant as a hint.
+         */
+        int64_t SizeHint() const
+        {
+            return m_Bottom.load(std::memory_order_relaxed) - m_Top.load(std::memory_order_relaxed);
+        }
+
+    private:
+
+        struct Buffer
+        {
+            int64_t                             Mask;
+            std::unique_ptr<std::atomic<T*>[]>  Items;
+
+            explicit Buffer(int64_t capacity) : Mask(capacity - 1), Items(new std::atomic<T*>[capacity]) {}
+
+            T*   Get(int64_t index) const        { return Items[index & Mask].load(std::memory_order_relaxed); }
+            void Put(int64_t index, T* pItem)    { Items[index & Mask].store(pItem, std::memory_order_relaxed); }
+        };
+
+        Buffer* Grow(Buffer* pBuffer, int64_t top, int64_t bottom)
+        {
+            m_Buffers.push_back(std::make_unique<Buffer>((pBuffer->Mask + 1) * 2));
+            Buffer* pNewBuffer = m_Buffers.back().get();
+            for (int64_t i = top; i < bottom; ++i)
+                pNewBuffer->Put(i, pBuffer->Get(i));
+
+            m_pBuffer.store(pNewBuffer, std::memory_order_release);
+            return pNewBuffer;
+        }
+
+        alignas(64) std::atomic<int64_t>        m_Top = { 0 };
+        alignas(64) std::atomic<int64_t>        m_Bottom = { 0 };
+        std::atomic<Buffer*>                    m_pBuffer = { nullptr };
+        std::vector<std::unique_ptr<Buffer>>    m_Buffers = {};     // Owner only
+    };
+
+} // namespace cauldron
@@ -221,6 +221,12 @@ namespace cauldron
         virtual void CopyData(const void* pData, size_t size) = 0;
         virtual void CopyData(const void* pData, size_t size, UploadContext* pUploadCtx, ResourceState postCopyState) = 0;
 
+        /**
+        * @brief   Reads back the start of a buffer created with <c><i>ResourceFlags::ReadbackBuffer</i></c>. The caller has to make sure
+        *          the GPU finished writing to it. Implemented internally per api/platform.
+        */
+        virtual void ReadData(void* pData, size_t size) = 0;
+
         /**
         * @brief   Gets the buffer's <c><i>BufferAddressInfo</i></c> for resource binding. Implemented internally per api/platform.
         */
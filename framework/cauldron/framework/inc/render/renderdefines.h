@@ -342,6 +342,7 @@ namespace cauldron
         AllowIndirect           = 0x1 << 8,     ///< Allow resource to be an indirect argument.
         AllowConstantBuffer     = 0x1 << 9,     ///< All resource to be used as a constant buffer
         BreadcrumbsBuffer       = 0x1 << 10,    ///< Special purpose buffer for holding AMD FidelityFX Breadcrumbs Library markers.
+        ReadbackBuffer          = 0x1 << 11,    ///< Buffer lives in CPU readable memory, is only used as a copy destination and read with <c><i>Buffer::ReadData</i></c>.
     };
     ENUM_FLAG_OPERATORS(ResourceFlags)
 
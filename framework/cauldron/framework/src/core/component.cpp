@@ -23,6 +23,7 @@
 #include "core/component.h"
 #include "core/entity.h"
 #include "core/framework.h"
+#include "core/taskmanager.h"
 #include "misc/assert.h"
 
 #include <functional>
@@ -67,6 +68,7 @@ namespace cauldron
 #endif // _DEBUG
 
         m_ManagedComponents.push_back(pComponent);
+        ++m_ComponentListVersion;
     }
 
     void ComponentMgr::StopManagingComponent(Component* pComponent)
@@ -79,6 +81,7 @@ namespace cauldron
             {
                 // Remove it from our own internal list
                 m_ManagedComponents.erase(iter);
+                ++m_ComponentListVersion;
                 return;
             }
 
@@ -91,6 +94,13 @@ namespace cauldron
 
     void ComponentMgr::UpdateComponents(double deltaTime)
     {
+        // Components that don't depend on each other can go wide
+        if (HasIndependentComponentUpdates())
+        {
+            ForEachComponent(0, GetComponentCount(), [this, deltaTime](uint32_t index) { m_ManagedComponents[index]->Update(deltaTime); });
+            return;
+        }
+
         // Update all components
         std::vector<Component*>::iterator iter  = m_ManagedComponents.begin();
         while (iter != m_ManagedComponents.end())
@@ -100,6 +110,18 @@ namespace cauldron
         }
     }
 
+    void ComponentMgr::ForEachComponent(uint32_t begin, uint32_t end, const std::function<void(uint32_t)>& updateFunc)
+    {
+        if (!GetConfig()->ParallelComponentUpdates || end - begin <= s_MinComponentsPerTask)
+        {
+            for (uint32_t index = begin; index < end; ++index)
+                updateFunc(index);
+            return;
+        }
+
+        GetTaskManager()->ParallelFor(end - begin, [begin, &updateFunc](uint32_t index, void*) { updateFunc(begin + index); }, nullptr, s_MinComponentsPerTask);
+    }
+
     Component* ComponentMgr::GetComponent(const Entity* pEntity) const
     {
         for (auto iter = m_ManagedComponents.begin(); iter != m_ManagedComponents.end(); ++iter)
@@ -157,57 +157,130 @@ namespace cauldron
         static double time = 0.0;
         time += deltaTime;
 
+        if (m_HierarchyListVersion != m_ComponentListVersion)
+            BuildHierarchyLevels();
+
         // Update local transforms
-        for (auto& component : m_ManagedComponents)
+        ForEachComponent(0, GetComponentCount(), [this](uint32_t index) { m_ManagedComponents[index]->Update(time); });
+
+        // Update global transforms (process the hierarchy one level at a time, parents before children)
+        for (size_t level = 0; level + 1 < m_HierarchyLevelStarts.size(); ++level)
         {
-            component->Update(time);
+            ForEachComponent(m_HierarchyLevelStarts[level], m_HierarchyLevelStarts[level + 1], [this](uint32_t index) {
+                UpdateGlobalTransform(m_HierarchyOrder[index]);
+            });
         }
 
-        // Update global transforms (process the hierarchy)
-        for (auto& component : m_ManagedComponents)
+        // Skinning
+        ForEachComponent(0, GetComponentCount(), [this](uint32_t index) {
+            UpdateSkinning(static_cast<AnimationComponent*>(m_ManagedComponents[index]));
+        });
+    }
+
+    void AnimationComponentMgr::BuildHierarchyLevels()
+    {
+        const uint32_t componentCount = GetComponentCount();
+
+        std::unordered_map<const Entity*, uint32_t> componentIndices;
+        componentIndices.reserve(componentCount);
+        for (uint32_t i = 0; i < componentCount; ++i)
+            componentIndices[m_ManagedComponents[i]->GetOwner()] = i;
+
+        // Only animated parents matter, other entities don't change their transform during the update
+        const uint32_t        unknownDepth = 0xffffffff;
+        std::vector<uint32_t> depths(componentCount, unknownDepth);
+        std::vector<uint32_t> chain;
+        uint32_t              levelCount = 0;
+        for (uint32_t i = 0; i < componentCount; ++i)
         {
-            const auto& parent = component->GetOwner()->GetParent();
-            const auto& data   = static_cast<const AnimationComponent*>(component)->GetData();
+            // Walk up until a component with a known depth or the top of the animated hierarchy
+            uint32_t current = i;
+            uint32_t depth   = 0;
+            while (depths[current] == unknownDepth)
+            {
+                chain.push_back(current);
+
+                Entity* pParent = m_ManagedComponents[current]->GetOwner()->GetParent();
+                auto    parent  = pParent ? componentIndices.find(pParent) : componentIndices.end();
+                if (parent == componentIndices.end())
+                    break;
+                current = parent->second;
+            }
+            if (depths[current] != unknownDepth)
+                depth = depths[current] + 1;
+
+            for (auto iter = chain.rbegin(); iter != chain.rend(); ++iter)
+                depths[*iter] = depth++;
+            chain.clear();
+
+            levelCount = std::max(levelCount, depths[i] + 1);
+        }
+
+        // Counting sort by depth, keeps the registration order within a level
+        m_HierarchyLevelStarts.assign(levelCount + 1, 0);
+        for (uint32_t i = 0; i < componentCount; ++i)
+            ++m_HierarchyLevelStarts[depths[i] + 1];
+        for (uint32_t level = 0; level < levelCount; ++level)
+            m_HierarchyLevelStarts[level + 1] += m_HierarchyLevelStarts[level];
 
-            Mat4 parentTransform = parent == nullptr ? Mat4::identity() : parent->GetTransform();
-            Mat4 globalTransform = parentTransform * static_cast<AnimationComponent*>(component)->GetLocalTransform();
+        std::vector<uint32_t> nextSlot(m_HierarchyLevelStarts.begin(), m_HierarchyLevelStarts.end() - 1);
+        m_HierarchyOrder.resize(componentCount);
+        for (uint32_t i = 0; i < componentCount; ++i)
+            m_HierarchyOrder[nextSlot[depths[i]]++] = static_cast<AnimationComponent*>(m_ManagedComponents[i]);
 
-            /*
-            * Currently supports only one Skin per Model. Most assets work this way but it's technically possible for a Model to have multiple Skins.
-            * If supporting these models is desired in the future, the following code needs to change.
-            */
-            const auto& skins = m_skinningData[data->m_modelId].m_pSkins;
+        m_HierarchyListVersion = m_ComponentListVersion;
+    }
+
+    void AnimationComponentMgr::UpdateGlobalTransform(AnimationComponent* pComponent)
+    {
+        Entity*     pOwner = pComponent->GetOwner();
+        Entity*     parent = pOwner->GetParent();
+        const auto& data   = pComponent->GetData();
+
+        Mat4 parentTransform = parent == nullptr ? Mat4::identity() : parent->GetTransform();
+        Mat4 globalTransform = parentTransform * pComponent->GetLocalTransform();
+
+        /*
+        * Currently supports only one Skin per Model. Most assets work this way but it's technically possible for a Model to have multiple Skins.
+        * If supporting these models is desired in the future, the following code needs to change.
+        */
+        // Runs concurrently for many components, so the map must not be modified here
+        auto skinningData = m_skinningData.find(data->m_modelId);
+        if (skinningData != m_skinningData.end())
+        {
+            const auto& skins = skinningData->second.m_pSkins;
             if (skins != nullptr && skins->size() > 0 && skins->at(0)->m_skeletonId == data->m_nodeId)
             {
-                globalTransform = static_cast<AnimationComponent*>(component)->GetLocalTransform();
+                globalTransform = pComponent->GetLocalTransform();
             }
-
-            component->GetOwner()->SetPrevTransform(component->GetOwner()->GetTransform());
-            component->GetOwner()->SetTransform(globalTransform);
         }
 
+        pOwner->SetPrevTransform(pOwner->GetTransform());
+        pOwner->SetTransform(globalTransform);
+    }
 
-        // Skinning
-        for (auto& component : m_ManagedComponents)
-        {
-            const auto& data = static_cast<const AnimationComponent*>(component)->GetData();
+    void AnimationComponentMgr::UpdateSkinning(AnimationComponent* pComponent)
+    {
+        const auto& data = pComponent->GetData();
+
+        // Animated models with no skinning
+        auto skinningData = m_skinningData.find(data->m_modelId);
+        if (skinningData == m_skinningData.end() || !skinningData->second.m_pSkins)
+            return;
 
-            // Animated models with no skinning
-            if (!m_skinningData[data->m_modelId].m_pSkins)
-                continue;
+        SkinningData& modelSkinning = skinningData->second;
+        for (size_t skinIdx = 0; skinIdx < modelSkinning.m_pSkins->size(); ++skinIdx)
+        {
+            const AnimationSkin* skin = modelSkinning.m_pSkins->at(skinIdx);
 
-            for (size_t skinIdx = 0; skinIdx < m_skinningData[data->m_modelId].m_pSkins->size(); ++skinIdx)
+            // if this node is in the target list of joints to be updated, update it
+            // Every joint belongs to a single node, so components never write the same matrix
+            for (size_t i = 0; i < skin->m_jointsNodeIdx.size(); ++i)
             {
-                const AnimationSkin* skin = m_skinningData[data->m_modelId].m_pSkins->at(skinIdx);
-
-                // if this node is in the target list of joints to be updated, update it
-                for (size_t i = 0; i < skin->m_jointsNodeIdx.size(); ++i)
+                if (data->m_nodeId == skin->m_jointsNodeIdx[i])
                 {
-                    if (data->m_nodeId == skin->m_jointsNodeIdx[i])
-                    {
-                        const Mat4* pM = (Mat4*)skin->m_InverseBindMatrices.Data.data();
-                        m_skinningData[data->m_modelId].m_SkinningMatrices[skinIdx][i].Set(component->GetOwner()->GetTransform() * pM[i]);
-                    }
+                    const Mat4* pM = (Mat4*)skin->m_InverseBindMatrices.Data.data();
+                    modelSkinning.m_SkinningMatrices[skinIdx][i].Set(pComponent->GetOwner()->GetTransform() * pM[i]);
                 }
             }
         }
@@ -71,6 +71,21 @@ namespace cauldron
          */
         virtual const wchar_t* ComponentType() const override { return s_ComponentName; }
 
+        /**
+         * @brief   Particle systems don't read shared data during their update.
+         */
+        virtual ComponentUpdateAccess GetUpdateReads() const override { return ComponentUpdateAccess::None; }
+
+        /**
+         * @brief   Particle systems only write their own state.
+         */
+        virtual ComponentUpdateAccess GetUpdateWrites() const override { return ComponentUpdateAccess::None; }
+
+        /**
+         * @brief   Particle systems are independent of each other, so they are updated concurrently.
+         */
+        virtual bool HasIndependentComponentUpdates() const override { return true; }
+
         /**
          * @brief   Initializes the component manager.
          */
@@ -869,6 +869,7 @@ namespace cauldron
         m_Config.OverrideSceneSamplers = configData.value("OverrideSceneSamplers", m_Config.OverrideSceneSamplers);
         m_Config.TakeScreenshot        = configData.value("Screenshot", m_Config.TakeScreenshot);
         m_Config.BuildRayTracingAccelerationStructure = configData.value("BuildRayTracingAccelerationStructure", m_Config.BuildRayTracingAccelerationStructure);
+        m_Config.ParallelComponentUpdates = configData.value("ParallelComponentUpdates", m_Config.ParallelComponentUpdates);
 
         // Content initialization
         if (configData.find("Content") != configData.end())
@@ -1209,6 +1210,7 @@ namespace cauldron
         m_Config.InvertedDepth         = true;
         m_Config.OverrideSceneSamplers = true;
         m_Config.BuildRayTracingAccelerationStructure = false;
+        m_Config.ParallelComponentUpdates = false;
 
         // Perf defaults
         m_Config.BenchmarkAppend       = false;
@@ -1617,6 +1619,45 @@ namespace cauldron
         return m_pImpl->Run();
     }
 
+    // Updates every component manager, in parallel where their update accesses allow it when ParallelComponentUpdates is set
+    void Framework::UpdateComponentManagers()
+    {
+        if (!m_Config.ParallelComponentUpdates)
+        {
+            for (auto compMgrIter = m_ComponentManagers.begin(); compMgrIter != m_ComponentManagers.end(); ++compMgrIter)
+                compMgrIter->second->UpdateComponents(m_DeltaTime);
+            return;
+        }
+
+        // One node per manager. A manager runs after every earlier manager it shares data with (one writes what the
+        // other reads or writes), so conflicting managers keep their registration order and the rest runs in parallel
+        TaskGraph* pGraph = m_pTaskManager->CreateTaskGraph(L"ComponentUpdates");
+        m_ComponentUpdateOrder.clear();
+        for (auto compMgrIter = m_ComponentManagers.begin(); compMgrIter != m_ComponentManagers.end(); ++compMgrIter)
+        {
+            ComponentMgr*         pManager = compMgrIter->second;
+            ComponentUpdateAccess reads    = pManager->GetUpdateReads();
+            ComponentUpdateAccess writes   = pManager->GetUpdateWrites();
+
+            TaskGraph::NodeID node = pGraph->AddTask(pManager->ComponentType(), [this](void* pParam) {
+                static_cast<ComponentMgr*>(pParam)->UpdateComponents(m_DeltaTime);
+            }, pManager);
+
+            for (TaskGraph::NodeID dependency = 0; dependency < node; ++dependency)
+            {
+                ComponentMgr* pDependency = m_ComponentUpdateOrder[dependency];
+                if ((writes & (pDependency->GetUpdateReads() | pDependency->GetUpdateWrites())) != ComponentUpdateAccess::None ||
+                    (reads & pDependency->GetUpdateWrites()) != ComponentUpdateAccess::None)
+                    pGraph->AddDependency(node, dependency);
+            }
+
+            m_ComponentUpdateOrder.push_back(pManager);
+        }
+
+        // The main thread takes part in the update and only returns once every manager is done
+        m_pTaskManager->Execute(pGraph);
+    }
+
     // Handles updating things outside the scope of the calling sample, and calls the sample's main loop function that controls render flow
     void Framework::MainLoop()
     {
@@ -1659,8 +1700,7 @@ namespace cauldron
         // Update all registered component managers
         {
             CPUScopedProfileCapture marker(L"ComponentUpdates");
-            for (auto compMgrIter = m_ComponentManagers.begin(); compMgrIter != m_ComponentManagers.end(); ++compMgrIter)
-                compMgrIter->second->UpdateComponents(m_DeltaTime);
+            UpdateComponentManagers();
         }
 
         // This can be closed out, new cmd lists will be opened after
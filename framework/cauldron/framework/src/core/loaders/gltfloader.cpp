@@ -498,39 +498,6 @@ namespace cauldron
                 GetContentManager()->LoadTextures(texLoadInfo, &GLTFLoader::LoadGLTFTexturesCompleted, glTFDataRep);
             }
 
-            // Now, schedule asynchronous loads of all the buffer data while we setup
-            // other structures (if we have any)
-            if (hasBuffers)
-            {
-                // Reserve the right number of entries
-                const json& buffers = glTFData["buffers"];
-                glTFDataRep->GLTFBufferData.resize(buffers.size());
-
-                // Load them asynchronously
-                TaskCompletionCallback* pCompletionCallback = new TaskCompletionCallback(Task(&GLTFLoader::LoadGLTFBuffersCompleted, glTFDataRep), static_cast<uint32_t>(buffers.size()));
-
-                std::queue<Task>   taskList;
-                for (size_t i = 0; i < buffers.size(); ++i)
-                {
-                    GLTFBufferLoadParams* pBufferLoadParams = new GLTFBufferLoadParams();
-                    pBufferLoadParams->pGLTFData = glTFDataRep;
-                    pBufferLoadParams->BufferIndex = (uint32_t)i;
-                    const std::string& uriName = buffers[i]["uri"];
-                    pBufferLoadParams->BufferName = filePathString + StringToWString(uriName);
-
-                    // Verify the file exists, otherwise we don't want to load
-                    // We can get around textures not being there, but not whole buffer info
-                    filesystem::path uriFile(pBufferLoadParams->BufferName);
-                    CauldronAssert(ASSERT_ERROR, filesystem::exists(uriFile), L"Buffer file %ls does not exist", pBufferLoadParams->BufferName.c_str());
-
-                    // Push the task
-                    taskList.push(Task(&GLTFLoader::LoadGLTFBuffer, pBufferLoadParams, pCompletionCallback));
-                }
-
-                // If all buffers were found, trigger the loading
-                GetTaskManager()->AddTaskList(taskList);
-            }
-
             // Load lights
             auto extensionsUsedIt = glTFData.find("extensionsUsed");
             if (extensionsUsedIt != glTFData.end())
@@ -630,8 +597,52 @@ namespace cauldron
                 }
             }
 
-            // For now, just create a task to call when all other loads are done (this task may wait for the loads to complete)
-            GetTaskManager()->AddTask(Task(std::bind(&GLTFLoader::PostGLTFContentLoadCompleted, this, std::placeholders::_1), glTFDataRep));
+            // Load all the buffer data in parallel, then create meshes, animations and skins from it in parallel.
+            // The scene gets built once all of it is done (textures are waited on separately).
+            TaskGraph* pLoadGraph = GetTaskManager()->CreateTaskGraph(L"glTF load");
+            pLoadGraph->SetReportCriticalPath(true);
+
+            TaskGraph::NodeID loadNodes[4];
+            uint32_t          loadNodeCount = 0;
+            if (hasBuffers)
+            {
+                // Reserve the right number of entries
+                const json& buffers = glTFData["buffers"];
+                glTFDataRep->GLTFBufferData.resize(buffers.size());
+
+                TaskGraph::NodeID buffersNode = pLoadGraph->AddParallelFor(L"Buffers", static_cast<uint32_t>(buffers.size()), &GLTFLoader::LoadGLTFBuffer, glTFDataRep);
+                loadNodes[loadNodeCount++] = buffersNode;
+
+                if (glTFData.find("meshes") != glTFData.end())
+                {
+                    uint32_t meshCount = static_cast<uint32_t>(glTFData["meshes"].size());
+                    glTFDataRep->pLoadedContentRep->Meshes.resize(meshCount);
+                    loadNodes[loadNodeCount] = pLoadGraph->AddParallelFor(L"Meshes", meshCount, &GLTFLoader::LoadGLTFMesh, glTFDataRep);
+                    pLoadGraph->AddDependency(loadNodes[loadNodeCount++], buffersNode);
+                }
+
+                if (glTFData.find("animations") != glTFData.end())
+                {
+                    uint32_t animationCount = static_cast<uint32_t>(glTFData["animations"].size());
+                    glTFDataRep->pLoadedContentRep->Animations.resize(animationCount);
+                    loadNodes[loadNodeCount] = pLoadGraph->AddParallelFor(L"Animations", animationCount, &GLTFLoader::LoadGLTFAnimation, glTFDataRep);
+                    pLoadGraph->AddDependency(loadNodes[loadNodeCount++], buffersNode);
+                }
+
+                if (glTFData.find("skins") != glTFData.end())
+                {
+                    uint32_t skinCount = static_cast<uint32_t>(glTFData["skins"].size());
+                    glTFDataRep->pLoadedContentRep->Skins.resize(skinCount);
+                    loadNodes[loadNodeCount] = pLoadGraph->AddParallelFor(L"Skins", skinCount, &GLTFLoader::LoadGLTFSkin, glTFDataRep);
+                    pLoadGraph->AddDependency(loadNodes[loadNodeCount++], buffersNode);
+                }
+            }
+
+            TaskGraph::NodeID sceneNode = pLoadGraph->AddTask(L"Scene", std::bind(&GLTFLoader::PostGLTFContentLoadCompleted, this, std::placeholders::_1), glTFDataRep);
+            for (uint32_t i = 0; i < loadNodeCount; ++i)
+                pLoadGraph->AddDependency(sceneNode, loadNodes[i]);
+
+            GetTaskManager()->Submit(pLoadGraph);
         }
 
         // Done with file path data
@@ -668,156 +679,44 @@ namespace cauldron
         }
     }
 
-    void GLTFLoader::LoadGLTFBuffer(void* pParam)
+    void GLTFLoader::LoadGLTFBuffer(uint32_t bufferIndex, void* pParam)
     {
-        GLTFBufferLoadParams* pLoadData = reinterpret_cast<GLTFBufferLoadParams*>(pParam);
+        GLTFDataRep* pGLTFData = reinterpret_cast<GLTFDataRep*>(pParam);
+        const json&  glTFData  = *pGLTFData->pGLTFJsonData;
+
+        const std::string& uriName = glTFData["buffers"][bufferIndex]["uri"];
+        std::wstring bufferName = pGLTFData->GLTFFilePath + StringToWString(uriName);
 
-        int64_t dataSize = GetFileSize(pLoadData->BufferName.c_str());
+        // Verify the file exists, otherwise we don't want to load
+        // We can get around textures not being there, but not whole buffer info
+        filesystem::path uriFile(bufferName);
+        CauldronAssert(ASSERT_ERROR, filesystem::exists(uriFile), L"Buffer file %ls does not exist", bufferName.c_str());
+
+        int64_t dataSize = GetFileSize(bufferName.c_str());
 
         // Allocate the data and read it in
-        pLoadData->pGLTFData->GLTFBufferData[pLoadData->BufferIndex].resize(dataSize+1);
+        pGLTFData->GLTFBufferData[bufferIndex].resize(dataSize+1);
         CauldronAssert(ASSERT_ERROR,
-                       dataSize == ReadFileAll(pLoadData->BufferName.c_str(), pLoadData->pGLTFData->GLTFBufferData[pLoadData->BufferIndex].data(), dataSize),
+                       dataSize == ReadFileAll(bufferName.c_str(), pGLTFData->GLTFBufferData[bufferIndex].data(), dataSize),
                        L"Error reading buffer file %ls",
-                       pLoadData->BufferName.c_str());
-
-        // Done with this memory
-        delete pLoadData;
+                       bufferName.c_str());
     }
 
-    void GLTFLoader::LoadGLTFBuffersCompleted(void* pParam)
+    // Meshes, animations and skins are uniquely named by the file they come from and their own name (or index if they don't have one)
+    std::wstring GLTFLoader::GetGLTFAssetName(const GLTFDataRep* pGLTFData, const json& assetEntry, const wchar_t* defaultPrefix, uint32_t assetIndex)
     {
-        GLTFDataRep* pGLTFData = reinterpret_cast<GLTFDataRep*>(pParam);
-        const json& glTFData = *pGLTFData->pGLTFJsonData;
-
-        bool hasMeshData = glTFData.find("meshes") != glTFData.end();
-        bool hasAnimationData = glTFData.find("animations") != glTFData.end();
-        bool hasAnimationSkins = glTFData.find("skins") != glTFData.end();
-
-        uint32_t numLoads = 0;
-
-        if (hasMeshData)
-        {
-            numLoads += (uint32_t)glTFData["meshes"].size();
-        }
-        if (hasAnimationData)
+        std::wstring assetName = pGLTFData->GLTFFilePath;
+        if (assetEntry.find("name") != assetEntry.end())
         {
-            numLoads += (uint32_t)glTFData["animations"].size();
+            std::string entryName = assetEntry["name"];
+            assetName += StringToWString(entryName);
         }
-        if (hasAnimationSkins)
-        {
-            numLoads += (uint32_t)glTFData["skins"].size();
-        }
-
-        // Create a completion callback to be called after all buffer loads have completed
-        TaskCompletionCallback* pLoadCompleteCallback = new TaskCompletionCallback(Task(&GLTFLoader::GLTFAllBufferAssetLoadsCompleted, pParam), numLoads);
-
-        // Dispatch a task for every mesh we need to load
-        if (hasMeshData)
-        {
-            const json& meshes = glTFData["meshes"];
-            std::queue<Task> meshTaskList;
-
-            pGLTFData->pLoadedContentRep->Meshes.resize(meshes.size());
-
-            for (int i = 0; i < meshes.size(); ++i)
-            {
-                // Build load info for the loading job
-                GLTFBufferLoadParams* pBufferLoadParams = new GLTFBufferLoadParams();
-                pBufferLoadParams->pGLTFData = pGLTFData;
-                pBufferLoadParams->BufferIndex = i;
-                pBufferLoadParams->BufferName = pGLTFData->GLTFFilePath;
-
-                if (meshes[i].find("name") != meshes[i].end())
-                {
-                    std::string meshName = meshes[i]["name"];
-                    pBufferLoadParams->BufferName += StringToWString(meshName);
-                }
-                else
-                {
-                    std::wstring meshName = L"Mesh_";
-                    meshName += std::to_wstring(i);
-                    pBufferLoadParams->BufferName += meshName;
-                }
-
-                // Push the task
-                meshTaskList.push(Task(&GLTFLoader::LoadGLTFMesh, pBufferLoadParams, pLoadCompleteCallback));
-            }
-
-            // Dispatch the loading tasks
-            GetTaskManager()->AddTaskList(meshTaskList);
-        }
-
-        if (hasAnimationData)
+        else
         {
-            const json& animationsJson = glTFData["animations"];
-            std::queue<Task> animationTaskList;
-
-            pGLTFData->pLoadedContentRep->Animations.resize(animationsJson.size());
-
-            for (int i = 0; i < animationsJson.size(); ++i)
-            {
-                // Build load info for the loading job
-                GLTFBufferLoadParams* pBufferLoadParams = new GLTFBufferLoadParams();
-                pBufferLoadParams->pGLTFData            = pGLTFData;
-                pBufferLoadParams->BufferIndex          = i;
-                pBufferLoadParams->BufferName           = pGLTFData->GLTFFilePath;
-
-                if (animationsJson[i].find("name") != animationsJson[i].end())
-                {
-                    std::string animationName = animationsJson[i]["name"];
-                    pBufferLoadParams->BufferName += StringToWString(animationName);
-                }
-                else
-                {
-                    std::wstring animationName = L"Animation_";
-                    animationName += std::to_wstring(i);
-                    pBufferLoadParams->BufferName += animationName;
-                }
-
-                // Push the task
-                animationTaskList.push(Task(&GLTFLoader::LoadGLTFAnimation, pBufferLoadParams, pLoadCompleteCallback));
-            }
-
-            // Dispatch the loading tasks
-            GetTaskManager()->AddTaskList(animationTaskList);
+            assetName += defaultPrefix;
+            assetName += std::to_wstring(assetIndex);
         }
-
-        if (hasAnimationSkins)
-        {
-            const json&      skinsJson = glTFData["skins"];
-            std::queue<Task> skinTaskList;
-
-            pGLTFData->pLoadedContentRep->Skins.resize(skinsJson.size());
-
-            for (size_t i = 0; i < skinsJson.size(); ++i)
-            {
-                // Build load info for the loading job
-                GLTFBufferLoadParams* pBufferLoadParams = new GLTFBufferLoadParams();
-                pBufferLoadParams->pGLTFData            = pGLTFData;
-                pBufferLoadParams->BufferIndex          = (uint32_t)i;
-                pBufferLoadParams->BufferName           = pGLTFData->GLTFFilePath;
-
-                if (skinsJson[i].find("name") != skinsJson[i].end())
-                {
-                    std::string skinName = skinsJson[i]["name"];
-                    pBufferLoadParams->BufferName += StringToWString(skinName);
-                }
-                else
-                {
-                    std::wstring skinName = L"Skin_";
-                    skinName += std::to_wstring(i);
-                    pBufferLoadParams->BufferName += skinName;
-                }
-
-                // Push the task
-                skinTaskList.push(Task(&GLTFLoader::LoadGLTFSkin, pBufferLoadParams, pLoadCompleteCallback));
-            }
-
-            // Dispatch the loading tasks
-            GetTaskManager()->AddTaskList(skinTaskList);
-        }
-
+        return assetName;
     }
 
     const json* GLTFLoader::LoadVertexBuffer(const json& attributes, const char* attributeName, const json& accessors, const json& bufferViews, const json& buffers, const GLTFBufferLoadParams& params, VertexBufferInformation& info, bool forceConversionToFloat)
@@ -1103,11 +1002,17 @@ namespace cauldron
     }
 
     // Called for each mesh in order to create and load mesh information
-    void GLTFLoader::LoadGLTFMesh(void* pParam)
+    void GLTFLoader::LoadGLTFMesh(uint32_t meshIndex, void* pParam)
     {
-        GLTFBufferLoadParams* pBufferLoadParams = reinterpret_cast<GLTFBufferLoadParams*>(pParam);
+        GLTFDataRep* pGLTFData = reinterpret_cast<GLTFDataRep*>(pParam);
+        const json&  glTFData  = *pGLTFData->pGLTFJsonData;
 
-        const json& glTFData = *pBufferLoadParams->pGLTFData->pGLTFJsonData;
+        // Build load info for the loading job
+        GLTFBufferLoadParams  bufferLoadParams;
+        GLTFBufferLoadParams* pBufferLoadParams = &bufferLoadParams;
+        pBufferLoadParams->pGLTFData   = pGLTFData;
+        pBufferLoadParams->BufferIndex = meshIndex;
+        pBufferLoadParams->BufferName  = GetGLTFAssetName(pGLTFData, glTFData["meshes"][meshIndex], L"Mesh_", meshIndex);
 
         // Get the mesh to load
         const json& meshes = glTFData["meshes"];
@@ -1194,16 +1099,19 @@ namespace cauldron
         }
 
         pBufferLoadParams->pGLTFData->pLoadedContentRep->Meshes[pBufferLoadParams->BufferIndex] = pMeshResource;
-
-        // Done with this memory
-        delete pBufferLoadParams;
     }
 
-    void GLTFLoader::LoadGLTFAnimation(void* pParam)
+    void GLTFLoader::LoadGLTFAnimation(uint32_t animationIndex, void* pParam)
     {
-        GLTFBufferLoadParams* pBufferLoadParams = reinterpret_cast<GLTFBufferLoadParams*>(pParam);
+        GLTFDataRep* pGLTFData = reinterpret_cast<GLTFDataRep*>(pParam);
+        const json&  glTFData  = *pGLTFData->pGLTFJsonData;
 
-        const json& glTFData = *pBufferLoadParams->pGLTFData->pGLTFJsonData;
+        // Build load info for the loading job
+        GLTFBufferLoadParams  bufferLoadParams;
+        GLTFBufferLoadParams* pBufferLoadParams = &bufferLoadParams;
+        pBufferLoadParams->pGLTFData   = pGLTFData;
+        pBufferLoadParams->BufferIndex = animationIndex;
+        pBufferLoadParams->BufferName  = GetGLTFAssetName(pGLTFData, glTFData["animations"][animationIndex], L"Animation_", animationIndex);
 
         const json& animations  = glTFData["animations"];
         auto&       accessors   = glTFData["accessors"];
@@ -1241,11 +1149,17 @@ namespace cauldron
         }
     }
 
-    void GLTFLoader::LoadGLTFSkin(void* pParam)
+    void GLTFLoader::LoadGLTFSkin(uint32_t skinIndex, void* pParam)
     {
-        GLTFBufferLoadParams* pBufferLoadParams = reinterpret_cast<GLTFBufferLoadParams*>(pParam);
+        GLTFDataRep* pGLTFData = reinterpret_cast<GLTFDataRep*>(pParam);
+        const json&  glTFData  = *pGLTFData->pGLTFJsonData;
 
-        const json& glTFData = *pBufferLoadParams->pGLTFData->pGLTFJsonData;
+        // Build load info for the loading job
+        GLTFBufferLoadParams  bufferLoadParams;
+        GLTFBufferLoadParams* pBufferLoadParams = &bufferLoadParams;
+        pBufferLoadParams->pGLTFData   = pGLTFData;
+        pBufferLoadParams->BufferIndex = skinIndex;
+        pBufferLoadParams->BufferName  = GetGLTFAssetName(pGLTFData, glTFData["skins"][skinIndex], L"Skin_", skinIndex);
 
         const json& skinEntry = glTFData["skins"][pBufferLoadParams->BufferIndex];
 
@@ -1296,17 +1210,6 @@ namespace cauldron
         pAccessor->Count     = inAccessor["count"];
     }
 
-    // Called once all buffer-related assets have been created and uploaded (i.e. Mesh, Animations, etc.)
-    void GLTFLoader::GLTFAllBufferAssetLoadsCompleted(void* pParam)
-    {
-        GLTFDataRep* pGLTFData = reinterpret_cast<GLTFDataRep*>(pParam);
-
-        // Mark load of buffer data complete and notify in case someone was waiting
-        std::unique_lock<std::mutex>    lock(pGLTFData->CriticalSection);
-        pGLTFData->BuffersLoaded = true;
-        pGLTFData->BufferCV.notify_one();
-    }
-
     void GLTFLoader::BuildBLAS(std::vector<Mesh*> meshes)
     {
         std::vector<CommandList*> cmdLists(1);
@@ -1419,12 +1322,7 @@ namespace cauldron
         static uint32_t modelIndex = 0;
 
         // create entities and component data
-        // If we had buffers, make sure all content was created/loaded
-        if (glTFData.find("buffers") != glTFData.end())
-        {
-            std::unique_lock<std::mutex> lock(pGLTFData->CriticalSection);
-            pGLTFData->BufferCV.wait(lock, [pGLTFData] { return pGLTFData->BuffersLoaded; });
-        }
+        // Buffer data and everything created from it is loaded by the time this runs (see LoadGLTFContent)
 
         // If we had textures, make sure all content was created/loaded
         if (glTFData.find("images") != glTFData.end())
@@ -49,7 +49,7 @@ namespace cauldron
 
         // Create a task completion callback to call in order to add textures to the content
         // manager once fully initialized and call the requester' callback
-        TaskCompletionCallback* pLoadCompleteCallback = new TaskCompletionCallback(Task(&TextureLoader::AsyncLoadCompleteCallback, pTexLoadData), 1);
+        TaskCompletionCallback* pLoadCompleteCallback = GetTaskManager()->CreateCompletionCallback(Task(&TextureLoader::AsyncLoadCompleteCallback, pTexLoadData), 1);
 
         // Enqueue the task to load content
         Task loadingTask(&TextureLoader::LoadTextureContent, &pTexLoadData->LoadInfo[0], pLoadCompleteCallback);
@@ -65,7 +65,7 @@ namespace cauldron
         *pTexLoadData = *pParams;
 
         // Create a task completion callback to call in order to call the requester' callback
-        TaskCompletionCallback* pLoadCompleteCallback = new TaskCompletionCallback(Task(&TextureLoader::AsyncLoadCompleteCallback, pTexLoadData), static_cast<uint32_t>(pTexLoadData->LoadInfo.size()));
+        TaskCompletionCallback* pLoadCompleteCallback = GetTaskManager()->CreateCompletionCallback(Task(&TextureLoader::AsyncLoadCompleteCallback, pTexLoadData), static_cast<uint32_t>(pTexLoadData->LoadInfo.size()));
 
         // Enqueue a task per texture to load the content
         std::queue<Task> taskList;
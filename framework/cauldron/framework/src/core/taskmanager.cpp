@@ -24,11 +24,179 @@
 #include "core/contentmanager.h"
 #include "core/framework.h"
 #include "misc/assert.h"
+#include "misc/log.h"
 
+#include <algorithm>
+#include <chrono>
 #include <functional>
+#include <string>
 
 namespace cauldron
 {
+    constexpr TaskGraph::NodeID TaskGraph::InvalidNode;
+
+    // Nodes are allocated in chunks and handed to workers in batches, so steady state submission doesn't allocate
+    static constexpr uint32_t s_NodeChunkSize       = 256;
+    static constexpr uint32_t s_NodeBatchSize       = 64;
+    static constexpr uint32_t s_MaxLocalFreeNodes   = 256;
+
+    // Number of times an idle worker looks for work again before going to sleep
+    static constexpr uint32_t s_IdleSpinCount       = 64;
+
+    // Identifies the pool (and the worker in it) the current thread belongs to
+    static thread_local TaskManager*    s_pWorkerOwner = nullptr;
+    static thread_local uint32_t        s_WorkerIndex = 0;
+
+    // Parallel fors aim for this many chunks per thread so uneven work still balances out
+    static constexpr uint32_t s_ChunksPerThread     = 4;
+
+    // Ready graph nodes are dispatched in batches of this size
+    static constexpr uint32_t s_DispatchBatchSize   = 32;
+
+    static int64_t GetTimeNs()
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::high_resolution_clock::now().time_since_epoch()).count();
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+    // TaskHandle
+
+    TaskHandle::TaskHandle(const TaskHandle& other) :
+        m_pGraph(other.m_pGraph)
+    {
+        if (m_pGraph)
+            ++m_pGraph->m_RefCount;
+    }
+
+    TaskHandle::TaskHandle(TaskHandle&& other) noexcept :
+        m_pGraph(other.m_pGraph)
+    {
+        other.m_pGraph = nullptr;
+    }
+
+    TaskHandle::~TaskHandle()
+    {
+        Reset();
+    }
+
+    TaskHandle& TaskHandle::operator=(const TaskHandle& other)
+    {
+        if (this != &other)
+        {
+            Reset();
+            m_pGraph = other.m_pGraph;
+            if (m_pGraph)
+                ++m_pGraph->m_RefCount;
+        }
+        return *this;
+    }
+
+    TaskHandle& TaskHandle::operator=(TaskHandle&& other) noexcept
+    {
+        if (this != &other)
+        {
+            Reset();
+            m_pGraph = other.m_pGraph;
+            other.m_pGraph = nullptr;
+        }
+        return *this;
+    }
+
+    bool TaskHandle::IsComplete() const
+    {
+        return !m_pGraph || m_pGraph->m_Complete.load();
+    }
+
+    void TaskHandle::Wait() const
+    {
+        if (!m_pGraph)
+            return;
+
+        TaskManager* pTaskManager = m_pGraph->m_pTaskManager;
+        if (pTaskManager->GetCurrentWorker())
+        {
+            // Keep the worker busy, the graph may well need it to make progress
+            while (!m_pGraph->m_Complete.load())
+            {
+                if (!pTaskManager->ExecuteOneTask())
+                    std::this_thread::yield();
+            }
+        }
+        else
+        {
+            std::unique_lock<std::mutex> lock(m_pGraph->m_CompleteMutex);
+            m_pGraph->m_CompleteCondition.wait(lock, [this] { return m_pGraph->m_Complete.load(); });
+        }
+    }
+
+    void TaskHandle::Reset()
+    {
+        if (m_pGraph)
+            m_pGraph->m_pTaskManager->ReleaseGraph(m_pGraph);
+        m_pGraph = nullptr;
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+    // TaskGraph
+
+    TaskGraph::NodeID TaskGraph::AddTask(const wchar_t* name, TaskFunc taskFunc, void* pParam)
+    {
+        CauldronAssert(ASSERT_CRITICAL, !m_Submitted, L"Can't add task %ls to graph %ls after it was submitted", name, m_pName);
+
+        Node* pNode = m_pTaskManager->m_GraphNodePool.Acquire();
+        pNode->pName            = name;
+        pNode->TaskFunction     = std::move(taskFunc);
+        pNode->ForFunction      = nullptr;
+        pNode->pParam           = pParam;
+        pNode->pGraph           = this;
+        pNode->IsParallelFor    = false;
+        pNode->Count            = 1;
+        pNode->ChunkSize        = 1;
+        pNode->ChunkCount       = 1;
+        pNode->DependencyCount  = 0;
+        pNode->Successors.clear();
+
+        m_Nodes.push_back(pNode);
+        return static_cast<NodeID>(m_Nodes.size() - 1);
+    }
+
+    TaskGraph::NodeID TaskGraph::AddParallelFor(const wchar_t* name, uint32_t count, ParallelForFunc forFunc, void* pParam, uint32_t minChunkSize)
+    {
+        CauldronAssert(ASSERT_CRITICAL, !m_Submitted, L"Can't add parallel for %ls to graph %ls after it was submitted", name, m_pName);
+
+        // Aim for a few chunks per thread (the submitting thread included), but never smaller than requested
+        uint32_t targetChunks = (m_pTaskManager->GetThreadCount() + 1) * s_ChunksPerThread;
+        uint32_t chunkSize    = std::max(std::max(minChunkSize, 1u), (count + targetChunks - 1) / targetChunks);
+
+        Node* pNode = m_pTaskManager->m_GraphNodePool.Acquire();
+        pNode->pName            = name;
+        pNode->TaskFunction     = nullptr;
+        pNode->ForFunction      = std::move(forFunc);
+        pNode->pParam           = pParam;
+        pNode->pGraph           = this;
+        pNode->IsParallelFor    = true;
+        pNode->Count            = count;
+        pNode->ChunkSize        = chunkSize;
+        pNode->ChunkCount       = (count + chunkSize - 1) / chunkSize;
+        pNode->DependencyCount  = 0;
+        pNode->Successors.clear();
+
+        m_Nodes.push_back(pNode);
+        return static_cast<NodeID>(m_Nodes.size() - 1);
+    }
+
+    void TaskGraph::AddDependency(NodeID node, NodeID dependency)
+    {
+        CauldronAssert(ASSERT_CRITICAL, !m_Submitted, L"Can't add dependencies to graph %ls after it was submitted", m_pName);
+        CauldronAssert(ASSERT_CRITICAL, node < m_Nodes.size() && dependency < node, L"Invalid dependency in graph %ls, dependencies must be added to the graph before the nodes depending on them", m_pName);
+
+        m_Nodes[dependency]->Successors.push_back(node);
+        ++m_Nodes[node]->DependencyCount;
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+    // TaskManager
+
     TaskManager::TaskManager()
     {
     }
@@ -39,10 +207,15 @@ namespace cauldron
 
     int32_t TaskManager::Init(uint32_t threadPoolSize)
     {
-        std::function<void()> pTaskHandler = [this]() { this->TaskExecutor(); };
+        // Create all worker state first, threads steal from each other as soon as they start
+        for (uint32_t i = 0; i < threadPoolSize; ++i)
+        {
+            m_Workers.push_back(std::make_unique<Worker>());
+            m_Workers.back()->StealSeed = i * 0x9E3779B9u + 1;
+        }
 
         for (uint32_t i = 0; i < threadPoolSize; ++i)
-            m_ThreadPool.push_back(std::thread(pTaskHandler));
+            m_ThreadPool.push_back(std::thread([this, i]() { this->TaskExecutor(i); }));
 
         return 0;
     }
@@ -54,9 +227,9 @@ namespace cauldron
 
         // Flag all threads to shutdown
         {
-            std::unique_lock<std::mutex> lock(m_CriticalSection);
+            std::unique_lock<std::mutex> lock(m_SleepMutex);
             m_ShuttingDown = true;
-            m_QueueCondition.notify_all();
+            m_SleepCondition.notify_all();
         }
 
         // Wait for all threads to be done
@@ -68,69 +241,576 @@ namespace cauldron
         }
     }
 
-    void TaskManager::AddTask(Task& newTask) 
-    { 
-        std::unique_lock<std::mutex> lock(m_CriticalSection);
-        m_TaskQueue.push(std::move(newTask));
+    TaskCompletionCallback* TaskManager::CreateCompletionCallback(Task completionTask, uint32_t taskCount)
+    {
+        TaskCompletionCallback* pCallback = m_CompletionCallbackPool.Acquire();
+        pCallback->CompletionTask = std::move(completionTask);
+        pCallback->TaskCount      = taskCount;
+        return pCallback;
+    }
 
-        // Wake a single thread to pick up the task
-        m_QueueCondition.notify_one();
+    TaskGraph* TaskManager::CreateTaskGraph(const wchar_t* name)
+    {
+        TaskGraph* pGraph = m_GraphPool.Acquire();
+        pGraph->m_pTaskManager       = this;
+        pGraph->m_pName              = name;
+        pGraph->m_ReportCriticalPath = false;
+        pGraph->m_Submitted          = false;
+        pGraph->m_Complete           = false;
+        return pGraph;
+    }
+
+    TaskHandle TaskManager::Submit(TaskGraph* pGraph)
+    {
+        CauldronAssert(ASSERT_CRITICAL, !pGraph->m_Submitted, L"Task graph %ls was already submitted", pGraph->m_pName);
+
+        // One reference is held until the graph completes, the other one is the returned handle
+        pGraph->m_Submitted      = true;
+        pGraph->m_SubmitTime     = GetTimeNs();
+        pGraph->m_RemainingNodes = static_cast<uint32_t>(pGraph->m_Nodes.size());
+        pGraph->m_RefCount       = 2;
+        TaskHandle handle(pGraph);
+
+        if (pGraph->m_Nodes.empty())
+        {
+            CompleteGraph(pGraph);
+            return handle;
+        }
+
+        for (TaskGraph::Node* pNode : pGraph->m_Nodes)
+        {
+            pNode->NextChunk           = 0;
+            pNode->CompletedChunks     = 0;
+            pNode->PendingDependencies = pNode->DependencyCount;
+            pNode->StartTime           = 0;
+            pNode->EndTime             = 0;
+        }
+
+        // Kick off every node without dependencies
+        TaskGraph::Node* readyNodes[s_DispatchBatchSize];
+        uint32_t         readyCount = 0;
+        for (TaskGraph::Node* pNode : pGraph->m_Nodes)
+        {
+            if (pNode->DependencyCount)
+                continue;
+
+            readyNodes[readyCount++] = pNode;
+            if (readyCount == s_DispatchBatchSize)
+            {
+                DispatchNodes(readyNodes, readyCount, 0);
+                readyCount = 0;
+            }
+        }
+        if (readyCount)
+            DispatchNodes(readyNodes, readyCount, 0);
+
+        return handle;
+    }
+
+    void TaskManager::Execute(TaskGraph* pGraph)
+    {
+        TaskHandle handle = Submit(pGraph);
+
+        // The handle keeps the nodes alive, help out with whatever is ready until everything ran
+        while (!handle.IsComplete())
+        {
+            bool ranChunks = false;
+            for (TaskGraph::Node* pNode : pGraph->m_Nodes)
+            {
+                if (pNode->PendingDependencies.load() || pNode->NextChunk.load() >= pNode->ChunkCount)
+                    continue;
+
+                RunNodeChunks(pNode);
+                ranChunks = true;
+            }
+
+            if (!ranChunks)
+                std::this_thread::yield();
+        }
+    }
+
+    void TaskManager::ParallelFor(uint32_t count, ParallelForFunc forFunc, void* pParam, uint32_t minChunkSize)
+    {
+        if (!count)
+            return;
+
+        TaskGraph* pGraph = CreateTaskGraph(L"ParallelFor");
+        pGraph->AddParallelFor(L"ParallelFor", count, std::move(forFunc), pParam, minChunkSize);
+        TaskGraph::Node* pNode = pGraph->m_Nodes[0];
+
+        pGraph->m_Submitted          = true;
+        pGraph->m_SubmitTime         = GetTimeNs();
+        pGraph->m_RemainingNodes     = 1;
+        pGraph->m_RefCount           = 2;
+        pNode->NextChunk             = 0;
+        pNode->CompletedChunks       = 0;
+        pNode->PendingDependencies   = 0;
+        pNode->StartTime             = 0;
+        TaskHandle handle(pGraph);
+
+        // The calling thread takes one share of the work itself
+        DispatchNodes(&pNode, 1, 1);
+        RunNodeChunks(pNode);
+
+        // All chunks are claimed at this point, only wait for the ones still running on other threads
+        while (pNode->CompletedChunks.load() < pNode->ChunkCount)
+            std::this_thread::yield();
+    }
+
+    void TaskManager::AddTask(Task& newTask)
+    {
+        Worker*   pWorker = GetCurrentWorker();
+        TaskNode* pNode   = pWorker ? AllocateNode(pWorker) : AllocateNodeShared();
+        pNode->NodeTask = std::move(newTask);
+
+        SubmitNodes(&pNode, 1);
     }
 
     void TaskManager::AddTaskList(std::queue<Task>& newTaskList)
     {
-        std::unique_lock<std::mutex> lock(m_CriticalSection);
-        while (newTaskList.size())
+        std::vector<TaskNode*> nodes;
+        nodes.reserve(newTaskList.size());
+
+        Worker* pWorker = GetCurrentWorker();
+        if (pWorker)
+        {
+            while (newTaskList.size())
+            {
+                nodes.push_back(AllocateNode(pWorker));
+                nodes.back()->NodeTask = std::move(newTaskList.front());
+                newTaskList.pop();
+            }
+        }
+        else
+        {
+            // Take all the nodes we need under a single lock
+            std::unique_lock<std::mutex> lock(m_NodePoolMutex);
+            while (newTaskList.size())
+            {
+                if (!m_pFreeNodes)
+                    AllocateNodeChunk();
+
+                TaskNode* pNode = m_pFreeNodes;
+                m_pFreeNodes    = pNode->pNext;
+                pNode->NodeTask = std::move(newTaskList.front());
+                nodes.push_back(pNode);
+                newTaskList.pop();
+            }
+        }
+
+        if (!nodes.empty())
+            SubmitNodes(nodes.data(), static_cast<uint32_t>(nodes.size()));
+    }
+
+    void TaskManager::SubmitNodes(TaskNode** ppNodes, uint32_t count)
+    {
+        // Workers push onto their own deque, everyone else goes through the injection queue
+        Worker* pWorker = GetCurrentWorker();
+        if (pWorker)
+        {
+            for (uint32_t i = 0; i < count; ++i)
+                pWorker->Queue.Push(ppNodes[i]);
+        }
+        else
+        {
+            std::unique_lock<std::mutex> lock(m_InjectionMutex);
+            m_InjectionQueue.insert(m_InjectionQueue.end(), ppNodes, ppNodes + count);
+        }
+
+        // Publish the new tasks before checking for sleepers. A worker about to sleep increments the sleeper count
+        // before checking the task count, so one of the two always sees the other
+        m_QueuedTasks.fetch_add(count);
+        uint32_t sleepingWorkers = m_SleepingWorkers.load();
+        if (sleepingWorkers)
         {
-            m_TaskQueue.push(std::move(newTaskList.front()));
-            newTaskList.pop();
+            // Only wake as many workers as there is work for
+            std::unique_lock<std::mutex> lock(m_SleepMutex);
+            for (uint32_t i = 0; i < std::min(count, sleepingWorkers); ++i)
+                m_SleepCondition.notify_one();
         }
+    }
 
-        // Wake up all threads to pick up as many concurrent tasks as possible
-        m_QueueCondition.notify_all();
+    TaskManager::Worker* TaskManager::GetCurrentWorker()
+    {
+        return s_pWorkerOwner == this ? m_Workers[s_WorkerIndex].get() : nullptr;
+    }
+
+    TaskManager::TaskNode* TaskManager::FindTask(uint32_t workerIndex)
+    {
+        Worker* pWorker = m_Workers[workerIndex].get();
+
+        // Newest local work first, it's most likely to still be in cache
+        TaskNode* pNode = pWorker->Queue.Pop();
+        if (pNode)
+            return pNode;
+
+        // Take a share of the injected tasks, keep one and queue the rest locally where others can steal them
+        {
+            std::unique_lock<std::mutex> lock(m_InjectionMutex);
+            size_t available = m_InjectionQueue.size() - m_InjectionHead;
+            if (available)
+            {
+                size_t batchSize = std::max<size_t>(1, available / m_Workers.size());
+                pNode = m_InjectionQueue[m_InjectionHead++];
+                for (size_t i = 1; i < batchSize; ++i)
+                    pWorker->Queue.Push(m_InjectionQueue[m_InjectionHead++]);
+
+                if (m_InjectionHead == m_InjectionQueue.size())
+                {
+                    m_InjectionQueue.clear();
+                    m_InjectionHead = 0;
+                }
+                return pNode;
+            }
+        }
+
+        // Steal from the other workers, starting at a random one to spread contention
+        uint32_t workerCount = static_cast<uint32_t>(m_Workers.size());
+        if (workerCount > 1)
+        {
+            pWorker->StealSeed ^= pWorker->StealSeed << 13;
+            pWorker->StealSeed ^= pWorker->StealSeed >> 17;
+            pWorker->StealSeed ^= pWorker->StealSeed << 5;
+
+            uint32_t start = pWorker->StealSeed % workerCount;
+            for (uint32_t i = 0; i < workerCount; ++i)
+            {
+                uint32_t victim = (start + i) % workerCount;
+                if (victim == workerIndex)
+                    continue;
+
+                pNode = m_Workers[victim]->Queue.Steal();
+                if (pNode)
+                    return pNode;
+            }
+        }
+
+        return nullptr;
     }
 
     // Runs for each thread and executes any waiting tasks when available
-    void TaskManager::TaskExecutor()
+    void TaskManager::TaskExecutor(uint32_t workerIndex)
     {
-        while (true)
+        s_pWorkerOwner = this;
+        s_WorkerIndex  = workerIndex;
+
+        while (!m_ShuttingDown)
         {
-            Task taskToExecute;
+            bool executed = ExecuteOneTask();
+            for (uint32_t spin = 0; !executed && spin < s_IdleSpinCount && !m_ShuttingDown; ++spin)
+            {
+                std::this_thread::yield();
+                executed = ExecuteOneTask();
+            }
+
+            if (!executed)
             {
-                // Try to unload a task to execute
-                std::unique_lock<std::mutex> lock(m_CriticalSection);
-                m_QueueCondition.wait(lock, [this] { return !this->m_TaskQueue.empty() || m_ShuttingDown; });    // Sleep until a task is available to execute or we are shutting down
+                // Sleep until a task is available to execute or we are shutting down
+                std::unique_lock<std::mutex> lock(m_SleepMutex);
+                m_SleepingWorkers.fetch_add(1);
+                m_SleepCondition.wait(lock, [this] { return m_QueuedTasks.load() > 0 || m_ShuttingDown; });
+                m_SleepingWorkers.fetch_sub(1);
+            }
+        }
+
+        s_pWorkerOwner = nullptr;
+    }
 
-                if (m_ShuttingDown)
-                    break;
+    // Worker threads only, returns false if there was nothing to run
+    bool TaskManager::ExecuteOneTask()
+    {
+        TaskNode* pNode = FindTask(s_WorkerIndex);
+        if (!pNode)
+            return false;
+
+        m_QueuedTasks.fetch_sub(1);
+
+        Task taskToExecute = std::move(pNode->NodeTask);
+        FreeNode(m_Workers[s_WorkerIndex].get(), pNode);
+        ExecuteTask(taskToExecute);
+        return true;
+    }
 
-                // Get the task (if not shutting down
-                taskToExecute = m_TaskQueue.front();
-                m_TaskQueue.pop();
+    void TaskManager::ExecuteTask(Task& taskToExecute)
+    {
+        while (taskToExecute.pTaskFunction)
+        {
+            // Execute the task
+            taskToExecute.pTaskFunction(taskToExecute.pTaskParam);
+
+            // When we are done, if there was a completion callback, tick it down and execute if needed
+            if (taskToExecute.pTaskCompletionCallback)
+            {
+                // If this was the last task on which we were waiting, execute the completion task now
+                if (--taskToExecute.pTaskCompletionCallback->TaskCount == 0)
+                {
+                    auto callbackMemPtr = taskToExecute.pTaskCompletionCallback;
+                    taskToExecute = std::move(taskToExecute.pTaskCompletionCallback->CompletionTask);
+                    m_CompletionCallbackPool.Release(callbackMemPtr);
+                    continue;
+                }
+            }
+
+            // No completion task to run, fetch another task or sleep
+            break;
+        }
+    }
+
+    // Queues tasks working on the given nodes, callerChunks is the number of threads that will work on the node outside of the pool
+    void TaskManager::DispatchNodes(TaskGraph::Node** ppNodes, uint32_t count, uint32_t callerChunks)
+    {
+        Worker*   pWorker = GetCurrentWorker();
+        TaskNode* taskNodes[s_DispatchBatchSize];
+        uint32_t  taskCount = 0;
+
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            TaskGraph::Node* pNode = ppNodes[i];
+
+            // Empty parallel fors are done right away
+            if (!pNode->ChunkCount)
+            {
+                pNode->StartTime = GetTimeNs();
+                CompleteNode(pNode);
+                continue;
             }
 
-            while (taskToExecute.pTaskFunction)
+            // Chunks are claimed by whoever gets to them first, so there's no point in more tasks than threads.
+            // Without workers, nothing would ever run the tasks and release their graph reference
+            uint32_t poolThreads = GetThreadCount();
+            uint32_t nodeTasks   = std::min(pNode->ChunkCount > callerChunks ? pNode->ChunkCount - callerChunks : 0, poolThreads);
+
+            // Every task keeps the graph alive, even if it only starts after all chunks were claimed
+            pNode->pGraph->m_RefCount += nodeTasks;
+
+            for (uint32_t t = 0; t < nodeTasks; ++t)
             {
-                // Execute the task
-                taskToExecute.pTaskFunction(taskToExecute.pTaskParam);
+                TaskNode* pTaskNode = pWorker ? AllocateNode(pWorker) : AllocateNodeShared();
+                pTaskNode->NodeTask = Task([this](void* pParam) { RunNode(static_cast<TaskGraph::Node*>(pParam)); }, pNode);
 
-                // When we are done, if there was a completion callback, tick it down and execute if needed
-                if (taskToExecute.pTaskCompletionCallback)
+                taskNodes[taskCount++] = pTaskNode;
+                if (taskCount == s_DispatchBatchSize)
                 {
-                    // If this was the last task on which we were waiting, execute the completion task now
-                    if (--taskToExecute.pTaskCompletionCallback->TaskCount == 0)
-                    {
-                        auto callbackMemPtr = taskToExecute.pTaskCompletionCallback;
-                        taskToExecute = taskToExecute.pTaskCompletionCallback->CompletionTask;
-                        delete callbackMemPtr;
-                        continue;
-                    }
+                    SubmitNodes(taskNodes, taskCount);
+                    taskCount = 0;
                 }
+            }
+        }
 
-                // No completion task to run, fetch another task or sleep
+        if (taskCount)
+            SubmitNodes(taskNodes, taskCount);
+    }
+
+    void TaskManager::RunNode(TaskGraph::Node* pNode)
+    {
+        // The node may be recycled as soon as the reference is released
+        TaskGraph* pGraph = pNode->pGraph;
+        RunNodeChunks(pNode);
+        ReleaseGraph(pGraph);
+    }
+
+    // Claims and runs chunks until none are left, returns true if this call finished the node
+    bool TaskManager::RunNodeChunks(TaskGraph::Node* pNode)
+    {
+        uint32_t completedChunks = 0;
+        while (true)
+        {
+            uint32_t chunk = pNode->NextChunk.fetch_add(1);
+            if (chunk >= pNode->ChunkCount)
                 break;
+
+            int64_t expectedStart = 0;
+            pNode->StartTime.compare_exchange_strong(expectedStart, GetTimeNs());
+
+            if (pNode->IsParallelFor)
+            {
+                uint32_t begin = chunk * pNode->ChunkSize;
+                uint32_t end   = std::min(begin + pNode->ChunkSize, pNode->Count);
+                for (uint32_t index = begin; index < end; ++index)
+                    pNode->ForFunction(index, pNode->pParam);
+            }
+            else if (pNode->TaskFunction)
+            {
+                pNode->TaskFunction(pNode->pParam);
+            }
+
+            ++completedChunks;
+        }
+
+        if (completedChunks && pNode->CompletedChunks.fetch_add(completedChunks) + completedChunks == pNode->ChunkCount)
+        {
+            CompleteNode(pNode);
+            return true;
+        }
+        return false;
+    }
+
+    void TaskManager::CompleteNode(TaskGraph::Node* pNode)
+    {
+        pNode->EndTime = GetTimeNs();
+
+        // Dispatch all successors this node was the last dependency of
+        TaskGraph*       pGraph = pNode->pGraph;
+        TaskGraph::Node* readyNodes[s_DispatchBatchSize];
+        uint32_t         readyCount = 0;
+        for (TaskGraph::NodeID successor : pNode->Successors)
+        {
+            TaskGraph::Node* pSuccessor = pGraph->m_Nodes[successor];
+            if (pSuccessor->PendingDependencies.fetch_sub(1) != 1)
+                continue;
+
+            readyNodes[readyCount++] = pSuccessor;
+            if (readyCount == s_DispatchBatchSize)
+            {
+                DispatchNodes(readyNodes, readyCount, 0);
+                readyCount = 0;
             }
         }
+        if (readyCount)
+            DispatchNodes(readyNodes, readyCount, 0);
+
+        if (pGraph->m_RemainingNodes.fetch_sub(1) == 1)
+            CompleteGraph(pGraph);
+    }
+
+    void TaskManager::CompleteGraph(TaskGraph* pGraph)
+    {
+        if (pGraph->m_ReportCriticalPath)
+            ReportCriticalPath(pGraph);
+
+        {
+            std::unique_lock<std::mutex> lock(pGraph->m_CompleteMutex);
+            pGraph->m_Complete = true;
+            pGraph->m_CompleteCondition.notify_all();
+        }
+
+        // Drop the reference held while executing
+        ReleaseGraph(pGraph);
+    }
+
+    void TaskManager::ReleaseGraph(TaskGraph* pGraph)
+    {
+        if (pGraph->m_RefCount.fetch_sub(1) != 1)
+            return;
+
+        // Drop the callables right away so nothing they captured outlives the graph
+        for (TaskGraph::Node* pNode : pGraph->m_Nodes)
+        {
+            pNode->TaskFunction = nullptr;
+            pNode->ForFunction  = nullptr;
+            m_GraphNodePool.Release(pNode);
+        }
+        pGraph->m_Nodes.clear();
+        m_GraphPool.Release(pGraph);
+    }
+
+    void TaskManager::ReportCriticalPath(TaskGraph* pGraph)
+    {
+        // Dependencies always come before the nodes depending on them, so one pass in order finds the longest chain
+        const std::vector<TaskGraph::Node*>& nodes = pGraph->m_Nodes;
+        std::vector<int64_t>            pathEnd(nodes.size(), 0);
+        std::vector<int64_t>            longestDependency(nodes.size(), 0);
+        std::vector<TaskGraph::NodeID>  previous(nodes.size(), TaskGraph::InvalidNode);
+
+        TaskGraph::NodeID last      = 0;
+        int64_t           graphEnd  = pGraph->m_SubmitTime;
+        for (TaskGraph::NodeID i = 0; i < nodes.size(); ++i)
+        {
+            pathEnd[i] = longestDependency[i] + (nodes[i]->EndTime - nodes[i]->StartTime);
+            for (TaskGraph::NodeID successor : nodes[i]->Successors)
+            {
+                if (pathEnd[i] > longestDependency[successor])
+                {
+                    longestDependency[successor] = pathEnd[i];
+                    previous[successor]          = i;
+                }
+            }
+
+            if (pathEnd[i] > pathEnd[last])
+                last = i;
+            graphEnd = std::max(graphEnd, nodes[i]->EndTime);
+        }
+
+        std::wstring path;
+        for (TaskGraph::NodeID node = last; node != TaskGraph::InvalidNode; node = previous[node])
+        {
+            wchar_t entry[256];
+            swprintf(entry, 256, L"%ls (%.2f ms)%ls", nodes[node]->pName, (nodes[node]->EndTime - nodes[node]->StartTime) * 1e-6f, path.empty() ? L"" : L" -> ");
+            path.insert(0, entry);
+        }
+
+        Log::Write(LOGLEVEL_TRACE, L"Task graph %ls took %.2f ms, critical path %.2f ms: %ls", pGraph->m_pName, (graphEnd - pGraph->m_SubmitTime) * 1e-6f, pathEnd[last] * 1e-6f, path.c_str());
+    }
+
+    TaskManager::TaskNode* TaskManager::AllocateNode(Worker* pWorker)
+    {
+        if (!pWorker->pFreeNodes)
+        {
+            // Refill the local free list with a batch from the shared one
+            std::unique_lock<std::mutex> lock(m_NodePoolMutex);
+            for (uint32_t i = 0; i < s_NodeBatchSize; ++i)
+            {
+                if (!m_pFreeNodes)
+                    AllocateNodeChunk();
+
+                TaskNode* pNode     = m_pFreeNodes;
+                m_pFreeNodes        = pNode->pNext;
+                pNode->pNext        = pWorker->pFreeNodes;
+                pWorker->pFreeNodes = pNode;
+            }
+            pWorker->FreeNodeCount = s_NodeBatchSize;
+        }
+
+        TaskNode* pNode     = pWorker->pFreeNodes;
+        pWorker->pFreeNodes = pNode->pNext;
+        --pWorker->FreeNodeCount;
+        pNode->pNext = nullptr;
+        return pNode;
+    }
+
+    void TaskManager::FreeNode(Worker* pWorker, TaskNode* pNode)
+    {
+        pNode->pNext        = pWorker->pFreeNodes;
+        pWorker->pFreeNodes = pNode;
+        ++pWorker->FreeNodeCount;
+
+        // Nodes allocated by other threads come back to the worker that ran them, return the surplus
+        if (pWorker->FreeNodeCount > s_MaxLocalFreeNodes)
+        {
+            std::unique_lock<std::mutex> lock(m_NodePoolMutex);
+            for (uint32_t i = 0; i < s_NodeBatchSize; ++i)
+            {
+                TaskNode* pReturnedNode = pWorker->pFreeNodes;
+                pWorker->pFreeNodes     = pReturnedNode->pNext;
+                pReturnedNode->pNext    = m_pFreeNodes;
+                m_pFreeNodes            = pReturnedNode;
+            }
+            pWorker->FreeNodeCount -= s_NodeBatchSize;
+        }
+    }
+
+    TaskManager::TaskNode* TaskManager::AllocateNodeShared()
+    {
+        std::unique_lock<std::mutex> lock(m_NodePoolMutex);
+        if (!m_pFreeNodes)
+            AllocateNodeChunk();
+
+        TaskNode* pNode = m_pFreeNodes;
+        m_pFreeNodes    = pNode->pNext;
+        pNode->pNext    = nullptr;
+        return pNode;
+    }
+
+    // Expects m_NodePoolMutex to be held
+    void TaskManager::AllocateNodeChunk()
+    {
+        m_NodeChunks.push_back(std::unique_ptr<TaskNode[]>(new TaskNode[s_NodeChunkSize]));
+        TaskNode* pChunk = m_NodeChunks.back().get();
+        for (uint32_t i = 0; i < s_NodeChunkSize; ++i)
+        {
+            pChunk[i].pNext = m_pFreeNodes;
+            m_pFreeNodes    = &pChunk[i];
+        }
     }
 
 } // namespace cauldron
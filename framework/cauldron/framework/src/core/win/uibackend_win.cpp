@@ -83,7 +83,7 @@ namespace cauldron
         // Load font to use (handled on a background thread)
         std::function<void(void*)> loadFont = [this](void*) { this->LoadUIFont(); };
         std::function<void(void*)> loadCompleteCallback = [this](void*) { this->UIFontLoadComplete(); };
-        TaskCompletionCallback* pCompletionCallback = new TaskCompletionCallback(Task(loadCompleteCallback));
+        TaskCompletionCallback* pCompletionCallback = GetTaskManager()->CreateCompletionCallback(Task(loadCompleteCallback));
         Task fontLoadTask(loadFont, nullptr, pCompletionCallback);
         GetTaskManager()->AddTask(fontLoadTask);
     }
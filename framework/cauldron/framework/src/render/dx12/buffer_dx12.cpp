@@ -49,6 +49,11 @@ namespace cauldron
         return new BufferInternal(pDesc, initialState, fn, customOwner);
     }
 
+    static D3D12_HEAP_TYPE GetHeapType(ResourceFlags flags)
+    {
+        return static_cast<bool>(flags & ResourceFlags::ReadbackBuffer) ? D3D12_HEAP_TYPE_READBACK : D3D12_HEAP_TYPE_DEFAULT;
+    }
+
     BufferInternal::BufferInternal(const BufferDesc* pDesc, ResourceState initialState, ResizeFunction fn, void* customOwner) :
         Buffer(pDesc, fn)
     {
@@ -62,7 +67,7 @@ namespace cauldron
             initParams.type = GPUResourceType::BufferBreadcrumbs;
         else
         {
-            initParams.heapType = D3D12_HEAP_TYPE_DEFAULT;
+            initParams.heapType = GetHeapType(pDesc->Flags);
             initParams.type = GPUResourceType::Buffer;
             customOwner = this;
         }
@@ -133,6 +138,23 @@ namespace cauldron
         ResourceBarrier(pUploadContext->GetImpl()->GetTransitionCmdList(), 1, &barrier);
     }
 
+    void BufferInternal::ReadData(void* pData, size_t size)
+    {
+        CauldronAssert(ASSERT_CRITICAL, static_cast<bool>(m_BufferDesc.Flags & ResourceFlags::ReadbackBuffer), L"Buffer %ls isn't a readback buffer", m_BufferDesc.Name.c_str());
+        CauldronAssert(ASSERT_CRITICAL, size <= m_BufferDesc.Size, L"Reading past the end of buffer %ls", m_BufferDesc.Name.c_str());
+
+        ID3D12Resource* pResource = m_pResource->GetImpl()->DX12Resource();
+
+        void*       pMapped   = nullptr;
+        D3D12_RANGE readRange = {0, size};
+        CauldronThrowOnFail(pResource->Map(0, &readRange, &pMapped));
+        memcpy(pData, pMapped, size);
+
+        // Nothing was written
+        D3D12_RANGE writtenRange = {0, 0};
+        pResource->Unmap(0, &writtenRange);
+    }
+
     BufferAddressInfo BufferInternal::GetAddressInfo() const
     {
         return addressInfo;
@@ -152,7 +174,7 @@ namespace cauldron
         CD3DX12_RESOURCE_DESC ResourceDesc = CreateResourceDesc(m_BufferDesc);
 
         // Recreate the resource
-        m_pResource->GetImpl()->RecreateResource(ResourceDesc, D3D12_HEAP_TYPE_DEFAULT, m_pResource->GetCurrentResourceState());
+        m_pResource->GetImpl()->RecreateResource(ResourceDesc, GetHeapType(m_BufferDesc.Flags), m_pResource->GetCurrentResourceState());
         InitAddressInfo();
     }
 
@@ -63,6 +63,7 @@ namespace cauldron
 
         virtual void CopyData(const void* pData, size_t size) override;
         virtual void CopyData(const void* pData, size_t size, UploadContext* pUploadCtx, ResourceState postCopyState) override;
+        virtual void ReadData(void* pData, size_t size) override;
         virtual BufferAddressInfo GetAddressInfo()const override;
 
     private:
@@ -70,7 +70,7 @@ namespace cauldron
         else
         {
             initParams.type = GPUResourceType::Buffer;
-            initParams.memoryUsage = VMA_MEMORY_USAGE_GPU_ONLY;
+            initParams.memoryUsage = static_cast<bool>(pDesc->Flags & ResourceFlags::ReadbackBuffer) ? VMA_MEMORY_USAGE_GPU_TO_CPU : VMA_MEMORY_USAGE_GPU_ONLY;
             customOwner = this;
         }
 
@@ -263,6 +263,25 @@ namespace cauldron
         pUploadContext->GetImpl()->HasGraphicsCmdList() = true;
     }
 
+    void BufferInternal::ReadData(void* pData, size_t size)
+    {
+        CauldronAssert(ASSERT_CRITICAL, static_cast<bool>(m_BufferDesc.Flags & ResourceFlags::ReadbackBuffer), L"Buffer %ls isn't a readback buffer", m_BufferDesc.Name.c_str());
+        CauldronAssert(ASSERT_CRITICAL, size <= m_BufferDesc.Size, L"Reading past the end of buffer %ls", m_BufferDesc.Name.c_str());
+
+        VmaAllocator  allocator  = GetDevice()->GetImpl()->GetVmaAllocator();
+        VmaAllocation allocation = m_pResource->GetImpl()->VKAllocation();
+
+        void*    pMapped = nullptr;
+        VkResult res     = vmaMapMemory(allocator, allocation, &pMapped);
+        CauldronAssert(ASSERT_CRITICAL, res == VK_SUCCESS, L"Cannot map readback buffer %ls", m_BufferDesc.Name.c_str());
+
+        // The memory may not be host coherent
+        vmaInvalidateAllocation(allocator, allocation, 0, static_cast<VkDeviceSize>(size));
+        memcpy(pData, pMapped, size);
+
+        vmaUnmapMemory(allocator, allocation);
+    }
+
     BufferAddressInfo BufferInternal::GetAddressInfo() const
     {
         BufferAddressInfo addressInfo;
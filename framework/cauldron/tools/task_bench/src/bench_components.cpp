@@ -0,0 +1,233 @@
+// This file is part of the FidelityFX SDK.
+//
+// Copyright (C) 2024 Advanced Micro Devices, Inc.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "core/taskmanager.h"
+#include "task_bench.h"
+
+#include <cmath>
+#include <cstdio>
+#include <functional>
+#include <thread>
+
+using namespace cauldron;
+
+namespace
+{
+    // Same minimum chunk as ComponentMgr::ForEachComponent
+    constexpr uint32_t MinComponentsPerTask = 32;
+
+    struct Matrix
+    {
+        float m[16];
+    };
+
+    Matrix Multiply(const Matrix& a, const Matrix& b)
+    {
+        Matrix result;
+        for (int row = 0; row < 4; ++row)
+        {
+            for (int column = 0; column < 4; ++column)
+            {
+                float sum = 0;
+                for (int k = 0; k < 4; ++k)
+                    sum += a.m[row * 4 + k] * b.m[k * 4 + column];
+                result.m[row * 4 + column] = sum;
+            }
+        }
+        return result;
+    }
+
+    struct Joint
+    {
+        int32_t Parent;
+        Matrix  Local;
+        Matrix  Global;
+        Matrix  Previous;
+        Matrix  Skin;
+        Matrix  InverseBind;
+    };
+
+    // Characters made of binary trees of joints, updated in the three passes AnimationComponentMgr runs:
+    // local transforms, global transforms one hierarchy level at a time, and skinning matrices
+    class SkinnedScene
+    {
+    public:
+        SkinnedScene(uint32_t characters, uint32_t jointsPerCharacter) : m_Joints(characters * jointsPerCharacter)
+        {
+            const Matrix identity = {{1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1}};
+
+            std::vector<uint32_t> depth(m_Joints.size());
+            uint32_t              levels = 0;
+            for (uint32_t i = 0; i < m_Joints.size(); ++i)
+            {
+                uint32_t joint     = i % jointsPerCharacter;
+                Joint&   current   = m_Joints[i];
+                current.Parent      = joint ? static_cast<int32_t>(i - joint + (joint - 1) / 2) : -1;
+                current.InverseBind = identity;
+                current.Global      = identity;
+
+                depth[i] = current.Parent < 0 ? 0 : depth[current.Parent] + 1;
+                levels   = std::max(levels, depth[i] + 1);
+            }
+
+            // Joints sorted by level, a level only depends on the ones before it
+            m_LevelStarts.assign(levels + 1, 0);
+            for (uint32_t level : depth)
+                ++m_LevelStarts[level + 1];
+            for (uint32_t level = 0; level < levels; ++level)
+                m_LevelStarts[level + 1] += m_LevelStarts[level];
+
+            std::vector<uint32_t> next(m_LevelStarts.begin(), m_LevelStarts.end() - 1);
+            m_Order.resize(m_Joints.size());
+            for (uint32_t i = 0; i < m_Joints.size(); ++i)
+                m_Order[next[depth[i]]++] = i;
+        }
+
+        size_t   GetJointCount() const { return m_Joints.size(); }
+        uint32_t GetLevelCount() const { return static_cast<uint32_t>(m_LevelStarts.size() - 1); }
+
+        void Update(TaskManager* pTaskManager, float time)
+        {
+            ForEach(pTaskManager, 0, static_cast<uint32_t>(m_Joints.size()), [this, time](uint32_t index) {
+                float angle = time + index * .01f;
+                float s     = std::sin(angle);
+                float c     = std::cos(angle);
+                m_Joints[index].Local = {{c, -s, 0, 0, s, c, 0, 0, 0, 0, 1, 0, .1f, 0, 0, 1}};
+            });
+
+            for (uint32_t level = 0; level < GetLevelCount(); ++level)
+            {
+                ForEach(pTaskManager, m_LevelStarts[level], m_LevelStarts[level + 1], [this](uint32_t index) {
+                    Joint& joint   = m_Joints[m_Order[index]];
+                    joint.Previous = joint.Global;
+                    joint.Global   = joint.Parent < 0 ? joint.Local : Multiply(m_Joints[joint.Parent].Global, joint.Local);
+                });
+            }
+
+            ForEach(pTaskManager, 0, static_cast<uint32_t>(m_Joints.size()), [this](uint32_t index) {
+                m_Joints[index].Skin = Multiply(m_Joints[index].Global, m_Joints[index].InverseBind);
+            });
+        }
+
+    private:
+        void ForEach(TaskManager* pTaskManager, uint32_t begin, uint32_t end, const std::function<void(uint32_t)>& updateFunc)
+        {
+            if (!pTaskManager || end - begin <= MinComponentsPerTask)
+            {
+                for (uint32_t index = begin; index < end; ++index)
+                    updateFunc(index);
+                return;
+            }
+
+            pTaskManager->ParallelFor(end - begin, [begin, &updateFunc](uint32_t index, void*) { updateFunc(begin + index); }, nullptr, MinComponentsPerTask);
+        }
+
+        std::vector<Joint>    m_Joints;
+        std::vector<uint32_t> m_LevelStarts;
+        std::vector<uint32_t> m_Order;
+    };
+}
+
+// Times a frame of component updates on a scene of animated characters, serially like ParallelComponentUpdates = false
+// and through a per-frame task graph with 0 to N worker threads like ParallelComponentUpdates = true
+int BenchComponents(int argc, char** argv)
+{
+    int32_t characters = 256;
+    int32_t joints     = 64;
+    int32_t frames     = 200;
+    int32_t threads    = static_cast<int32_t>(std::max(std::thread::hardware_concurrency(), 1u));
+
+    for (int arg = 0; arg < argc; arg++)
+    {
+        const char* value = nullptr;
+        if (ParseOption(argv[arg], "-characters=", &value))
+            characters = atoi(value);
+        else if (ParseOption(argv[arg], "-joints=", &value))
+            joints = atoi(value);
+        else if (ParseOption(argv[arg], "-frames=", &value))
+            frames = atoi(value);
+        else if (ParseOption(argv[arg], "-threads=", &value))
+            threads = atoi(value);
+        else
+        {
+            fprintf(stderr, "Unknown option \"%s\"!\n", argv[arg]);
+            return 1;
+        }
+    }
+
+    if (characters <= 0 || joints <= 0 || frames <= 0 || threads <= 0)
+    {
+        fprintf(stderr, "Invalid character count, joint count, frame count or thread count!\n");
+        return 1;
+    }
+
+    SkinnedScene scene(characters, joints);
+    printf("Scene:       %zu joints in %u levels\n", scene.GetJointCount(), scene.GetLevelCount());
+
+    // -1 updates serially on the main thread, without any task manager
+    for (int32_t workers = -1; workers <= threads; workers = workers < 1 ? workers + 1 : (workers < threads ? std::min(workers * 2, threads) : threads + 1))
+    {
+        TaskManager  taskManager;
+        TaskManager* pTaskManager = workers >= 0 ? &taskManager : nullptr;
+        if (pTaskManager)
+            taskManager.Init(workers);
+
+        // The other managers are trivial, they only add the graph's dispatch overhead around the animation
+        float time  = 0;
+        auto  frame = [&]() {
+            time += 1 / 60.f;
+            if (!pTaskManager)
+            {
+                scene.Update(nullptr, time);
+                return;
+            }
+
+            TaskGraph*        pGraph    = taskManager.CreateTaskGraph(L"ComponentUpdates");
+            TaskGraph::NodeID animation = pGraph->AddTask(L"Animation", [&](void*) { scene.Update(pTaskManager, time); });
+            TaskGraph::NodeID mesh      = pGraph->AddTask(L"Mesh", [](void*) {});
+            pGraph->AddDependency(mesh, animation);
+            pGraph->AddTask(L"Lights", [](void*) {});
+            taskManager.Execute(pGraph);
+        };
+
+        for (int32_t warmup = 0; warmup < 10; ++warmup)
+            frame();
+
+        std::vector<double> frameMs;
+        for (int32_t i = 0; i < frames; ++i)
+        {
+            TaskBenchTimer timer;
+            frame();
+            frameMs.push_back(timer.GetMs());
+        }
+
+        if (pTaskManager)
+            taskManager.Shutdown();
+
+        if (workers < 0)
+            printf("Serial:      %.3f ms p50, %.3f ms p95\n", Percentile(frameMs, .5), Percentile(frameMs, .95));
+        else
+            printf("%2d workers:  %.3f ms p50, %.3f ms p95\n", workers, Percentile(frameMs, .5), Percentile(frameMs, .95));
+    }
+
+    return 0;
+}
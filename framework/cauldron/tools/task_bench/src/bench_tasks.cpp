@@ -0,0 +1,136 @@
+// This file is part of the FidelityFX SDK.
+//
+// Copyright (C) 2024 Advanced Micro Devices, Inc.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "core/taskmanager.h"
+#include "task_bench.h"
+
+#include <atomic>
+#include <cstdio>
+#include <thread>
+
+using namespace cauldron;
+
+namespace
+{
+    // Parents spawned per run, each adds ChildrenPerParent tasks from inside the pool
+    constexpr uint32_t ChildrenPerParent = 199;
+
+    void WaitFor(const std::atomic<uint32_t>& counter, uint32_t value)
+    {
+        while (counter.load(std::memory_order_acquire) < value)
+            std::this_thread::yield();
+    }
+
+    // Submits all tasks from the main thread in one list, like a content loader queuing its jobs
+    double RunInjected(TaskManager& taskManager, uint32_t taskCount)
+    {
+        std::atomic<uint32_t> done{0};
+        std::queue<Task>      tasks;
+
+        TaskBenchTimer timer;
+        for (uint32_t i = 0; i < taskCount; ++i)
+            tasks.push(Task([&done](void*) { done.fetch_add(1, std::memory_order_relaxed); }));
+        taskManager.AddTaskList(tasks);
+        WaitFor(done, taskCount);
+        return timer.GetMs();
+    }
+
+    // Every parent task adds its children from a worker, the completion callback fires once all parents ran
+    double RunSpawned(TaskManager& taskManager, uint32_t taskCount)
+    {
+        const uint32_t parentCount = std::max(taskCount / (ChildrenPerParent + 1), 1u);
+        const uint32_t total       = parentCount * (ChildrenPerParent + 1);
+
+        std::atomic<uint32_t> done{0};
+        std::atomic<uint32_t> finished{0};
+
+        TaskBenchTimer          timer;
+        TaskCompletionCallback* pCallback = taskManager.CreateCompletionCallback(Task([&finished](void*) { finished.store(1, std::memory_order_release); }), parentCount);
+        for (uint32_t i = 0; i < parentCount; ++i)
+        {
+            Task parent([&taskManager, &done](void*) {
+                for (uint32_t child = 0; child < ChildrenPerParent; ++child)
+                {
+                    Task childTask([&done](void*) { done.fetch_add(1, std::memory_order_relaxed); });
+                    taskManager.AddTask(childTask);
+                }
+                done.fetch_add(1, std::memory_order_relaxed);
+            }, nullptr, pCallback);
+            taskManager.AddTask(parent);
+        }
+        WaitFor(finished, 1);
+        WaitFor(done, total);
+        return timer.GetMs() * taskCount / total;
+    }
+}
+
+// Measures task throughput from 1 to N worker threads, doubling the thread count every step
+int BenchTasks(int argc, char** argv)
+{
+    int32_t tasks      = 200000;
+    int32_t threads    = static_cast<int32_t>(std::max(std::thread::hardware_concurrency(), 1u));
+    int32_t iterations = 5;
+
+    for (int arg = 0; arg < argc; arg++)
+    {
+        const char* value = nullptr;
+        if (ParseOption(argv[arg], "-tasks=", &value))
+            tasks = atoi(value);
+        else if (ParseOption(argv[arg], "-threads=", &value))
+            threads = atoi(value);
+        else if (ParseOption(argv[arg], "-iterations=", &value))
+            iterations = atoi(value);
+        else
+        {
+            fprintf(stderr, "Unknown option \"%s\"!\n", argv[arg]);
+            return 1;
+        }
+    }
+
+    if (tasks <= 0 || threads <= 0 || iterations <= 0)
+    {
+        fprintf(stderr, "Invalid task count, thread count or iteration count!\n");
+        return 1;
+    }
+
+    printf("Threads  Injected Mtasks/s  Spawned Mtasks/s  (p50 of %d runs of %d tasks)\n", iterations, tasks);
+    for (int32_t threadCount = 1;; threadCount = std::min(threadCount * 2, threads))
+    {
+        TaskManager taskManager;
+        taskManager.Init(threadCount);
+
+        std::vector<double> injectedMs;
+        std::vector<double> spawnedMs;
+        for (int32_t iteration = 0; iteration < iterations; iteration++)
+        {
+            injectedMs.push_back(RunInjected(taskManager, tasks));
+            spawnedMs.push_back(RunSpawned(taskManager, tasks));
+        }
+        taskManager.Shutdown();
+
+        printf("%7d  %17.2f  %16.2f\n", threadCount, tasks / Percentile(injectedMs, .5) * 1e-3, tasks / Percentile(spawnedMs, .5) * 1e-3);
+        if (threadCount == threads)
+            break;
+    }
+
+    return 0;
+}
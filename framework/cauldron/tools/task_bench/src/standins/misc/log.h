@@ -0,0 +1,44 @@
+// This file is part of the FidelityFX SDK.
+//
+// Copyright (C) 2024 Advanced Micro Devices, Inc.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#pragma once
+
+namespace cauldron
+{
+    enum LogLevel
+    {
+        LOGLEVEL_TRACE   = 0x1 << 0,
+        LOGLEVEL_DEBUG   = 0x1 << 1,
+        LOGLEVEL_INFO    = 0x1 << 2,
+        LOGLEVEL_WARNING = 0x1 << 3,
+        LOGLEVEL_ERROR   = 0x1 << 4,
+        LOGLEVEL_FATAL   = 0x1 << 5,
+    };
+
+    // Writes straight to stdout instead of the framework's log file
+    class Log
+    {
+    public:
+        static void Write(LogLevel level, const wchar_t* format, ...);
+    };
+
+} // namespace cauldron
@@ -0,0 +1,64 @@
+// This file is part of the FidelityFX SDK.
+//
+// Copyright (C) 2024 Advanced Micro Devices, Inc.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "core/contentmanager.h"
+#include "misc/assert.h"
+#include "misc/log.h"
+
+#include <cstdarg>
+#include <cstdio>
+#include <cstdlib>
+#include <cwchar>
+
+namespace cauldron
+{
+    ContentManager* GetContentManager()
+    {
+        static ContentManager contentManager;
+        return &contentManager;
+    }
+
+    void CauldronAssert(AssertLevel severity, bool condition, const wchar_t* format, ...)
+    {
+        if (condition)
+            return;
+
+        va_list args;
+        va_start(args, format);
+        vfwprintf(stderr, format, args);
+        va_end(args);
+        fwprintf(stderr, L"\n");
+
+        if (severity == ASSERT_CRITICAL)
+            abort();
+    }
+
+    void Log::Write(LogLevel level, const wchar_t* format, ...)
+    {
+        va_list args;
+        va_start(args, format);
+        vfwprintf(stdout, format, args);
+        va_end(args);
+        fwprintf(stdout, L"\n");
+    }
+
+} // namespace cauldron
@@ -0,0 +1,68 @@
+// This file is part of the FidelityFX SDK.
+//
+// Copyright (C) 2024 Advanced Micro Devices, Inc.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+// Headless benchmarks of the Cauldron task manager, runs without a device or window so the numbers quoted in
+// changes to the task manager can be reproduced on any machine.
+//
+// Usage: CauldronTaskBench <benchmark> [options]
+//
+// Benchmarks:
+//   tasks      tasks per second submitted from outside the pool and spawned from workers, from 1 to N threads
+//   components frame time of animated characters updated serially and through the per-frame component task graph
+
+#include <cstdio>
+#include <cstring>
+
+#include "task_bench.h"
+
+namespace
+{
+    struct TaskBenchmark
+    {
+        const char*   name;
+        const char*   options;
+        TaskBenchFunc func;
+    };
+
+    const TaskBenchmark Benchmarks[] =
+    {
+        {"tasks", "-tasks=<n> -threads=<n> -iterations=<n>", BenchTasks},
+        {"components", "-characters=<n> -joints=<n> -frames=<n> -threads=<n>", BenchComponents},
+    };
+}
+
+int main(int argc, char** argv)
+{
+    if (argc >= 2)
+    {
+        for (const TaskBenchmark& benchmark : Benchmarks)
+        {
+            if (strcmp(argv[1], benchmark.name) == 0)
+                return benchmark.func(argc - 2, argv + 2);
+        }
+    }
+
+    fprintf(stderr, "Usage: %s <benchmark> [options]\n", argv[0]);
+    for (const TaskBenchmark& benchmark : Benchmarks)
+        fprintf(stderr, "       %s %s %s\n", argv[0], benchmark.name, benchmark.options);
+    return 1;
+}
@@ -0,0 +1,67 @@
+// This file is part of the FidelityFX SDK.
+//
+// Copyright (C) 2024 Advanced Micro Devices, Inc.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+// Every benchmark parses its own options from argv and returns the process exit code
+using TaskBenchFunc = int (*)(int argc, char** argv);
+
+int BenchTasks(int argc, char** argv);
+int BenchComponents(int argc, char** argv);
+
+// Matches "-name=" options, value points behind the '='
+inline bool ParseOption(const char* arg, const char* name, const char** value)
+{
+    size_t length = strlen(name);
+    if (strncmp(arg, name, length) != 0)
+        return false;
+
+    *value = arg + length;
+    return true;
+}
+
+inline double Percentile(std::vector<double> values, double percentile)
+{
+    if (values.empty())
+        return 0;
+
+    std::sort(values.begin(), values.end());
+    size_t index = std::min(values.size() - 1, static_cast<size_t>(percentile * (values.size() - 1) + .5));
+    return values[index];
+}
+
+class TaskBenchTimer
+{
+public:
+    TaskBenchTimer() : m_Start(std::chrono::steady_clock::now()) {}
+
+    double GetMs() const { return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - m_Start).count(); }
+
+private:
+    std::chrono::steady_clock::time_point m_Start;
+};
@@ -218,6 +218,21 @@ void BreadcrumbsRenderModule::Execute(double deltaTime, cauldron::CommandList* p
 
 void BreadcrumbsRenderModule::ProcessDeviceRemovedEvent(void* data)
 {
+    // Binary snapshot is saved first since it only copies the markers, it can be decoded later with FidelityFX_BreadcrumbsDecoder
+    FfxBreadcrumbsSnapshot snapshot = {};
+    if (ffxBreadcrumbsSaveSnapshot((FfxBreadcrumbsContext*)data, &snapshot) == FFX_OK)
+    {
+        std::ofstream snapshotOut("breadcrumbs_sample_dumpfile.bin", std::ios::binary);
+        CauldronAssert(ASSERT_WARNING, snapshotOut.good(), L"Failed to create \"breadcrumbs_sample_dumpfile.bin\"!");
+
+        if (snapshotOut.good())
+        {
+            snapshotOut.write(static_cast<const char*>(snapshot.pBuffer), snapshot.bufferSize);
+            snapshotOut.close();
+        }
+        FFX_SAFE_FREE(snapshot.pBuffer, free);
+    }
+
     FfxBreadcrumbsMarkersStatus markerStatus = {};
     FfxErrorCode result = ffxBreadcrumbsPrintStatus((FfxBreadcrumbsContext*)data, &markerStatus);
     CauldronAssert(ASSERT_CRITICAL, result == FFX_OK, L"Failed to retrieve markers buffer!");
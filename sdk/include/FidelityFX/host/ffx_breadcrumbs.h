@@ -280,6 +280,27 @@ typedef struct FfxBreadcrumbsMarkersStatus
     char*                       pBuffer;                   ///< UTF-8 encoded buffer with log about markers execution. Have to be released with <c><i>FFX_FREE</i></c>.
 } FfxBreadcrumbsMarkersStatus;
 
+/// A structure containing binary snapshot of FidelityFX Breadcrumbs markers.
+///
+/// Snapshot holds everything needed to print the markers status later on, so it can be written
+/// to a file after a crash and decoded offline with <c><i>ffxBreadcrumbsPrintSnapshot()</i></c>.
+///
+/// @ingroup ffxBreadcrumbs
+typedef struct FfxBreadcrumbsSnapshot
+{
+    size_t                      bufferSize;                ///< Size of the snapshot buffer.
+    void*                       pBuffer;                   ///< Snapshot data. Have to be released with <c><i>FFX_FREE</i></c>.
+} FfxBreadcrumbsSnapshot;
+
+/// An enumeration of formats that Breadcrumbs snapshots can be printed in.
+///
+/// @ingroup ffxBreadcrumbs
+typedef enum FfxBreadcrumbsStatusFormat
+{
+    FFX_BREADCRUMBS_STATUS_FORMAT_TEXT,                    ///< Same tree as returned by <c><i>ffxBreadcrumbsPrintStatus()</i></c>.
+    FFX_BREADCRUMBS_STATUS_FORMAT_JSON,                    ///< Whole JSON tree of frames, command lists and markers, regardless of printing flags.
+} FfxBreadcrumbsStatusFormat;
+
 /// A structure encapsulating the FidelityFX Breadcrumbs context.
 ///
 /// This sets up an object which contains all persistent internal data and
@@ -367,6 +388,8 @@ FFX_API FfxErrorCode ffxBreadcrumbsStartFrame(FfxBreadcrumbsContext* pContext);
 /// Register new command list for current frame FidelityFX Breadcrumbs operations.
 /// 
 /// After call to <c><i>ffxBreadcrumbsStartFrame()</i></c> every previously used list has to be registered again.
+/// Markers of a single command list have to be recorded from one thread at a time, different lists can be recorded concurrently
+/// when <c><i>FFX_BREADCRUMBS_ENABLE_THREAD_SYNCHRONIZATION</i></c> is set.
 ///
 /// @param [in] pContext                A pointer to a <c><i>FfxBreadcrumbsContext</i></c> structure.
 /// @param [in] pCommandListDescription A pointer to a <c><i>FfxBreadcrumbsCommandListDescription</i></c> structure.
@@ -474,6 +497,51 @@ FFX_API FfxErrorCode ffxBreadcrumbsEndMarker(FfxBreadcrumbsContext* pContext, Ff
 /// @ingroup ffxBreadcrumbs
 FFX_API FfxErrorCode ffxBreadcrumbsPrintStatus(FfxBreadcrumbsContext* pContext, FfxBreadcrumbsMarkersStatus* pMarkersStatus);
 
+/// Save current FidelityFX Breadcrumbs markers into a binary snapshot.
+/// 
+/// After receiving device lost error on GPU you can use this method to copy markers out of the context with minimal amount of work,
+/// leaving decoding of them to <c><i>ffxBreadcrumbsPrintSnapshot()</i></c>, possibly in other process or on other machine.
+/// Should always be called from a single thread.
+///
+/// @param [in] pContext                A pointer to a <c><i>FfxBreadcrumbsContext</i></c> structure.
+/// @param [out] pSnapshot              Binary snapshot of Breadcrumbs markers.
+///
+/// @retval
+/// FFX_OK                              The operation completed successfully.
+/// @retval
+/// FFX_ERROR_INVALID_POINTER           The operation failed because either <c><i>pContext</i></c> or <c><i>pSnapshot</i></c> was <c><i>NULL</i></c>.
+/// @retval
+/// FFX_ERROR_OUT_OF_MEMORY             The operation failed because snapshot buffer could not be allocated.
+///
+/// @ingroup ffxBreadcrumbs
+FFX_API FfxErrorCode ffxBreadcrumbsSaveSnapshot(FfxBreadcrumbsContext* pContext, FfxBreadcrumbsSnapshot* pSnapshot);
+
+/// Print FidelityFX Breadcrumbs markers status from a binary snapshot.
+/// 
+/// Doesn't require Breadcrumbs context nor any GPU backend, snapshot contents are validated before printing
+/// so it's safe to use on snapshots loaded from files.
+///
+/// @param [in] pSnapshot               A pointer to a <c><i>FfxBreadcrumbsSnapshot</i></c> structure.
+/// @param [in] format                  Format of the printed status.
+/// @param [in] pAllocCallbacks         Callbacks used to allocate status buffer.
+/// @param [out] pMarkersStatus         Buffer with post-mortem log of Breadcrumbs markers.
+///
+/// @retval
+/// FFX_OK                              The operation completed successfully.
+/// @retval
+/// FFX_ERROR_INVALID_POINTER           The operation failed because either <c><i>pSnapshot</i></c>, its buffer, <c><i>pAllocCallbacks</i></c> or <c><i>pMarkersStatus</i></c> was <c><i>NULL</i></c>.
+/// @retval
+/// FFX_ERROR_INVALID_ALIGNMENT         The operation failed because snapshot buffer is not aligned to 8 bytes.
+/// @retval
+/// FFX_ERROR_INVALID_VERSION           The operation failed because snapshot has been saved with incompatible version of Breadcrumbs.
+/// @retval
+/// FFX_ERROR_MALFORMED_DATA            The operation failed because snapshot contents are incorrect.
+/// @retval
+/// FFX_ERROR_INVALID_ENUM              The operation failed because <c><i>format</i></c> is not supported.
+///
+/// @ingroup ffxBreadcrumbs
+FFX_API FfxErrorCode ffxBreadcrumbsPrintSnapshot(const FfxBreadcrumbsSnapshot* pSnapshot, FfxBreadcrumbsStatusFormat format, FfxAllocationCallbacks* pAllocCallbacks, FfxBreadcrumbsMarkersStatus* pMarkersStatus);
+
 /// Queries the effect version number.
 ///
 /// @returns
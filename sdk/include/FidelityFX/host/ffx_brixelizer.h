@@ -27,7 +27,7 @@
 /// The size of the context specified in 32bit values.
 ///
 /// @ingroup ffxBrixelizer
-#define FFX_BRIXELIZER_CONTEXT_SIZE            (5938838)
+#define FFX_BRIXELIZER_CONTEXT_SIZE            (7315098)
 
 /// The size of the update description specified in 32bit values.
 ///
@@ -890,7 +890,7 @@ typedef struct FfxResourceBinding
 {
     uint32_t    slotIndex;                      ///< The slot into which to bind the resource
     uint32_t    arrayIndex;                     ///< The resource offset for mip/array access
-    uint32_t    resourceIdentifier;             ///< A unique resource identifier representing an internal resource index
+    uint32_t    resourceIdentifier;             ///< A unique resource identifier representing an internal resource index, holds the FNV-1a hash of the bind point name until the effect resolves it
     wchar_t     name[FFX_RESOURCE_NAME_SIZE];   ///< A debug name to help track the resource binding
 }FfxResourceBinding;
 
@@ -1143,6 +1143,25 @@ typedef struct FfxGpuJobDescription{
 #undef POPULATE_SHADER_BLOB_FFX
 #endif // #if defined(POPULATE_SHADER_BLOB_FFX)
 
+/// Resource name hashes of a shader permutation, only permutation headers written by a FidelityFX_SC that is built from
+/// tools/ffx_shader_compiler have them. Without them the backends hash the resource names when creating the pipelines.
+///
+/// @ingroup SDKTypes
+#if defined(FFX_SC_RESOURCE_NAME_HASHES)
+#define FFX_SHADER_BLOB_NAME_HASHES(info, index, type) info[index].type##NameHashes
+#else
+#define FFX_SHADER_BLOB_NAME_HASHES(info, index, type) NULL
+#endif // #if defined(FFX_SC_RESOURCE_NAME_HASHES)
+
+/// Archive key of a shader permutation, only permutation headers written for a shader archive have it
+///
+/// @ingroup SDKTypes
+#if defined(FFX_SHADER_ARCHIVE)
+#define FFX_SHADER_BLOB_ARCHIVE_KEY(info, index) info[index].blobArchiveKey
+#else
+#define FFX_SHADER_BLOB_ARCHIVE_KEY(info, index) 0
+#endif // #if defined(FFX_SHADER_ARCHIVE)
+
 /// Macro definition to copy header shader blob information into its SDK structural representation
 ///
 /// @ingroup SDKTypes
@@ -1158,33 +1177,41 @@ typedef struct FfxGpuJobDescription{
         info[index].numSamplers,                     \
         info[index].numRTAccelerationStructures,     \
         info[index].constantBufferNames,             \
+        FFX_SHADER_BLOB_NAME_HASHES(info, index, constantBuffer), \
         info[index].constantBufferBindings,          \
         info[index].constantBufferCounts,            \
         info[index].constantBufferSpaces,            \
         info[index].srvTextureNames,                 \
+        FFX_SHADER_BLOB_NAME_HASHES(info, index, srvTexture), \
         info[index].srvTextureBindings,              \
         info[index].srvTextureCounts,                \
         info[index].srvTextureSpaces,                \
         info[index].uavTextureNames,                 \
+        FFX_SHADER_BLOB_NAME_HASHES(info, index, uavTexture), \
         info[index].uavTextureBindings,              \
         info[index].uavTextureCounts,                \
         info[index].uavTextureSpaces,                \
         info[index].srvBufferNames,                  \
+        FFX_SHADER_BLOB_NAME_HASHES(info, index, srvBuffer), \
         info[index].srvBufferBindings,               \
         info[index].srvBufferCounts,                 \
         info[index].srvBufferSpaces,                 \
         info[index].uavBufferNames,                  \
+        FFX_SHADER_BLOB_NAME_HASHES(info, index, uavBuffer), \
         info[index].uavBufferBindings,               \
         info[index].uavBufferCounts,                 \
         info[index].uavBufferSpaces,                 \
         info[index].samplerNames,                    \
+        FFX_SHADER_BLOB_NAME_HASHES(info, index, sampler), \
         info[index].samplerBindings,                 \
         info[index].samplerCounts,                   \
         info[index].samplerSpaces,                   \
         info[index].rtAccelerationStructureNames,    \
+        FFX_SHADER_BLOB_NAME_HASHES(info, index, rtAccelerationStructure), \
         info[index].rtAccelerationStructureBindings, \
         info[index].rtAccelerationStructureCounts,   \
-        info[index].rtAccelerationStructureSpaces    \
+        info[index].rtAccelerationStructureSpaces,   \
+        FFX_SHADER_BLOB_ARCHIVE_KEY(info, index)     \
     }
 
 /// A single shader blob and a description of its resources.
@@ -1205,46 +1232,55 @@ typedef struct FfxShaderBlob {
 
     // constant buffers
     const char** boundConstantBufferNames;
+    const uint32_t* boundConstantBufferNameHashes;      ///< Pointer to an array of FNV-1a hashes of the bound ConstantBuffer names, NULL if the backend hashes the names
     const uint32_t* boundConstantBuffers;               ///< Pointer to an array of bound ConstantBuffers.
     const uint32_t* boundConstantBufferCounts;          ///< Pointer to an array of bound ConstantBuffer resource counts
     const uint32_t* boundConstantBufferSpaces;          ///< Pointer to an array of bound ConstantBuffer resource spaces
 
     // srv textures
     const char** boundSRVTextureNames;
+    const uint32_t* boundSRVTextureNameHashes;          ///< Pointer to an array of FNV-1a hashes of the bound SRV texture names, NULL if the backend hashes the names
     const uint32_t* boundSRVTextures;                   ///< Pointer to an array of bound SRV resources.
     const uint32_t* boundSRVTextureCounts;              ///< Pointer to an array of bound SRV resource counts
     const uint32_t* boundSRVTextureSpaces;              ///< Pointer to an array of bound SRV resource spaces
 
     // uav textures
     const char** boundUAVTextureNames;
+    const uint32_t* boundUAVTextureNameHashes;          ///< Pointer to an array of FNV-1a hashes of the bound UAV texture names, NULL if the backend hashes the names
     const uint32_t* boundUAVTextures;                   ///< Pointer to an array of bound UAV texture resources.
     const uint32_t* boundUAVTextureCounts;              ///< Pointer to an array of bound UAV texture resource counts
     const uint32_t* boundUAVTextureSpaces;              ///< Pointer to an array of bound UAV texture resource spaces
 
     // srv buffers
     const char** boundSRVBufferNames;
+    const uint32_t* boundSRVBufferNameHashes;           ///< Pointer to an array of FNV-1a hashes of the bound SRV buffer names, NULL if the backend hashes the names
     const uint32_t* boundSRVBuffers;                    ///< Pointer to an array of bound SRV buffer resources.
     const uint32_t* boundSRVBufferCounts;               ///< Pointer to an array of bound SRV buffer resource counts
     const uint32_t* boundSRVBufferSpaces;               ///< Pointer to an array of bound SRV buffer resource spaces
 
     // uav buffers
     const char** boundUAVBufferNames;
+    const uint32_t* boundUAVBufferNameHashes;           ///< Pointer to an array of FNV-1a hashes of the bound UAV buffer names, NULL if the backend hashes the names
     const uint32_t* boundUAVBuffers;                    ///< Pointer to an array of bound UAV buffer resources.
     const uint32_t* boundUAVBufferCounts;               ///< Pointer to an array of bound UAV buffer resource counts
     const uint32_t* boundUAVBufferSpaces;               ///< Pointer to an array of bound UAV buffer resource spaces
 
     // samplers
     const char** boundSamplerNames;
+    const uint32_t* boundSamplerNameHashes;             ///< Pointer to an array of FNV-1a hashes of the bound sampler names, NULL if the backend hashes the names
     const uint32_t* boundSamplers;                      ///< Pointer to an array of bound sampler resources.
     const uint32_t* boundSamplerCounts;                 ///< Pointer to an array of bound sampler resource counts
     const uint32_t* boundSamplerSpaces;                 ///< Pointer to an array of bound sampler resource spaces
 
     // rt acceleration structures
     const char** boundRTAccelerationStructureNames;
+    const uint32_t* boundRTAccelerationStructureNameHashes; ///< Pointer to an array of FNV-1a hashes of the bound RT acceleration structure names, NULL if the backend hashes the names
     const uint32_t* boundRTAccelerationStructures;      ///< Pointer to an array of bound UAV buffer resources.
     const uint32_t* boundRTAccelerationStructureCounts; ///< Pointer to an array of bound UAV buffer resource counts
     const uint32_t* boundRTAccelerationStructureSpaces; ///< Pointer to an array of bound UAV buffer resource spaces
 
+    const uint64_t archiveKey;                          ///< Key of the blob in the shader archive, 0 if the blob data is embedded. Archived blobs get their data on first request.
+
 } FfxShaderBlob;
 
 /// A structure describing the parameters passed from the
@@ -1291,7 +1327,7 @@ typedef struct FfxSwapchainFramePacingTuning
     float    safetyMarginInMs; // in Millisecond
     float    varianceFactor; // valid range [0.0,1.0]
     bool     allowHybridSpin; //Allows pacing spinlock to sleep.
-    uint32_t hybridSpinTime;  //How long to spin when hybridSpin is enabled. Measured in timer resolution units. Not recommended to go below 2. Will result in frequent overshoots.
+    uint32_t hybridSpinTime;  //How long to spin when hybridSpin is enabled. Measured in timer resolution units. Not recommended to go below 2. Will result in frequent overshoots. Only the initial value, the spin time is calibrated to the measured sleep overshoot at runtime.
     bool     allowWaitForSingleObjectOnFence; //Allows to call WaitForSingleObject() instead of spinning for fence value.
 } FfxSwapchainFramePacingTuning;
 
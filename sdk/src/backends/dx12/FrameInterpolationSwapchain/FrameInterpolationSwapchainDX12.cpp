@@ -408,6 +408,17 @@ void presentToSwapChain(FrameinterpolationPresentInfo* presenter, PacingData* pa
 
 }
 
+struct SwapChainPresentSink : public FrameInterpolationPresentSink
+{
+    FrameinterpolationPresentInfo* presenter;
+    PacingData*                    pacingEntry;
+
+    void present(uint32_t frameType) override
+    {
+        presentToSwapChain(presenter, pacingEntry, (PacingData::FrameType)frameType);
+    }
+};
+
 DWORD WINAPI presenterThread(LPVOID param)
 {
     FrameinterpolationPresentInfo* presenter = static_cast<FrameinterpolationPresentInfo*>(param);
@@ -415,16 +426,6 @@ DWORD WINAPI presenterThread(LPVOID param)
     if (presenter)
     {
         UINT64 numFramesSentForPresentation = 0;
-        int64_t qpcFrequency                 = 0;
-
-        LARGE_INTEGER freq;
-        QueryPerformanceFrequency(&freq);
-        qpcFrequency = freq.QuadPart;
-
-        TIMECAPS timerCaps;
-        timerCaps.wPeriodMin = UNKNOWN_TIMER_RESOlUTION; //Default to unknown to prevent sleep without guarantees.
-
-        presenter->previousPresentQpc = 0;
 
         while (!presenter->shutdown)
         {
@@ -446,6 +447,10 @@ DWORD WINAPI presenterThread(LPVOID param)
                     presenter->presentQueue->Signal(presenter->presentFence, entry.numFramesSentForPresentationBase);
                     presenter->presentQueue->Wait(presenter->interpolationFence, entry.interpolationCompletedFenceValue);
 
+                    SwapChainPresentSink sink;
+                    sink.presenter   = presenter;
+                    sink.pacingEntry = &entry;
+
                     for (uint32_t frameType = 0; frameType < PacingData::FrameType::Count; frameType++)
                     {
                         const PacingData::FrameInfo& frameInfo = entry.frames[frameType];
@@ -459,27 +464,9 @@ DWORD WINAPI presenterThread(LPVOID param)
                                 presenter->presentQueue->Signal(presenter->replacementBufferFence, entry.replacementBufferFenceSignal);
                             }
 
-                            
-                            MMRESULT result = timeGetDevCaps(&timerCaps, sizeof(timerCaps));
-                            if (result != MMSYSERR_NOERROR || !presenter->allowHybridSpin)
-                            {
-                                timerCaps.wPeriodMin = UNKNOWN_TIMER_RESOlUTION;
-                            }
-                            else
-                            {
-                                timerCaps.wPeriodMin = FFX_MAXIMUM(1, timerCaps.wPeriodMin);
-                            }
-
                             // pacing without composition
                             waitForFenceValue(presenter->compositionFenceGPU, frameInfo.presentIndex);
-                            uint64_t targetQpc = presenter->previousPresentQpc + frameInfo.presentQpcDelta;
-                            waitForPerformanceCount(targetQpc, qpcFrequency, timerCaps.wPeriodMin, presenter->hybridSpinTime);
-
-                            int64_t currentPresentQPC;
-                            QueryPerformanceCounter(reinterpret_cast<LARGE_INTEGER*>(&currentPresentQPC));
-                            presenter->previousPresentQpc = currentPresentQPC;
-
-                            presentToSwapChain(presenter, &entry, (PacingData::FrameType)frameType);
+                            presenter->pacer.presentFrame(frameInfo.presentQpcDelta, sink, frameType);
                         }
                     }
 
@@ -501,6 +488,8 @@ DWORD WINAPI interpolationThread(LPVOID param)
 
     if (presenter)
     {
+        presenter->pacer.reset();
+
         HANDLE presenterThreadHandle = CreateThread(nullptr, 0, presenterThread, param, 0, nullptr);
         FFX_ASSERT(presenterThreadHandle != NULL);
 
@@ -509,13 +498,6 @@ DWORD WINAPI interpolationThread(LPVOID param)
             SetThreadPriority(presenterThreadHandle, THREAD_PRIORITY_HIGHEST);
             SetThreadDescription(presenterThreadHandle, L"AMD FSR Presenter Thread");
 
-            SimpleMovingAverage<10, double> frameTime{};
-
-            int64_t previousQpc = 0;
-            int64_t previousDelta = 0;
-            int64_t qpcFrequency;
-            QueryPerformanceFrequency(reinterpret_cast<LARGE_INTEGER*>(&qpcFrequency)); 
-
             while (!presenter->shutdown)
             {
                 WaitForSingleObject(presenter->presentEvent, INFINITE);
@@ -529,13 +511,8 @@ DWORD WINAPI interpolationThread(LPVOID param)
 
                     LeaveCriticalSection(&presenter->criticalSectionScheduledFrame);
                     
-                    int64_t preWaitQPC = 0;
-                    QueryPerformanceCounter(reinterpret_cast<LARGE_INTEGER*>(&preWaitQPC));
-                    int64_t previousPresentQPC = presenter->previousPresentQpc;
-                    int64_t targetDelta = (previousPresentQPC + previousDelta) - preWaitQPC;
-                    
                     //Risk of late wake if overthreading. If allowed, use WaitForSingleObject to wait for interpolationFence if the target is more than 2ms later.
-                    if (previousPresentQPC && (targetDelta * 1000000) / qpcFrequency > 2000)  
+                    if (presenter->pacer.getSecondsUntilNextPresent() > 0.002)
                     {
                         waitForFenceValue(
                             presenter->interpolationFence, 
@@ -560,31 +537,9 @@ DWORD WINAPI interpolationThread(LPVOID param)
                     
                     SetEvent(presenter->interpolationEvent);
 
-                    int64_t currentQpc = 0;
-                    QueryPerformanceCounter(reinterpret_cast<LARGE_INTEGER*>(&currentQpc));
-
-                    const double deltaQpc = double(currentQpc - previousQpc) * (previousQpc > 0);
-                    previousQpc           = currentQpc;
-
-                    // reset pacing averaging if delta > 10 fps,
-                    const float fTimeoutInSeconds       = 0.1f;
-                    double      deltaQpcResetThreashold = double(qpcFrequency * fTimeoutInSeconds);
-                    if ((deltaQpc > deltaQpcResetThreashold) || presenter->resetTimer)
-                    {
-                        frameTime.reset();
-                    }
-                    else
-                    {
-                        frameTime.update(deltaQpc);
-                    }
-
-                    // set presentation time: reduce based on variance and subract safety margin so we don't lock on a framerate lower than necessary
-                    int64_t qpcSafetyMargin         = int64_t(qpcFrequency * presenter->safetyMarginInSec);
-                    const int64_t conservativeAvg   = int64_t(frameTime.getAverage() * 0.5 - frameTime.getVariance() * presenter->varianceFactor);
-                    const int64_t deltaToUse        = conservativeAvg > qpcSafetyMargin ? (conservativeAvg - qpcSafetyMargin) : 0;
+                    const int64_t deltaToUse = presenter->pacer.scheduleFrame(presenter->resetTimer);
                     entry.frames[PacingData::FrameType::Interpolated_1].presentQpcDelta = deltaToUse;
                     entry.frames[PacingData::FrameType::Real].presentQpcDelta           = deltaToUse;
-                    previousDelta                                                       = deltaToUse;
                     
                     // schedule presents
                     EnterCriticalSection(&presenter->criticalSectionScheduledFrame);
@@ -1227,10 +1182,10 @@ void FrameInterpolationSwapChainDX12::setWaitCallback(FfxWaitCallbackFunc waitCa
 
 void FrameInterpolationSwapChainDX12::setFramePacingTuning(const FfxSwapchainFramePacingTuning* framePacingTuning)
 {
-    presentInfo.safetyMarginInSec = static_cast<double> (framePacingTuning->safetyMarginInMs) / 1000.0;
-    presentInfo.varianceFactor = static_cast<double> (framePacingTuning->varianceFactor);
-    presentInfo.allowHybridSpin = framePacingTuning->allowHybridSpin;
-    presentInfo.hybridSpinTime = framePacingTuning->hybridSpinTime;
+    presentInfo.pacer.safetyMarginInSec = static_cast<double> (framePacingTuning->safetyMarginInMs) / 1000.0;
+    presentInfo.pacer.varianceFactor = static_cast<double> (framePacingTuning->varianceFactor);
+    presentInfo.pacingClock.allowHybridSpin = framePacingTuning->allowHybridSpin;
+    presentInfo.pacingClock.hybridSpinTime = framePacingTuning->hybridSpinTime;
     presentInfo.allowWaitForSingleObjectOnFence = framePacingTuning->allowWaitForSingleObjectOnFence;
 }
 
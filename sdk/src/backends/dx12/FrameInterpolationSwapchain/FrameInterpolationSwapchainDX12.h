@@ -112,15 +112,12 @@ typedef struct FrameinterpolationPresentInfo
     volatile bool       resetTimer              = false;
     volatile bool       shutdown                = false;
 
-    volatile double     safetyMarginInSec       = 0.0001; //0.1ms
-    volatile double     varianceFactor          = 0.1;
-    volatile bool       allowHybridSpin         = false;
-    volatile uint32_t   hybridSpinTime          = 2; //Measured in system timer resolution units. Default is 2. Below 1 will frequently result in overshoot. Overshoots stop showing up >=2.
     volatile bool       allowWaitForSingleObjectOnFence = false;
     
     FfxWaitCallbackFunc waitCallback            = nullptr;
 
-    volatile int64_t    previousPresentQpc         = 0;
+    FrameInterpolationPreciseClock pacingClock;
+    FrameInterpolationPacer        pacer{ pacingClock };
 } FrameinterpolationPresentInfo;
 
 typedef struct ReplacementResource
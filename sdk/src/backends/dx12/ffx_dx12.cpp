@@ -27,6 +27,7 @@
 #include <FidelityFX/host/backends/dx12/d3dx12.h>
 #include <ffx_shader_blobs.h>
 #include <ffx_breadcrumbs_list.h>
+#include <ffx_resource_binding.h>
 #include <codecvt>  // convert string to wstring
 #include <memoryapi.h> // for VirtualAlloc
 #include <mutex>
@@ -2395,7 +2396,9 @@ FfxErrorCode CreatePipelineDX12(
     ID3D12Device* dx12Device = backendContext->device;
 
     FfxShaderBlob shaderBlob = { };
-    backendInterface->fpGetPermutationBlobByIndex(effect, pass, FFX_BIND_COMPUTE_SHADER_STAGE, permutationOptions, &shaderBlob);
+    const FfxErrorCode blobErrorCode = backendInterface->fpGetPermutationBlobByIndex(effect, pass, FFX_BIND_COMPUTE_SHADER_STAGE, permutationOptions, &shaderBlob);
+    if (blobErrorCode != FFX_OK)
+        return blobErrorCode;
     FFX_ASSERT(shaderBlob.data && shaderBlob.size);
 
     int32_t staticTextureSrvCount = 0;
@@ -2783,6 +2786,11 @@ FfxErrorCode CreatePipelineDX12(
 
             outPipeline->srvTextureBindings[bindingIndex].slotIndex  = slotIndex;
             outPipeline->srvTextureBindings[bindingIndex].arrayIndex = arrayIndex;
+            // the effect resolves the name hash to its resource identifier when patching the bindings, blobs written by older
+            // versions of FidelityFX_SC have no hashes
+            outPipeline->srvTextureBindings[bindingIndex].resourceIdentifier =
+                shaderBlob.boundSRVTextureNameHashes ? shaderBlob.boundSRVTextureNameHashes[srvIndex]
+                                                     : ffxGetResourceBindingNameHash(shaderBlob.boundSRVTextureNames[srvIndex]);
             MultiByteToWideChar(CP_UTF8,
                                 0,
                                 shaderBlob.boundSRVTextureNames[srvIndex],
@@ -2813,6 +2821,9 @@ FfxErrorCode CreatePipelineDX12(
 
             outPipeline->uavTextureBindings[bindingIndex].slotIndex  = slotIndex;
             outPipeline->uavTextureBindings[bindingIndex].arrayIndex = arrayIndex;
+            outPipeline->uavTextureBindings[bindingIndex].resourceIdentifier =
+                shaderBlob.boundUAVTextureNameHashes ? shaderBlob.boundUAVTextureNameHashes[uavIndex]
+                                                     : ffxGetResourceBindingNameHash(shaderBlob.boundUAVTextureNames[uavIndex]);
             MultiByteToWideChar(CP_UTF8,
                                 0,
                                 shaderBlob.boundUAVTextureNames[uavIndex],
@@ -2843,6 +2854,9 @@ FfxErrorCode CreatePipelineDX12(
 
             outPipeline->srvBufferBindings[bindingIndex].slotIndex  = slotIndex;
             outPipeline->srvBufferBindings[bindingIndex].arrayIndex = arrayIndex;
+            outPipeline->srvBufferBindings[bindingIndex].resourceIdentifier =
+                shaderBlob.boundSRVBufferNameHashes ? shaderBlob.boundSRVBufferNameHashes[srvIndex]
+                                                    : ffxGetResourceBindingNameHash(shaderBlob.boundSRVBufferNames[srvIndex]);
             MultiByteToWideChar(CP_UTF8,
                                 0,
                                 shaderBlob.boundSRVBufferNames[srvIndex],
@@ -2873,6 +2887,9 @@ FfxErrorCode CreatePipelineDX12(
 
             outPipeline->uavBufferBindings[bindingIndex].slotIndex  = slotIndex;
             outPipeline->uavBufferBindings[bindingIndex].arrayIndex = arrayIndex;
+            outPipeline->uavBufferBindings[bindingIndex].resourceIdentifier =
+                shaderBlob.boundUAVBufferNameHashes ? shaderBlob.boundUAVBufferNameHashes[uavIndex]
+                                                    : ffxGetResourceBindingNameHash(shaderBlob.boundUAVBufferNames[uavIndex]);
             MultiByteToWideChar(CP_UTF8,
                                 0,
                                 shaderBlob.boundUAVBufferNames[uavIndex],
@@ -2889,6 +2906,9 @@ FfxErrorCode CreatePipelineDX12(
     {
         outPipeline->constantBufferBindings[cbIndex].slotIndex  = shaderBlob.boundConstantBuffers[cbIndex];
         outPipeline->constantBufferBindings[cbIndex].arrayIndex = 1;
+        outPipeline->constantBufferBindings[cbIndex].resourceIdentifier =
+            shaderBlob.boundConstantBufferNameHashes ? shaderBlob.boundConstantBufferNameHashes[cbIndex]
+                                                     : ffxGetResourceBindingNameHash(shaderBlob.boundConstantBufferNames[cbIndex]);
         MultiByteToWideChar(CP_UTF8,
                             0,
                             shaderBlob.boundConstantBufferNames[cbIndex],
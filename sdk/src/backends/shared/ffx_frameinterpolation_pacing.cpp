@@ -0,0 +1,87 @@
+// This file is part of the FidelityFX SDK.
+//
+// Copyright (C) 2024 Advanced Micro Devices, Inc.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "ffx_frameinterpolation_pacing.h"
+
+FrameInterpolationPacer::FrameInterpolationPacer(FrameInterpolationPacingClock& clock)
+    : clock(clock)
+{
+}
+
+void FrameInterpolationPacer::reset()
+{
+    frameTime.reset();
+    previousFrameTicks   = 0;
+    previousPresentTicks = 0;
+    presentDelta         = 0;
+}
+
+int64_t FrameInterpolationPacer::scheduleFrame(bool resetHistory)
+{
+    const int64_t frequency    = clock.getFrequency();
+    const int64_t currentTicks = clock.getTicks();
+
+    const double deltaTicks = double(currentTicks - previousFrameTicks) * (previousFrameTicks > 0);
+    previousFrameTicks      = currentTicks;
+
+    // reset pacing averaging if delta > 10 fps,
+    const float fTimeoutInSeconds         = 0.1f;
+    double      deltaTicksResetThreashold = double(frequency * fTimeoutInSeconds);
+    if ((deltaTicks > deltaTicksResetThreashold) || resetHistory)
+    {
+        frameTime.reset();
+    }
+    else
+    {
+        frameTime.update(deltaTicks);
+    }
+
+    // set presentation time: reduce based on variance and subract safety margin so we don't lock on a framerate lower than necessary
+    int64_t       safetyMargin    = int64_t(frequency * safetyMarginInSec);
+    const double  percentile      = frameTimePercentile;
+    const int64_t conservativeAvg = percentile > 0.0 ? int64_t(frameTime.getPercentile(percentile) * 0.5)
+                                                     : int64_t(frameTime.getAverage() * 0.5 - frameTime.getVariance() * varianceFactor);
+    const int64_t deltaToUse      = conservativeAvg > safetyMargin ? (conservativeAvg - safetyMargin) : 0;
+
+    presentDelta = deltaToUse;
+
+    return deltaToUse;
+}
+
+void FrameInterpolationPacer::presentFrame(int64_t delta, FrameInterpolationPresentSink& sink, uint32_t frameType)
+{
+    clock.waitForTicks(previousPresentTicks + delta);
+    previousPresentTicks = clock.getTicks();
+
+    sink.present(frameType);
+}
+
+double FrameInterpolationPacer::getSecondsUntilNextPresent()
+{
+    const int64_t previousPresent = previousPresentTicks;
+    if (previousPresent == 0)
+        return 0.0;
+
+    const int64_t ticksLeft = previousPresent + presentDelta - clock.getTicks();
+
+    return ticksLeft > 0 ? double(ticksLeft) / double(clock.getFrequency()) : 0.0;
+}
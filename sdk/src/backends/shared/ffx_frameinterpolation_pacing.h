@@ -0,0 +1,275 @@
+// This file is part of the FidelityFX SDK.
+//
+// Copyright (C) 2024 Advanced Micro Devices, Inc.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#pragma once
+
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+
+#include "ffx_precise_wait.h"
+
+// Frame pacing of the frame interpolation swapchains. Every pacing decision is made here, the swapchains only
+// provide the time source and the present itself, so the same logic runs against a simulated clock off-device.
+
+// Time source of the pacer, in ticks of getFrequency() per second
+struct FrameInterpolationPacingClock
+{
+    virtual ~FrameInterpolationPacingClock()
+    {
+    }
+
+    virtual int64_t getFrequency() = 0;
+    virtual int64_t getTicks()     = 0;
+
+    // Returns once getTicks() has reached targetTicks
+    virtual void waitForTicks(int64_t targetTicks) = 0;
+};
+
+// Receives frames from the pacer once they are due
+struct FrameInterpolationPresentSink
+{
+    virtual ~FrameInterpolationPresentSink()
+    {
+    }
+
+    // frameType is the PacingData::FrameType of the swapchain
+    virtual void present(uint32_t frameType) = 0;
+};
+
+// Statistics over the last Size samples. Average and deviation are updated in constant time, the window is only
+// sorted when a percentile is requested and at most once per update.
+template <const int Size, typename Type = double>
+struct SlidingWindowStatistics
+{
+    Type         history[Size] = {};
+    Type         sorted[Size]  = {};
+    unsigned int idx           = 0;
+    unsigned int updateCount   = 0;
+    unsigned int sortedCount   = 0;  // updateCount the sorted copy was made at
+    Type         mean          = 0.0;
+    Type         m2            = 0.0;  // sum of squared deviations from mean
+
+    Type getAverage()
+    {
+        if (updateCount < Size)
+            return 0.0;
+
+        return mean;
+    }
+
+    // Standard deviation of the window
+    Type getVariance()
+    {
+        if (updateCount < Size)
+            return 0.0;
+
+        return sqrt((m2 > 0.0 ? m2 : 0.0) / Size);
+    }
+
+    // Linearly interpolated percentile of the window, percentile in [0,1]
+    Type getPercentile(double percentile)
+    {
+        if (updateCount < Size)
+            return 0.0;
+
+        if (sortedCount != updateCount)
+        {
+            for (unsigned int i = 0; i < Size; i++)
+            {
+                unsigned int position = i;
+                for (; position > 0 && sorted[position - 1] > history[i]; position--)
+                    sorted[position] = sorted[position - 1];
+                sorted[position] = history[i];
+            }
+            sortedCount = updateCount;
+        }
+
+        const double       position = (percentile < 0.0 ? 0.0 : percentile > 1.0 ? 1.0 : percentile) * (Size - 1);
+        const unsigned int lower    = static_cast<unsigned int>(position);
+        const unsigned int upper    = lower + 1 < Size ? lower + 1 : lower;
+
+        return sorted[lower] + (sorted[upper] - sorted[lower]) * Type(position - lower);
+    }
+
+    void reset()
+    {
+        updateCount = 0;
+        sortedCount = 0;
+        idx         = 0;
+        mean        = 0.0;
+        m2          = 0.0;
+    }
+
+    void update(Type newValue)
+    {
+        if (updateCount < Size)
+        {
+            const Type delta = newValue - mean;
+            mean += delta / (updateCount + 1);
+            m2 += delta * (newValue - mean);
+        }
+        else
+        {
+            const Type oldValue = history[idx];
+            const Type oldMean  = mean;
+            mean += (newValue - oldValue) / Size;
+            m2 += (newValue - oldValue) * (newValue - mean + oldValue - oldMean);
+        }
+
+        history[idx] = newValue;
+        idx          = (idx + 1) % Size;
+        updateCount++;
+
+        // recompute once per window so rounding errors of the running sums can't accumulate
+        if (idx == 0)
+        {
+            Type sum = 0.0;
+            for (unsigned int i = 0; i < Size; i++)
+                sum += history[i];
+            mean = sum / Size;
+
+            m2 = 0.0;
+            for (unsigned int i = 0; i < Size; i++)
+                m2 += (history[i] - mean) * (history[i] - mean);
+        }
+    }
+};
+
+// Spaces the interpolated and real frame of every game frame evenly. scheduleFrame is called on the interpolation
+// thread and presentFrame on the presenter thread, the tuning values may be written from any thread.
+class FrameInterpolationPacer
+{
+public:
+    explicit FrameInterpolationPacer(FrameInterpolationPacingClock& clock);
+
+    volatile double safetyMarginInSec = 0.0001; //0.1ms
+    volatile double varianceFactor    = 0.1;
+    // If above 0, the present delay is based on this percentile of recent frame times instead of their average minus
+    // varianceFactor standard deviations. Low percentiles pace conservatively, only that share of frames is faster.
+    volatile double frameTimePercentile = 0.0;
+
+    // Forgets the frame time history and the last present, call before the pacing threads start
+    void reset();
+
+    // Called once interpolation of a game frame completed, returns the delay between its presents in clock ticks
+    int64_t scheduleFrame(bool resetHistory);
+
+    // Waits until presentDelta ticks passed since the previous present, then hands the frame to the sink
+    void presentFrame(int64_t presentDelta, FrameInterpolationPresentSink& sink, uint32_t frameType);
+
+    // Time left until the next present is due with the last scheduled delay, 0 before the first present or if overdue
+    double getSecondsUntilNextPresent();
+
+    FrameInterpolationPacingClock& getClock()
+    {
+        return clock;
+    }
+
+private:
+    FrameInterpolationPacingClock&      clock;
+    SlidingWindowStatistics<10, double> frameTime{};
+    int64_t                             previousFrameTicks   = 0;
+    std::atomic<int64_t>                previousPresentTicks = {0};
+    std::atomic<int64_t>                presentDelta         = {0};
+};
+
+// Clock of the swapchains on the platform's high resolution timer
+class FrameInterpolationPreciseClock : public FrameInterpolationPacingClock
+{
+public:
+    volatile bool     allowHybridSpin = false;  // sleep through the bulk of a wait instead of spinning all of it
+    volatile uint32_t hybridSpinTime  = 2;      // initial spin time in timer resolution units, calibrated to the sleep overshoot later
+
+    int64_t getFrequency() override
+    {
+        return PreciseWaiter::getFrequency();
+    }
+
+    int64_t getTicks() override
+    {
+        return PreciseWaiter::getTicks();
+    }
+
+    void waitForTicks(int64_t targetTicks) override
+    {
+        const uint32_t spinTime = hybridSpinTime;
+        if (spinTime != appliedSpinTime)
+        {
+            waiter.setSpinMarginInSec(spinTime * PreciseWaiter::getTimerResolutionInSec());
+            appliedSpinTime = spinTime;
+        }
+
+        waiter.allowSleep = allowHybridSpin;
+        waiter.waitUntil(targetTicks);
+    }
+
+    PreciseWaiter& getWaiter()
+    {
+        return waiter;
+    }
+
+private:
+    PreciseWaiter waiter;
+    uint32_t      appliedSpinTime = 0;
+};
+
+// Clock that only moves when waited on or set, for replaying frame time traces without a display
+class FrameInterpolationSimulatedClock : public FrameInterpolationPacingClock
+{
+public:
+    // Starts at one second, the pacer treats a timestamp of 0 as "nothing happened yet"
+    explicit FrameInterpolationSimulatedClock(int64_t frequency = 10000000)
+        : frequency(frequency)
+        , ticks(frequency)
+    {
+    }
+
+    // Ticks every wait that has to block overshoots its target by, to model wake-up latency
+    int64_t wakeUpLatency = 0;
+
+    int64_t getFrequency() override
+    {
+        return frequency;
+    }
+
+    int64_t getTicks() override
+    {
+        return ticks;
+    }
+
+    void waitForTicks(int64_t targetTicks) override
+    {
+        if (ticks < targetTicks)
+            ticks = targetTicks + wakeUpLatency;
+    }
+
+    // Moves the clock to any point in time, also backwards to interleave events of different threads
+    void setTicks(int64_t newTicks)
+    {
+        ticks = newTicks;
+    }
+
+private:
+    int64_t frequency;
+    int64_t ticks;
+};
@@ -0,0 +1,207 @@
+// This file is part of the FidelityFX SDK.
+//
+// Copyright (C) 2024 Advanced Micro Devices, Inc.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "ffx_precise_wait.h"
+
+#include <cmath>
+
+#ifdef _WIN32
+#include <Windows.h>
+#include <timeapi.h>
+#pragma comment(lib, "winmm.lib")
+
+#ifndef CREATE_WAITABLE_TIMER_HIGH_RESOLUTION
+#define CREATE_WAITABLE_TIMER_HIGH_RESOLUTION 0x00000002
+#endif  // #ifndef CREATE_WAITABLE_TIMER_HIGH_RESOLUTION
+#else
+#include <cerrno>
+#include <time.h>
+#endif  // #ifdef _WIN32
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define FFX_SPIN_PAUSE() _mm_pause()
+#elif defined(_M_ARM64) || defined(_M_ARM)
+#include <intrin.h>
+#define FFX_SPIN_PAUSE() __yield()
+#elif defined(__aarch64__) || defined(__arm__)
+#define FFX_SPIN_PAUSE() __asm__ __volatile__("yield")
+#else
+#define FFX_SPIN_PAUSE()
+#endif
+
+// Weight of the latest sleep in the overshoot statistics, and how many deviations the margin covers
+static const double  OVERSHOOT_WEIGHT     = 1.0 / 16.0;
+static const double  OVERSHOOT_DEVIATIONS = 4.0;
+// Share of the margin given up whenever it's too large to sleep at all, so it gets measured again
+static const int64_t MARGIN_DECAY_DIVISOR = 32;
+
+PreciseWaiter::PreciseWaiter()
+{
+    frequency     = getFrequency();
+    minSpinMargin = frequency / 100000;  // 10us
+    maxSpinMargin = frequency / 250;     // 4ms
+    spinMargin    = frequency / 1000;    // 1ms until calibrated
+}
+
+PreciseWaiter::~PreciseWaiter()
+{
+#ifdef _WIN32
+    if (timer)
+        CloseHandle(timer);
+#endif  // #ifdef _WIN32
+}
+
+int64_t PreciseWaiter::getFrequency()
+{
+#ifdef _WIN32
+    LARGE_INTEGER qpcFrequency;
+    QueryPerformanceFrequency(&qpcFrequency);
+    return qpcFrequency.QuadPart;
+#else
+    return 1000000000;
+#endif  // #ifdef _WIN32
+}
+
+int64_t PreciseWaiter::getTicks()
+{
+#ifdef _WIN32
+    LARGE_INTEGER currentQpc;
+    QueryPerformanceCounter(&currentQpc);
+    return currentQpc.QuadPart;
+#else
+    timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return int64_t(time.tv_sec) * 1000000000 + time.tv_nsec;
+#endif  // #ifdef _WIN32
+}
+
+double PreciseWaiter::getTimerResolutionInSec()
+{
+#ifdef _WIN32
+    TIMECAPS timerCaps;
+    if (timeGetDevCaps(&timerCaps, sizeof(timerCaps)) != TIMERR_NOERROR)
+        return 0.001;
+    return (timerCaps.wPeriodMin > 1 ? timerCaps.wPeriodMin : 1) / 1000.0;
+#else
+    timespec resolution;
+    if (clock_getres(CLOCK_MONOTONIC, &resolution) != 0)
+        return 0.001;
+    return double(resolution.tv_sec) + double(resolution.tv_nsec) / 1000000000.0;
+#endif  // #ifdef _WIN32
+}
+
+bool PreciseWaiter::sleepUntil(int64_t targetTicks)
+{
+#ifdef _WIN32
+    if (timer == nullptr)
+    {
+        // high resolution timers need Windows 10 1803, fall back to Sleep() with 1ms timer resolution before
+        timer        = CreateWaitableTimerExW(nullptr, nullptr, CREATE_WAITABLE_TIMER_HIGH_RESOLUTION, TIMER_ALL_ACCESS);
+        timerHighRes = timer != nullptr;
+    }
+
+    const int64_t remainingTicks = targetTicks - getTicks();
+    if (timerHighRes)
+    {
+        LARGE_INTEGER dueTime;
+        dueTime.QuadPart = -(remainingTicks * 10000000 / frequency);  // relative in 100ns units, absolute ones are system time
+        if (dueTime.QuadPart >= 0)
+            return false;
+
+        return SetWaitableTimer(timer, &dueTime, 0, nullptr, nullptr, FALSE) && WaitForSingleObject(timer, INFINITE) == WAIT_OBJECT_0;
+    }
+
+    const DWORD millis = DWORD(remainingTicks * 1000 / frequency);
+    if (millis == 0 || timeBeginPeriod(1) != TIMERR_NOERROR)
+        return false;
+
+    Sleep(millis);
+    timeEndPeriod(1);
+    return true;
+#else
+    timespec time;
+    time.tv_sec  = time_t(targetTicks / 1000000000);
+    time.tv_nsec = long(targetTicks % 1000000000);
+
+    int result;
+    while ((result = clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &time, nullptr)) == EINTR)
+    {
+    }
+    return result == 0;
+#endif  // #ifdef _WIN32
+}
+
+void PreciseWaiter::updateMargin(int64_t overshootTicks)
+{
+    // a single preemption can't more than double the margin, repeated ones still raise it quickly
+    const int64_t clampedTicks = overshootTicks < 2 * spinMargin ? overshootTicks : 2 * spinMargin;
+
+    const double overshoot = double(clampedTicks);
+    const double delta     = overshoot - overshootMean;
+    overshootMean += OVERSHOOT_WEIGHT * delta;
+    overshootVar = (1.0 - OVERSHOOT_WEIGHT) * (overshootVar + OVERSHOOT_WEIGHT * delta * delta);
+
+    int64_t margin = int64_t(overshootMean + OVERSHOOT_DEVIATIONS * sqrt(overshootVar));
+    margin         = margin < minSpinMargin ? minSpinMargin : margin;
+    spinMargin     = margin > maxSpinMargin ? maxSpinMargin : margin;
+}
+
+void PreciseWaiter::waitUntil(int64_t targetTicks)
+{
+    if (allowSleep)
+    {
+        const int64_t currentTicks = getTicks();
+        const int64_t sleepTarget  = targetTicks - spinMargin;
+        if (sleepTarget > currentTicks)
+        {
+            if (sleepUntil(sleepTarget))
+            {
+                const int64_t wakeTicks = getTicks();
+                updateMargin(wakeTicks - sleepTarget);
+
+                sleepCount++;
+                lateWakeCount += wakeTicks > targetTicks;
+            }
+        }
+        else if (targetTicks - currentTicks > minSpinMargin)
+        {
+            spinMargin -= (spinMargin - minSpinMargin) / MARGIN_DECAY_DIVISOR;
+        }
+    }
+
+    while (getTicks() < targetTicks)
+    {
+        FFX_SPIN_PAUSE();
+    }
+}
+
+double PreciseWaiter::getSpinMarginInSec() const
+{
+    return double(spinMargin) / double(frequency);
+}
+
+void PreciseWaiter::setSpinMarginInSec(double margin)
+{
+    const int64_t marginTicks = int64_t(margin * double(frequency));
+    spinMargin                = marginTicks < minSpinMargin ? minSpinMargin : marginTicks > maxSpinMargin ? maxSpinMargin : marginTicks;
+}
@@ -0,0 +1,83 @@
+// This file is part of the FidelityFX SDK.
+//
+// Copyright (C) 2024 Advanced Micro Devices, Inc.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#pragma once
+
+#include <cstdint>
+
+// Waits for a point in time on the high resolution timer of the platform (QueryPerformanceCounter on Windows,
+// CLOCK_MONOTONIC elsewhere). The bulk of a wait is slept through, only the tail is spun. The sleep has an absolute
+// deadline on CLOCK_MONOTONIC, on Windows it's a relative due time taken right before sleeping, as absolute waitable
+// timer due times follow the system time instead of the performance counter.
+// How early the sleep ends is calibrated from the overshoot of previous sleeps, so the spin is as short as the
+// scheduler allows. A waiter is meant to be used by a single thread.
+class PreciseWaiter
+{
+public:
+    PreciseWaiter();
+    ~PreciseWaiter();
+
+    PreciseWaiter(const PreciseWaiter&)            = delete;
+    PreciseWaiter& operator=(const PreciseWaiter&) = delete;
+
+    static int64_t getFrequency();
+    static int64_t getTicks();
+
+    // Resolution of the timer the waiter sleeps on, what FfxSwapchainFramePacingTuning::hybridSpinTime is measured in
+    static double getTimerResolutionInSec();
+
+    // Only spins if false
+    volatile bool allowSleep = true;
+
+    // Returns once getTicks() has reached targetTicks
+    void waitUntil(int64_t targetTicks);
+
+    // Time the sleep currently ends before the target, calibrated from the measured overshoot
+    double getSpinMarginInSec() const;
+    void   setSpinMarginInSec(double margin);
+
+    uint64_t getSleepCount() const
+    {
+        return sleepCount;
+    }
+
+    // Sleeps that overshot the target, the wait returned late
+    uint64_t getLateWakeCount() const
+    {
+        return lateWakeCount;
+    }
+
+private:
+    bool sleepUntil(int64_t targetTicks);
+    void updateMargin(int64_t overshootTicks);
+
+    int64_t  frequency        = 0;
+    int64_t  spinMargin       = 0;
+    int64_t  minSpinMargin    = 0;
+    int64_t  maxSpinMargin    = 0;
+    double   overshootMean    = 0.0;
+    double   overshootVar     = 0.0;
+    uint64_t sleepCount       = 0;
+    uint64_t lateWakeCount    = 0;
+    void*    timer            = nullptr;
+    bool     timerHighRes     = false;
+};
@@ -0,0 +1,240 @@
+// This file is part of the FidelityFX SDK.
+//
+// Copyright (C) 2024 Advanced Micro Devices, Inc.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "ffx_shader_archive.h"
+
+#include <ffx_shader_archive_format.h>
+
+#include <atomic>
+#include <mutex>
+#include <stdlib.h>
+#include <string>
+
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <dlfcn.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif  // #ifdef _WIN32
+
+namespace
+{
+
+class ShaderArchive
+{
+public:
+    ~ShaderArchive();
+
+    bool         open();
+    FfxErrorCode getBlob(uint64_t key, uint32_t size, const uint8_t** outData);
+
+private:
+    bool map(const char* path);
+
+    const uint8_t*               mappedData        = nullptr;
+    size_t                       mappedSize        = 0;
+    const FfxShaderArchiveEntry* entries           = nullptr;
+    uint32_t                     entryCount        = 0;
+    std::atomic<uint8_t*>*       decompressedBlobs = nullptr;
+
+#ifdef _WIN32
+    HANDLE file    = INVALID_HANDLE_VALUE;
+    HANDLE mapping = nullptr;
+#endif  // #ifdef _WIN32
+};
+
+ShaderArchive::~ShaderArchive()
+{
+    for (uint32_t i = 0; decompressedBlobs && i < entryCount; ++i)
+        free(decompressedBlobs[i].load());
+    delete[] decompressedBlobs;
+
+#ifdef _WIN32
+    if (mappedData)
+        UnmapViewOfFile(mappedData);
+    if (mapping)
+        CloseHandle(mapping);
+    if (file != INVALID_HANDLE_VALUE)
+        CloseHandle(file);
+#else
+    if (mappedData)
+        munmap(const_cast<uint8_t*>(mappedData), mappedSize);
+#endif  // #ifdef _WIN32
+}
+
+bool ShaderArchive::map(const char* path)
+{
+#ifdef _WIN32
+    file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+        return false;
+
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0)
+        return false;
+
+    mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (mapping == nullptr)
+        return false;
+
+    mappedData = static_cast<const uint8_t*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+    mappedSize = size_t(fileSize.QuadPart);
+#else
+    const int fd = ::open(path, O_RDONLY);
+    if (fd < 0)
+        return false;
+
+    struct stat fileStat;
+    if (fstat(fd, &fileStat) == 0 && fileStat.st_size > 0)
+    {
+        void* data = mmap(nullptr, size_t(fileStat.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+        if (data != MAP_FAILED)
+        {
+            mappedData = static_cast<const uint8_t*>(data);
+            mappedSize = size_t(fileStat.st_size);
+        }
+    }
+    close(fd);
+#endif  // #ifdef _WIN32
+
+    return mappedData != nullptr;
+}
+
+bool ShaderArchive::open()
+{
+    // the archive is deployed next to the module the backend is linked into
+    std::string path;
+#ifdef _WIN32
+    HMODULE module = nullptr;
+    char    modulePath[MAX_PATH];
+    if (GetModuleHandleExA(GET_MODULE_HANDLE_EX_FLAG_FROM_ADDRESS | GET_MODULE_HANDLE_EX_FLAG_UNCHANGED_REFCOUNT,
+                           reinterpret_cast<LPCSTR>(&ffxGetShaderArchiveBlob),
+                           &module))
+    {
+        const DWORD length = GetModuleFileNameA(module, modulePath, MAX_PATH);
+        if (length > 0 && length < MAX_PATH)
+            path = modulePath;
+    }
+    const size_t separator = path.find_last_of("\\/");
+#else
+    Dl_info moduleInfo;
+    if (dladdr(reinterpret_cast<void*>(&ffxGetShaderArchiveBlob), &moduleInfo) && moduleInfo.dli_fname)
+        path = moduleInfo.dli_fname;
+    const size_t separator = path.find_last_of('/');
+#endif  // #ifdef _WIN32
+    path = (separator != std::string::npos ? path.substr(0, separator + 1) : std::string()) + FFX_SHADER_ARCHIVE_NAME;
+
+    if (!map(path.c_str()) || mappedSize < sizeof(FfxShaderArchiveHeader))
+        return false;
+
+    const FfxShaderArchiveHeader* header = reinterpret_cast<const FfxShaderArchiveHeader*>(mappedData);
+    if (header->magic != FFX_SHADER_ARCHIVE_MAGIC || header->version != FFX_SHADER_ARCHIVE_VERSION ||
+        header->entryCount > (mappedSize - sizeof(FfxShaderArchiveHeader)) / sizeof(FfxShaderArchiveEntry))
+        return false;
+
+    // only the index is touched here, blob data is paged in when it's requested
+    entries           = reinterpret_cast<const FfxShaderArchiveEntry*>(mappedData + sizeof(FfxShaderArchiveHeader));
+    entryCount        = header->entryCount;
+    decompressedBlobs = new std::atomic<uint8_t*>[entryCount]();
+    return true;
+}
+
+FfxErrorCode ShaderArchive::getBlob(uint64_t key, uint32_t size, const uint8_t** outData)
+{
+    uint32_t first = 0;
+    uint32_t last  = entryCount;
+    while (first < last)
+    {
+        const uint32_t middle = first + (last - first) / 2;
+        if (entries[middle].key < key)
+            first = middle + 1;
+        else
+            last = middle;
+    }
+
+    if (first == entryCount || entries[first].key != key)
+        return FFX_ERROR_INVALID_ARGUMENT;
+
+    const FfxShaderArchiveEntry& entry = entries[first];
+    if (entry.size != size || entry.offset > mappedSize || entry.storedSize > mappedSize - entry.offset)
+        return FFX_ERROR_MALFORMED_DATA;
+
+    const uint8_t* storedData = mappedData + entry.offset;
+    switch (entry.compression)
+    {
+    case FFX_SHADER_ARCHIVE_COMPRESSION_NONE:
+        if (entry.storedSize != entry.size)
+            return FFX_ERROR_MALFORMED_DATA;
+        *outData = storedData;
+        return FFX_OK;
+
+    case FFX_SHADER_ARCHIVE_COMPRESSION_LZ4:
+    {
+        std::atomic<uint8_t*>& decompressedBlob = decompressedBlobs[first];
+        uint8_t*               blob             = decompressedBlob.load(std::memory_order_acquire);
+        if (blob == nullptr)
+        {
+            // pipelines of several contexts may be created concurrently, the first decompressed copy is kept
+            blob = static_cast<uint8_t*>(malloc(entry.size));
+            if (blob == nullptr)
+                return FFX_ERROR_OUT_OF_MEMORY;
+
+            if (!ffxShaderArchiveDecompressLZ4(storedData, entry.storedSize, blob, entry.size))
+            {
+                free(blob);
+                return FFX_ERROR_MALFORMED_DATA;
+            }
+
+            uint8_t* expected = nullptr;
+            if (!decompressedBlob.compare_exchange_strong(expected, blob, std::memory_order_acq_rel))
+            {
+                free(blob);
+                blob = expected;
+            }
+        }
+
+        *outData = blob;
+        return FFX_OK;
+    }
+
+    default:
+        return FFX_ERROR_MALFORMED_DATA;
+    }
+}
+
+ShaderArchive  s_ShaderArchive;
+std::once_flag s_ShaderArchiveOpenFlag;
+bool           s_ShaderArchiveOpened = false;
+
+}  // namespace
+
+FfxErrorCode ffxGetShaderArchiveBlob(uint64_t key, uint32_t size, const uint8_t** outData)
+{
+    std::call_once(s_ShaderArchiveOpenFlag, []() { s_ShaderArchiveOpened = s_ShaderArchive.open(); });
+    if (!s_ShaderArchiveOpened)
+        return FFX_ERROR_INVALID_PATH;
+
+    return s_ShaderArchive.getBlob(key, size, outData);
+}
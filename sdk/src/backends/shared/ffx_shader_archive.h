@@ -0,0 +1,36 @@
+// This file is part of the FidelityFX SDK.
+//
+// Copyright (C) 2024 Advanced Micro Devices, Inc.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#pragma once
+
+#include <FidelityFX/host/ffx_error.h>
+
+#include <stdint.h>
+
+// Name of the shader archive, looked up in the directory of the module the backend is linked into
+#if !defined(FFX_SHADER_ARCHIVE_NAME)
+#define FFX_SHADER_ARCHIVE_NAME "ffx_shader_archive.bin"
+#endif  // #if !defined(FFX_SHADER_ARCHIVE_NAME)
+
+// Get the bytecode of a blob in the shader archive. The archive is memory-mapped on first use, stored blobs are used
+// in place and compressed ones are decompressed on first request. The data stays valid until the module is unloaded.
+FfxErrorCode ffxGetShaderArchiveBlob(uint64_t key, uint32_t size, const uint8_t** outData);
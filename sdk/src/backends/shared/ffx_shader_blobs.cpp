@@ -21,6 +21,7 @@
 // THE SOFTWARE.
 
 #include "ffx_shader_blobs.h"
+#include "ffx_shader_archive.h"
 
 #if defined(FFX_FSR1) || defined(FFX_ALL)
 #include "blob_accessors/ffx_fsr1_shaderblobs.h"
@@ -100,7 +101,7 @@
 
 #include <string.h> // for memset
 
-FfxErrorCode ffxGetPermutationBlobByIndex(
+static FfxErrorCode getPermutationBlobByIndex(
     FfxEffect effectId,
     FfxPass passId,
     FfxBindStage stageId,
@@ -222,6 +223,22 @@ FfxErrorCode ffxGetPermutationBlobByIndex(
     return FFX_OK;
 }
 
+FfxErrorCode ffxGetPermutationBlobByIndex(
+    FfxEffect effectId,
+    FfxPass passId,
+    FfxBindStage stageId,
+    uint32_t permutationOptions,
+    FfxShaderBlob* outBlob)
+{
+    const FfxErrorCode errorCode = getPermutationBlobByIndex(effectId, passId, stageId, permutationOptions, outBlob);
+
+    // shaders compiled into the shader archive only carry their reflection data, the bytecode is loaded on first use
+    if (errorCode == FFX_OK && outBlob->data == nullptr && outBlob->archiveKey != 0)
+        return ffxGetShaderArchiveBlob(outBlob->archiveKey, outBlob->size, &outBlob->data);
+
+    return errorCode;
+}
+
 FfxErrorCode ffxIsWave64(FfxEffect effectId, uint32_t permutationOptions, bool& isWave64)
 {
     (void)permutationOptions;
@@ -775,6 +775,26 @@ VkResult presentToSwapChain(FrameinterpolationPresentInfo* pPresenter, uint32_t
     return res;
 }
 
+struct SwapChainPresentSink : public FrameInterpolationPresentSink
+{
+    FrameinterpolationPresentInfo* presenter;
+    uint32_t                       imageIndex;
+    uint32_t                       semaphoreIndex;
+    VkResult                       result = VK_SUCCESS;
+
+    SwapChainPresentSink(FrameinterpolationPresentInfo* presenter, uint32_t imageIndex, uint32_t semaphoreIndex = 0)
+        : presenter(presenter)
+        , imageIndex(imageIndex)
+        , semaphoreIndex(semaphoreIndex)
+    {
+    }
+
+    void present(uint32_t frameType) override
+    {
+        result = presentToSwapChain(presenter, imageIndex, semaphoreIndex);
+    }
+};
+
 VkResult compositeSwapChainFrame(FrameinterpolationPresentInfo* pPresenter,
                                  const PacingData*              pPacingEntry,
                                  const PacingData::FrameType    frameType,
@@ -912,7 +932,6 @@ DWORD WINAPI copyAndPresent_presenterThread(LPVOID pParam)
     if (presenter)
     {
         uint64_t numFramesSentForPresentation = 0;
-        int64_t  previousPresentQpc           = 0;
 
         while (!presenter->shutdown)
         {
@@ -1017,10 +1036,10 @@ DWORD WINAPI copyAndPresent_presenterThread(LPVOID pParam)
 
                                 res = presentCommandList->execute(toWait, toSignal);
 
-                                waitForPerformanceCount(previousPresentQpc + frameInfo.presentQpcDelta);
-                                QueryPerformanceCounter(reinterpret_cast<LARGE_INTEGER*>(&previousPresentQpc));
+                                SwapChainPresentSink sink(presenter, imageIndex, imageIndex);
+                                presenter->pacer.presentFrame(frameInfo.presentQpcDelta, sink, frameType);
 
-                                res = presentToSwapChain(presenter, imageIndex, imageIndex);
+                                res = sink.result;
                                 // VK_SUBOPTIMAL_KHR & VK_ERROR_OUT_OF_DATE_KHR: the swapchain has been recreated
                                 FFX_ASSERT_MESSAGE_FORMAT(res == VK_SUCCESS || res == VK_SUBOPTIMAL_KHR || res == VK_ERROR_OUT_OF_DATE_KHR,
                                                           "presentToSwapChain failed with error %d",
@@ -1056,7 +1075,6 @@ DWORD WINAPI composeAndPresent_presenterThread(LPVOID pParam)
     if (presenter)
     {
         uint64_t numFramesSentForPresentation = 0;
-        int64_t  previousPresentQpc           = 0;
 
         while (!presenter->shutdown)
         {
@@ -1129,10 +1147,10 @@ DWORD WINAPI composeAndPresent_presenterThread(LPVOID pParam)
                                                               uiSurfaceTransfered);
                                 FFX_ASSERT_MESSAGE_FORMAT(res == VK_SUCCESS, "compositeSwapChainFrame failed with error %d", res);
 
-                                waitForPerformanceCount(previousPresentQpc + frameInfo.presentQpcDelta);
-                                QueryPerformanceCounter(reinterpret_cast<LARGE_INTEGER*>(&previousPresentQpc));
+                                SwapChainPresentSink sink(presenter, realSwapchainImageIndex);
+                                presenter->pacer.presentFrame(frameInfo.presentQpcDelta, sink, frameType);
 
-                                res = presentToSwapChain(presenter, realSwapchainImageIndex);
+                                res = sink.result;
                                 // VK_SUBOPTIMAL_KHR & VK_ERROR_OUT_OF_DATE_KHR: the swapchain has been recreated
                                 FFX_ASSERT_MESSAGE_FORMAT(res == VK_SUCCESS || res == VK_SUBOPTIMAL_KHR || res == VK_ERROR_OUT_OF_DATE_KHR,
                                                           "presentToSwapChain failed with error %d",
@@ -1173,6 +1191,8 @@ DWORD WINAPI interpolationThread(LPVOID param)
 
     if (presenter)
     {
+        presenter->pacer.reset();
+
         HANDLE presenterThreadHandle = NULL;
         if (presenter->compositionMode == FGSwapchainCompositionMode::eComposeOnPresentQueue)
         {
@@ -1190,9 +1210,6 @@ DWORD WINAPI interpolationThread(LPVOID param)
             SetThreadPriority(presenterThreadHandle, THREAD_PRIORITY_HIGHEST);
             SetThreadDescription(presenterThreadHandle, L"AMD FSR Presenter Thread");
 
-            SimpleMovingAverage<10, double> frameTime{};
-            int64_t previousQpc = 0;
-
             while (!presenter->shutdown)
             {
                 WaitForSingleObject(presenter->presentEvent, INFINITE);
@@ -1211,30 +1228,7 @@ DWORD WINAPI interpolationThread(LPVOID param)
                                           entry.frames[PacingData::FrameType::Interpolated_1].interpolationCompletedSemaphoreValue);
                     SetEvent(presenter->interpolationEvent); // unlocks the queuePresent method
 
-                    int64_t currentQpc = 0;
-                    QueryPerformanceCounter(reinterpret_cast<LARGE_INTEGER*>(&currentQpc));
-
-                    const double deltaQpc = double(currentQpc - previousQpc) * (previousQpc > 0);
-                    previousQpc           = currentQpc;
-
-                    // reset pacing averaging if delta > 10 fps,
-                    int64_t qpcFrequency;
-                    QueryPerformanceFrequency(reinterpret_cast<LARGE_INTEGER*>(&qpcFrequency));
-                    const float fTimeoutInSeconds       = 0.1f;
-                    double      deltaQpcResetThreashold = double(qpcFrequency * fTimeoutInSeconds);
-                    if ((deltaQpc > deltaQpcResetThreashold) || presenter->resetTimer)
-                    {
-                        frameTime.reset();
-                    }
-                    else
-                    {
-                        frameTime.update(deltaQpc);
-                    }
-
-                    // set presentation time: reduce based on variance and subract safety margin so we don't lock on a framerate lower than necessary
-                    int64_t qpcSafetyMargin         = int64_t(qpcFrequency * presenter->safetyMarginInSec);
-                    const int64_t conservativeAvg   = int64_t(frameTime.getAverage() * 0.5 - frameTime.getVariance() * presenter->varianceFactor);
-                    const int64_t deltaToUse        = conservativeAvg > qpcSafetyMargin ? (conservativeAvg - qpcSafetyMargin) : 0;
+                    const int64_t deltaToUse = presenter->pacer.scheduleFrame(presenter->resetTimer);
                     entry.frames[PacingData::FrameType::Interpolated_1].presentQpcDelta = deltaToUse;
                     entry.frames[PacingData::FrameType::Real].presentQpcDelta           = deltaToUse;
 
@@ -2220,8 +2214,10 @@ void FrameInterpolationSwapChainVK::getGpuMemoryUsage(FfxEffectMemoryUsage* vram
 
 void FrameInterpolationSwapChainVK::setFramePacingTuning(const FfxSwapchainFramePacingTuning* framePacingTuning)
 {
-    presentInfo.safetyMarginInSec = static_cast<double> (framePacingTuning->safetyMarginInMs) / 1000.0;
-    presentInfo.varianceFactor = static_cast<double> (framePacingTuning->varianceFactor);
+    presentInfo.pacer.safetyMarginInSec = static_cast<double> (framePacingTuning->safetyMarginInMs) / 1000.0;
+    presentInfo.pacer.varianceFactor = static_cast<double> (framePacingTuning->varianceFactor);
+    presentInfo.pacingClock.allowHybridSpin = framePacingTuning->allowHybridSpin;
+    presentInfo.pacingClock.hybridSpinTime = framePacingTuning->hybridSpinTime;
 }
 
 VkResult FrameInterpolationSwapChainVK::queuePresentNonInterpolated(VkCommands* pCommands, uint32_t imageIndex, SubmissionSemaphores& semaphoresToWait)
@@ -211,8 +211,8 @@ struct FrameinterpolationPresentInfo
     // small helpers for queue ownership transfer
     VkImageMemoryBarrier queueFamilyOwnershipTransferGameToPresent(FfxResource resource) const;
 
-    volatile double            safetyMarginInSec = 0.0001; //0.1ms
-    volatile double            varianceFactor    = 0.1;
+    FrameInterpolationPreciseClock pacingClock;
+    FrameInterpolationPacer        pacer{ pacingClock };
 
     FfxWaitCallbackFunc waitCallback               = nullptr;
 };
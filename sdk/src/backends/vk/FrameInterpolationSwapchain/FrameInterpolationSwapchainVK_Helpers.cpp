@@ -26,15 +26,6 @@
 #include <dwmapi.h>
 #endif  // #ifdef _WIN32
 
-void waitForPerformanceCount(const int64_t targetCount)
-{
-    int64_t currentCount = 0;
-    do
-    {
-        QueryPerformanceCounter(reinterpret_cast<LARGE_INTEGER*>(&currentCount));
-    } while (currentCount < targetCount);
-}
-
 VkResult VulkanQueue::submit(VkCommandBuffer commandBuffer, SubmissionSemaphores& semaphoresToWait, SubmissionSemaphores& semaphoresToSignal, VkFence fence)
 {
     VkSubmitInfo submitInfo         = {};
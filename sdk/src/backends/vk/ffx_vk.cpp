@@ -26,6 +26,7 @@
 #include <FidelityFX/host/backends/vk/ffx_vk.h>
 #include <ffx_shader_blobs.h>
 #include <ffx_breadcrumbs_list.h>
+#include <ffx_resource_binding.h>
 
 #ifdef _WIN32
 #include <windows.h>
@@ -3233,7 +3234,9 @@ FfxErrorCode CreatePipelineVK(FfxInterface* backendInterface,
     // start by fetching the shader blob
     FfxShaderBlob shaderBlob = { };
     // WON'T WORK WITH FSR3!!
-    backendInterface->fpGetPermutationBlobByIndex(effect, pass, FFX_BIND_COMPUTE_SHADER_STAGE, permutationOptions, &shaderBlob);
+    const FfxErrorCode blobErrorCode = backendInterface->fpGetPermutationBlobByIndex(effect, pass, FFX_BIND_COMPUTE_SHADER_STAGE, permutationOptions, &shaderBlob);
+    if (blobErrorCode != FFX_OK)
+        return blobErrorCode;
     FFX_ASSERT(shaderBlob.data && shaderBlob.size);
 
     //////////////////////////////////////////////////////////////////////////
@@ -3486,6 +3489,11 @@ FfxErrorCode CreatePipelineVK(FfxInterface* backendInterface,
 
             outPipeline->srvTextureBindings[bindingIndex].slotIndex  = slotIndex;
             outPipeline->srvTextureBindings[bindingIndex].arrayIndex = arrayIndex;
+            // the effect resolves the name hash to its resource identifier when patching the bindings, blobs written by older
+            // versions of FidelityFX_SC have no hashes
+            outPipeline->srvTextureBindings[bindingIndex].resourceIdentifier =
+                shaderBlob.boundSRVTextureNameHashes ? shaderBlob.boundSRVTextureNameHashes[srvIndex]
+                                                     : ffxGetResourceBindingNameHash(shaderBlob.boundSRVTextureNames[srvIndex]);
             ConvertUTF8ToUTF16(shaderBlob.boundSRVTextureNames[srvIndex], outPipeline->srvTextureBindings[bindingIndex].name, FFX_RESOURCE_NAME_SIZE);
         }
     }
@@ -3506,6 +3514,9 @@ FfxErrorCode CreatePipelineVK(FfxInterface* backendInterface,
 
             outPipeline->uavTextureBindings[bindingIndex].slotIndex  = slotIndex;
             outPipeline->uavTextureBindings[bindingIndex].arrayIndex = arrayIndex;
+            outPipeline->uavTextureBindings[bindingIndex].resourceIdentifier =
+                shaderBlob.boundUAVTextureNameHashes ? shaderBlob.boundUAVTextureNameHashes[uavIndex]
+                                                     : ffxGetResourceBindingNameHash(shaderBlob.boundUAVTextureNames[uavIndex]);
             ConvertUTF8ToUTF16(shaderBlob.boundUAVTextureNames[uavIndex], outPipeline->uavTextureBindings[bindingIndex].name, FFX_RESOURCE_NAME_SIZE);
         }
     }
@@ -3531,6 +3542,9 @@ FfxErrorCode CreatePipelineVK(FfxInterface* backendInterface,
 
             outPipeline->srvBufferBindings[bindingIndex].slotIndex  = slotIndex;
             outPipeline->srvBufferBindings[bindingIndex].arrayIndex = arrayIndex;
+            outPipeline->srvBufferBindings[bindingIndex].resourceIdentifier =
+                shaderBlob.boundSRVBufferNameHashes ? shaderBlob.boundSRVBufferNameHashes[srvIndex]
+                                                    : ffxGetResourceBindingNameHash(shaderBlob.boundSRVBufferNames[srvIndex]);
             ConvertUTF8ToUTF16(shaderBlob.boundSRVBufferNames[srvIndex], outPipeline->srvBufferBindings[bindingIndex].name, FFX_RESOURCE_NAME_SIZE);
         }
     }
@@ -3551,6 +3565,9 @@ FfxErrorCode CreatePipelineVK(FfxInterface* backendInterface,
 
             outPipeline->uavBufferBindings[bindingIndex].slotIndex  = slotIndex;
             outPipeline->uavBufferBindings[bindingIndex].arrayIndex = arrayIndex;
+            outPipeline->uavBufferBindings[bindingIndex].resourceIdentifier =
+                shaderBlob.boundUAVBufferNameHashes ? shaderBlob.boundUAVBufferNameHashes[uavIndex]
+                                                    : ffxGetResourceBindingNameHash(shaderBlob.boundUAVBufferNames[uavIndex]);
             ConvertUTF8ToUTF16(shaderBlob.boundUAVBufferNames[uavIndex], outPipeline->uavBufferBindings[bindingIndex].name, FFX_RESOURCE_NAME_SIZE);
         }
     }
@@ -3562,6 +3579,9 @@ FfxErrorCode CreatePipelineVK(FfxInterface* backendInterface,
     {
         outPipeline->constantBufferBindings[cbIndex].slotIndex  = shaderBlob.boundConstantBuffers[cbIndex];
         outPipeline->constantBufferBindings[cbIndex].arrayIndex = 1;
+        outPipeline->constantBufferBindings[cbIndex].resourceIdentifier =
+            shaderBlob.boundConstantBufferNameHashes ? shaderBlob.boundConstantBufferNameHashes[cbIndex]
+                                                     : ffxGetResourceBindingNameHash(shaderBlob.boundConstantBufferNames[cbIndex]);
         ConvertUTF8ToUTF16(shaderBlob.boundConstantBufferNames[cbIndex], outPipeline->constantBufferBindings[cbIndex].name, FFX_RESOURCE_NAME_SIZE);
     }
 
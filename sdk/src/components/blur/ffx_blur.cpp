@@ -30,27 +30,25 @@
 #include <FidelityFX/gpu/blur/ffx_blur.h>
 
 #include <ffx_object_management.h>
+#include <ffx_resource_binding.h>
 
 #include "ffx_blur_private.h"
 
 // lists to map shader resource bindpoint name to resource identifier
-typedef struct ResourceBinding
-{
-    uint32_t index;
-    wchar_t  name[64];
-} ResourceBinding;
-
-static const ResourceBinding srvTextureBindingTable[] = {
+static constexpr ResourceBinding srvTextureBindingTable[] = {
     {FFX_BLUR_RESOURCE_IDENTIFIER_INPUT_SRC, L"r_input_src"},
 };
+static constexpr auto srvTextureBindingLookup = ffxMakeResourceBindingLookup(srvTextureBindingTable);
 
-static const ResourceBinding uavTextureBindingTable[] = {
+static constexpr ResourceBinding uavTextureBindingTable[] = {
     {FFX_BLUR_RESOURCE_IDENTIFIER_OUTPUT, L"rw_output"},
 };
+static constexpr auto uavTextureBindingLookup = ffxMakeResourceBindingLookup(uavTextureBindingTable);
 
-static const ResourceBinding cbResourceBindingTable[] = {
+static constexpr ResourceBinding cbResourceBindingTable[] = {
     {FFX_BLUR_CONSTANTBUFFER_IDENTIFIER_BLUR, L"cbBLUR"},
 };
+static constexpr auto cbResourceBindingLookup = ffxMakeResourceBindingLookup(cbResourceBindingTable);
 
 static wchar_t* getKernelSizeString(wchar_t* buffer, FfxBlurKernelSize kernelSize)
 {
@@ -102,13 +100,8 @@ static FfxErrorCode patchResourceBindings(FfxPipelineState* inoutPipeline)
 {
     for (uint32_t srvIndex = 0; srvIndex < inoutPipeline->srvTextureCount; ++srvIndex)
     {
-        int32_t mapIndex = 0;
-        for (mapIndex = 0; mapIndex < _countof(srvTextureBindingTable); ++mapIndex)
-        {
-            if (0 == wcscmp(srvTextureBindingTable[mapIndex].name, inoutPipeline->srvTextureBindings[srvIndex].name))
-                break;
-        }
-        if (mapIndex == _countof(srvTextureBindingTable))
+        const int32_t mapIndex = ffxFindResourceBinding(srvTextureBindingTable, srvTextureBindingLookup, inoutPipeline->srvTextureBindings[srvIndex]);
+        if (mapIndex < 0)
             return FFX_ERROR_INVALID_ARGUMENT;
 
         inoutPipeline->srvTextureBindings[srvIndex].resourceIdentifier = srvTextureBindingTable[mapIndex].index;
@@ -116,13 +109,8 @@ static FfxErrorCode patchResourceBindings(FfxPipelineState* inoutPipeline)
 
     for (uint32_t uavIndex = 0; uavIndex < inoutPipeline->uavTextureCount; ++uavIndex)
     {
-        int32_t mapIndex = 0;
-        for (mapIndex = 0; mapIndex < _countof(uavTextureBindingTable); ++mapIndex)
-        {
-            if (0 == wcscmp(uavTextureBindingTable[mapIndex].name, inoutPipeline->uavTextureBindings[uavIndex].name))
-                break;
-        }
-        if (mapIndex == _countof(uavTextureBindingTable))
+        const int32_t mapIndex = ffxFindResourceBinding(uavTextureBindingTable, uavTextureBindingLookup, inoutPipeline->uavTextureBindings[uavIndex]);
+        if (mapIndex < 0)
             return FFX_ERROR_INVALID_ARGUMENT;
 
         inoutPipeline->uavTextureBindings[uavIndex].resourceIdentifier = uavTextureBindingTable[mapIndex].index;
@@ -130,13 +118,8 @@ static FfxErrorCode patchResourceBindings(FfxPipelineState* inoutPipeline)
 
     for (uint32_t cbIndex = 0; cbIndex < inoutPipeline->constCount; ++cbIndex)
     {
-        int32_t mapIndex = 0;
-        for (mapIndex = 0; mapIndex < _countof(cbResourceBindingTable); ++mapIndex)
-        {
-            if (0 == wcscmp(cbResourceBindingTable[mapIndex].name, inoutPipeline->constantBufferBindings[cbIndex].name))
-                break;
-        }
-        if (mapIndex == _countof(cbResourceBindingTable))
+        const int32_t mapIndex = ffxFindResourceBinding(cbResourceBindingTable, cbResourceBindingLookup, inoutPipeline->constantBufferBindings[cbIndex]);
+        if (mapIndex < 0)
             return FFX_ERROR_INVALID_ARGUMENT;
 
         inoutPipeline->constantBufferBindings[cbIndex].resourceIdentifier = cbResourceBindingTable[mapIndex].index;
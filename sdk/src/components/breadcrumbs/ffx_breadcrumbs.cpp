@@ -20,28 +20,79 @@
 // OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
 // THE SOFTWARE.
 
-#include <cstring>     // for memset
+#include <cstring>     // for memset, memcpy
 
 #include <ffx_object_management.h>           
 #include <ffx_breadcrumbs_list.h>           
 
 #include "ffx_breadcrumbs_private.h"
 
-static const char* breadDecodeMarkerType(FfxBreadcrumbsMarkerType type)
+static char* breadcrumbsAllocName(FfxAllocationCallbacks* allocs, BreadcrumbsNameStorage* storage, size_t length)
 {
-#define X(marker) case FFX_BREADCRUMBS_MARKER_##marker: return #marker;
-    switch (type)
+    // Lock placed externally, storage is only filled by one thread at a time.
+    FFX_ASSERT(storage);
+
+    BreadcrumbsNameChunk* chunk = storage->pCurrentChunk;
+    if (chunk == nullptr || chunk->size - chunk->used < length)
     {
-    default:
-        FFX_ASSERT_FAIL("Unhandled enum value!");
-        FFX_BREADCRUMBS_MARKER_LIST
+        // Move to the next chunk kept from previous use, or put a bigger one in front of it.
+        BreadcrumbsNameChunk* next = chunk ? chunk->pNext : nullptr;
+        if (next && next->size >= length)
+        {
+            next->used = 0;
+            chunk = next;
+        }
+        else
+        {
+            size_t size = chunk ? chunk->size * 2 : FFX_BREADCRUMBS_NAME_CHUNK_SIZE;
+            while (size < length)
+                size <<= 1;
+
+            BreadcrumbsNameChunk* newChunk = (BreadcrumbsNameChunk*)allocs->fpAlloc(sizeof(BreadcrumbsNameChunk) + size);
+            FFX_ASSERT(newChunk);
+            newChunk->pNext = next;
+            newChunk->size = size;
+            newChunk->used = 0;
+            if (chunk)
+                chunk->pNext = newChunk;
+            else
+                storage->pFirstChunk = newChunk;
+            chunk = newChunk;
+        }
+        storage->pCurrentChunk = chunk;
     }
-#undef X
+
+    char* name = (char*)(chunk + 1) + chunk->used;
+    chunk->used += length;
+    return name;
 }
 
-static void breadcrumbsSetName(FfxAllocationCallbacks* allocs, BreadcrumbsCustomNameBuffer* nameBuffer, const FfxBreadcrumbsNameTag* tag, bool enableLock, BreadcrumbsCustomName* name)
+static void breadcrumbsResetNames(BreadcrumbsNameStorage* storage)
 {
-    FFX_ASSERT(nameBuffer);
+    // Lock placed externally.
+    FFX_ASSERT(storage);
+    if (storage->pFirstChunk)
+        storage->pFirstChunk->used = 0;
+    storage->pCurrentChunk = storage->pFirstChunk;
+}
+
+static void breadcrumbsFreeNames(FfxAllocationCallbacks* allocs, BreadcrumbsNameStorage* storage)
+{
+    // Lock placed externally.
+    FFX_ASSERT(storage);
+    while (storage->pFirstChunk)
+    {
+        BreadcrumbsNameChunk* chunk = storage->pFirstChunk;
+        storage->pFirstChunk = chunk->pNext;
+        allocs->fpFree(chunk);
+    }
+    storage->pCurrentChunk = nullptr;
+}
+
+static void breadcrumbsSetName(FfxAllocationCallbacks* allocs, BreadcrumbsNameStorage* storage, const FfxBreadcrumbsNameTag* tag, BreadcrumbsCustomName* name)
+{
+    // Lock placed externally, storage is only filled by one thread at a time.
+    FFX_ASSERT(storage);
     FFX_ASSERT(tag);
     FFX_ASSERT(name);
 
@@ -49,72 +100,234 @@ static void breadcrumbsSetName(FfxAllocationCallbacks* allocs, BreadcrumbsCustom
     if (tag->pName && !tag->isNameExternallyOwned)
     {
         const size_t length = strlen(tag->pName) + 1;
+        name->pName = breadcrumbsAllocName(allocs, storage, length);
+        memcpy(name->pName, tag->pName, length);
+    }
+    else
+        name->pName = (char*)tag->pName;
+}
 
-        if (enableLock)
-        {
-            FFX_MUTEX_LOCK(nameBuffer->mutex);
-        }
+static size_t breadcrumbsLocateSegment(size_t index, size_t* segment)
+{
+    // Segment s starts at element FFX_BREADCRUMBS_SEGMENT_BASE_SIZE * (2^s - 1), returns the index inside the segment.
+    FFX_ASSERT(segment);
+
+    size_t current = 0;
+    while (index >= ((size_t)FFX_BREADCRUMBS_SEGMENT_BASE_SIZE << current))
+    {
+        index -= (size_t)FFX_BREADCRUMBS_SEGMENT_BASE_SIZE << current;
+        ++current;
+    }
+    FFX_ASSERT(current < FFX_BREADCRUMBS_MAX_SEGMENTS);
+    *segment = current;
+    return index;
+}
 
-        const size_t nameOffset = nameBuffer->currentNamesOffset;
-        nameBuffer->currentNamesOffset += length;
-        if (nameBuffer->bufferSize < nameBuffer->currentNamesOffset)
+static void* breadcrumbsGetElement(const BreadcrumbsSegmentedArray* array, size_t index, size_t elementSize)
+{
+    // No need for lock, only published elements are accessed.
+    FFX_ASSERT(array);
+
+    size_t segment;
+    const size_t offset = breadcrumbsLocateSegment(index, &segment);
+    uint8_t* data = array->pSegments[segment].load(std::memory_order_acquire);
+    FFX_ASSERT(data);
+    return data + elementSize * offset;
+}
+
+static void breadcrumbsReserveElements(FfxAllocationCallbacks* allocs, BreadcrumbsSegmentedArray* array, size_t count, size_t elementSize)
+{
+    // Lock placed externally.
+    FFX_ASSERT(array);
+    if (count == 0)
+        return;
+
+    size_t lastSegment;
+    breadcrumbsLocateSegment(count - 1, &lastSegment);
+    for (size_t segment = 0; segment <= lastSegment; ++segment)
+    {
+        if (array->pSegments[segment].load(std::memory_order_relaxed) == nullptr)
         {
-            nameBuffer->pBuffer = (char*)ffxBreadcrumbsAppendList(nameBuffer->pBuffer,
-                nameBuffer->bufferSize, 1, nameBuffer->currentNamesOffset - nameBuffer->bufferSize, allocs);
+            const size_t size = elementSize * ((size_t)FFX_BREADCRUMBS_SEGMENT_BASE_SIZE << segment);
+            uint8_t* data = (uint8_t*)allocs->fpAlloc(size);
+            FFX_ASSERT(data);
+            memset(data, 0, size);
+            array->pSegments[segment].store(data, std::memory_order_release);
         }
-        memcpy(nameBuffer->pBuffer + nameOffset, tag->pName, length);
+    }
+}
+
+static size_t breadcrumbsGetElementsCapacity(const BreadcrumbsSegmentedArray* array)
+{
+    // Lock placed externally.
+    FFX_ASSERT(array);
+
+    size_t capacity = 0;
+    for (size_t segment = 0; segment < FFX_BREADCRUMBS_MAX_SEGMENTS && array->pSegments[segment].load(std::memory_order_relaxed); ++segment)
+        capacity += (size_t)FFX_BREADCRUMBS_SEGMENT_BASE_SIZE << segment;
+    return capacity;
+}
+
+static void breadcrumbsFreeElements(FfxAllocationCallbacks* allocs, BreadcrumbsSegmentedArray* array)
+{
+    // Lock placed externally.
+    FFX_ASSERT(array);
+    for (size_t segment = 0; segment < FFX_BREADCRUMBS_MAX_SEGMENTS; ++segment)
+    {
+        uint8_t* data = array->pSegments[segment].exchange(nullptr, std::memory_order_relaxed);
+        if (data)
+            allocs->fpFree(data);
+    }
+}
+
+static size_t breadcrumbsHashHandle(const void* handle)
+{
+    // Handles are mostly aligned pointers, mix the bits so the low ones used for the slot are well distributed
+    uint64_t hash = (uint64_t)(uintptr_t)handle;
+    hash ^= hash >> 33;
+    hash *= 0xFF51AFD7ED558CCDULL;
+    hash ^= hash >> 33;
+    return (size_t)hash;
+}
+
+static BreadcrumbsHandleSlot* breadcrumbsGetHandleSlots(const BreadcrumbsHandleTable* table)
+{
+    return (BreadcrumbsHandleSlot*)(table + 1);
+}
 
-        if (enableLock)
+static void breadcrumbsHandleTableAdd(BreadcrumbsHandleTable* table, const void* handle, void* record)
+{
+    // Lock placed externally
+    FFX_ASSERT(table);
+    FFX_ASSERT(handle);
+
+    BreadcrumbsHandleSlot* slots = breadcrumbsGetHandleSlots(table);
+    const size_t mask = table->capacity - 1;
+    size_t slot = breadcrumbsHashHandle(handle) & mask;
+    while (slots[slot].handle.load(std::memory_order_relaxed))
+        slot = (slot + 1) & mask;
+
+    // Concurrent lookups can only see the handle after the record is set
+    slots[slot].pRecord = record;
+    slots[slot].handle.store(handle, std::memory_order_release);
+    ++table->count;
+}
+
+static void breadcrumbsHandleTableInsert(FfxAllocationCallbacks* allocs, std::atomic<BreadcrumbsHandleTable*>* tablePtr, const void* handle, void* record)
+{
+    // Lock placed externally
+    FFX_ASSERT(tablePtr);
+
+    BreadcrumbsHandleTable* table = tablePtr->load(std::memory_order_relaxed);
+    const size_t count = table ? table->count + 1 : 1;
+    if (table == nullptr || count * 2 > table->capacity)
+    {
+        // Lookups may still be probing the old table, so it's only retired and the grown copy is published in its place
+        size_t capacity = table ? table->capacity * 2 : FFX_BREADCRUMBS_LIST_MIN_CAPACITY;
+        while (capacity < count * 2)
+            capacity <<= 1;
+
+        const size_t size = sizeof(BreadcrumbsHandleTable) + sizeof(BreadcrumbsHandleSlot) * capacity;
+        BreadcrumbsHandleTable* newTable = (BreadcrumbsHandleTable*)allocs->fpAlloc(size);
+        FFX_ASSERT(newTable);
+        memset(newTable, 0, size);
+        newTable->capacity = capacity;
+        newTable->pRetired = table;
+
+        if (table)
         {
-            FFX_MUTEX_UNLOCK(nameBuffer->mutex);
+            const BreadcrumbsHandleSlot* slots = breadcrumbsGetHandleSlots(table);
+            for (size_t slot = 0; slot < table->capacity; ++slot)
+            {
+                const void* oldHandle = slots[slot].handle.load(std::memory_order_relaxed);
+                if (oldHandle)
+                    breadcrumbsHandleTableAdd(newTable, oldHandle, slots[slot].pRecord);
+            }
         }
+        tablePtr->store(newTable, std::memory_order_release);
+        table = newTable;
+    }
+    breadcrumbsHandleTableAdd(table, handle, record);
+}
+
+static void* breadcrumbsHandleTableFind(const std::atomic<BreadcrumbsHandleTable*>* tablePtr, const void* handle)
+{
+    // No need for lock
+    FFX_ASSERT(tablePtr);
+    FFX_ASSERT(handle);
+
+    const BreadcrumbsHandleTable* table = tablePtr->load(std::memory_order_acquire);
+    if (table == nullptr)
+        return nullptr;
 
-        name->pName = (char*)(nameOffset + 1);
-        name->isCopied = true;
+    const BreadcrumbsHandleSlot* slots = breadcrumbsGetHandleSlots(table);
+    const size_t mask = table->capacity - 1;
+    for (size_t slot = breadcrumbsHashHandle(handle) & mask;; slot = (slot + 1) & mask)
+    {
+        const void* slotHandle = slots[slot].handle.load(std::memory_order_acquire);
+        if (slotHandle == nullptr)
+            return nullptr;
+        if (slotHandle == handle)
+            return slots[slot].pRecord;
     }
-    else
+}
+
+static void breadcrumbsHandleTableClear(FfxAllocationCallbacks* allocs, std::atomic<BreadcrumbsHandleTable*>* tablePtr)
+{
+    // Not protected by lock, no lookups can be running.
+    FFX_ASSERT(tablePtr);
+
+    BreadcrumbsHandleTable* table = tablePtr->load(std::memory_order_relaxed);
+    if (table)
     {
-        name->pName = (char*)tag->pName;
-        name->isCopied = false;
+        while (table->pRetired)
+        {
+            BreadcrumbsHandleTable* retired = table->pRetired;
+            table->pRetired = retired->pRetired;
+            allocs->fpFree(retired);
+        }
+        BreadcrumbsHandleSlot* slots = breadcrumbsGetHandleSlots(table);
+        for (size_t slot = 0; slot < table->capacity; ++slot)
+            slots[slot].handle.store(nullptr, std::memory_order_relaxed);
+        table->count = 0;
     }
 }
 
-static char* breadcrumbsGetName(BreadcrumbsCustomNameBuffer* nameBuffer, const BreadcrumbsCustomName* name)
+static void breadcrumbsHandleTableFree(FfxAllocationCallbacks* allocs, std::atomic<BreadcrumbsHandleTable*>* tablePtr)
 {
-    // No need for lock
-    FFX_ASSERT(nameBuffer);
-    FFX_ASSERT(name);
-    FFX_ASSERT(name->pName);
+    // Not protected by lock, no lookups can be running.
+    FFX_ASSERT(tablePtr);
 
-    if (name->isCopied)
-        return nameBuffer->pBuffer + (size_t)name->pName - 1;
-    return name->pName;
+    BreadcrumbsHandleTable* table = tablePtr->exchange(nullptr, std::memory_order_relaxed);
+    while (table)
+    {
+        BreadcrumbsHandleTable* retired = table->pRetired;
+        allocs->fpFree(table);
+        table = retired;
+    }
+}
+
+static BreadcrumbsListData* breadcrumbsGetList(const BreadcrumbsFrameData* frame, size_t index)
+{
+    FFX_ASSERT(frame);
+    return (BreadcrumbsListData*)breadcrumbsGetElement(&frame->usedLists, index, sizeof(BreadcrumbsListData));
 }
 
 static BreadcrumbsListData* breadcrumbsSearchList(BreadcrumbsFrameData* frame, FfxCommandList list)
 {
-    // Lock placed externally
+    // No need for lock
     FFX_ASSERT(frame);
     FFX_ASSERT(list);
-    for (size_t i = 0; i < frame->usedListsCount; ++i)
-    {
-        if (frame->pUsedLists[i].list == list)
-            return frame->pUsedLists + i;
-    }
-    return nullptr;
+    return (BreadcrumbsListData*)breadcrumbsHandleTableFind(&frame->pUsedListsTable, list);
 }
 
 static BreadcrumbsPipelineData* breadcrumbsSearchPipeline(FfxBreadcrumbsContext_Private* context, FfxPipeline pipeline)
 {
-    // Lock placed externally
+    // No need for lock
     FFX_ASSERT(context);
+    FFX_ASSERT(context->pPipelines);
     FFX_ASSERT(pipeline);
-    for (size_t i = 0; i < context->registeredPipelinesCount; ++i)
-    {
-        if (context->pRegisteredPipelines[i].pipeline == pipeline)
-            return context->pRegisteredPipelines + i;
-    }
-    return nullptr;
+    return (BreadcrumbsPipelineData*)breadcrumbsHandleTableFind(&context->pPipelines->pTable, pipeline);
 }
 
 static bool breadcrumbsIsCorrectPipeline(FfxBreadcrumbsContext_Private* context, FfxPipeline pipeline, bool newPipeline)
@@ -124,17 +337,7 @@ static bool breadcrumbsIsCorrectPipeline(FfxBreadcrumbsContext_Private* context,
     if (FFX_CONTAINS_FLAG(context->contextDescription.flags, FFX_BREADCRUMBS_PRINT_SKIP_PIPELINE_INFO))
         return true;
 
-    const bool lockEnable = FFX_CONTAINS_FLAG(context->contextDescription.flags, FFX_BREADCRUMBS_ENABLE_THREAD_SYNCHRONIZATION);
-    if (lockEnable)
-    {
-        FFX_MUTEX_LOCK_SHARED(context->pipelinesNamesBuffer.mutex);
-    }
     BreadcrumbsPipelineData* data = breadcrumbsSearchPipeline(context, pipeline);
-    if (lockEnable)
-    {
-        FFX_MUTEX_UNLOCK_SHARED(context->pipelinesNamesBuffer.mutex);
-    }
-
     return (data == nullptr) == newPipeline;
 }
 
@@ -146,19 +349,12 @@ static BreadcrumbsFrameData* breadcrumbsGetCurrentFrame(FfxBreadcrumbsContext_Pr
     return context->pFrameData + (context->frameIndex % context->contextDescription.frameHistoryLength);
 }
 
-static FfxBreadcrumbsBlockData* breadcrumbsGetLastBlock(BreadcrumbsBlockVector* blockVector)
+static FfxBreadcrumbsBlockData* breadcrumbsGetBlock(const BreadcrumbsBlockVector* blockVector, size_t block)
 {
-    // Lock placed externally.
+    // No need for lock, only published blocks are accessed.
     FFX_ASSERT(blockVector);
-    FFX_ASSERT(blockVector->currentBlock < blockVector->memoryBlocksCount);
-    return blockVector->pMemoryBlocks + blockVector->currentBlock;
-}
-
-static FfxBreadcrumbsBlockData* breadcrumbsGetQueueLastBlock(BreadcrumbsFrameData* frame, uint32_t queue)
-{
-    // Lock placed externally.
-    FFX_ASSERT(frame);
-    return breadcrumbsGetLastBlock(frame->pBlockPerQueue + queue);
+    FFX_ASSERT(block < blockVector->memoryBlocksCount.load(std::memory_order_relaxed));
+    return (FfxBreadcrumbsBlockData*)breadcrumbsGetElement(&blockVector->memoryBlocks, block, sizeof(FfxBreadcrumbsBlockData));
 }
 
 static FfxErrorCode breadcrumbsAllocBlock(FfxInterface* ptr, FfxAllocationCallbacks* allocs,
@@ -173,10 +369,11 @@ static FfxErrorCode breadcrumbsAllocBlock(FfxInterface* ptr, FfxAllocationCallba
     if (errorCode != FFX_OK)
         return errorCode;
 
-    blockVector->pMemoryBlocks = (FfxBreadcrumbsBlockData*)ffxBreadcrumbsAppendList(blockVector->pMemoryBlocks,
-        blockVector->memoryBlocksCount, sizeof(FfxBreadcrumbsBlockData), 1, allocs);
-    blockVector->pMemoryBlocks[blockVector->memoryBlocksCount] = newBlock;
-    ++blockVector->memoryBlocksCount;
+    const size_t blockCount = blockVector->memoryBlocksCount.load(std::memory_order_relaxed);
+    breadcrumbsReserveElements(allocs, &blockVector->memoryBlocks, blockCount + 1, sizeof(FfxBreadcrumbsBlockData));
+    *(FfxBreadcrumbsBlockData*)breadcrumbsGetElement(&blockVector->memoryBlocks, blockCount, sizeof(FfxBreadcrumbsBlockData)) = newBlock;
+    // Publish block for markers reserved past the previous ones.
+    blockVector->memoryBlocksCount.store(blockCount + 1, std::memory_order_release);
 
     return FFX_OK;
 }
@@ -186,44 +383,56 @@ static FfxErrorCode breadcrumbsRelease(FfxBreadcrumbsContext_Private* context)
     // Not protected by lock, should be called from single thread only!
     FFX_ASSERT(context);
 
-    FFX_SAFE_FREE(context->contextDescription.pUsedGpuQueues, context->contextDescription.allocCallbacks.fpFree);
+    FfxAllocationCallbacks* allocs = &context->contextDescription.allocCallbacks;
+    FFX_SAFE_FREE(context->contextDescription.pUsedGpuQueues, allocs->fpFree);
     if (context->pFrameData)
     {
         for (uint32_t f = 0; f < context->contextDescription.frameHistoryLength; ++f)
         {
             BreadcrumbsFrameData* frame = context->pFrameData + f;
-            for (uint32_t list = 0; list < frame->usedListsCount; ++list)
+            const size_t listsCapacity = breadcrumbsGetElementsCapacity(&frame->usedLists);
+            for (size_t list = 0; list < listsCapacity; ++list)
             {
-                FFX_SAFE_FREE(frame->pUsedLists->pMarkers, context->contextDescription.allocCallbacks.fpFree);
+                BreadcrumbsListData* listData = breadcrumbsGetList(frame, list);
+                FFX_SAFE_FREE(listData->pMarkers, allocs->fpFree);
+                FFX_SAFE_FREE(listData->pCurrentStack, allocs->fpFree);
+                breadcrumbsFreeNames(allocs, &listData->names);
             }
-            FFX_SAFE_FREE(frame->pUsedLists, context->contextDescription.allocCallbacks.fpFree);
+            breadcrumbsFreeElements(allocs, &frame->usedLists);
+            breadcrumbsHandleTableFree(allocs, &frame->pUsedListsTable);
 
-            for (uint32_t queue = 0; queue < context->contextDescription.usedGpuQueuesCount; ++queue)
+            if (frame->pBlockPerQueue)
             {
-                if (frame->pBlockPerQueue)
+                for (uint32_t queue = 0; queue < context->contextDescription.usedGpuQueuesCount; ++queue)
                 {
                     BreadcrumbsBlockVector* blockVector = frame->pBlockPerQueue + queue;
-                    for (uint32_t block = 0; block < blockVector->memoryBlocksCount; ++block)
+                    const size_t blockCount = blockVector->memoryBlocksCount.load(std::memory_order_relaxed);
+                    for (size_t block = 0; block < blockCount; ++block)
                     {
-                        FFX_ASSERT(blockVector->pMemoryBlocks);
-
-                        context->contextDescription.backendInterface.fpBreadcrumbsFreeBlock(&context->contextDescription.backendInterface, blockVector->pMemoryBlocks + block);
+                        FfxBreadcrumbsBlockData* blockData = breadcrumbsGetBlock(blockVector, block);
+                        context->contextDescription.backendInterface.fpBreadcrumbsFreeBlock(&context->contextDescription.backendInterface, blockData);
                         // All data should be cleared at this point
-                        FFX_ASSERT(!blockVector->pMemoryBlocks[block].buffer);
-                        FFX_ASSERT(!blockVector->pMemoryBlocks[block].heap);
-                        FFX_ASSERT(!blockVector->pMemoryBlocks[block].memory);
+                        FFX_ASSERT(!blockData->buffer);
+                        FFX_ASSERT(!blockData->heap);
+                        FFX_ASSERT(!blockData->memory);
                     }
-                    FFX_SAFE_FREE(blockVector->pMemoryBlocks, context->contextDescription.allocCallbacks.fpFree);
+                    breadcrumbsFreeElements(allocs, &blockVector->memoryBlocks);
+                    blockVector->~BreadcrumbsBlockVector();
                 }
+                FFX_SAFE_FREE(frame->pBlockPerQueue, allocs->fpFree);
             }
-            FFX_SAFE_FREE(frame->pBlockPerQueue, context->contextDescription.allocCallbacks.fpFree);
-            FFX_SAFE_FREE(frame->namesBuffer.pBuffer, context->contextDescription.allocCallbacks.fpFree);
             frame->~BreadcrumbsFrameData();
         }
-        context->contextDescription.allocCallbacks.fpFree(context->pFrameData);
+        allocs->fpFree(context->pFrameData);
+    }
+    if (context->pPipelines)
+    {
+        breadcrumbsFreeElements(allocs, &context->pPipelines->pipelines);
+        breadcrumbsHandleTableFree(allocs, &context->pPipelines->pTable);
+        breadcrumbsFreeNames(allocs, &context->pPipelines->names);
+        context->pPipelines->~BreadcrumbsPipelineRegistry();
+        FFX_SAFE_FREE(context->pPipelines, allocs->fpFree);
     }
-    FFX_SAFE_FREE(context->pRegisteredPipelines, context->contextDescription.allocCallbacks.fpFree);
-    FFX_SAFE_FREE(context->pipelinesNamesBuffer.pBuffer, context->contextDescription.allocCallbacks.fpFree);
 
     // Destroy the context
     context->contextDescription.backendInterface.fpDestroyBackendContext(&context->contextDescription.backendInterface, context->effectContextId);
@@ -256,6 +465,10 @@ static FfxErrorCode breadcrumbsCreate(FfxBreadcrumbsContext_Private* context, co
     FFX_ASSERT(context->contextDescription.pUsedGpuQueues);
     memcpy(context->contextDescription.pUsedGpuQueues, contextDescription->pUsedGpuQueues, sizeof(uint32_t) * contextDescription->usedGpuQueuesCount);
 
+    context->pPipelines = (BreadcrumbsPipelineRegistry*)context->contextDescription.allocCallbacks.fpAlloc(sizeof(BreadcrumbsPipelineRegistry));
+    FFX_ASSERT(context->pPipelines);
+    new(context->pPipelines) BreadcrumbsPipelineRegistry();
+
     context->pFrameData = (BreadcrumbsFrameData*)context->contextDescription.allocCallbacks.fpAlloc(sizeof(BreadcrumbsFrameData) * contextDescription->frameHistoryLength);
     FFX_ASSERT(context->pFrameData);
 
@@ -265,9 +478,10 @@ static FfxErrorCode breadcrumbsCreate(FfxBreadcrumbsContext_Private* context, co
         new(context->pFrameData + frame) BreadcrumbsFrameData();
         context->pFrameData[frame].pBlockPerQueue = (BreadcrumbsBlockVector*)context->contextDescription.allocCallbacks.fpAlloc(sizeof(BreadcrumbsBlockVector) * contextDescription->usedGpuQueuesCount);
         FFX_ASSERT(context->pFrameData[frame].pBlockPerQueue);
+        for (uint32_t queue = 0; queue < contextDescription->usedGpuQueuesCount; ++queue)
+            new(context->pFrameData[frame].pBlockPerQueue + queue) BreadcrumbsBlockVector();
         for (uint32_t queue = 0; queue < contextDescription->usedGpuQueuesCount; ++queue)
         {
-            context->pFrameData[frame].pBlockPerQueue[queue] = {};
             errorCode = breadcrumbsAllocBlock(&context->contextDescription.backendInterface, &context->contextDescription.allocCallbacks, context->pFrameData[frame].pBlockPerQueue + queue, contextDescription->maxMarkersPerMemoryBlock);
             if (errorCode != FFX_OK)
             {
@@ -355,21 +569,19 @@ FfxErrorCode ffxBreadcrumbsStartFrame(FfxBreadcrumbsContext* context)
 
     ++contextPrivate->frameIndex;
     BreadcrumbsFrameData* frame = breadcrumbsGetCurrentFrame(contextPrivate);
-    frame->namesBuffer.currentNamesOffset = 0;
-    for (uint32_t list = 0; list < frame->usedListsCount; ++list)
+    // Frame storage only gets reset, so after warming up recording a frame doesn't allocate anymore.
+    for (size_t list = 0; list < frame->usedListsCount; ++list)
     {
-        FFX_SAFE_FREE(frame->pUsedLists->pMarkers, contextPrivate->contextDescription.allocCallbacks.fpFree);
+        BreadcrumbsListData* listData = breadcrumbsGetList(frame, list);
+        listData->markersCount = 0;
+        listData->currentStackCount = 0;
+        breadcrumbsResetNames(&listData->names);
     }
-    FFX_SAFE_FREE(frame->pUsedLists, contextPrivate->contextDescription.allocCallbacks.fpFree);
     frame->usedListsCount = 0;
+    breadcrumbsHandleTableClear(&contextPrivate->contextDescription.allocCallbacks, &frame->pUsedListsTable);
 
     for (uint32_t queue = 0; queue < contextPrivate->contextDescription.usedGpuQueuesCount; ++queue)
-    {
-        BreadcrumbsBlockVector* blockVector = frame->pBlockPerQueue + queue;
-        blockVector->currentBlock = 0;
-        if (blockVector->memoryBlocksCount)
-            breadcrumbsGetLastBlock(blockVector)->nextMarker = 0;
-    }
+        frame->pBlockPerQueue[queue].nextMarker.store(0, std::memory_order_relaxed);
     return FFX_OK;
 }
 
@@ -383,11 +595,9 @@ FfxErrorCode ffxBreadcrumbsRegisterCommandList(FfxBreadcrumbsContext* context, c
     FFX_RETURN_ON_ERROR(commandListDescription->queueType < contextPrivate->contextDescription.usedGpuQueuesCount, FFX_ERROR_INVALID_ARGUMENT);
 
     BreadcrumbsFrameData* frame = breadcrumbsGetCurrentFrame(contextPrivate);
-    BreadcrumbsCustomName name;
+    FfxAllocationCallbacks* allocs = &contextPrivate->contextDescription.allocCallbacks;
 
     const bool lockEnable = FFX_CONTAINS_FLAG(contextPrivate->contextDescription.flags, FFX_BREADCRUMBS_ENABLE_THREAD_SYNCHRONIZATION);
-    breadcrumbsSetName(&contextPrivate->contextDescription.allocCallbacks, &frame->namesBuffer, &commandListDescription->name, lockEnable, &name);
-
     if (lockEnable)
     {
         FFX_MUTEX_LOCK(frame->listMutex);
@@ -400,20 +610,22 @@ FfxErrorCode ffxBreadcrumbsRegisterCommandList(FfxBreadcrumbsContext* context, c
         }
         return FFX_ERROR_INVALID_ARGUMENT;
     }
-    frame->pUsedLists = (BreadcrumbsListData*)ffxBreadcrumbsAppendList(frame->pUsedLists, frame->usedListsCount, sizeof(BreadcrumbsListData), 1, &contextPrivate->contextDescription.allocCallbacks);
-    frame->pUsedLists[frame->usedListsCount] =
-    {
-        commandListDescription->commandList,
-        commandListDescription->queueType,
-        commandListDescription->submissionIndex,
-        name,
-        FFX_CONTAINS_FLAG(contextPrivate->contextDescription.flags, FFX_BREADCRUMBS_PRINT_SKIP_PIPELINE_INFO) ? nullptr : commandListDescription->pipeline,
-        0,
-        nullptr,
-        0,
-        nullptr
-    };
+
+    // Slot may hold marker and name storage from a previous frame, keep it.
+    // From now on the list data is only used by the thread recording the list, so no more locking is needed for it.
+    breadcrumbsReserveElements(allocs, &frame->usedLists, frame->usedListsCount + 1, sizeof(BreadcrumbsListData));
+    BreadcrumbsListData* listData = breadcrumbsGetList(frame, frame->usedListsCount);
+    listData->list = commandListDescription->commandList;
+    listData->queueType = commandListDescription->queueType;
+    listData->submissionIndex = commandListDescription->submissionIndex;
+    breadcrumbsResetNames(&listData->names);
+    breadcrumbsSetName(allocs, &listData->names, &commandListDescription->name, &listData->name);
+    listData->currentPipeline = FFX_CONTAINS_FLAG(contextPrivate->contextDescription.flags, FFX_BREADCRUMBS_PRINT_SKIP_PIPELINE_INFO) ? nullptr : commandListDescription->pipeline;
+    listData->markersCount = 0;
+    listData->currentStackCount = 0;
     ++frame->usedListsCount;
+
+    breadcrumbsHandleTableInsert(allocs, &frame->pUsedListsTable, listData->list, listData);
     if (lockEnable)
     {
         FFX_MUTEX_UNLOCK(frame->listMutex);
@@ -450,35 +662,37 @@ FfxErrorCode ffxBreadcrumbsRegisterPipeline(FfxBreadcrumbsContext* context, cons
     if (FFX_CONTAINS_FLAG(contextPrivate->contextDescription.flags, FFX_BREADCRUMBS_PRINT_SKIP_PIPELINE_INFO))
         return FFX_OK;
 
+    BreadcrumbsPipelineRegistry* registry = contextPrivate->pPipelines;
     const bool lockEnable = FFX_CONTAINS_FLAG(contextPrivate->contextDescription.flags, FFX_BREADCRUMBS_ENABLE_THREAD_SYNCHRONIZATION);
     if (lockEnable)
     {
-        FFX_MUTEX_LOCK(contextPrivate->pipelinesNamesBuffer.mutex);
+        FFX_MUTEX_LOCK(registry->mutex);
     }
 
-    contextPrivate->pRegisteredPipelines = (BreadcrumbsPipelineData*)ffxBreadcrumbsAppendList(contextPrivate->pRegisteredPipelines,
-        contextPrivate->registeredPipelinesCount, sizeof(BreadcrumbsPipelineData), 1, &contextPrivate->contextDescription.allocCallbacks);
-    BreadcrumbsPipelineData* newPipeline = contextPrivate->pRegisteredPipelines + contextPrivate->registeredPipelinesCount;
-    ++contextPrivate->registeredPipelinesCount;
-
     FfxAllocationCallbacks* allocs = &contextPrivate->contextDescription.allocCallbacks;
-    BreadcrumbsCustomNameBuffer* nameBuffer = &contextPrivate->pipelinesNamesBuffer;
+    BreadcrumbsNameStorage* names = &registry->names;
 
+    breadcrumbsReserveElements(allocs, &registry->pipelines, registry->pipelinesCount + 1, sizeof(BreadcrumbsPipelineData));
+    BreadcrumbsPipelineData* newPipeline = (BreadcrumbsPipelineData*)breadcrumbsGetElement(&registry->pipelines, registry->pipelinesCount, sizeof(BreadcrumbsPipelineData));
     newPipeline->pipeline = pipelineDescription->pipeline;
-    breadcrumbsSetName(allocs, nameBuffer, &pipelineDescription->name, false, &newPipeline->name);
-    breadcrumbsSetName(allocs, nameBuffer, &pipelineDescription->vertexShader, false, &newPipeline->vertexShader);
-    breadcrumbsSetName(allocs, nameBuffer, &pipelineDescription->hullShader, false, &newPipeline->hullShader);
-    breadcrumbsSetName(allocs, nameBuffer, &pipelineDescription->domainShader, false, &newPipeline->domainShader);
-    breadcrumbsSetName(allocs, nameBuffer, &pipelineDescription->geometryShader, false, &newPipeline->geometryShader);
-    breadcrumbsSetName(allocs, nameBuffer, &pipelineDescription->meshShader, false, &newPipeline->meshShader);
-    breadcrumbsSetName(allocs, nameBuffer, &pipelineDescription->amplificationShader, false, &newPipeline->amplificationShader);
-    breadcrumbsSetName(allocs, nameBuffer, &pipelineDescription->pixelShader, false, &newPipeline->pixelShader);
-    breadcrumbsSetName(allocs, nameBuffer, &pipelineDescription->computeShader, false, &newPipeline->computeShader);
-    breadcrumbsSetName(allocs, nameBuffer, &pipelineDescription->rayTracingShader, false, &newPipeline->rayTracingShader);
+    newPipeline->index = (uint32_t)registry->pipelinesCount++;
+    breadcrumbsSetName(allocs, names, &pipelineDescription->name, &newPipeline->name);
+    breadcrumbsSetName(allocs, names, &pipelineDescription->vertexShader, &newPipeline->vertexShader);
+    breadcrumbsSetName(allocs, names, &pipelineDescription->hullShader, &newPipeline->hullShader);
+    breadcrumbsSetName(allocs, names, &pipelineDescription->domainShader, &newPipeline->domainShader);
+    breadcrumbsSetName(allocs, names, &pipelineDescription->geometryShader, &newPipeline->geometryShader);
+    breadcrumbsSetName(allocs, names, &pipelineDescription->meshShader, &newPipeline->meshShader);
+    breadcrumbsSetName(allocs, names, &pipelineDescription->amplificationShader, &newPipeline->amplificationShader);
+    breadcrumbsSetName(allocs, names, &pipelineDescription->pixelShader, &newPipeline->pixelShader);
+    breadcrumbsSetName(allocs, names, &pipelineDescription->computeShader, &newPipeline->computeShader);
+    breadcrumbsSetName(allocs, names, &pipelineDescription->rayTracingShader, &newPipeline->rayTracingShader);
+
+    // Make pipeline visible to lookups only when it's fully filled
+    breadcrumbsHandleTableInsert(allocs, &registry->pTable, newPipeline->pipeline, newPipeline);
 
     if (lockEnable)
     {
-        FFX_MUTEX_UNLOCK(contextPrivate->pipelinesNamesBuffer.mutex);
+        FFX_MUTEX_UNLOCK(registry->mutex);
     }
     return FFX_OK;
 }
@@ -494,26 +708,12 @@ FfxErrorCode ffxBreadcrumbsSetPipeline(FfxBreadcrumbsContext* context, FfxComman
     if (FFX_CONTAINS_FLAG(contextPrivate->contextDescription.flags, FFX_BREADCRUMBS_PRINT_SKIP_PIPELINE_INFO))
         return FFX_OK;
 
-    FfxErrorCode ret = FFX_OK;
-    BreadcrumbsFrameData* frame = breadcrumbsGetCurrentFrame(contextPrivate);
-
-    const bool lockEnable = FFX_CONTAINS_FLAG(contextPrivate->contextDescription.flags, FFX_BREADCRUMBS_ENABLE_THREAD_SYNCHRONIZATION);
-    if (lockEnable)
-    {
-        FFX_MUTEX_LOCK_SHARED(frame->listMutex);
-    }
-
-    BreadcrumbsListData* listData = breadcrumbsSearchList(frame, commandList);
-    if (listData)
-        listData->currentPipeline = pipeline;
-    else
-        ret = FFX_ERROR_INVALID_ARGUMENT;
+    // No need for lock, list data is only used by the thread recording it.
+    BreadcrumbsListData* listData = breadcrumbsSearchList(breadcrumbsGetCurrentFrame(contextPrivate), commandList);
+    FFX_RETURN_ON_ERROR(listData, FFX_ERROR_INVALID_ARGUMENT);
 
-    if (lockEnable)
-    {
-        FFX_MUTEX_UNLOCK_SHARED(frame->listMutex);
-    }
-    return ret;
+    listData->currentPipeline = pipeline;
+    return FFX_OK;
 }
 
 FfxErrorCode ffxBreadcrumbsBeginMarker(FfxBreadcrumbsContext* context, FfxCommandList commandList, FfxBreadcrumbsMarkerType type, const FfxBreadcrumbsNameTag* name)
@@ -529,89 +729,53 @@ FfxErrorCode ffxBreadcrumbsBeginMarker(FfxBreadcrumbsContext* context, FfxComman
     FfxBreadcrumbsContext_Private* contextPrivate = (FfxBreadcrumbsContext_Private*)(context);
     BreadcrumbsFrameData* frame = breadcrumbsGetCurrentFrame(contextPrivate);
 
+    // No need for lock, list data is only used by the thread recording it.
+    BreadcrumbsListData* listData = breadcrumbsSearchList(frame, commandList);
+    FFX_RETURN_ON_ERROR(listData, FFX_ERROR_INVALID_ARGUMENT);
+    FFX_ASSERT(listData->queueType < contextPrivate->contextDescription.usedGpuQueuesCount);
+
+    FfxAllocationCallbacks* allocs = &contextPrivate->contextDescription.allocCallbacks;
     BreadcrumbsMarkerData markerData = {};
     markerData.type = type;
+    markerData.usedPipeline = listData->currentPipeline;
+    markerData.nestingLevel = listData->currentStackCount;
+    breadcrumbsSetName(allocs, &listData->names, name, &markerData.name);
 
-    FfxAllocationCallbacks* allocs = &contextPrivate->contextDescription.allocCallbacks;
-    const bool lockEnable = FFX_CONTAINS_FLAG(contextPrivate->contextDescription.flags, FFX_BREADCRUMBS_ENABLE_THREAD_SYNCHRONIZATION);
-    breadcrumbsSetName(allocs, &frame->namesBuffer, name, lockEnable, &markerData.name);
+    // Reserve slot for marker in the queue memory, blocks are filled one after another.
+    BreadcrumbsBlockVector* queueBlocks = frame->pBlockPerQueue + listData->queueType;
+    const uint32_t markersPerBlock = contextPrivate->contextDescription.maxMarkersPerMemoryBlock;
+    const uint64_t slot = queueBlocks->nextMarker.fetch_add(1, std::memory_order_relaxed);
+    markerData.block = (size_t)(slot / markersPerBlock);
+    markerData.offset = (uint32_t)(slot % markersPerBlock);
 
-    // Get queue type of current command list.
-    if (lockEnable)
-    {
-        FFX_MUTEX_LOCK_SHARED(frame->listMutex);
-    }
-    BreadcrumbsListData* listData = breadcrumbsSearchList(frame, commandList);
-    if (listData == nullptr)
+    if (markerData.block >= queueBlocks->memoryBlocksCount.load(std::memory_order_acquire))
     {
+        // Only lock when all blocks are used up, other threads may need a new one at the same time.
+        const bool lockEnable = FFX_CONTAINS_FLAG(contextPrivate->contextDescription.flags, FFX_BREADCRUMBS_ENABLE_THREAD_SYNCHRONIZATION);
         if (lockEnable)
         {
-            FFX_MUTEX_UNLOCK_SHARED(frame->listMutex);
+            FFX_MUTEX_LOCK(frame->blockMutex);
         }
-        return FFX_ERROR_INVALID_ARGUMENT;
-    }
-    uint32_t queueType = listData->queueType;
-    FFX_ASSERT(queueType < contextPrivate->contextDescription.usedGpuQueuesCount);
-
-    if (lockEnable)
-    {
-        FFX_MUTEX_UNLOCK_SHARED(frame->listMutex);
-        FFX_MUTEX_LOCK(frame->blockMutex);
-    }
-
-    // Select block with free region for marker.
-    BreadcrumbsBlockVector* queueBlocks = frame->pBlockPerQueue + queueType;
-    FfxBreadcrumbsBlockData* block = breadcrumbsGetLastBlock(queueBlocks);
-    FFX_ASSERT(block);
-
-    if (block->nextMarker >= contextPrivate->contextDescription.maxMarkersPerMemoryBlock)
-    {
-        // Advance to next block.
-        if (++queueBlocks->currentBlock >= queueBlocks->memoryBlocksCount)
+        FfxErrorCode error = FFX_OK;
+        while (error == FFX_OK && markerData.block >= queueBlocks->memoryBlocksCount.load(std::memory_order_relaxed))
+            error = breadcrumbsAllocBlock(&contextPrivate->contextDescription.backendInterface, allocs, queueBlocks, markersPerBlock);
+        if (lockEnable)
         {
-            FfxErrorCode error = breadcrumbsAllocBlock(&contextPrivate->contextDescription.backendInterface, allocs,
-                queueBlocks, contextPrivate->contextDescription.maxMarkersPerMemoryBlock);
-            if (error != FFX_OK)
-            {
-                FFX_MUTEX_UNLOCK(frame->blockMutex);
-                return error;
-            }
-            block = breadcrumbsGetLastBlock(queueBlocks);
+            FFX_MUTEX_UNLOCK(frame->blockMutex);
         }
-        else
-            block->nextMarker = 0;
+        if (error != FFX_OK)
+            return error;
     }
+    const FfxBreadcrumbsBlockData* block = breadcrumbsGetBlock(queueBlocks, markerData.block);
 
-    markerData.block = queueBlocks->currentBlock;
-    markerData.offset = block->nextMarker++;
-    void* buffer = block->buffer;
-    const uint64_t baseAddress = block->baseAddress;
-
-    if (lockEnable)
-    {
-        FFX_MUTEX_UNLOCK(frame->blockMutex);
-        FFX_MUTEX_LOCK_SHARED(frame->listMutex);
-    }
-
-    // Find CL.
-    listData = breadcrumbsSearchList(frame, commandList);
-    FFX_ASSERT(listData);
-    markerData.usedPipeline = listData->currentPipeline;
-    markerData.nestingLevel = listData->currentStackCount;
-
-    listData->pCurrentStack = (uint32_t*)ffxBreadcrumbsAppendList(listData->pCurrentStack, listData->currentStackCount, sizeof(uint32_t), 1, allocs);
+    listData->pCurrentStack = (uint32_t*)ffxBreadcrumbsReserveList(listData->pCurrentStack, &listData->currentStackCapacity, sizeof(uint32_t), listData->currentStackCount + 1, allocs);
     listData->pCurrentStack[listData->currentStackCount++] = listData->markersCount;
-    listData->pMarkers = (BreadcrumbsMarkerData*)ffxBreadcrumbsAppendList(listData->pMarkers, listData->markersCount, sizeof(BreadcrumbsMarkerData), 1, allocs);
+    listData->pMarkers = (BreadcrumbsMarkerData*)ffxBreadcrumbsReserveList(listData->pMarkers, &listData->markersCapacity, sizeof(BreadcrumbsMarkerData), listData->markersCount + 1, allocs);
     listData->pMarkers[listData->markersCount++] = markerData;
 
-    if (lockEnable)
-    {
-        FFX_MUTEX_UNLOCK_SHARED(frame->listMutex);
-    }
-
     // Unset bit 0 indicates that it's starting marker.
     contextPrivate->contextDescription.backendInterface.fpBreadcrumbsWrite(&contextPrivate->contextDescription.backendInterface,
-        commandList, (contextPrivate->frameIndex + 1) << 1, baseAddress + 4ULL * markerData.offset, buffer, true);
+        commandList, (contextPrivate->frameIndex + 1) << 1, block->baseAddress + 4ULL * markerData.offset, block->buffer, true);
     return FFX_OK;
 }
 
@@ -623,423 +787,225 @@ FfxErrorCode ffxBreadcrumbsEndMarker(FfxBreadcrumbsContext* context, FfxCommandL
     FfxBreadcrumbsContext_Private* contextPrivate = (FfxBreadcrumbsContext_Private*)(context);
     BreadcrumbsFrameData* frame = breadcrumbsGetCurrentFrame(contextPrivate);
 
-    const bool lockEnable = FFX_CONTAINS_FLAG(contextPrivate->contextDescription.flags, FFX_BREADCRUMBS_ENABLE_THREAD_SYNCHRONIZATION);
-    if (lockEnable)
-    {
-        FFX_MUTEX_LOCK(frame->listMutex);
-    }
-
-    // Find CL that is used with this marker
+    // Find CL that is used with this marker, no need for lock as list data is only used by the thread recording it.
     BreadcrumbsListData* listData = breadcrumbsSearchList(frame, commandList);
-    if (listData == nullptr || listData->currentStackCount == 0)
-    {
-        if (lockEnable)
-        {
-            FFX_MUTEX_UNLOCK(frame->listMutex);
-        }
-        return FFX_ERROR_INVALID_ARGUMENT;
-    }
+    FFX_RETURN_ON_ERROR(listData && listData->currentStackCount != 0, FFX_ERROR_INVALID_ARGUMENT);
 
     // Retrieve data about which marker is being closed now.
     uint32_t markerIndex = listData->pCurrentStack[--listData->currentStackCount];
     FFX_ASSERT(markerIndex < listData->markersCount);
-    listData->pCurrentStack = (uint32_t*)ffxBreadcrumbsPopList(listData->pCurrentStack, listData->currentStackCount, sizeof(uint32_t),
-        &contextPrivate->contextDescription.allocCallbacks);
 
     // Get correct location for writing
-    BreadcrumbsMarkerData* marker = listData->pMarkers + markerIndex;
-    FfxBreadcrumbsBlockData* block = frame->pBlockPerQueue[listData->queueType].pMemoryBlocks + marker->block;
-    void* buffer = block->buffer;
-    const uint64_t baseAddress = block->baseAddress;
-    const uint32_t offset = marker->offset;
-
-    if (lockEnable)
-    {
-        FFX_MUTEX_UNLOCK(frame->listMutex);
-    }
+    const BreadcrumbsMarkerData* marker = listData->pMarkers + markerIndex;
+    const FfxBreadcrumbsBlockData* block = breadcrumbsGetBlock(frame->pBlockPerQueue + listData->queueType, marker->block);
 
     // Set bit 0 indicates that it's ending marker.
     contextPrivate->contextDescription.backendInterface.fpBreadcrumbsWrite(&contextPrivate->contextDescription.backendInterface,
-        commandList, ((contextPrivate->frameIndex + 1) << 1) + 1, baseAddress + 4ULL * offset, buffer, false);
+        commandList, ((contextPrivate->frameIndex + 1) << 1) + 1, block->baseAddress + 4ULL * marker->offset, block->buffer, false);
     return FFX_OK;
 }
 
-FfxErrorCode ffxBreadcrumbsPrintStatus(FfxBreadcrumbsContext* context, FfxBreadcrumbsMarkersStatus* markersStatus)
+static uint32_t breadcrumbsSnapshotName(BreadcrumbsSnapshotNames* names, const BreadcrumbsCustomName* name)
 {
-    FFX_RETURN_ON_ERROR(context, FFX_ERROR_INVALID_POINTER);
-    FFX_RETURN_ON_ERROR(markersStatus, FFX_ERROR_INVALID_POINTER);
-    
-    FfxBreadcrumbsContext_Private* contextPrivate = (FfxBreadcrumbsContext_Private*)(context);
-    markersStatus->bufferSize = 0;
-    markersStatus->pBuffer = nullptr;
+    if (name->pName == nullptr)
+        return FFX_BREADCRUMBS_SNAPSHOT_NONE;
+
+    // Names that are not copied are shared between markers, so recently written ones are reused.
+    const size_t slot = breadcrumbsHashHandle(name->pName) % FFX_BREADCRUMBS_SNAPSHOT_NAME_CACHE_SIZE;
+    if (names->cachedNames[slot] == name->pName)
+        return names->cachedOffsets[slot];
+
+    const size_t length = strlen(name->pName) + 1;
+    FFX_ASSERT_MESSAGE(names->size + length < FFX_BREADCRUMBS_SNAPSHOT_NONE, "Too many names to save in snapshot!");
+    const uint32_t offset = (uint32_t)names->size;
+    if (names->pStrings)
+        memcpy(names->pStrings + offset, name->pName, length);
+    names->size += length;
+
+    names->cachedNames[slot] = name->pName;
+    names->cachedOffsets[slot] = offset;
+    return offset;
+}
 
-    const bool skipFinishedLists = !FFX_CONTAINS_FLAG(contextPrivate->contextDescription.flags, FFX_BREADCRUMBS_PRINT_FINISHED_LISTS);
-    const bool skipNotStartedLists = !FFX_CONTAINS_FLAG(contextPrivate->contextDescription.flags, FFX_BREADCRUMBS_PRINT_NOT_STARTED_LISTS);
-    const bool skipFinishedNodes = !FFX_CONTAINS_FLAG(contextPrivate->contextDescription.flags, FFX_BREADCRUMBS_PRINT_FINISHED_NODES);
-    const bool skipNotStartedNodes = !FFX_CONTAINS_FLAG(contextPrivate->contextDescription.flags, FFX_BREADCRUMBS_PRINT_NOT_STARTED_NODES);
-    
-    FfxAllocationCallbacks* allocs = &contextPrivate->contextDescription.allocCallbacks;
-    if (!FFX_CONTAINS_FLAG(contextPrivate->contextDescription.flags, FFX_BREADCRUMBS_PRINT_SKIP_DEVICE_INFO))
-    {
-        FFX_RETURN_ON_ERROR(contextPrivate->contextDescription.backendInterface.fpBreadcrumbsPrintDeviceInfo, FFX_ERROR_INVALID_ARGUMENT);
-        contextPrivate->contextDescription.backendInterface.fpBreadcrumbsPrintDeviceInfo(&contextPrivate->contextDescription.backendInterface, allocs,
-            FFX_CONTAINS_FLAG(contextPrivate->contextDescription.flags, FFX_BREADCRUMBS_PRINT_EXTENDED_DEVICE_INFO),
-            &markersStatus->pBuffer, &markersStatus->bufferSize);
-    }
-    FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, "[BREADCRUMBS]\n");
-    for (uint32_t i = contextPrivate->contextDescription.frameHistoryLength; i--;)
-    {
-        if (i > contextPrivate->frameIndex)
+static void breadcrumbsCaptureSnapshot(FfxBreadcrumbsContext_Private* context, BreadcrumbsSnapshotHeader* header, BreadcrumbsSnapshotNames* names, void* buffer)
+{
+    // Not protected by lock, should be called from single thread only!
+    // Without buffer only counts of all sections are gathered, they have to be unchanged when writing into the buffer later.
+    BreadcrumbsSnapshotPipeline* pipelines = nullptr;
+    BreadcrumbsSnapshotFrame* frames = nullptr;
+    BreadcrumbsSnapshotList* lists = nullptr;
+    BreadcrumbsSnapshotMarker* markers = nullptr;
+    names->pStrings = nullptr;
+    if (buffer)
+    {
+        pipelines = (BreadcrumbsSnapshotPipeline*)((BreadcrumbsSnapshotHeader*)buffer + 1);
+        frames = (BreadcrumbsSnapshotFrame*)(pipelines + header->pipelineCount);
+        lists = (BreadcrumbsSnapshotList*)(frames + header->frameCount);
+        markers = (BreadcrumbsSnapshotMarker*)(lists + header->listCount);
+        names->pStrings = (char*)(markers + header->markerCount);
+    }
+    header->frameCount = 0;
+    header->listCount = 0;
+    header->markerCount = 0;
+    header->pipelineCount = 0;
+    // Device info is placed at the start of the strings.
+    names->size = header->deviceInfoSize;
+    for (uint32_t i = 0; i < FFX_BREADCRUMBS_SNAPSHOT_NAME_CACHE_SIZE; ++i)
+        names->cachedNames[i] = nullptr;
+
+    const BreadcrumbsPipelineRegistry* registry = context->pPipelines;
+    for (size_t p = 0; p < registry->pipelinesCount; ++p)
+    {
+        const BreadcrumbsPipelineData* pipeline = (const BreadcrumbsPipelineData*)breadcrumbsGetElement(&registry->pipelines, p, sizeof(BreadcrumbsPipelineData));
+        FFX_ASSERT(pipeline->index == p);
+
+        BreadcrumbsSnapshotPipeline snapshotPipeline;
+        snapshotPipeline.pipeline = (uint64_t)(uintptr_t)pipeline->pipeline;
+        snapshotPipeline.name = breadcrumbsSnapshotName(names, &pipeline->name);
+        snapshotPipeline.vertexShader = breadcrumbsSnapshotName(names, &pipeline->vertexShader);
+        snapshotPipeline.hullShader = breadcrumbsSnapshotName(names, &pipeline->hullShader);
+        snapshotPipeline.domainShader = breadcrumbsSnapshotName(names, &pipeline->domainShader);
+        snapshotPipeline.geometryShader = breadcrumbsSnapshotName(names, &pipeline->geometryShader);
+        snapshotPipeline.meshShader = breadcrumbsSnapshotName(names, &pipeline->meshShader);
+        snapshotPipeline.amplificationShader = breadcrumbsSnapshotName(names, &pipeline->amplificationShader);
+        snapshotPipeline.pixelShader = breadcrumbsSnapshotName(names, &pipeline->pixelShader);
+        snapshotPipeline.computeShader = breadcrumbsSnapshotName(names, &pipeline->computeShader);
+        snapshotPipeline.rayTracingShader = breadcrumbsSnapshotName(names, &pipeline->rayTracingShader);
+        if (pipelines)
+            pipelines[header->pipelineCount] = snapshotPipeline;
+        ++header->pipelineCount;
+    }
+
+    for (uint32_t i = context->contextDescription.frameHistoryLength; i--;)
+    {
+        if (i > context->frameIndex)
             continue;
-        const uint32_t currentFrame = contextPrivate->frameIndex - i;
-        FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, "<Frame ");
-        FFX_BREADCRUMBS_APPEND_UINT(markersStatus->pBuffer, markersStatus->bufferSize, currentFrame);
-        FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, ">\n");
+        const uint32_t currentFrame = context->frameIndex - i;
 
         // Move backwards in recorded frames inside ring buffer for frames in flight.
-        BreadcrumbsFrameData* frame = contextPrivate->pFrameData + (currentFrame % contextPrivate->contextDescription.frameHistoryLength);
-        if (frame->usedListsCount == 0)
+        const BreadcrumbsFrameData* frame = context->pFrameData + (currentFrame % context->contextDescription.frameHistoryLength);
+        if (frames)
         {
-            FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, " - No command lists\n");
-            continue;
+            frames[header->frameCount].frameIndex = currentFrame;
+            frames[header->frameCount].listCount = (uint32_t)frame->usedListsCount;
         }
+        ++header->frameCount;
+
         for (size_t j = 0; j < frame->usedListsCount; ++j)
         {
-            FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, " - [");
-
-            BreadcrumbsListData* cl = frame->pUsedLists + j;
-            bool skipList = false;
-            uint32_t markerFrame = UINT32_MAX;
-            const uint32_t* location = nullptr;
+            const BreadcrumbsListData* cl = breadcrumbsGetList(frame, j);
             const BreadcrumbsBlockVector* queueBlocks = frame->pBlockPerQueue + cl->queueType;
-            // Check for finished or not started CLs
-            if (cl->markersCount > 0)
-            {
-                // Inspect last marker's memory location to determine it's status and decode it's frame value (coded in 31-1 bits of saved data minus 1)
-                BreadcrumbsMarkerData* lastMarker = cl->pMarkers + cl->markersCount - 1;
-                location = (uint32_t*)(queueBlocks->pMemoryBlocks[lastMarker->block].memory) + lastMarker->offset;
-                markerFrame = (*location >> 1) - 1;
-                FFX_ASSERT_MESSAGE(markerFrame <= currentFrame, "Should not find value higher than current frame!");
 
-                if (markerFrame == currentFrame)
-                {
-                    // Check marker status: 0 - started, 1 - finished
-                    // If finished then all previous have also finished
-                    if (*location & 1)
-                    {
-                        FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, "X");
-                        skipList = skipFinishedLists;
-                    }
-                    else
-                    {
-                        FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, ">");
-                    }
-                }
-                else // markerFrame < currentFrame, last case is asserted for
-                {
-                    // Same check for first marker
-                    location = (uint32_t*)(queueBlocks->pMemoryBlocks[cl->pMarkers->block].memory) + cl->pMarkers->offset;
-                    markerFrame = (*location >> 1) - 1;
-                    FFX_ASSERT_MESSAGE(markerFrame <= currentFrame, "Should not find value higher than current frame!");
-
-                    // If first marker have not started yet, then none in this command list has started too
-                    if (markerFrame < currentFrame)
-                    {
-                        FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, " ");
-                        skipList = skipNotStartedLists;
-                    }
-                    else
-                    {
-                        FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, ">");
-                    }
-                }
-            }
-            else
-            {
-                FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, " ");
-                skipList = true;
-            }
+            BreadcrumbsSnapshotList snapshotList;
+            snapshotList.queueType = cl->queueType;
+            snapshotList.submissionIndex = cl->submissionIndex;
+            snapshotList.name = breadcrumbsSnapshotName(names, &cl->name);
+            snapshotList.markerCount = cl->markersCount;
+            if (lists)
+                lists[header->listCount] = snapshotList;
+            ++header->listCount;
 
-            FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, "] Queue type <");
-            FFX_BREADCRUMBS_APPEND_UINT(markersStatus->pBuffer, markersStatus->bufferSize, cl->queueType);
-            FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, ">, submission no. ");
-            FFX_BREADCRUMBS_APPEND_UINT(markersStatus->pBuffer, markersStatus->bufferSize, cl->submissionIndex);
-            FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, ", command list ");
-            FFX_BREADCRUMBS_APPEND_UINT64(markersStatus->pBuffer, markersStatus->bufferSize, j + 1);
-            if (cl->name.pName)
-            {
-                FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, ": \"");
-                FFX_BREADCRUMBS_APPEND_STRING_DYNAMIC(markersStatus->pBuffer, markersStatus->bufferSize, breadcrumbsGetName(&frame->namesBuffer, &cl->name));
-                FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, "\"");
-            }
-            FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, "\n");
-            if (skipList)
-                continue;
-
-            // Indices determining how long given nesting level will be present before moving up in hierarchy.
-            uint32_t* nestingLevelIndicatorIndices = (uint32_t*)ffxBreadcrumbsAppendList(nullptr, 0, sizeof(uint32_t), 1, allocs);
-            nestingLevelIndicatorIndices[0] = 0;
-            uint32_t nestingLevelIndicesCount = 1;
-
-            // Display level informs from which point deeper markers can be cut out
-            // in case of collapsing uniform nodes (markers that all nested markers have same finished or not started status).
-            uint32_t displayLevel = UINT32_MAX;
-            uint32_t markerId = 0;
-
-            FfxBreadcrumbsMarkerType currentType = FFX_BREADCRUMBS_MARKER_PASS;
-            // Go through every marker in command list and display it's info
             for (uint32_t m = 0; m < cl->markersCount; ++m)
             {
-                BreadcrumbsMarkerData* marker = cl->pMarkers + m;
-                // Same checks as before with determining if marker is finished or not started
-                location = (uint32_t*)(queueBlocks->pMemoryBlocks[marker->block].memory) + marker->offset;
-                markerFrame = (*location >> 1) - 1;
-                FFX_ASSERT_MESSAGE(markerFrame <= currentFrame, "Should not find value higher than current frame!");
-
-                char status = ' ';
-                if (markerFrame == currentFrame)
-                {
-                    if (*location & 1)
-                        status = 'X';
-                    else
-                        status = '>';
-                }
-
-                // When going deeper into hierarchy allocate new index for marker.
-                if (marker->nestingLevel >= nestingLevelIndicesCount)
-                {
-                    markerId = 0;
-                    nestingLevelIndicatorIndices = (uint32_t*)ffxBreadcrumbsAppendList(nestingLevelIndicatorIndices, nestingLevelIndicesCount, sizeof(uint32_t), 1, allocs);
-                    nestingLevelIndicatorIndices[nestingLevelIndicesCount++] = 0;
-                    // Check whether deeper nodes will be collapsed or not.
-                    if (((skipFinishedNodes && status == 'X') || (skipNotStartedNodes && status == ' ')) && displayLevel == UINT32_MAX)
-                        displayLevel = marker->nestingLevel;
-                }
-                else
+                const BreadcrumbsMarkerData* marker = cl->pMarkers + m;
+
+                BreadcrumbsSnapshotMarker snapshotMarker;
+                snapshotMarker.type = marker->type;
+                snapshotMarker.nestingLevel = marker->nestingLevel;
+                snapshotMarker.name = breadcrumbsSnapshotName(names, &marker->name);
+                snapshotMarker.pipeline = FFX_BREADCRUMBS_SNAPSHOT_NONE;
+                if (marker->usedPipeline)
                 {
-                    if (skipFinishedNodes || skipNotStartedNodes)
-                    {
-                        // If going up in hierarchy check wheter displayLevel can be relaxed or restricted to upper level.
-                        if (displayLevel != UINT32_MAX)
-                        {
-                            if (displayLevel > marker->nestingLevel)
-                                displayLevel = status == '>' ? UINT32_MAX : marker->nestingLevel;
-                            else if (displayLevel == marker->nestingLevel && status == '>')
-                                displayLevel = UINT32_MAX;
-                        }
-                        else if ((skipFinishedNodes && status == 'X') || (skipNotStartedNodes && status == ' '))
-                            displayLevel = marker->nestingLevel;
-                    }
-                    // Pop indicators when moving to up in nesting levels
-                    if (marker->nestingLevel + 1 < nestingLevelIndicesCount)
-                        markerId = 0;
-                    while (marker->nestingLevel + 1 < nestingLevelIndicesCount)
-                        nestingLevelIndicatorIndices = (uint32_t*)ffxBreadcrumbsPopList(nestingLevelIndicatorIndices, --nestingLevelIndicesCount, sizeof(uint32_t), allocs);
+                    const BreadcrumbsPipelineData* pipeline = breadcrumbsSearchPipeline(context, marker->usedPipeline);
+                    FFX_ASSERT_MESSAGE(pipeline, "When pipeline has been properly set on command list it should always be present here!");
+                    if (pipeline)
+                        snapshotMarker.pipeline = pipeline->index;
                 }
-                if (marker->type != currentType)
+                if (markers)
                 {
-                    currentType = marker->type;
-                    markerId = 0;
+                    // Only copy of the value written by GPU is needed, it's decoded when printing the snapshot.
+                    snapshotMarker.value = *((uint32_t*)(breadcrumbsGetBlock(queueBlocks, marker->block)->memory) + marker->offset);
+                    markers[header->markerCount] = snapshotMarker;
                 }
+                ++header->markerCount;
+            }
+        }
+    }
+    header->stringsSize = names->size;
+}
 
-                if (marker->nestingLevel <= displayLevel)
-                {
-                    // When on next level, check for newer indices
-                    uint32_t* lastIdx = nestingLevelIndicatorIndices + nestingLevelIndicesCount - 1;
-                    if (*lastIdx != UINT32_MAX && *lastIdx <= m)
-                    {
-                        *lastIdx = UINT32_MAX;
-                        // Detect how long given level will be present to calculate proper tree branches
-                        for (uint32_t next = m + 1; next < cl->markersCount; ++next)
-                        {
-                            const uint32_t nestingLevel = cl->pMarkers[next].nestingLevel;
-                            if (nestingLevel < marker->nestingLevel)
-                                break;
-                            else if (nestingLevel == marker->nestingLevel)
-                                *lastIdx = next;
-                        }
-                    }
+FfxErrorCode ffxBreadcrumbsSaveSnapshot(FfxBreadcrumbsContext* context, FfxBreadcrumbsSnapshot* snapshot)
+{
+    FFX_RETURN_ON_ERROR(context, FFX_ERROR_INVALID_POINTER);
+    FFX_RETURN_ON_ERROR(snapshot, FFX_ERROR_INVALID_POINTER);
 
-                    // Mark previous levels in tree and display current entry
-                    FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, "  ");
-                    for (uint32_t k = 0; k < marker->nestingLevel; ++k)
-                    {
-                        FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, "  ");
-                        if (nestingLevelIndicatorIndices[k] != UINT32_MAX && nestingLevelIndicatorIndices[k] > m)
-                        {
-                            FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, "\xe2\x94\x82"); // `|`
-                        }
-                        else
-                        {
-                            FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, " ");
-                        }
-                    }
+    FfxBreadcrumbsContext_Private* contextPrivate = (FfxBreadcrumbsContext_Private*)(context);
+    snapshot->bufferSize = 0;
+    snapshot->pBuffer = nullptr;
 
-                    FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, "  ");
-                    if (nestingLevelIndicatorIndices[nestingLevelIndicesCount - 1] == UINT32_MAX || nestingLevelIndicatorIndices[nestingLevelIndicesCount - 1] == m)
-                    {
-                        FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, "\xe2\x94\x94"); // `'-`
-                    }
-                    else
-                    {
-                        FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, "\xe2\x94\x9c"); // `|-`
-                    }
+    FfxAllocationCallbacks* allocs = &contextPrivate->contextDescription.allocCallbacks;
+    char* deviceInfo = nullptr;
+    size_t deviceInfoSize = 0;
+    if (!FFX_CONTAINS_FLAG(contextPrivate->contextDescription.flags, FFX_BREADCRUMBS_PRINT_SKIP_DEVICE_INFO))
+    {
+        FFX_RETURN_ON_ERROR(contextPrivate->contextDescription.backendInterface.fpBreadcrumbsPrintDeviceInfo, FFX_ERROR_INVALID_ARGUMENT);
+        contextPrivate->contextDescription.backendInterface.fpBreadcrumbsPrintDeviceInfo(&contextPrivate->contextDescription.backendInterface, allocs,
+            FFX_CONTAINS_FLAG(contextPrivate->contextDescription.flags, FFX_BREADCRUMBS_PRINT_EXTENDED_DEVICE_INFO),
+            &deviceInfo, &deviceInfoSize);
+    }
 
-                    FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, "\xe2\x94\x80["); // `-`
-                    markersStatus->pBuffer = (char*)ffxBreadcrumbsAppendList(markersStatus->pBuffer, markersStatus->bufferSize, sizeof(char), 1, allocs);
-                    markersStatus->pBuffer[markersStatus->bufferSize++] = status;
-                    FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, "] ");
+    BreadcrumbsSnapshotHeader header = {};
+    header.magic = FFX_BREADCRUMBS_SNAPSHOT_MAGIC;
+    header.version = FFX_BREADCRUMBS_SNAPSHOT_VERSION;
+    header.flags = contextPrivate->contextDescription.flags;
+    header.deviceInfoSize = (uint32_t)deviceInfoSize;
 
-                    if (marker->type == FFX_BREADCRUMBS_MARKER_PASS)
-                    {
-                        FFX_ASSERT_MESSAGE(marker->name.pName, "Custom passes should always have names!");
-                        FFX_BREADCRUMBS_APPEND_STRING_DYNAMIC(markersStatus->pBuffer, markersStatus->bufferSize, breadcrumbsGetName(&frame->namesBuffer, &marker->name));
-                    }
-                    else
-                    {
-                        FFX_BREADCRUMBS_APPEND_STRING_DYNAMIC(markersStatus->pBuffer, markersStatus->bufferSize, breadDecodeMarkerType(marker->type));
-                        if (markerId != 0 || m + 1 < cl->markersCount && cl->pMarkers[m + 1].type == marker->type)
-                        {
-                            FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, " ");
-                            FFX_BREADCRUMBS_APPEND_UINT(markersStatus->pBuffer, markersStatus->bufferSize, ++markerId);
-                        }
-                        if (marker->name.pName)
-                        {
-                            FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, ": \"");
-                            FFX_BREADCRUMBS_APPEND_STRING_DYNAMIC(markersStatus->pBuffer, markersStatus->bufferSize, breadcrumbsGetName(&frame->namesBuffer, &marker->name));
-                            FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, "\"");
-                        }
-                    }
-                    if (marker->usedPipeline)
-                    {
-                        BreadcrumbsPipelineData* pipeline = breadcrumbsSearchPipeline(contextPrivate, marker->usedPipeline);
-                        FFX_ASSERT_MESSAGE(pipeline, "When pipeline has been properly set on command list it should always be present here!");
-
-                        const bool isCompute = pipeline->computeShader.pName != nullptr;
-                        const bool isRT = pipeline->rayTracingShader.pName != nullptr;
-                        const bool isVertexShading = pipeline->vertexShader.pName || pipeline->hullShader.pName || pipeline->domainShader.pName || pipeline->geometryShader.pName;
-                        const bool isMeshShading = pipeline->meshShader.pName || pipeline->amplificationShader.pName;
-                        const bool isGfx = isVertexShading || isMeshShading || pipeline->pixelShader.pName;
-                        FFX_ASSERT_MESSAGE((!isCompute && !isRT) || (!isCompute && !isGfx) || (!isRT && !isGfx), "Wrong combination of shaders for pipeline!");
-                        FFX_ASSERT_MESSAGE(!(isVertexShading && isMeshShading), "Wrong combination of geometry processing for graphics pipeline!");
-
-                        FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, ", ");
-                        if (isCompute)
-                        {
-                            FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, "compute ");
-                        }
-                        else if (isRT)
-                        {
-                            FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, "ray tracing ");
-                        }
-                        else if (isGfx)
-                        {
-                            FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, "graphics ");
-                        }
-                        FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, "pipeline");
-                        if (pipeline->name.pName)
-                        {
-                            FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, " \"");
-                            FFX_BREADCRUMBS_APPEND_STRING_DYNAMIC(markersStatus->pBuffer, markersStatus->bufferSize, breadcrumbsGetName(&contextPrivate->pipelinesNamesBuffer, &pipeline->name));
-                            FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, "\"");
-                        }
-
-                        if (isCompute)
-                        {
-                            FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, " [ CS: ");
-                            FFX_BREADCRUMBS_APPEND_STRING_DYNAMIC(markersStatus->pBuffer, markersStatus->bufferSize, breadcrumbsGetName(&contextPrivate->pipelinesNamesBuffer, &pipeline->computeShader));
-                            FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, " ]");
-                        }
-                        else if (isRT)
-                        {
-                            FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, " [ RT: ");
-                            FFX_BREADCRUMBS_APPEND_STRING_DYNAMIC(markersStatus->pBuffer, markersStatus->bufferSize, breadcrumbsGetName(&contextPrivate->pipelinesNamesBuffer, &pipeline->rayTracingShader));
-                            FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, " ]");
-                        }
-                        else if (isGfx)
-                        {
-                            FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, " [");
-                            bool before = false;
-                            if (isVertexShading)
-                            {
-                                if (pipeline->vertexShader.pName)
-                                {
-                                    before = true;
-                                    FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, " VS: ");
-                                    FFX_BREADCRUMBS_APPEND_STRING_DYNAMIC(markersStatus->pBuffer, markersStatus->bufferSize, breadcrumbsGetName(&contextPrivate->pipelinesNamesBuffer, &pipeline->vertexShader));
-                                }
-                                if (pipeline->hullShader.pName)
-                                {
-                                    if (before)
-                                    {
-                                        FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, " |");
-                                    }
-                                    before = true;
-                                    FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, " HS: ");
-                                    FFX_BREADCRUMBS_APPEND_STRING_DYNAMIC(markersStatus->pBuffer, markersStatus->bufferSize, breadcrumbsGetName(&contextPrivate->pipelinesNamesBuffer, &pipeline->hullShader));
-                                }
-                                if (pipeline->domainShader.pName)
-                                {
-                                    if (before)
-                                    {
-                                        FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, " |");
-                                    }
-                                    before = true;
-                                    FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, " DS: ");
-                                    FFX_BREADCRUMBS_APPEND_STRING_DYNAMIC(markersStatus->pBuffer, markersStatus->bufferSize, breadcrumbsGetName(&contextPrivate->pipelinesNamesBuffer, &pipeline->domainShader));
-                                }
-                                if (pipeline->geometryShader.pName)
-                                {
-                                    if (before)
-                                    {
-                                        FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, " |");
-                                    }
-                                    before = true;
-                                    FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, " GS: ");
-                                    FFX_BREADCRUMBS_APPEND_STRING_DYNAMIC(markersStatus->pBuffer, markersStatus->bufferSize, breadcrumbsGetName(&contextPrivate->pipelinesNamesBuffer, &pipeline->geometryShader));
-                                }
-                            }
-                            else if (isMeshShading)
-                            {
-                                if (pipeline->meshShader.pName)
-                                {
-                                    before = true;
-                                    FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, " MS: ");
-                                    FFX_BREADCRUMBS_APPEND_STRING_DYNAMIC(markersStatus->pBuffer, markersStatus->bufferSize, breadcrumbsGetName(&contextPrivate->pipelinesNamesBuffer, &pipeline->meshShader));
-                                }
-                                if (pipeline->amplificationShader.pName)
-                                {
-                                    if (before)
-                                    {
-                                        FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, " |");
-                                    }
-                                    before = true;
-                                    FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, " AS: ");
-                                    FFX_BREADCRUMBS_APPEND_STRING_DYNAMIC(markersStatus->pBuffer, markersStatus->bufferSize, breadcrumbsGetName(&contextPrivate->pipelinesNamesBuffer, &pipeline->amplificationShader));
-                                }
-                            }
-                            if (pipeline->pixelShader.pName)
-                            {
-                                if (before)
-                                {
-                                    FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, " |");
-                                }
-                                before = true;
-                                FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, " PS: ");
-                                FFX_BREADCRUMBS_APPEND_STRING_DYNAMIC(markersStatus->pBuffer, markersStatus->bufferSize, breadcrumbsGetName(&contextPrivate->pipelinesNamesBuffer, &pipeline->pixelShader));
-                            }
-                            FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, " ]");
-                        }
-                    }
-                    FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, "\n");
-                }
-            }
-        }
+    // First pass only gathers sizes of the sections, so whole snapshot is written into single allocation.
+    BreadcrumbsSnapshotNames names;
+    breadcrumbsCaptureSnapshot(contextPrivate, &header, &names, nullptr);
+    const uint64_t size = breadcrumbsGetSnapshotSize(&header);
+
+    void* buffer = allocs->fpAlloc((size_t)size);
+    if (buffer == nullptr)
+    {
+        if (deviceInfo)
+            allocs->fpFree(deviceInfo);
+        return FFX_ERROR_OUT_OF_MEMORY;
     }
+    breadcrumbsCaptureSnapshot(contextPrivate, &header, &names, buffer);
+    FFX_ASSERT_MESSAGE(breadcrumbsGetSnapshotSize(&header) == size, "Markers have been recorded while saving snapshot!");
 
+    memcpy(buffer, &header, sizeof(BreadcrumbsSnapshotHeader));
+    if (deviceInfo)
+    {
+        memcpy(names.pStrings, deviceInfo, deviceInfoSize);
+        allocs->fpFree(deviceInfo);
+    }
+    snapshot->bufferSize = (size_t)size;
+    snapshot->pBuffer = buffer;
     return FFX_OK;
 }
 
+FfxErrorCode ffxBreadcrumbsPrintStatus(FfxBreadcrumbsContext* context, FfxBreadcrumbsMarkersStatus* markersStatus)
+{
+    FFX_RETURN_ON_ERROR(context, FFX_ERROR_INVALID_POINTER);
+    FFX_RETURN_ON_ERROR(markersStatus, FFX_ERROR_INVALID_POINTER);
+
+    FfxBreadcrumbsContext_Private* contextPrivate = (FfxBreadcrumbsContext_Private*)(context);
+    markersStatus->bufferSize = 0;
+    markersStatus->pBuffer = nullptr;
+
+    // Status is always printed from a snapshot, so the output is the same as when decoding saved snapshots later on.
+    FfxBreadcrumbsSnapshot snapshot;
+    FfxErrorCode errorCode = ffxBreadcrumbsSaveSnapshot(context, &snapshot);
+    FFX_RETURN_ON_ERROR(errorCode == FFX_OK, errorCode);
+
+    FfxAllocationCallbacks* allocs = &contextPrivate->contextDescription.allocCallbacks;
+    errorCode = ffxBreadcrumbsPrintSnapshot(&snapshot, FFX_BREADCRUMBS_STATUS_FORMAT_TEXT, allocs, markersStatus);
+    allocs->fpFree(snapshot.pBuffer);
+    return errorCode;
+}
+
 FFX_API FfxVersionNumber ffxBreadcrumbsGetEffectVersion()
 {
     return FFX_SDK_MAKE_VERSION(FFX_BREADCRUMBS_VERSION_MAJOR, FFX_BREADCRUMBS_VERSION_MINOR, FFX_BREADCRUMBS_VERSION_PATCH);
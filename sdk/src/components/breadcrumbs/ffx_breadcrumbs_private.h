@@ -21,28 +21,66 @@
 // THE SOFTWARE.
 
 #pragma once
+#include <atomic>
 #include <FidelityFX/host/ffx_breadcrumbs.h>
+#include "ffx_breadcrumbs_snapshot.h"
+
+// Segment i of a BreadcrumbsSegmentedArray holds FFX_BREADCRUMBS_SEGMENT_BASE_SIZE << i elements.
+#define FFX_BREADCRUMBS_SEGMENT_BASE_SIZE 16
+#define FFX_BREADCRUMBS_MAX_SEGMENTS      32
+// Initial size of the storage for copied names.
+#define FFX_BREADCRUMBS_NAME_CHUNK_SIZE   1024
+
+// Growable array whose elements never move. Segments are added under the owner's lock and published atomically,
+// so published elements can be accessed without locking while the array grows. New segments are zeroed.
+typedef struct BreadcrumbsSegmentedArray {
+
+    std::atomic<uint8_t*>               pSegments[FFX_BREADCRUMBS_MAX_SEGMENTS];
+} BreadcrumbsSegmentedArray;
+
+// Record pointer is written before the handle is published.
+typedef struct BreadcrumbsHandleSlot {
+
+    std::atomic<const void*>            handle;
+    void*                               pRecord;
+} BreadcrumbsHandleSlot;
+
+// Open addressing table mapping command list or pipeline handles to their records, slots follow the header.
+// Lookups don't lock: slots are published with release stores and a grown table replaces the previous one atomically.
+// Replaced tables are kept in pRetired until no lookup can be using them anymore.
+typedef struct BreadcrumbsHandleTable {
+
+    size_t                              capacity;       // Power of two, kept at least twice the entry count.
+    size_t                              count;
+    struct BreadcrumbsHandleTable*      pRetired;
+} BreadcrumbsHandleTable;
 
 typedef struct BreadcrumbsBlockVector {
 
-    size_t                              memoryBlocksCount;
-    size_t                              currentBlock;
-    FfxBreadcrumbsBlockData*            pMemoryBlocks;
+    std::atomic<uint64_t>               nextMarker;         // Markers reserved on the queue this frame, slot n is in block n / maxMarkersPerMemoryBlock.
+    std::atomic<size_t>                 memoryBlocksCount;
+    BreadcrumbsSegmentedArray           memoryBlocks;       // FfxBreadcrumbsBlockData
 } BreadcrumbsBlockVector;
 
 typedef struct BreadcrumbsCustomName {
 
     char*                               pName;
-    bool                                isCopied;
 } BreadcrumbsCustomName;
 
-typedef struct BreadcrumbsCustomNameBuffer {
+// Name storage follows the header.
+typedef struct BreadcrumbsNameChunk {
 
-    size_t                              bufferSize;
-    char*                               pBuffer;
-    size_t                              currentNamesOffset;
-    FFX_MUTEX                           mutex;
-} BreadcrumbsCustomNameBuffer;
+    struct BreadcrumbsNameChunk*        pNext;
+    size_t                              size;
+    size_t                              used;
+} BreadcrumbsNameChunk;
+
+// Copied names, only filled by one thread at a time. Chunks are kept when resetting, so a warmed up owner doesn't allocate.
+typedef struct BreadcrumbsNameStorage {
+
+    BreadcrumbsNameChunk*               pFirstChunk;
+    BreadcrumbsNameChunk*               pCurrentChunk;
+} BreadcrumbsNameStorage;
 
 typedef struct BreadcrumbsMarkerData {
 
@@ -54,6 +92,7 @@ typedef struct BreadcrumbsMarkerData {
     FfxPipeline                         usedPipeline;
 } BreadcrumbsMarkerData;
 
+// Recording state of a command list. Only touched by the thread recording the list, so markers are recorded without locks.
 typedef struct BreadcrumbsListData {
 
     FfxCommandList                      list;
@@ -62,25 +101,30 @@ typedef struct BreadcrumbsListData {
     BreadcrumbsCustomName               name;
     FfxPipeline                         currentPipeline;
     uint32_t                            markersCount;
+    size_t                              markersCapacity;
     BreadcrumbsMarkerData*              pMarkers;
     // Indices for ending markers.
     uint32_t                            currentStackCount;
+    size_t                              currentStackCapacity;
     uint32_t*                           pCurrentStack;
+    BreadcrumbsNameStorage              names;
 } BreadcrumbsListData;
 
 typedef struct BreadcrumbsFrameData {
 
     size_t                              usedListsCount;
-    BreadcrumbsListData*                pUsedLists;
+    // Lists past usedListsCount are left over from earlier frames, their storage is reused by new lists.
+    BreadcrumbsSegmentedArray           usedLists;          // BreadcrumbsListData
+    std::atomic<BreadcrumbsHandleTable*> pUsedListsTable;
     BreadcrumbsBlockVector*             pBlockPerQueue;
-    BreadcrumbsCustomNameBuffer         namesBuffer;
-    FFX_MUTEX                           listMutex;
-    FFX_MUTEX                           blockMutex;
+    FFX_MUTEX                           listMutex;          // Only taken to register command lists.
+    FFX_MUTEX                           blockMutex;         // Only taken to allocate a new memory block.
 } BreadcrumbsFrameData;
 
 typedef struct BreadcrumbsPipelineData {
 
     FfxPipeline                         pipeline;
+    uint32_t                            index;              // Registration order, used to refer to the pipeline in snapshots.
     BreadcrumbsCustomName               name;
     BreadcrumbsCustomName               vertexShader;
     BreadcrumbsCustomName               hullShader;
@@ -93,6 +137,28 @@ typedef struct BreadcrumbsPipelineData {
     BreadcrumbsCustomName               rayTracingShader;
 } BreadcrumbsPipelineData;
 
+typedef struct BreadcrumbsPipelineRegistry {
+
+    size_t                              pipelinesCount;
+    BreadcrumbsSegmentedArray           pipelines;          // BreadcrumbsPipelineData
+    std::atomic<BreadcrumbsHandleTable*> pTable;
+    BreadcrumbsNameStorage              names;
+    FFX_MUTEX                           mutex;              // Only taken to register pipelines.
+} BreadcrumbsPipelineRegistry;
+
+// Number of recently written names remembered when saving a snapshot. Names that aren't copied are
+// mostly shared between many markers, so they are only written once.
+#define FFX_BREADCRUMBS_SNAPSHOT_NAME_CACHE_SIZE 64
+
+// String section of a snapshot that is being written, only sized when pStrings is null.
+typedef struct BreadcrumbsSnapshotNames {
+
+    char*                               pStrings;
+    uint64_t                            size;
+    const char*                         cachedNames[FFX_BREADCRUMBS_SNAPSHOT_NAME_CACHE_SIZE];
+    uint32_t                            cachedOffsets[FFX_BREADCRUMBS_SNAPSHOT_NAME_CACHE_SIZE];
+} BreadcrumbsSnapshotNames;
+
 // FfxBreadcrumbsContext_Private
 // The private implementation of the Breadcrumbs context.
 typedef struct FfxBreadcrumbsContext_Private {
@@ -101,7 +167,5 @@ typedef struct FfxBreadcrumbsContext_Private {
     uint32_t                            frameIndex;
     FfxUInt32                           effectContextId;
     BreadcrumbsFrameData*               pFrameData;
-    size_t                              registeredPipelinesCount;
-    BreadcrumbsPipelineData*            pRegisteredPipelines;
-    BreadcrumbsCustomNameBuffer         pipelinesNamesBuffer;
+    BreadcrumbsPipelineRegistry*        pPipelines;
 } FfxBreadcrumbsContext_Private;
@@ -0,0 +1,749 @@
+// This file is part of the FidelityFX SDK.
+//
+// Copyright (C) 2024 Advanced Micro Devices, Inc.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include <cstring>     // for memcpy
+
+#include <FidelityFX/host/ffx_breadcrumbs.h>
+#include <ffx_breadcrumbs_list.h>
+
+#include "ffx_breadcrumbs_snapshot.h"
+
+static const char* breadDecodeMarkerType(FfxBreadcrumbsMarkerType type)
+{
+#define X(marker) case FFX_BREADCRUMBS_MARKER_##marker: return #marker;
+    switch (type)
+    {
+    default:
+        FFX_ASSERT_FAIL("Unhandled enum value!");
+        FFX_BREADCRUMBS_MARKER_LIST
+    }
+#undef X
+}
+
+static bool breadcrumbsIsSnapshotString(const BreadcrumbsSnapshotHeader* header, uint32_t name)
+{
+    return name == FFX_BREADCRUMBS_SNAPSHOT_NONE || (name >= header->deviceInfoSize && name < header->stringsSize);
+}
+
+static const char* breadcrumbsGetSnapshotString(const BreadcrumbsSnapshotView* view, uint32_t name)
+{
+    if (name == FFX_BREADCRUMBS_SNAPSHOT_NONE)
+        return nullptr;
+    return view->pStrings + name;
+}
+
+static FfxErrorCode breadcrumbsReadSnapshot(const FfxBreadcrumbsSnapshot* snapshot, BreadcrumbsSnapshotView* view)
+{
+    // Snapshots can come from files, so everything is checked before it's used for printing.
+    FFX_RETURN_ON_ERROR(snapshot->pBuffer, FFX_ERROR_INVALID_POINTER);
+    FFX_RETURN_ON_ERROR((uintptr_t)snapshot->pBuffer % alignof(BreadcrumbsSnapshotHeader) == 0, FFX_ERROR_INVALID_ALIGNMENT);
+    FFX_RETURN_ON_ERROR(snapshot->bufferSize >= sizeof(BreadcrumbsSnapshotHeader), FFX_ERROR_MALFORMED_DATA);
+
+    const BreadcrumbsSnapshotHeader* header = (const BreadcrumbsSnapshotHeader*)snapshot->pBuffer;
+    FFX_RETURN_ON_ERROR(header->magic == FFX_BREADCRUMBS_SNAPSHOT_MAGIC, FFX_ERROR_MALFORMED_DATA);
+    FFX_RETURN_ON_ERROR(header->version == FFX_BREADCRUMBS_SNAPSHOT_VERSION, FFX_ERROR_INVALID_VERSION);
+
+    // Checked first so whole size cannot overflow
+    FFX_RETURN_ON_ERROR(header->stringsSize <= snapshot->bufferSize, FFX_ERROR_MALFORMED_DATA);
+    FFX_RETURN_ON_ERROR(breadcrumbsGetSnapshotSize(header) == snapshot->bufferSize, FFX_ERROR_MALFORMED_DATA);
+    FFX_RETURN_ON_ERROR(header->deviceInfoSize <= header->stringsSize, FFX_ERROR_MALFORMED_DATA);
+
+    view->pHeader = header;
+    view->pPipelines = (const BreadcrumbsSnapshotPipeline*)(header + 1);
+    view->pFrames = (const BreadcrumbsSnapshotFrame*)(view->pPipelines + header->pipelineCount);
+    view->pLists = (const BreadcrumbsSnapshotList*)(view->pFrames + header->frameCount);
+    view->pMarkers = (const BreadcrumbsSnapshotMarker*)(view->pLists + header->listCount);
+    view->pStrings = (const char*)(view->pMarkers + header->markerCount);
+
+    // Names are only terminated when the last one is
+    FFX_RETURN_ON_ERROR(header->stringsSize == header->deviceInfoSize || view->pStrings[header->stringsSize - 1] == '\0', FFX_ERROR_MALFORMED_DATA);
+
+    for (uint32_t p = 0; p < header->pipelineCount; ++p)
+    {
+        const BreadcrumbsSnapshotPipeline* pipeline = view->pPipelines + p;
+        FFX_RETURN_ON_ERROR(breadcrumbsIsSnapshotString(header, pipeline->name)
+            && breadcrumbsIsSnapshotString(header, pipeline->vertexShader)
+            && breadcrumbsIsSnapshotString(header, pipeline->hullShader)
+            && breadcrumbsIsSnapshotString(header, pipeline->domainShader)
+            && breadcrumbsIsSnapshotString(header, pipeline->geometryShader)
+            && breadcrumbsIsSnapshotString(header, pipeline->meshShader)
+            && breadcrumbsIsSnapshotString(header, pipeline->amplificationShader)
+            && breadcrumbsIsSnapshotString(header, pipeline->pixelShader)
+            && breadcrumbsIsSnapshotString(header, pipeline->computeShader)
+            && breadcrumbsIsSnapshotString(header, pipeline->rayTracingShader), FFX_ERROR_MALFORMED_DATA);
+    }
+
+#define X(marker) + 1
+    const uint32_t markerTypeCount = 1 FFX_BREADCRUMBS_MARKER_LIST;
+#undef X
+
+    uint64_t listCount = 0;
+    for (uint32_t f = 0; f < header->frameCount; ++f)
+        listCount += view->pFrames[f].listCount;
+    FFX_RETURN_ON_ERROR(listCount == header->listCount, FFX_ERROR_MALFORMED_DATA);
+
+    uint64_t markerCount = 0;
+    for (uint32_t l = 0; l < header->listCount; ++l)
+    {
+        const BreadcrumbsSnapshotList* list = view->pLists + l;
+        FFX_RETURN_ON_ERROR(breadcrumbsIsSnapshotString(header, list->name), FFX_ERROR_MALFORMED_DATA);
+        FFX_RETURN_ON_ERROR(list->markerCount <= header->markerCount - markerCount, FFX_ERROR_MALFORMED_DATA);
+
+        // Printing the tree relies on markers only going one nesting level deeper at a time
+        const BreadcrumbsSnapshotMarker* markers = view->pMarkers + markerCount;
+        for (uint32_t m = 0; m < list->markerCount; ++m)
+        {
+            const BreadcrumbsSnapshotMarker* marker = markers + m;
+            FFX_RETURN_ON_ERROR(marker->type < markerTypeCount, FFX_ERROR_MALFORMED_DATA);
+            FFX_RETURN_ON_ERROR(marker->nestingLevel <= (m ? markers[m - 1].nestingLevel + 1 : 0), FFX_ERROR_MALFORMED_DATA);
+            FFX_RETURN_ON_ERROR(breadcrumbsIsSnapshotString(header, marker->name), FFX_ERROR_MALFORMED_DATA);
+            FFX_RETURN_ON_ERROR(marker->type != FFX_BREADCRUMBS_MARKER_PASS || marker->name != FFX_BREADCRUMBS_SNAPSHOT_NONE, FFX_ERROR_MALFORMED_DATA);
+            FFX_RETURN_ON_ERROR(marker->pipeline == FFX_BREADCRUMBS_SNAPSHOT_NONE || marker->pipeline < header->pipelineCount, FFX_ERROR_MALFORMED_DATA);
+        }
+        markerCount += list->markerCount;
+    }
+    FFX_RETURN_ON_ERROR(markerCount == header->markerCount, FFX_ERROR_MALFORMED_DATA);
+
+    return FFX_OK;
+}
+
+static FfxErrorCode breadcrumbsPrintSnapshotText(const BreadcrumbsSnapshotView* view, FfxAllocationCallbacks* allocs, FfxBreadcrumbsMarkersStatus* markersStatus)
+{
+    const bool skipFinishedLists = !FFX_CONTAINS_FLAG(view->pHeader->flags, FFX_BREADCRUMBS_PRINT_FINISHED_LISTS);
+    const bool skipNotStartedLists = !FFX_CONTAINS_FLAG(view->pHeader->flags, FFX_BREADCRUMBS_PRINT_NOT_STARTED_LISTS);
+    const bool skipFinishedNodes = !FFX_CONTAINS_FLAG(view->pHeader->flags, FFX_BREADCRUMBS_PRINT_FINISHED_NODES);
+    const bool skipNotStartedNodes = !FFX_CONTAINS_FLAG(view->pHeader->flags, FFX_BREADCRUMBS_PRINT_NOT_STARTED_NODES);
+
+    if (view->pHeader->deviceInfoSize)
+    {
+        markersStatus->pBuffer = (char*)ffxBreadcrumbsAppendList(markersStatus->pBuffer, markersStatus->bufferSize, 1, view->pHeader->deviceInfoSize, allocs);
+        memcpy(markersStatus->pBuffer + markersStatus->bufferSize, view->pStrings, view->pHeader->deviceInfoSize);
+        markersStatus->bufferSize += view->pHeader->deviceInfoSize;
+    }
+    FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, "[BREADCRUMBS]\n");
+    const BreadcrumbsSnapshotList* cl = view->pLists;
+    const BreadcrumbsSnapshotMarker* markers = view->pMarkers;
+    for (uint32_t f = 0; f < view->pHeader->frameCount; ++f)
+    {
+        const BreadcrumbsSnapshotFrame* frame = view->pFrames + f;
+        const uint32_t currentFrame = frame->frameIndex;
+        FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, "<Frame ");
+        FFX_BREADCRUMBS_APPEND_UINT(markersStatus->pBuffer, markersStatus->bufferSize, currentFrame);
+        FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, ">\n");
+
+        if (frame->listCount == 0)
+        {
+            FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, " - No command lists\n");
+            continue;
+        }
+        // Lists and their markers are stored one after another
+        for (size_t j = 0; j < frame->listCount; markers += cl->markerCount, ++cl, ++j)
+        {
+            FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, " - [");
+
+            const char* listName = breadcrumbsGetSnapshotString(view, cl->name);
+            bool skipList = false;
+            uint32_t markerFrame = UINT32_MAX;
+            uint32_t value = 0;
+            // Check for finished or not started CLs
+            if (cl->markerCount > 0)
+            {
+                // Inspect value saved for last marker to determine it's status and decode it's frame value (coded in 31-1 bits of saved data minus 1)
+                const BreadcrumbsSnapshotMarker* lastMarker = markers + cl->markerCount - 1;
+                value = lastMarker->value;
+                markerFrame = (value >> 1) - 1;
+                FFX_ASSERT_MESSAGE(markerFrame <= currentFrame, "Should not find value higher than current frame!");
+
+                if (markerFrame == currentFrame)
+                {
+                    // Check marker status: 0 - started, 1 - finished
+                    // If finished then all previous have also finished
+                    if (value & 1)
+                    {
+                        FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, "X");
+                        skipList = skipFinishedLists;
+                    }
+                    else
+                    {
+                        FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, ">");
+                    }
+                }
+                else // markerFrame < currentFrame, last case is asserted for
+                {
+                    // Same check for first marker
+                    value = markers->value;
+                    markerFrame = (value >> 1) - 1;
+                    FFX_ASSERT_MESSAGE(markerFrame <= currentFrame, "Should not find value higher than current frame!");
+
+                    // If first marker have not started yet, then none in this command list has started too
+                    if (markerFrame < currentFrame)
+                    {
+                        FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, " ");
+                        skipList = skipNotStartedLists;
+                    }
+                    else
+                    {
+                        FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, ">");
+                    }
+                }
+            }
+            else
+            {
+                FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, " ");
+                skipList = true;
+            }
+
+            FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, "] Queue type <");
+            FFX_BREADCRUMBS_APPEND_UINT(markersStatus->pBuffer, markersStatus->bufferSize, cl->queueType);
+            FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, ">, submission no. ");
+            FFX_BREADCRUMBS_APPEND_UINT(markersStatus->pBuffer, markersStatus->bufferSize, cl->submissionIndex);
+            FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, ", command list ");
+            FFX_BREADCRUMBS_APPEND_UINT64(markersStatus->pBuffer, markersStatus->bufferSize, j + 1);
+            if (listName)
+            {
+                FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, ": \"");
+                FFX_BREADCRUMBS_APPEND_STRING_DYNAMIC(markersStatus->pBuffer, markersStatus->bufferSize, listName);
+                FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, "\"");
+            }
+            FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, "\n");
+            if (skipList)
+                continue;
+
+            // Indices determining how long given nesting level will be present before moving up in hierarchy.
+            uint32_t* nestingLevelIndicatorIndices = (uint32_t*)ffxBreadcrumbsAppendList(nullptr, 0, sizeof(uint32_t), 1, allocs);
+            nestingLevelIndicatorIndices[0] = 0;
+            uint32_t nestingLevelIndicesCount = 1;
+
+            // Display level informs from which point deeper markers can be cut out
+            // in case of collapsing uniform nodes (markers that all nested markers have same finished or not started status).
+            uint32_t displayLevel = UINT32_MAX;
+            uint32_t markerId = 0;
+
+            uint32_t currentType = FFX_BREADCRUMBS_MARKER_PASS;
+            // Go through every marker in command list and display it's info
+            for (uint32_t m = 0; m < cl->markerCount; ++m)
+            {
+                const BreadcrumbsSnapshotMarker* marker = markers + m;
+                const char* markerName = breadcrumbsGetSnapshotString(view, marker->name);
+                // Same checks as before with determining if marker is finished or not started
+                value = marker->value;
+                markerFrame = (value >> 1) - 1;
+                FFX_ASSERT_MESSAGE(markerFrame <= currentFrame, "Should not find value higher than current frame!");
+
+                char status = ' ';
+                if (markerFrame == currentFrame)
+                {
+                    if (value & 1)
+                        status = 'X';
+                    else
+                        status = '>';
+                }
+
+                // When going deeper into hierarchy allocate new index for marker.
+                if (marker->nestingLevel >= nestingLevelIndicesCount)
+                {
+                    markerId = 0;
+                    nestingLevelIndicatorIndices = (uint32_t*)ffxBreadcrumbsAppendList(nestingLevelIndicatorIndices, nestingLevelIndicesCount, sizeof(uint32_t), 1, allocs);
+                    nestingLevelIndicatorIndices[nestingLevelIndicesCount++] = 0;
+                    // Check whether deeper nodes will be collapsed or not.
+                    if (((skipFinishedNodes && status == 'X') || (skipNotStartedNodes && status == ' ')) && displayLevel == UINT32_MAX)
+                        displayLevel = marker->nestingLevel;
+                }
+                else
+                {
+                    if (skipFinishedNodes || skipNotStartedNodes)
+                    {
+                        // If going up in hierarchy check wheter displayLevel can be relaxed or restricted to upper level.
+                        if (displayLevel != UINT32_MAX)
+                        {
+                            if (displayLevel > marker->nestingLevel)
+                                displayLevel = status == '>' ? UINT32_MAX : marker->nestingLevel;
+                            else if (displayLevel == marker->nestingLevel && status == '>')
+                                displayLevel = UINT32_MAX;
+                        }
+                        else if ((skipFinishedNodes && status == 'X') || (skipNotStartedNodes && status == ' '))
+                            displayLevel = marker->nestingLevel;
+                    }
+                    // Pop indicators when moving to up in nesting levels
+                    if (marker->nestingLevel + 1 < nestingLevelIndicesCount)
+                        markerId = 0;
+                    while (marker->nestingLevel + 1 < nestingLevelIndicesCount)
+                        nestingLevelIndicatorIndices = (uint32_t*)ffxBreadcrumbsPopList(nestingLevelIndicatorIndices, --nestingLevelIndicesCount, sizeof(uint32_t), allocs);
+                }
+                if (marker->type != currentType)
+                {
+                    currentType = marker->type;
+                    markerId = 0;
+                }
+
+                if (marker->nestingLevel <= displayLevel)
+                {
+                    // When on next level, check for newer indices
+                    uint32_t* lastIdx = nestingLevelIndicatorIndices + nestingLevelIndicesCount - 1;
+                    if (*lastIdx != UINT32_MAX && *lastIdx <= m)
+                    {
+                        *lastIdx = UINT32_MAX;
+                        // Detect how long given level will be present to calculate proper tree branches
+                        for (uint32_t next = m + 1; next < cl->markerCount; ++next)
+                        {
+                            const uint32_t nestingLevel = markers[next].nestingLevel;
+                            if (nestingLevel < marker->nestingLevel)
+                                break;
+                            else if (nestingLevel == marker->nestingLevel)
+                                *lastIdx = next;
+                        }
+                    }
+
+                    // Mark previous levels in tree and display current entry
+                    FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, "  ");
+                    for (uint32_t k = 0; k < marker->nestingLevel; ++k)
+                    {
+                        FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, "  ");
+                        if (nestingLevelIndicatorIndices[k] != UINT32_MAX && nestingLevelIndicatorIndices[k] > m)
+                        {
+                            FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, "\xe2\x94\x82"); // `|`
+                        }
+                        else
+                        {
+                            FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, " ");
+                        }
+                    }
+
+                    FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, "  ");
+                    if (nestingLevelIndicatorIndices[nestingLevelIndicesCount - 1] == UINT32_MAX || nestingLevelIndicatorIndices[nestingLevelIndicesCount - 1] == m)
+                    {
+                        FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, "\xe2\x94\x94"); // `'-`
+                    }
+                    else
+                    {
+                        FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, "\xe2\x94\x9c"); // `|-`
+                    }
+
+                    FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, "\xe2\x94\x80["); // `-`
+                    markersStatus->pBuffer = (char*)ffxBreadcrumbsAppendList(markersStatus->pBuffer, markersStatus->bufferSize, sizeof(char), 1, allocs);
+                    markersStatus->pBuffer[markersStatus->bufferSize++] = status;
+                    FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, "] ");
+
+                    if (marker->type == FFX_BREADCRUMBS_MARKER_PASS)
+                    {
+                        FFX_ASSERT_MESSAGE(markerName, "Custom passes should always have names!");
+                        FFX_BREADCRUMBS_APPEND_STRING_DYNAMIC(markersStatus->pBuffer, markersStatus->bufferSize, markerName);
+                    }
+                    else
+                    {
+                        FFX_BREADCRUMBS_APPEND_STRING_DYNAMIC(markersStatus->pBuffer, markersStatus->bufferSize, breadDecodeMarkerType((FfxBreadcrumbsMarkerType)marker->type));
+                        if (markerId != 0 || (m + 1 < cl->markerCount && markers[m + 1].type == marker->type))
+                        {
+                            FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, " ");
+                            FFX_BREADCRUMBS_APPEND_UINT(markersStatus->pBuffer, markersStatus->bufferSize, ++markerId);
+                        }
+                        if (markerName)
+                        {
+                            FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, ": \"");
+                            FFX_BREADCRUMBS_APPEND_STRING_DYNAMIC(markersStatus->pBuffer, markersStatus->bufferSize, markerName);
+                            FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, "\"");
+                        }
+                    }
+                    if (marker->pipeline != FFX_BREADCRUMBS_SNAPSHOT_NONE)
+                    {
+                        const BreadcrumbsSnapshotPipeline* pipeline = view->pPipelines + marker->pipeline;
+                        const char* pipelineName = breadcrumbsGetSnapshotString(view, pipeline->name);
+                        const char* vertexShader = breadcrumbsGetSnapshotString(view, pipeline->vertexShader);
+                        const char* hullShader = breadcrumbsGetSnapshotString(view, pipeline->hullShader);
+                        const char* domainShader = breadcrumbsGetSnapshotString(view, pipeline->domainShader);
+                        const char* geometryShader = breadcrumbsGetSnapshotString(view, pipeline->geometryShader);
+                        const char* meshShader = breadcrumbsGetSnapshotString(view, pipeline->meshShader);
+                        const char* amplificationShader = breadcrumbsGetSnapshotString(view, pipeline->amplificationShader);
+                        const char* pixelShader = breadcrumbsGetSnapshotString(view, pipeline->pixelShader);
+                        const char* computeShader = breadcrumbsGetSnapshotString(view, pipeline->computeShader);
+                        const char* rayTracingShader = breadcrumbsGetSnapshotString(view, pipeline->rayTracingShader);
+
+                        const bool isCompute = computeShader != nullptr;
+                        const bool isRT = rayTracingShader != nullptr;
+                        const bool isVertexShading = vertexShader || hullShader || domainShader || geometryShader;
+                        const bool isMeshShading = meshShader || amplificationShader;
+                        const bool isGfx = isVertexShading || isMeshShading || pixelShader;
+                        FFX_ASSERT_MESSAGE((!isCompute && !isRT) || (!isCompute && !isGfx) || (!isRT && !isGfx), "Wrong combination of shaders for pipeline!");
+                        FFX_ASSERT_MESSAGE(!(isVertexShading && isMeshShading), "Wrong combination of geometry processing for graphics pipeline!");
+
+                        FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, ", ");
+                        if (isCompute)
+                        {
+                            FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, "compute ");
+                        }
+                        else if (isRT)
+                        {
+                            FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, "ray tracing ");
+                        }
+                        else if (isGfx)
+                        {
+                            FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, "graphics ");
+                        }
+                        FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, "pipeline");
+                        if (pipelineName)
+                        {
+                            FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, " \"");
+                            FFX_BREADCRUMBS_APPEND_STRING_DYNAMIC(markersStatus->pBuffer, markersStatus->bufferSize, pipelineName);
+                            FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, "\"");
+                        }
+
+                        if (isCompute)
+                        {
+                            FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, " [ CS: ");
+                            FFX_BREADCRUMBS_APPEND_STRING_DYNAMIC(markersStatus->pBuffer, markersStatus->bufferSize, computeShader);
+                            FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, " ]");
+                        }
+                        else if (isRT)
+                        {
+                            FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, " [ RT: ");
+                            FFX_BREADCRUMBS_APPEND_STRING_DYNAMIC(markersStatus->pBuffer, markersStatus->bufferSize, rayTracingShader);
+                            FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, " ]");
+                        }
+                        else if (isGfx)
+                        {
+                            FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, " [");
+                            bool before = false;
+                            if (isVertexShading)
+                            {
+                                if (vertexShader)
+                                {
+                                    before = true;
+                                    FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, " VS: ");
+                                    FFX_BREADCRUMBS_APPEND_STRING_DYNAMIC(markersStatus->pBuffer, markersStatus->bufferSize, vertexShader);
+                                }
+                                if (hullShader)
+                                {
+                                    if (before)
+                                    {
+                                        FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, " |");
+                                    }
+                                    before = true;
+                                    FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, " HS: ");
+                                    FFX_BREADCRUMBS_APPEND_STRING_DYNAMIC(markersStatus->pBuffer, markersStatus->bufferSize, hullShader);
+                                }
+                                if (domainShader)
+                                {
+                                    if (before)
+                                    {
+                                        FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, " |");
+                                    }
+                                    before = true;
+                                    FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, " DS: ");
+                                    FFX_BREADCRUMBS_APPEND_STRING_DYNAMIC(markersStatus->pBuffer, markersStatus->bufferSize, domainShader);
+                                }
+                                if (geometryShader)
+                                {
+                                    if (before)
+                                    {
+                                        FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, " |");
+                                    }
+                                    before = true;
+                                    FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, " GS: ");
+                                    FFX_BREADCRUMBS_APPEND_STRING_DYNAMIC(markersStatus->pBuffer, markersStatus->bufferSize, geometryShader);
+                                }
+                            }
+                            else if (isMeshShading)
+                            {
+                                if (meshShader)
+                                {
+                                    before = true;
+                                    FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, " MS: ");
+                                    FFX_BREADCRUMBS_APPEND_STRING_DYNAMIC(markersStatus->pBuffer, markersStatus->bufferSize, meshShader);
+                                }
+                                if (amplificationShader)
+                                {
+                                    if (before)
+                                    {
+                                        FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, " |");
+                                    }
+                                    before = true;
+                                    FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, " AS: ");
+                                    FFX_BREADCRUMBS_APPEND_STRING_DYNAMIC(markersStatus->pBuffer, markersStatus->bufferSize, amplificationShader);
+                                }
+                            }
+                            if (pixelShader)
+                            {
+                                if (before)
+                                {
+                                    FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, " |");
+                                }
+                                before = true;
+                                FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, " PS: ");
+                                FFX_BREADCRUMBS_APPEND_STRING_DYNAMIC(markersStatus->pBuffer, markersStatus->bufferSize, pixelShader);
+                            }
+                            FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, " ]");
+                        }
+                    }
+                    FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, "\n");
+                }
+            }
+            allocs->fpFree(nestingLevelIndicatorIndices);
+        }
+    }
+
+    return FFX_OK;
+}
+
+static void breadcrumbsAppendJsonString(FfxBreadcrumbsMarkersStatus* markersStatus, const char* str, size_t length, FfxAllocationCallbacks* allocs)
+{
+    FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, "\"");
+    const char* end = str + length;
+    while (str < end)
+    {
+        // Copy runs of characters that don't need escaping at once
+        size_t runLength = 0;
+        while (str + runLength < end && str[runLength] != '"' && str[runLength] != '\\' && (unsigned char)str[runLength] >= 0x20)
+            ++runLength;
+        if (runLength)
+        {
+            markersStatus->pBuffer = (char*)ffxBreadcrumbsAppendList(markersStatus->pBuffer, markersStatus->bufferSize, 1, runLength, allocs);
+            memcpy(markersStatus->pBuffer + markersStatus->bufferSize, str, runLength);
+            markersStatus->bufferSize += runLength;
+            str += runLength;
+        }
+        if (str < end)
+        {
+            switch (*str)
+            {
+            case '"':
+                FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, "\\\"");
+                break;
+            case '\\':
+                FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, "\\\\");
+                break;
+            case '\n':
+                FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, "\\n");
+                break;
+            case '\r':
+                FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, "\\r");
+                break;
+            case '\t':
+                FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, "\\t");
+                break;
+            default:
+                FFX_BREADCRUMBS_APPEND_NUMBER(markersStatus->pBuffer, markersStatus->bufferSize, (uint32_t)(unsigned char)*str, 7, "\\u%04X");
+                break;
+            }
+            ++str;
+        }
+    }
+    FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, "\"");
+}
+
+static void breadcrumbsAppendJsonName(FfxBreadcrumbsMarkersStatus* markersStatus, const char* key, const char* name, FfxAllocationCallbacks* allocs)
+{
+    // Optional names are left out
+    if (name)
+    {
+        FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, ", ");
+        breadcrumbsAppendJsonString(markersStatus, key, strlen(key), allocs);
+        FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, ": ");
+        breadcrumbsAppendJsonString(markersStatus, name, strlen(name), allocs);
+    }
+}
+
+static const char* breadcrumbsGetJsonStatus(uint32_t value, uint32_t currentFrame)
+{
+    // Same decoding as for text output, saved value holds frame index + 1 in bits 31-1 and bit 0 set when marker has finished
+    if ((value >> 1) - 1 != currentFrame)
+        return "notStarted";
+    return value & 1 ? "finished" : "inProgress";
+}
+
+static FfxErrorCode breadcrumbsPrintSnapshotJson(const BreadcrumbsSnapshotView* view, FfxAllocationCallbacks* allocs, FfxBreadcrumbsMarkersStatus* markersStatus)
+{
+    // Whole tree is always written, collapsing nodes is left for the tools reading it.
+    FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, "{\n");
+    if (view->pHeader->deviceInfoSize)
+    {
+        FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, "  \"deviceInfo\": ");
+        breadcrumbsAppendJsonString(markersStatus, view->pStrings, view->pHeader->deviceInfoSize, allocs);
+        FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, ",\n");
+    }
+
+    FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, "  \"pipelines\": [");
+    for (uint32_t p = 0; p < view->pHeader->pipelineCount; ++p)
+    {
+        const BreadcrumbsSnapshotPipeline* pipeline = view->pPipelines + p;
+        const bool isCompute = pipeline->computeShader != FFX_BREADCRUMBS_SNAPSHOT_NONE;
+        const bool isRT = pipeline->rayTracingShader != FFX_BREADCRUMBS_SNAPSHOT_NONE;
+
+        if (p)
+        {
+            FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, ",");
+        }
+        FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, "\n    { \"pipeline\": \"0x");
+        FFX_BREADCRUMBS_APPEND_NUMBER(markersStatus->pBuffer, markersStatus->bufferSize, (unsigned long long)pipeline->pipeline, 17, "%llX");
+        FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, "\", \"type\": ");
+        if (isCompute)
+        {
+            FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, "\"compute\"");
+        }
+        else if (isRT)
+        {
+            FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, "\"rayTracing\"");
+        }
+        else
+        {
+            FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, "\"graphics\"");
+        }
+        breadcrumbsAppendJsonName(markersStatus, "name", breadcrumbsGetSnapshotString(view, pipeline->name), allocs);
+        breadcrumbsAppendJsonName(markersStatus, "VS", breadcrumbsGetSnapshotString(view, pipeline->vertexShader), allocs);
+        breadcrumbsAppendJsonName(markersStatus, "HS", breadcrumbsGetSnapshotString(view, pipeline->hullShader), allocs);
+        breadcrumbsAppendJsonName(markersStatus, "DS", breadcrumbsGetSnapshotString(view, pipeline->domainShader), allocs);
+        breadcrumbsAppendJsonName(markersStatus, "GS", breadcrumbsGetSnapshotString(view, pipeline->geometryShader), allocs);
+        breadcrumbsAppendJsonName(markersStatus, "MS", breadcrumbsGetSnapshotString(view, pipeline->meshShader), allocs);
+        breadcrumbsAppendJsonName(markersStatus, "AS", breadcrumbsGetSnapshotString(view, pipeline->amplificationShader), allocs);
+        breadcrumbsAppendJsonName(markersStatus, "PS", breadcrumbsGetSnapshotString(view, pipeline->pixelShader), allocs);
+        breadcrumbsAppendJsonName(markersStatus, "CS", breadcrumbsGetSnapshotString(view, pipeline->computeShader), allocs);
+        breadcrumbsAppendJsonName(markersStatus, "RT", breadcrumbsGetSnapshotString(view, pipeline->rayTracingShader), allocs);
+        FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, " }");
+    }
+    FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, "\n  ],\n  \"frames\": [");
+
+    const BreadcrumbsSnapshotList* cl = view->pLists;
+    const BreadcrumbsSnapshotMarker* markers = view->pMarkers;
+    for (uint32_t f = 0; f < view->pHeader->frameCount; ++f)
+    {
+        const BreadcrumbsSnapshotFrame* frame = view->pFrames + f;
+        const uint32_t currentFrame = frame->frameIndex;
+        if (f)
+        {
+            FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, ",");
+        }
+        FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, "\n    { \"frame\": ");
+        FFX_BREADCRUMBS_APPEND_UINT(markersStatus->pBuffer, markersStatus->bufferSize, currentFrame);
+        FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, ", \"commandLists\": [");
+
+        for (size_t j = 0; j < frame->listCount; markers += cl->markerCount, ++cl, ++j)
+        {
+            // List has finished when its last marker has, and started when its first one has
+            const char* listStatus = "notStarted";
+            if (cl->markerCount)
+            {
+                listStatus = breadcrumbsGetJsonStatus(markers[cl->markerCount - 1].value, currentFrame);
+                if (listStatus[0] == 'n' && breadcrumbsGetJsonStatus(markers->value, currentFrame)[0] != 'n')
+                    listStatus = "inProgress";
+            }
+
+            if (j)
+            {
+                FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, ",");
+            }
+            FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, "\n      { \"commandList\": ");
+            FFX_BREADCRUMBS_APPEND_UINT64(markersStatus->pBuffer, markersStatus->bufferSize, j + 1);
+            FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, ", \"queueType\": ");
+            FFX_BREADCRUMBS_APPEND_UINT(markersStatus->pBuffer, markersStatus->bufferSize, cl->queueType);
+            FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, ", \"submissionIndex\": ");
+            FFX_BREADCRUMBS_APPEND_UINT(markersStatus->pBuffer, markersStatus->bufferSize, cl->submissionIndex);
+            breadcrumbsAppendJsonName(markersStatus, "name", breadcrumbsGetSnapshotString(view, cl->name), allocs);
+            FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, ", \"status\": \"");
+            FFX_BREADCRUMBS_APPEND_STRING_DYNAMIC(markersStatus->pBuffer, markersStatus->bufferSize, listStatus);
+            FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, "\", \"markers\": [");
+
+            // Nested markers go into the "markers" array of their parent, which is left open until a marker on the same or upper level comes
+            for (uint32_t m = 0; m < cl->markerCount; ++m)
+            {
+                const BreadcrumbsSnapshotMarker* marker = markers + m;
+                if (m)
+                {
+                    if (marker->nestingLevel > markers[m - 1].nestingLevel)
+                    {
+                        FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, ", \"markers\": [");
+                    }
+                    else
+                    {
+                        FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, " }");
+                        for (uint32_t level = markers[m - 1].nestingLevel; level > marker->nestingLevel; --level)
+                        {
+                            FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, " ] }");
+                        }
+                        FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, ",");
+                    }
+                }
+                FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, "\n        ");
+                for (uint32_t level = 0; level < marker->nestingLevel; ++level)
+                {
+                    FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, "  ");
+                }
+
+                FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, "{ \"type\": \"");
+                if (marker->type == FFX_BREADCRUMBS_MARKER_PASS)
+                {
+                    FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, "PASS");
+                }
+                else
+                {
+                    FFX_BREADCRUMBS_APPEND_STRING_DYNAMIC(markersStatus->pBuffer, markersStatus->bufferSize, breadDecodeMarkerType((FfxBreadcrumbsMarkerType)marker->type));
+                }
+                FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, "\"");
+                breadcrumbsAppendJsonName(markersStatus, "name", breadcrumbsGetSnapshotString(view, marker->name), allocs);
+                FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, ", \"status\": \"");
+                FFX_BREADCRUMBS_APPEND_STRING_DYNAMIC(markersStatus->pBuffer, markersStatus->bufferSize, breadcrumbsGetJsonStatus(marker->value, currentFrame));
+                FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, "\"");
+                if (marker->pipeline != FFX_BREADCRUMBS_SNAPSHOT_NONE)
+                {
+                    FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, ", \"pipeline\": ");
+                    FFX_BREADCRUMBS_APPEND_UINT(markersStatus->pBuffer, markersStatus->bufferSize, marker->pipeline);
+                }
+            }
+            if (cl->markerCount)
+            {
+                FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, " }");
+                for (uint32_t level = markers[cl->markerCount - 1].nestingLevel; level > 0; --level)
+                {
+                    FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, " ] }");
+                }
+            }
+            FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, " ] }");
+        }
+        FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, " ] }");
+    }
+    FFX_BREADCRUMBS_APPEND_STRING(markersStatus->pBuffer, markersStatus->bufferSize, "\n  ]\n}\n");
+
+    return FFX_OK;
+}
+
+FfxErrorCode ffxBreadcrumbsPrintSnapshot(const FfxBreadcrumbsSnapshot* snapshot, FfxBreadcrumbsStatusFormat format, FfxAllocationCallbacks* allocCallbacks, FfxBreadcrumbsMarkersStatus* markersStatus)
+{
+    // No need for lock, snapshot is not tied to any context.
+    FFX_RETURN_ON_ERROR(snapshot, FFX_ERROR_INVALID_POINTER);
+    FFX_RETURN_ON_ERROR(allocCallbacks, FFX_ERROR_INVALID_POINTER);
+    FFX_RETURN_ON_ERROR(markersStatus, FFX_ERROR_INVALID_POINTER);
+
+    markersStatus->bufferSize = 0;
+    markersStatus->pBuffer = nullptr;
+
+    BreadcrumbsSnapshotView view;
+    const FfxErrorCode errorCode = breadcrumbsReadSnapshot(snapshot, &view);
+    FFX_RETURN_ON_ERROR(errorCode == FFX_OK, errorCode);
+
+    switch (format)
+    {
+    case FFX_BREADCRUMBS_STATUS_FORMAT_TEXT:
+        return breadcrumbsPrintSnapshotText(&view, allocCallbacks, markersStatus);
+    case FFX_BREADCRUMBS_STATUS_FORMAT_JSON:
+        return breadcrumbsPrintSnapshotJson(&view, allocCallbacks, markersStatus);
+    default:
+        return FFX_ERROR_INVALID_ENUM;
+    }
+}
@@ -0,0 +1,103 @@
+// This file is part of the FidelityFX SDK.
+//
+// Copyright (C) 2024 Advanced Micro Devices, Inc.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#pragma once
+#include <cstdint>
+
+// Layout of the binary snapshot written by ffxBreadcrumbsSaveSnapshot(). All sections follow the header in the order:
+// pipelines, frames, lists, markers, strings. Lists of a frame and markers of a list are stored one after another.
+// Names are offsets into the string section, which starts with the printed device info.
+#define FFX_BREADCRUMBS_SNAPSHOT_MAGIC   0x42584646 // "FFXB"
+#define FFX_BREADCRUMBS_SNAPSHOT_VERSION 1
+#define FFX_BREADCRUMBS_SNAPSHOT_NONE    UINT32_MAX
+
+typedef struct BreadcrumbsSnapshotHeader {
+
+    uint32_t                            magic;
+    uint32_t                            version;
+    uint32_t                            flags;              // FfxBreadcrumbsInitializationFlagBits of the context.
+    uint32_t                            frameCount;
+    uint32_t                            listCount;
+    uint32_t                            markerCount;
+    uint32_t                            pipelineCount;
+    uint32_t                            deviceInfoSize;     // Not null terminated.
+    uint64_t                            stringsSize;
+} BreadcrumbsSnapshotHeader;
+
+typedef struct BreadcrumbsSnapshotPipeline {
+
+    uint64_t                            pipeline;           // Handle value, informational only.
+    uint32_t                            name;
+    uint32_t                            vertexShader;
+    uint32_t                            hullShader;
+    uint32_t                            domainShader;
+    uint32_t                            geometryShader;
+    uint32_t                            meshShader;
+    uint32_t                            amplificationShader;
+    uint32_t                            pixelShader;
+    uint32_t                            computeShader;
+    uint32_t                            rayTracingShader;
+} BreadcrumbsSnapshotPipeline;
+
+typedef struct BreadcrumbsSnapshotFrame {
+
+    uint32_t                            frameIndex;
+    uint32_t                            listCount;
+} BreadcrumbsSnapshotFrame;
+
+typedef struct BreadcrumbsSnapshotList {
+
+    uint32_t                            queueType;
+    uint32_t                            submissionIndex;
+    uint32_t                            name;
+    uint32_t                            markerCount;
+} BreadcrumbsSnapshotList;
+
+typedef struct BreadcrumbsSnapshotMarker {
+
+    uint32_t                            type;
+    uint32_t                            nestingLevel;
+    uint32_t                            name;
+    uint32_t                            pipeline;           // Index into the pipelines section.
+    uint32_t                            value;              // Value written by the GPU into the marker slot.
+} BreadcrumbsSnapshotMarker;
+
+// Sections of a validated snapshot.
+typedef struct BreadcrumbsSnapshotView {
+
+    const BreadcrumbsSnapshotHeader*    pHeader;
+    const BreadcrumbsSnapshotPipeline*  pPipelines;
+    const BreadcrumbsSnapshotFrame*     pFrames;
+    const BreadcrumbsSnapshotList*      pLists;
+    const BreadcrumbsSnapshotMarker*    pMarkers;
+    const char*                         pStrings;
+} BreadcrumbsSnapshotView;
+
+static inline uint64_t breadcrumbsGetSnapshotSize(const BreadcrumbsSnapshotHeader* header)
+{
+    return sizeof(BreadcrumbsSnapshotHeader)
+        + sizeof(BreadcrumbsSnapshotPipeline) * (uint64_t)header->pipelineCount
+        + sizeof(BreadcrumbsSnapshotFrame) * (uint64_t)header->frameCount
+        + sizeof(BreadcrumbsSnapshotList) * (uint64_t)header->listCount
+        + sizeof(BreadcrumbsSnapshotMarker) * (uint64_t)header->markerCount
+        + header->stringsSize;
+}
@@ -21,8 +21,10 @@
 // THE SOFTWARE.
 
 #include <FidelityFX/host/ffx_brixelizer.h>
+#include "ffx_brixelizer_job_bricks.h"
 
 #include <float.h> // FLT_MIN, FLT_MAX
+#include <stddef.h> // offsetof
 #include <string.h> // memset
 #include <math.h> // floorf
 #include <stdbool.h>
@@ -47,6 +49,24 @@ static bool aabbsOverlap(FfxBrixelizerAABB x, FfxBrixelizerAABB y)
     return true;
 }
 
+static FfxBrixelizerAABB aabbsUnion(FfxBrixelizerAABB x, FfxBrixelizerAABB y)
+{
+    FfxBrixelizerAABB result;
+    ifor (3) {
+        result.min[i] = x.min[i] < y.min[i] ? x.min[i] : y.min[i];
+        result.max[i] = x.max[i] > y.max[i] ? x.max[i] : y.max[i];
+    }
+    return result;
+}
+
+static float aabbSurfaceArea(FfxBrixelizerAABB x)
+{
+    float dx = x.max[0] - x.min[0];
+    float dy = x.max[1] - x.min[1];
+    float dz = x.max[2] - x.min[2];
+    return 2.0f * (dx * dy + dy * dz + dz * dx);
+}
+
 typedef struct FfxBrixelizerBakedUpdateDescription_Private {
     FfxBrixelizerResources                      resources;
     FfxBrixelizerRawCascadeUpdateDescription    cascadeUpdateDesc;
@@ -79,6 +99,29 @@ typedef struct FfxBrixelizerInstance {
     FfxBrixelizerAABB       aabb;
 } FfxBrixelizerInstance;
 
+#define FFX_BRIXELIZER_INSTANCE_TREE_NULL_NODE  ((uint32_t)-1)
+#define FFX_BRIXELIZER_INSTANCE_TREE_MAX_NODES  (2 * FFX_BRIXELIZER_MAX_INSTANCES)
+// Enough for any tree kept balanced over FFX_BRIXELIZER_MAX_INSTANCES leaves.
+#define FFX_BRIXELIZER_INSTANCE_TREE_STACK_SIZE 64
+
+// Leaves hold a single instance, inner nodes always have two children and the union of their boxes.
+typedef struct FfxBrixelizerInstanceTreeNode {
+    FfxBrixelizerAABB aabb;
+    uint32_t          parent;         // Next free node while the node is unused.
+    uint32_t          children[2];    // Leaves keep their instance ID in the first child.
+    int32_t           height;         // Zero for leaves.
+} FfxBrixelizerInstanceTreeNode;
+
+// Bounding volume hierarchy over static instance AABBs, updated as instances are created and deleted
+// and kept balanced with tree rotations, so cascade updates only visit instances near the cascade.
+typedef struct FfxBrixelizerInstanceTree {
+    uint32_t                      root;
+    uint32_t                      freeNode;
+    uint32_t                      numNodes;     // Nodes past numNodes have never been used.
+    uint32_t                      leaves[FFX_BRIXELIZER_MAX_INSTANCES];   // Indexed by instance ID.
+    FfxBrixelizerInstanceTreeNode nodes[FFX_BRIXELIZER_INSTANCE_TREE_MAX_NODES];
+} FfxBrixelizerInstanceTree;
+
 typedef struct FfxBrixelizerScratchSpace {
     union {
         struct {
@@ -88,6 +131,9 @@ typedef struct FfxBrixelizerScratchSpace {
         struct {
             FfxBrixelizerInstanceID instanceIDs[FFX_BRIXELIZER_MAX_INSTANCES];
         } update;
+        struct {
+            uint64_t invalidBricks[FFX_BRIXELIZER_CASCADE_RESOLUTION * FFX_BRIXELIZER_CASCADE_RESOLUTION];   // One bit per brick, rows along x.
+        } bakeUpdate;
     };
 } FfxBrixelizerScratchSpace;
 
@@ -101,11 +147,183 @@ typedef struct FfxBrixelizerContext_Private {
     uint32_t                    dynamicInstanceStartIndex;
     uint32_t                    instanceIndices[FFX_BRIXELIZER_MAX_INSTANCES];
     FfxBrixelizerInstance       instances[FFX_BRIXELIZER_MAX_INSTANCES];
+    FfxBrixelizerInstanceTree   staticInstanceTree;
     FfxBrixelizerScratchSpace   scratchSpace;
 } FfxBrixelizerContext_Private;
 
 FFX_STATIC_ASSERT(sizeof(FfxBrixelizerContext) >= sizeof(FfxBrixelizerContext_Private));
 
+static void instanceTreeInit(FfxBrixelizerInstanceTree* tree)
+{
+    tree->root = FFX_BRIXELIZER_INSTANCE_TREE_NULL_NODE;
+    tree->freeNode = FFX_BRIXELIZER_INSTANCE_TREE_NULL_NODE;
+    tree->numNodes = 0;
+}
+
+static uint32_t instanceTreeAllocNode(FfxBrixelizerInstanceTree* tree)
+{
+    uint32_t index = tree->freeNode;
+    if (index != FFX_BRIXELIZER_INSTANCE_TREE_NULL_NODE) {
+        tree->freeNode = tree->nodes[index].parent;
+    } else {
+        FFX_ASSERT(tree->numNodes < FFX_ARRAY_ELEMENTS(tree->nodes));
+        index = tree->numNodes++;
+    }
+
+    FfxBrixelizerInstanceTreeNode *node = &tree->nodes[index];
+    node->parent = FFX_BRIXELIZER_INSTANCE_TREE_NULL_NODE;
+    node->children[0] = FFX_BRIXELIZER_INSTANCE_TREE_NULL_NODE;
+    node->children[1] = FFX_BRIXELIZER_INSTANCE_TREE_NULL_NODE;
+    node->height = 0;
+    return index;
+}
+
+static void instanceTreeFreeNode(FfxBrixelizerInstanceTree* tree, uint32_t index)
+{
+    tree->nodes[index].parent = tree->freeNode;
+    tree->nodes[index].height = -1;
+    tree->freeNode = index;
+}
+
+static void instanceTreeReplaceChild(FfxBrixelizerInstanceTree* tree, uint32_t parent, uint32_t oldChild, uint32_t newChild)
+{
+    if (parent == FFX_BRIXELIZER_INSTANCE_TREE_NULL_NODE) {
+        tree->root = newChild;
+    } else {
+        FfxBrixelizerInstanceTreeNode *node = &tree->nodes[parent];
+        node->children[node->children[0] == oldChild ? 0 : 1] = newChild;
+    }
+}
+
+static void instanceTreeRefit(FfxBrixelizerInstanceTree* tree, uint32_t index)
+{
+    FfxBrixelizerInstanceTreeNode *node = &tree->nodes[index];
+    FfxBrixelizerInstanceTreeNode *a = &tree->nodes[node->children[0]];
+    FfxBrixelizerInstanceTreeNode *b = &tree->nodes[node->children[1]];
+    node->aabb = aabbsUnion(a->aabb, b->aabb);
+    node->height = 1 + (a->height > b->height ? a->height : b->height);
+}
+
+// Rotates the taller child of node a above it when a is imbalanced, returns the new root of the subtree.
+static uint32_t instanceTreeBalance(FfxBrixelizerInstanceTree* tree, uint32_t a)
+{
+    FfxBrixelizerInstanceTreeNode *nodeA = &tree->nodes[a];
+    if (nodeA->height < 2) {
+        return a;
+    }
+
+    int32_t balance = tree->nodes[nodeA->children[1]].height - tree->nodes[nodeA->children[0]].height;
+    if (balance >= -1 && balance <= 1) {
+        return a;
+    }
+
+    uint32_t side = balance > 1 ? 1 : 0;
+    uint32_t c = nodeA->children[side];
+    FfxBrixelizerInstanceTreeNode *nodeC = &tree->nodes[c];
+    uint32_t f = nodeC->children[0];
+    uint32_t g = nodeC->children[1];
+
+    // c takes the place of a, a becomes child of c
+    nodeC->parent = nodeA->parent;
+    nodeA->parent = c;
+    instanceTreeReplaceChild(tree, nodeC->parent, a, c);
+
+    // Taller child of c stays with it, the other one moves into the place c had under a
+    uint32_t keep = tree->nodes[f].height > tree->nodes[g].height ? f : g;
+    uint32_t move = keep == f ? g : f;
+    nodeC->children[side] = keep;
+    nodeC->children[1 - side] = a;
+    nodeA->children[side] = move;
+    tree->nodes[move].parent = a;
+
+    instanceTreeRefit(tree, a);
+    instanceTreeRefit(tree, c);
+    return c;
+}
+
+static void instanceTreeRefitAncestors(FfxBrixelizerInstanceTree* tree, uint32_t index)
+{
+    while (index != FFX_BRIXELIZER_INSTANCE_TREE_NULL_NODE) {
+        index = instanceTreeBalance(tree, index);
+        instanceTreeRefit(tree, index);
+        index = tree->nodes[index].parent;
+    }
+}
+
+static void instanceTreeInsert(FfxBrixelizerInstanceTree* tree, FfxBrixelizerInstanceID instanceID, FfxBrixelizerAABB aabb)
+{
+    uint32_t leaf = instanceTreeAllocNode(tree);
+    tree->nodes[leaf].aabb = aabb;
+    tree->nodes[leaf].children[0] = instanceID;
+    tree->leaves[instanceID] = leaf;
+
+    if (tree->root == FFX_BRIXELIZER_INSTANCE_TREE_NULL_NODE) {
+        tree->root = leaf;
+        return;
+    }
+
+    // Descend towards the sibling giving the smallest increase in surface area
+    uint32_t sibling = tree->root;
+    while (tree->nodes[sibling].height > 0) {
+        FfxBrixelizerInstanceTreeNode *node = &tree->nodes[sibling];
+        float area = aabbSurfaceArea(node->aabb);
+        float combinedArea = aabbSurfaceArea(aabbsUnion(node->aabb, aabb));
+
+        // Cost of pairing the leaf with this node, and the least cost added to this node when pushing the leaf further down
+        float cost = 2.0f * combinedArea;
+        float inheritanceCost = 2.0f * (combinedArea - area);
+
+        float childCosts[2];
+        ifor (2) {
+            FfxBrixelizerInstanceTreeNode *child = &tree->nodes[node->children[i]];
+            childCosts[i] = aabbSurfaceArea(aabbsUnion(child->aabb, aabb)) + inheritanceCost;
+            if (child->height > 0) {
+                childCosts[i] -= aabbSurfaceArea(child->aabb);
+            }
+        }
+
+        if (cost < childCosts[0] && cost < childCosts[1]) {
+            break;
+        }
+        sibling = node->children[childCosts[0] < childCosts[1] ? 0 : 1];
+    }
+
+    uint32_t oldParent = tree->nodes[sibling].parent;
+    uint32_t newParent = instanceTreeAllocNode(tree);
+    tree->nodes[newParent].parent = oldParent;
+    tree->nodes[newParent].children[0] = sibling;
+    tree->nodes[newParent].children[1] = leaf;
+    tree->nodes[sibling].parent = newParent;
+    tree->nodes[leaf].parent = newParent;
+    instanceTreeReplaceChild(tree, oldParent, sibling, newParent);
+    instanceTreeRefit(tree, newParent);
+
+    instanceTreeRefitAncestors(tree, newParent);
+}
+
+static void instanceTreeRemove(FfxBrixelizerInstanceTree* tree, FfxBrixelizerInstanceID instanceID)
+{
+    uint32_t leaf = tree->leaves[instanceID];
+    FFX_ASSERT(leaf < tree->numNodes && tree->nodes[leaf].height == 0 && tree->nodes[leaf].children[0] == instanceID);
+
+    uint32_t parent = tree->nodes[leaf].parent;
+    instanceTreeFreeNode(tree, leaf);
+    if (parent == FFX_BRIXELIZER_INSTANCE_TREE_NULL_NODE) {
+        tree->root = FFX_BRIXELIZER_INSTANCE_TREE_NULL_NODE;
+        return;
+    }
+
+    // Sibling takes the place of the parent
+    FfxBrixelizerInstanceTreeNode *parentNode = &tree->nodes[parent];
+    uint32_t sibling = parentNode->children[parentNode->children[0] == leaf ? 1 : 0];
+    uint32_t grandParent = parentNode->parent;
+    tree->nodes[sibling].parent = grandParent;
+    instanceTreeReplaceChild(tree, grandParent, parent, sibling);
+    instanceTreeFreeNode(tree, parent);
+
+    instanceTreeRefitAncestors(tree, grandParent);
+}
+
 FfxErrorCode ffxBrixelizerContextCreate(const FfxBrixelizerContextDescription* desc, FfxBrixelizerContext* uncastOutContext)
 {
     FfxBrixelizerContext_Private *outContext = (FfxBrixelizerContext_Private*)uncastOutContext;
@@ -117,6 +335,7 @@ FfxErrorCode ffxBrixelizerContextCreate(const FfxBrixelizerContextDescription* d
 
     memset(outContext, 0, sizeof(*outContext));
     outContext->dynamicInstanceStartIndex = FFX_ARRAY_ELEMENTS(outContext->instances);
+    instanceTreeInit(&outContext->staticInstanceTree);
     RETURN_ON_FAIL(ffxBrixelizerRawContextCreate(&outContext->context, &rawDesc));
 
     uint32_t numStaticAndDynamicCascades = 0;
@@ -195,12 +414,18 @@ FfxErrorCode ffxBrixelizerContextDestroy(FfxBrixelizerContext* uncastContext)
     return FFX_OK;
 }
 
+static uint64_t brickRowMask(uint32_t begin, uint32_t end)
+{
+    return (~0ull >> (FFX_BRIXELIZER_CASCADE_RESOLUTION - (end - begin))) << begin;
+}
+
 FfxErrorCode ffxBrixelizerBakeUpdate(FfxBrixelizerContext* uncastContext, const FfxBrixelizerUpdateDescription* desc, FfxBrixelizerBakedUpdateDescription* uncastOutDesc)
 {
     FfxBrixelizerContext_Private *context = (FfxBrixelizerContext_Private*)uncastContext;
     FfxBrixelizerBakedUpdateDescription_Private *outDesc = (FfxBrixelizerBakedUpdateDescription_Private*)uncastOutDesc;
 
-    memset(outDesc, 0, sizeof(*outDesc));
+    // Job arrays are only read up to numStaticJobs and numDynamicJobs, so only clear what comes before them.
+    memset(outDesc, 0, offsetof(FfxBrixelizerBakedUpdateDescription_Private, staticJobs));
 
     uint32_t cascadeIndex = ffxBrixelizerRawGetCascadeToUpdate(desc->frameIndex, context->numCascades);
 
@@ -237,37 +462,54 @@ FfxErrorCode ffxBrixelizerBakeUpdate(FfxBrixelizerContext* uncastContext, const
         FfxBrixelizerRawJobDescription *curJob = outDesc->staticJobs;
 
         // Create instance jobs
-        ifor (context->numStaticInstances) {
-            FfxBrixelizerInstance *instance = &context->instances[i];
-            if (aabbsOverlap(instance->aabb, casacadeAABB)) {
-                FfxBrixelizerRawJobDescription job = {};
-                ifor (3) {
-                    job.aabbMin[i] = instance->aabb.min[i];
-                    job.aabbMax[i] = instance->aabb.max[i];
-                }
-                job.instanceIdx = instance->id;
-                *curJob++ = job;
-                outDesc->numStaticJobs++;
-                FFX_ASSERT(outDesc->numStaticJobs <= FFX_ARRAY_ELEMENTS(outDesc->staticJobs));
+        const FfxBrixelizerInstanceTree *tree = &context->staticInstanceTree;
+        uint32_t stack[FFX_BRIXELIZER_INSTANCE_TREE_STACK_SIZE];
+        uint32_t stackSize = 0;
+        if (tree->root != FFX_BRIXELIZER_INSTANCE_TREE_NULL_NODE) {
+            stack[stackSize++] = tree->root;
+        }
+        while (stackSize) {
+            const FfxBrixelizerInstanceTreeNode *node = &tree->nodes[stack[--stackSize]];
+            if (!aabbsOverlap(node->aabb, casacadeAABB)) {
+                continue;
+            }
+            if (node->height > 0) {
+                FFX_ASSERT(stackSize + 2 <= FFX_ARRAY_ELEMENTS(stack));
+                stack[stackSize++] = node->children[0];
+                stack[stackSize++] = node->children[1];
+                continue;
+            }
+
+            FfxBrixelizerRawJobDescription job = {};
+            ifor (3) {
+                job.aabbMin[i] = node->aabb.min[i];
+                job.aabbMax[i] = node->aabb.max[i];
             }
+            job.instanceIdx = node->children[0];
+            *curJob++ = job;
+            outDesc->numStaticJobs++;
+            FFX_ASSERT(outDesc->numStaticJobs <= FFX_ARRAY_ELEMENTS(outDesc->staticJobs));
         }
 
-        // Create invalidations
+        // Mark the bricks touched by invalidations of this cascade
+        uint64_t *invalidBricks = context->scratchSpace.bakeUpdate.invalidBricks;
+        bool anyInvalidBricks = false;
+        memset(invalidBricks, 0, sizeof(context->scratchSpace.bakeUpdate.invalidBricks));
+
         uint32_t cascadeMask = 1 << cascadeIndex;
         uint32_t curInvalidation= 0;
         while (curInvalidation < context->numInvalidations) {
             FfxBrixelizerInvalidation *invalidation = &context->invalidations[curInvalidation];
             if (invalidation->cascades & cascadeMask) {
-                if (aabbsOverlap(invalidation->aabb, casacadeAABB)) {
-                    FfxBrixelizerRawJobDescription job = {};
-                    ifor (3) {
-                        job.aabbMin[i] = invalidation->aabb.min[i];
-                        job.aabbMax[i] = invalidation->aabb.max[i];
+                uint32_t brickMin[3], brickMax[3];
+                if (ffxBrixelizerGetJobBricks(cascadeUpdateDesc->cascadeMin, cascadePrivate->voxelSize, invalidation->aabb.min, invalidation->aabb.max, brickMin, brickMax)) {
+                    uint64_t rowMask = brickRowMask(brickMin[0], brickMax[0]);
+                    for (uint32_t z = brickMin[2]; z < brickMax[2]; ++z) {
+                        for (uint32_t y = brickMin[1]; y < brickMax[1]; ++y) {
+                            invalidBricks[z * FFX_BRIXELIZER_CASCADE_RESOLUTION + y] |= rowMask;
+                        }
                     }
-                    job.flags = FFX_BRIXELIZER_RAW_JOB_FLAG_INVALIDATE;
-                    *curJob++ = job;
-                    outDesc->numStaticJobs++;
-                    FFX_ASSERT(outDesc->numStaticJobs <= FFX_ARRAY_ELEMENTS(outDesc->staticJobs));
+                    anyInvalidBricks = true;
                 }
                 invalidation->cascades &= ~cascadeMask;
                 if (!invalidation->cascades) {
@@ -277,6 +519,57 @@ FfxErrorCode ffxBrixelizerBakeUpdate(FfxBrixelizerContext* uncastContext, const
             }
             ++curInvalidation;
         }
+
+        // Create invalidation jobs from boxes of marked bricks, grown greedily along x, then y, then z
+        for (uint32_t z = 0; anyInvalidBricks && z < FFX_BRIXELIZER_CASCADE_RESOLUTION; ++z) {
+            for (uint32_t y = 0; y < FFX_BRIXELIZER_CASCADE_RESOLUTION; ++y) {
+                uint64_t *row = &invalidBricks[z * FFX_BRIXELIZER_CASCADE_RESOLUTION + y];
+                while (*row) {
+                    uint32_t brickMin[3] = { 0, y, z };
+                    uint32_t brickMax[3] = { 0, y + 1, z + 1 };
+                    while (!((*row >> brickMin[0]) & 1)) {
+                        ++brickMin[0];
+                    }
+                    brickMax[0] = brickMin[0] + 1;
+                    while (brickMax[0] < FFX_BRIXELIZER_CASCADE_RESOLUTION && ((*row >> brickMax[0]) & 1)) {
+                        ++brickMax[0];
+                    }
+                    uint64_t rowMask = brickRowMask(brickMin[0], brickMax[0]);
+
+                    while (brickMax[1] < FFX_BRIXELIZER_CASCADE_RESOLUTION && (invalidBricks[z * FFX_BRIXELIZER_CASCADE_RESOLUTION + brickMax[1]] & rowMask) == rowMask) {
+                        ++brickMax[1];
+                    }
+                    for (; brickMax[2] < FFX_BRIXELIZER_CASCADE_RESOLUTION; ++brickMax[2]) {
+                        bool fullSlice = true;
+                        for (uint32_t y1 = brickMin[1]; y1 < brickMax[1] && fullSlice; ++y1) {
+                            fullSlice = (invalidBricks[brickMax[2] * FFX_BRIXELIZER_CASCADE_RESOLUTION + y1] & rowMask) == rowMask;
+                        }
+                        if (!fullSlice) {
+                            break;
+                        }
+                    }
+                    for (uint32_t z1 = brickMin[2]; z1 < brickMax[2]; ++z1) {
+                        for (uint32_t y1 = brickMin[1]; y1 < brickMax[1]; ++y1) {
+                            invalidBricks[z1 * FFX_BRIXELIZER_CASCADE_RESOLUTION + y1] &= ~rowMask;
+                        }
+                    }
+
+                    FfxBrixelizerRawJobDescription job = {};
+                    ffxBrixelizerGetBricksJobAABB(cascadeUpdateDesc->cascadeMin, cascadePrivate->voxelSize, brickMin, brickMax, job.aabbMin, job.aabbMax);
+                    job.flags = FFX_BRIXELIZER_RAW_JOB_FLAG_INVALIDATE;
+#ifdef _DEBUG
+                    uint32_t jobBrickMin[3], jobBrickMax[3];
+                    FFX_ASSERT(ffxBrixelizerGetJobBricks(cascadeUpdateDesc->cascadeMin, cascadePrivate->voxelSize, job.aabbMin, job.aabbMax, jobBrickMin, jobBrickMax));
+                    ifor (3) {
+                        FFX_ASSERT(jobBrickMin[i] == brickMin[i] && jobBrickMax[i] == brickMax[i]);
+                    }
+#endif
+                    *curJob++ = job;
+                    outDesc->numStaticJobs++;
+                    FFX_ASSERT(outDesc->numStaticJobs <= FFX_ARRAY_ELEMENTS(outDesc->staticJobs));
+                }
+            }
+        }
     }
 
     // create dynamic jobs
@@ -507,7 +800,33 @@ static void addInvalidationJob(FfxBrixelizerContext_Private* context, FfxBrixeli
     invalidation.cascades = cascadesMask;
     invalidation.aabb = aabb;
 
-    FFX_ASSERT(context->numInvalidations < FFX_ARRAY_ELEMENTS(context->invalidations));
+    // Instances are mostly created and deleted in spatially coherent batches, so fold overlapping
+    // invalidations into the previous one while their union stays about as tight as the pair.
+    if (context->numInvalidations) {
+        FfxBrixelizerInvalidation *last = &context->invalidations[context->numInvalidations - 1];
+        if (last->cascades == invalidation.cascades) {
+            FfxBrixelizerAABB merged = aabbsUnion(last->aabb, invalidation.aabb);
+            if (aabbSurfaceArea(merged) <= aabbSurfaceArea(last->aabb) + aabbSurfaceArea(invalidation.aabb)) {
+                last->aabb = merged;
+                return;
+            }
+        }
+    }
+
+    // When full merge neighbouring pairs, invalidating a larger area is always safe.
+    if (context->numInvalidations == FFX_ARRAY_ELEMENTS(context->invalidations)) {
+        uint32_t numMerged = 0;
+        for (uint32_t i = 0; i < context->numInvalidations; i += 2) {
+            FfxBrixelizerInvalidation pair = context->invalidations[i];
+            if (i + 1 < context->numInvalidations) {
+                pair.cascades |= context->invalidations[i + 1].cascades;
+                pair.aabb = aabbsUnion(pair.aabb, context->invalidations[i + 1].aabb);
+            }
+            context->invalidations[numMerged++] = pair;
+        }
+        context->numInvalidations = numMerged;
+    }
+
     context->invalidations[context->numInvalidations++] = invalidation;
 }
 
@@ -567,6 +886,7 @@ FfxErrorCode ffxBrixelizerCreateInstances(FfxBrixelizerContext* uncastContext, c
             instance->id = instanceID;
             instance->aabb = desc->aabb;
             context->instanceIndices[instanceID] = instanceIndex;
+            instanceTreeInsert(&context->staticInstanceTree, instanceID, desc->aabb);
 
             addInvalidationJob(context, desc->aabb);
 
@@ -592,6 +912,7 @@ FfxErrorCode ffxBrixelizerDeleteInstances(FfxBrixelizerContext* uncastContext, c
         FfxBrixelizerInstance instance = context->instances[index];
 
         addInvalidationJob(context, instance.aabb);
+        instanceTreeRemove(&context->staticInstanceTree, instanceID);
 
         instance = context->instances[--context->numStaticInstances];
         context->instances[index] = instance;
@@ -0,0 +1,358 @@
+// This file is part of the FidelityFX SDK.
+//
+// Copyright (C) 2024 Advanced Micro Devices, Inc.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+
+#include <stdint.h>   // for integer types.
+#include <stdlib.h>   // for qsort.
+#include <string.h>   // for memcpy.
+
+#define FFX_CPU
+#include <FidelityFX/gpu/ffx_core.h>
+#include <FidelityFX/host/ffx_brixelizer_raw.h>
+
+#include "ffx_brixelizer_cascade_cache.h"
+
+#define FFX_BRIXELIZER_BRICKS_PER_ATLAS_DIMENSION (FFX_BRIXELIZER_STATIC_CONFIG_SDF_ATLAS_SIZE / FFX_BRIXELIZER_BRICK_DIMENSION)
+#define FFX_BRIXELIZER_CASCADE_BRICK_MAP_ENTRIES  (FFX_BRIXELIZER_CASCADE_RESOLUTION * FFX_BRIXELIZER_CASCADE_RESOLUTION * FFX_BRIXELIZER_CASCADE_RESOLUTION)
+
+static const uint64_t HASH_SEED  = 0xcbf29ce484222325ull;
+static const uint64_t HASH_PRIME = 0x100000001b3ull;
+
+static uint64_t hashMix(uint64_t hash)
+{
+    hash ^= hash >> 33;
+    hash *= 0xff51afd7ed558ccdull;
+    hash ^= hash >> 33;
+    return hash;
+}
+
+// FNV-1a over 64-bit words with a shift so high bits reach the whole hash, then over the remaining bytes.
+static uint64_t hashBytes(uint64_t hash, const void* data, size_t size)
+{
+    const uint8_t* bytes = (const uint8_t*)data;
+    for (; size >= sizeof(uint64_t); size -= sizeof(uint64_t), bytes += sizeof(uint64_t))
+    {
+        uint64_t word;
+        memcpy(&word, bytes, sizeof(word));
+        hash = (hash ^ word) * HASH_PRIME;
+        hash ^= hash >> 29;
+    }
+    for (; size; --size, ++bytes)
+        hash = (hash ^ *bytes) * HASH_PRIME;
+    return hash;
+}
+
+static bool isValidBrickEntry(uint32_t entry)
+{
+    return (entry & FFX_BRIXELIZER_BRICK_ID_MASK) != FFX_BRIXELIZER_INVALID_ID;
+}
+
+// Offset of the first texel of a brick in a tightly packed SDF atlas, see FfxBrixelizerGetSDFAtlasOffset.
+static size_t getAtlasBrickOffset(uint32_t brickIndex)
+{
+    size_t x = (brickIndex % FFX_BRIXELIZER_BRICKS_PER_ATLAS_DIMENSION) * FFX_BRIXELIZER_BRICK_DIMENSION;
+    size_t y = ((brickIndex / FFX_BRIXELIZER_BRICKS_PER_ATLAS_DIMENSION) % FFX_BRIXELIZER_BRICKS_PER_ATLAS_DIMENSION) * FFX_BRIXELIZER_BRICK_DIMENSION;
+    size_t z = (brickIndex / FFX_BRIXELIZER_BRICKS_PER_ATLAS_DIMENSION / FFX_BRIXELIZER_BRICKS_PER_ATLAS_DIMENSION) * FFX_BRIXELIZER_BRICK_DIMENSION;
+    return (z * FFX_BRIXELIZER_STATIC_CONFIG_SDF_ATLAS_SIZE + y) * FFX_BRIXELIZER_STATIC_CONFIG_SDF_ATLAS_SIZE + x;
+}
+
+static void copyBrickFromAtlas(const uint8_t* sdfAtlas, uint32_t brickIndex, uint8_t* texels)
+{
+    const uint8_t* brick = sdfAtlas + getAtlasBrickOffset(brickIndex);
+    for (uint32_t z = 0; z < FFX_BRIXELIZER_BRICK_DIMENSION; ++z)
+        for (uint32_t y = 0; y < FFX_BRIXELIZER_BRICK_DIMENSION; ++y)
+            memcpy(texels + (z * FFX_BRIXELIZER_BRICK_DIMENSION + y) * FFX_BRIXELIZER_BRICK_DIMENSION,
+                   brick + ((size_t)z * FFX_BRIXELIZER_STATIC_CONFIG_SDF_ATLAS_SIZE + y) * FFX_BRIXELIZER_STATIC_CONFIG_SDF_ATLAS_SIZE,
+                   FFX_BRIXELIZER_BRICK_DIMENSION);
+}
+
+static void copyBrickToAtlas(const uint8_t* texels, uint32_t brickIndex, uint8_t* sdfAtlas)
+{
+    uint8_t* brick = sdfAtlas + getAtlasBrickOffset(brickIndex);
+    for (uint32_t z = 0; z < FFX_BRIXELIZER_BRICK_DIMENSION; ++z)
+        for (uint32_t y = 0; y < FFX_BRIXELIZER_BRICK_DIMENSION; ++y)
+            memcpy(brick + ((size_t)z * FFX_BRIXELIZER_STATIC_CONFIG_SDF_ATLAS_SIZE + y) * FFX_BRIXELIZER_STATIC_CONFIG_SDF_ATLAS_SIZE,
+                   texels + (z * FFX_BRIXELIZER_BRICK_DIMENSION + y) * FFX_BRIXELIZER_BRICK_DIMENSION,
+                   FFX_BRIXELIZER_BRICK_DIMENSION);
+}
+
+static int compareCacheInstances(const void* a, const void* b)
+{
+    uint64_t hashA = ((const FfxBrixelizerCascadeCacheInstance*)a)->hash;
+    uint64_t hashB = ((const FfxBrixelizerCascadeCacheInstance*)b)->hash;
+    return hashA < hashB ? -1 : hashA > hashB ? 1 : 0;
+}
+
+static bool resourceDataIsValid(const FfxBrixelizerCascadeCacheResourceData* resourceData)
+{
+    return resourceData->brickMap && resourceData->aabbTree && resourceData->brickAABBs && resourceData->sdfAtlas;
+}
+
+// Pointers to the sections of a cascade cache, see FfxBrixelizerCascadeCacheHeader.
+typedef struct CascadeCacheSections
+{
+    FfxBrixelizerCascadeCacheHeader*   header;
+    FfxBrixelizerCascadeCacheInstance* instances;
+    uint32_t*                          brickMap;
+    uint8_t*                           aabbTree;
+    uint32_t*                          brickAABBs;
+    uint8_t*                           bricks;
+} CascadeCacheSections;
+
+static CascadeCacheSections getCascadeCacheSections(void* cache, uint32_t numInstances, uint32_t numBricks)
+{
+    CascadeCacheSections sections = {};
+    sections.header     = (FfxBrixelizerCascadeCacheHeader*)cache;
+    sections.instances  = (FfxBrixelizerCascadeCacheInstance*)(sections.header + 1);
+    sections.brickMap   = (uint32_t*)(sections.instances + numInstances);
+    sections.aabbTree   = (uint8_t*)(sections.brickMap + FFX_BRIXELIZER_CASCADE_BRICK_MAP_ENTRIES);
+    sections.brickAABBs = (uint32_t*)(sections.aabbTree + FFX_BRIXELIZER_CASCADE_AABB_TREE_SIZE);
+    sections.bricks     = (uint8_t*)(sections.brickAABBs + numBricks);
+    return sections;
+}
+
+uint64_t brixelizerGetInstanceHash(const FfxBrixelizerRawInstanceDescription* instanceDescription)
+{
+    FFX_ASSERT(instanceDescription);
+
+    // Hash fields one by one, buffer indices depend on registration order and outInstanceID is a pointer.
+    uint64_t hash = HASH_SEED;
+    hash = hashBytes(hash, instanceDescription->aabbMin, sizeof(instanceDescription->aabbMin));
+    hash = hashBytes(hash, instanceDescription->aabbMax, sizeof(instanceDescription->aabbMax));
+    hash = hashBytes(hash, &instanceDescription->transform, sizeof(instanceDescription->transform));
+    hash = hashBytes(hash, &instanceDescription->indexFormat, sizeof(instanceDescription->indexFormat));
+    hash = hashBytes(hash, &instanceDescription->indexBufferOffset, sizeof(instanceDescription->indexBufferOffset));
+    hash = hashBytes(hash, &instanceDescription->triangleCount, sizeof(instanceDescription->triangleCount));
+    hash = hashBytes(hash, &instanceDescription->vertexStride, sizeof(instanceDescription->vertexStride));
+    hash = hashBytes(hash, &instanceDescription->vertexBufferOffset, sizeof(instanceDescription->vertexBufferOffset));
+    hash = hashBytes(hash, &instanceDescription->vertexCount, sizeof(instanceDescription->vertexCount));
+    hash = hashBytes(hash, &instanceDescription->vertexFormat, sizeof(instanceDescription->vertexFormat));
+    hash = hashBytes(hash, &instanceDescription->flags, sizeof(instanceDescription->flags));
+    return hashMix(hash);
+}
+
+uint64_t brixelizerGetInstanceSetHash(const FfxBrixelizerCascadeCacheInstance* instances, uint32_t numInstances)
+{
+    FFX_ASSERT(instances || !numInstances);
+
+    // A sum of mixed hashes doesn't depend on the order of the instances.
+    uint64_t hash = hashMix(HASH_SEED ^ numInstances);
+    for (uint32_t i = 0; i < numInstances; ++i)
+        hash += hashMix(instances[i].hash ^ HASH_SEED);
+    return hashMix(hash);
+}
+
+FfxErrorCode brixelizerCascadeCacheGetSize(const FfxBrixelizerCascadeCacheDescription* cacheDescription, size_t* size)
+{
+    FFX_RETURN_ON_ERROR(cacheDescription, FFX_ERROR_INVALID_POINTER);
+    FFX_RETURN_ON_ERROR(resourceDataIsValid(&cacheDescription->resourceData), FFX_ERROR_INVALID_POINTER);
+    FFX_RETURN_ON_ERROR(cacheDescription->instances || !cacheDescription->numInstances, FFX_ERROR_INVALID_POINTER);
+    FFX_RETURN_ON_ERROR(size, FFX_ERROR_INVALID_POINTER);
+
+    uint32_t numBricks = 0;
+    for (uint32_t i = 0; i < FFX_BRIXELIZER_CASCADE_BRICK_MAP_ENTRIES; ++i)
+        numBricks += isValidBrickEntry(cacheDescription->resourceData.brickMap[i]) ? 1 : 0;
+
+    *size = (size_t)brixelizerGetCascadeCacheSize(cacheDescription->numInstances, numBricks);
+    return FFX_OK;
+}
+
+FfxErrorCode brixelizerCascadeCacheWrite(const FfxBrixelizerCascadeCacheDescription* cacheDescription, void* cache, size_t cacheSize)
+{
+    FFX_RETURN_ON_ERROR(cache, FFX_ERROR_INVALID_POINTER);
+    FFX_RETURN_ON_ERROR(((uintptr_t)cache % sizeof(uint64_t)) == 0, FFX_ERROR_INVALID_ALIGNMENT);
+
+    size_t requiredSize = 0;
+    FfxErrorCode errorCode = brixelizerCascadeCacheGetSize(cacheDescription, &requiredSize);
+    FFX_RETURN_ON_ERROR(errorCode == FFX_OK, errorCode);
+    FFX_RETURN_ON_ERROR(cacheSize >= requiredSize, FFX_ERROR_INSUFFICIENT_MEMORY);
+
+    const FfxBrixelizerCascadeCacheResourceData* resourceData = &cacheDescription->resourceData;
+    uint32_t numBricks = (uint32_t)((requiredSize - brixelizerGetCascadeCacheSize(cacheDescription->numInstances, 0)) / (FFX_BRIXELIZER_BRICK_AABBS_STRIDE + FFX_BRIXELIZER_BRICK_TEXELS));
+    CascadeCacheSections sections = getCascadeCacheSections(cache, cacheDescription->numInstances, numBricks);
+
+    if (cacheDescription->numInstances)
+    {
+        memcpy(sections.instances, cacheDescription->instances, cacheDescription->numInstances * sizeof(FfxBrixelizerCascadeCacheInstance));
+        qsort(sections.instances, cacheDescription->numInstances, sizeof(FfxBrixelizerCascadeCacheInstance), compareCacheInstances);
+    }
+
+    // Pack the bricks of the cascade in brick map order and point the brick map at them
+    uint32_t cachedBrick = 0;
+    for (uint32_t i = 0; i < FFX_BRIXELIZER_CASCADE_BRICK_MAP_ENTRIES; ++i)
+    {
+        uint32_t entry = resourceData->brickMap[i];
+        if (!isValidBrickEntry(entry))
+        {
+            sections.brickMap[i] = entry;
+            continue;
+        }
+
+        uint32_t brickIndex = entry & FFX_BRIXELIZER_BRICK_ID_MASK;
+        FFX_RETURN_ON_ERROR(brickIndex < FFX_BRIXELIZER_MAX_BRICKS, FFX_ERROR_OUT_OF_RANGE);
+
+        sections.brickMap[i] = (entry & ~FFX_BRIXELIZER_BRICK_ID_MASK) | cachedBrick;
+        sections.brickAABBs[cachedBrick] = resourceData->brickAABBs[brickIndex];
+        copyBrickFromAtlas(resourceData->sdfAtlas, brickIndex, sections.bricks + (size_t)cachedBrick * FFX_BRIXELIZER_BRICK_TEXELS);
+        ++cachedBrick;
+    }
+    FFX_ASSERT(cachedBrick == numBricks);
+
+    memcpy(sections.aabbTree, resourceData->aabbTree, FFX_BRIXELIZER_CASCADE_AABB_TREE_SIZE);
+
+    FfxBrixelizerCascadeCacheHeader* header = sections.header;
+    header->magic                 = FFX_BRIXELIZER_CASCADE_CACHE_MAGIC;
+    header->version               = FFX_BRIXELIZER_CASCADE_CACHE_VERSION;
+    header->key.instanceSetHash   = brixelizerGetInstanceSetHash(cacheDescription->instances, cacheDescription->numInstances);
+    header->key.voxelSize         = cacheDescription->voxelSize;
+    header->key.clipmapOffset[0]  = cacheDescription->clipmapOffset[0];
+    header->key.clipmapOffset[1]  = cacheDescription->clipmapOffset[1];
+    header->key.clipmapOffset[2]  = cacheDescription->clipmapOffset[2];
+    header->numInstances          = cacheDescription->numInstances;
+    header->numBricks             = numBricks;
+    header->checksum              = hashBytes(HASH_SEED, header + 1, requiredSize - sizeof(*header));
+
+    return FFX_OK;
+}
+
+FfxErrorCode brixelizerCascadeCacheValidate(const void* cache, size_t cacheSize, FfxBrixelizerCascadeCacheInfo* cacheInfo)
+{
+    FFX_RETURN_ON_ERROR(cache, FFX_ERROR_INVALID_POINTER);
+    FFX_RETURN_ON_ERROR(cacheInfo, FFX_ERROR_INVALID_POINTER);
+    FFX_RETURN_ON_ERROR(((uintptr_t)cache % sizeof(uint64_t)) == 0, FFX_ERROR_INVALID_ALIGNMENT);
+    FFX_RETURN_ON_ERROR(cacheSize >= sizeof(FfxBrixelizerCascadeCacheHeader), FFX_ERROR_MALFORMED_DATA);
+
+    const FfxBrixelizerCascadeCacheHeader* header = (const FfxBrixelizerCascadeCacheHeader*)cache;
+    FFX_RETURN_ON_ERROR(header->magic == FFX_BRIXELIZER_CASCADE_CACHE_MAGIC, FFX_ERROR_MALFORMED_DATA);
+    FFX_RETURN_ON_ERROR(header->version == FFX_BRIXELIZER_CASCADE_CACHE_VERSION, FFX_ERROR_INVALID_VERSION);
+    FFX_RETURN_ON_ERROR(header->numBricks <= FFX_BRIXELIZER_MAX_BRICKS, FFX_ERROR_MALFORMED_DATA);
+    FFX_RETURN_ON_ERROR(cacheSize == brixelizerGetCascadeCacheSize(header->numInstances, header->numBricks), FFX_ERROR_MALFORMED_DATA);
+    FFX_RETURN_ON_ERROR(header->checksum == hashBytes(HASH_SEED, header + 1, cacheSize - sizeof(*header)), FFX_ERROR_MALFORMED_DATA);
+
+    CascadeCacheSections sections = getCascadeCacheSections(const_cast<void*>(cache), header->numInstances, header->numBricks);
+    for (uint32_t i = 1; i < header->numInstances; ++i)
+        FFX_RETURN_ON_ERROR(sections.instances[i - 1].hash <= sections.instances[i].hash, FFX_ERROR_MALFORMED_DATA);
+
+    // Bricks are stored in brick map order, so valid entries have to count up from zero
+    uint32_t nextBrick = 0;
+    for (uint32_t i = 0; i < FFX_BRIXELIZER_CASCADE_BRICK_MAP_ENTRIES; ++i)
+    {
+        uint32_t entry = sections.brickMap[i];
+        if (isValidBrickEntry(entry))
+        {
+            FFX_RETURN_ON_ERROR((entry & FFX_BRIXELIZER_BRICK_ID_MASK) == nextBrick, FFX_ERROR_MALFORMED_DATA);
+            ++nextBrick;
+        }
+    }
+    FFX_RETURN_ON_ERROR(nextBrick == header->numBricks, FFX_ERROR_MALFORMED_DATA);
+
+    cacheInfo->key          = header->key;
+    cacheInfo->numInstances = header->numInstances;
+    cacheInfo->numBricks    = header->numBricks;
+    return FFX_OK;
+}
+
+FfxErrorCode brixelizerCascadeCacheRead(const void* cache, size_t cacheSize, const uint32_t* brickIndices, const FfxBrixelizerCascadeCacheResourceData* resourceData)
+{
+    FFX_RETURN_ON_ERROR(resourceData, FFX_ERROR_INVALID_POINTER);
+    FFX_RETURN_ON_ERROR(resourceDataIsValid(resourceData), FFX_ERROR_INVALID_POINTER);
+
+    FfxBrixelizerCascadeCacheInfo cacheInfo = {};
+    FfxErrorCode errorCode = brixelizerCascadeCacheValidate(cache, cacheSize, &cacheInfo);
+    FFX_RETURN_ON_ERROR(errorCode == FFX_OK, errorCode);
+    FFX_RETURN_ON_ERROR(brickIndices || !cacheInfo.numBricks, FFX_ERROR_INVALID_POINTER);
+
+    for (uint32_t i = 0; i < cacheInfo.numBricks; ++i)
+        FFX_RETURN_ON_ERROR(brickIndices[i] < FFX_BRIXELIZER_MAX_BRICKS, FFX_ERROR_OUT_OF_RANGE);
+
+    CascadeCacheSections sections = getCascadeCacheSections(const_cast<void*>(cache), cacheInfo.numInstances, cacheInfo.numBricks);
+    for (uint32_t i = 0; i < FFX_BRIXELIZER_CASCADE_BRICK_MAP_ENTRIES; ++i)
+    {
+        uint32_t entry = sections.brickMap[i];
+        if (!isValidBrickEntry(entry))
+        {
+            resourceData->brickMap[i] = entry;
+            continue;
+        }
+
+        uint32_t cachedBrick = entry & FFX_BRIXELIZER_BRICK_ID_MASK;
+        uint32_t brickIndex  = brickIndices[cachedBrick];
+        resourceData->brickMap[i] = (entry & ~FFX_BRIXELIZER_BRICK_ID_MASK) | brickIndex;
+        resourceData->brickAABBs[brickIndex] = sections.brickAABBs[cachedBrick];
+        copyBrickToAtlas(sections.bricks + (size_t)cachedBrick * FFX_BRIXELIZER_BRICK_TEXELS, brickIndex, resourceData->sdfAtlas);
+    }
+
+    memcpy(resourceData->aabbTree, sections.aabbTree, FFX_BRIXELIZER_CASCADE_AABB_TREE_SIZE);
+
+    return FFX_OK;
+}
+
+FfxErrorCode brixelizerCascadeCacheGetInvalidations(const void* cache, size_t cacheSize, FfxBrixelizerCascadeCacheInstance* instances, uint32_t numInstances, FfxBrixelizerRawJobDescription* jobs, uint32_t maxJobs, uint32_t* numJobs)
+{
+    FFX_RETURN_ON_ERROR(instances || !numInstances, FFX_ERROR_INVALID_POINTER);
+    FFX_RETURN_ON_ERROR(jobs || !maxJobs, FFX_ERROR_INVALID_POINTER);
+    FFX_RETURN_ON_ERROR(numJobs, FFX_ERROR_INVALID_POINTER);
+
+    FfxBrixelizerCascadeCacheInfo cacheInfo = {};
+    FfxErrorCode errorCode = brixelizerCascadeCacheValidate(cache, cacheSize, &cacheInfo);
+    FFX_RETURN_ON_ERROR(errorCode == FFX_OK, errorCode);
+
+    if (numInstances)
+        qsort(instances, numInstances, sizeof(FfxBrixelizerCascadeCacheInstance), compareCacheInstances);
+
+    // Walk both sorted lists, every instance found in only one of them changes the area it covers
+    CascadeCacheSections sections = getCascadeCacheSections(const_cast<void*>(cache), cacheInfo.numInstances, cacheInfo.numBricks);
+    uint32_t cachedIndex  = 0;
+    uint32_t currentIndex = 0;
+    uint32_t jobCount     = 0;
+    while (cachedIndex < cacheInfo.numInstances || currentIndex < numInstances)
+    {
+        const FfxBrixelizerCascadeCacheInstance* changed = nullptr;
+        if (currentIndex == numInstances || (cachedIndex < cacheInfo.numInstances && sections.instances[cachedIndex].hash < instances[currentIndex].hash))
+        {
+            changed = &sections.instances[cachedIndex++];
+        }
+        else if (cachedIndex == cacheInfo.numInstances || instances[currentIndex].hash < sections.instances[cachedIndex].hash)
+        {
+            changed = &instances[currentIndex++];
+        }
+        else
+        {
+            ++cachedIndex;
+            ++currentIndex;
+            continue;
+        }
+
+        if (jobCount < maxJobs)
+        {
+            FfxBrixelizerRawJobDescription* job = &jobs[jobCount];
+            memset(job, 0, sizeof(*job));
+            memcpy(job->aabbMin, changed->aabbMin, sizeof(job->aabbMin));
+            memcpy(job->aabbMax, changed->aabbMax, sizeof(job->aabbMax));
+            job->flags = FFX_BRIXELIZER_RAW_JOB_FLAG_INVALIDATE;
+        }
+        ++jobCount;
+    }
+
+    *numJobs = jobCount;
+    return jobCount <= maxJobs ? FFX_OK : FFX_ERROR_INSUFFICIENT_MEMORY;
+}
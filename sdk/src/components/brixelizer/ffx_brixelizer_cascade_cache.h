@@ -0,0 +1,114 @@
+// This file is part of the FidelityFX SDK.
+//
+// Copyright (C) 2024 Advanced Micro Devices, Inc.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+
+#pragma once
+
+#include <FidelityFX/host/ffx_brixelizer_raw.h>
+
+// CPU side of a cache for baked static cascades. It is kept out of the public API until the raw context can stream a
+// cache back in: bricks are allocated on the GPU, so a restore needs an allocation pass handing out the brick indices
+// brixelizerCascadeCacheRead() writes to. Until then only FidelityFX_BrixelizerBench uses it.
+
+// Identifies the contents of a cached static cascade. A cache can only be restored into a cascade with the same voxel
+// size and clipmap offset, and is complete only when it was built from the same set of instances.
+typedef struct FfxBrixelizerCascadeCacheKey
+{
+    uint64_t instanceSetHash;   // See brixelizerGetInstanceSetHash().
+    float    voxelSize;
+    int32_t  clipmapOffset[3];  // As passed in FfxBrixelizerRawCascadeUpdateDescription.
+} FfxBrixelizerCascadeCacheKey;
+
+typedef struct FfxBrixelizerCascadeCacheInstance
+{
+    uint64_t hash;              // See brixelizerGetInstanceHash().
+    float    aabbMin[3];
+    float    aabbMax[3];
+} FfxBrixelizerCascadeCacheInstance;
+
+// CPU copies of the resources of a cascade.
+typedef struct FfxBrixelizerCascadeCacheResourceData
+{
+    uint32_t* brickMap;         // FFX_BRIXELIZER_CASCADE_BRICK_MAP_SIZE bytes.
+    void*     aabbTree;         // FFX_BRIXELIZER_CASCADE_AABB_TREE_SIZE bytes.
+    uint32_t* brickAABBs;       // FFX_BRIXELIZER_BRICK_AABBS_SIZE bytes.
+    uint8_t*  sdfAtlas;         // 512x512x512 tightly packed 8-bit values with x varying fastest.
+} FfxBrixelizerCascadeCacheResourceData;
+
+typedef struct FfxBrixelizerCascadeCacheDescription
+{
+    float                                    voxelSize;
+    int32_t                                  clipmapOffset[3];  // When the resources were read back.
+    const FfxBrixelizerCascadeCacheInstance* instances;         // The instances the cascade was built from.
+    uint32_t                                 numInstances;
+    FfxBrixelizerCascadeCacheResourceData    resourceData;      // Only read from.
+} FfxBrixelizerCascadeCacheDescription;
+
+typedef struct FfxBrixelizerCascadeCacheInfo
+{
+    FfxBrixelizerCascadeCacheKey key;
+    uint32_t                     numInstances;
+    uint32_t                     numBricks;
+} FfxBrixelizerCascadeCacheInfo;
+
+// Covers the AABB, transform and geometry layout of an instance, but neither buffer slots nor buffer contents.
+uint64_t brixelizerGetInstanceHash(const FfxBrixelizerRawInstanceDescription* instanceDescription);
+// Does not depend on the order of the instances.
+uint64_t brixelizerGetInstanceSetHash(const FfxBrixelizerCascadeCacheInstance* instances, uint32_t numInstances);
+
+FfxErrorCode brixelizerCascadeCacheGetSize(const FfxBrixelizerCascadeCacheDescription* cacheDescription, size_t* size);
+// Stores only the bricks referenced by the brick map. The cache has to be 8-byte aligned.
+FfxErrorCode brixelizerCascadeCacheWrite(const FfxBrixelizerCascadeCacheDescription* cacheDescription, void* cache, size_t cacheSize);
+// Checks magic, version, size, checksum and every section before anything is read.
+FfxErrorCode brixelizerCascadeCacheValidate(const void* cache, size_t cacheSize, FfxBrixelizerCascadeCacheInfo* cacheInfo);
+// Places cached brick i at brickIndices[i] in the atlas and brick AABBs, other bricks are left untouched.
+FfxErrorCode brixelizerCascadeCacheRead(const void* cache, size_t cacheSize, const uint32_t* brickIndices, const FfxBrixelizerCascadeCacheResourceData* resourceData);
+// Invalidation jobs for instances removed or added since the cache was written. Sorts instances by hash in place,
+// sets numJobs and returns FFX_ERROR_INSUFFICIENT_MEMORY when more than maxJobs are needed.
+FfxErrorCode brixelizerCascadeCacheGetInvalidations(const void* cache, size_t cacheSize, FfxBrixelizerCascadeCacheInstance* instances, uint32_t numInstances, FfxBrixelizerRawJobDescription* jobs, uint32_t maxJobs, uint32_t* numJobs);
+
+// Layout of a cascade cache written by brixelizerCascadeCacheWrite(). All sections follow the header in the order:
+// instances sorted by hash, brick map, AABB tree, brick AABBs, brick texels. Valid entries of the cached brick map hold
+// indices into the cached bricks instead of into the SDF atlas.
+#define FFX_BRIXELIZER_CASCADE_CACHE_MAGIC       0x43435846 // "FXCC"
+#define FFX_BRIXELIZER_CASCADE_CACHE_VERSION     1
+#define FFX_BRIXELIZER_BRICK_DIMENSION           8
+#define FFX_BRIXELIZER_BRICK_TEXELS              (FFX_BRIXELIZER_BRICK_DIMENSION * FFX_BRIXELIZER_BRICK_DIMENSION * FFX_BRIXELIZER_BRICK_DIMENSION)
+
+typedef struct FfxBrixelizerCascadeCacheHeader
+{
+    uint32_t                     magic;
+    uint32_t                     version;
+    FfxBrixelizerCascadeCacheKey key;
+    uint32_t                     numInstances;
+    uint32_t                     numBricks;
+    uint64_t                     checksum;      // Of everything following the header.
+} FfxBrixelizerCascadeCacheHeader;
+
+static inline uint64_t brixelizerGetCascadeCacheSize(uint64_t numInstances, uint64_t numBricks)
+{
+    return sizeof(FfxBrixelizerCascadeCacheHeader)
+        + numInstances * sizeof(FfxBrixelizerCascadeCacheInstance)
+        + FFX_BRIXELIZER_CASCADE_BRICK_MAP_SIZE
+        + FFX_BRIXELIZER_CASCADE_AABB_TREE_SIZE
+        + numBricks * (FFX_BRIXELIZER_BRICK_AABBS_STRIDE + FFX_BRIXELIZER_BRICK_TEXELS);
+}
@@ -0,0 +1,62 @@
+// This file is part of the FidelityFX SDK.
+//
+// Copyright (C) 2024 Advanced Micro Devices, Inc.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#pragma once
+
+#include <FidelityFX/host/ffx_brixelizer_raw.h>
+
+// Mapping from the AABB of a raw job to the bricks of a cascade it covers. ffxBrixelizerRawContextUpdateCascade()
+// grows every job by a brick on each side and skips jobs outside of the grown cascade and jobs of zero volume.
+// ffxBrixelizerBakeUpdate() maps invalidations through the same function and emits invalidation jobs built with
+// ffxBrixelizerGetBricksJobAABB(), so both have to change together.
+static inline bool ffxBrixelizerGetJobBricks(const float cascadeMin[3], float brickSize, const float aabbMin[3], const float aabbMax[3], uint32_t brickMin[3], uint32_t brickMax[3])
+{
+    for (uint32_t i = 0; i < 3; ++i) {
+        float cascadeMax = cascadeMin[i] + brickSize * FFX_BRIXELIZER_CASCADE_RESOLUTION;
+        if (aabbMax[i] < cascadeMin[i] - brickSize || aabbMin[i] > cascadeMax + brickSize) {
+            return false;
+        }
+    }
+    if (aabbMin[0] == aabbMax[0] && aabbMin[1] == aabbMax[1] && aabbMin[2] == aabbMax[2]) {
+        return false;
+    }
+    for (uint32_t i = 0; i < 3; ++i) {
+        float lo = (aabbMin[i] - brickSize - cascadeMin[i]) / brickSize;
+        float hi = (aabbMax[i] + brickSize - cascadeMin[i]) / brickSize;
+        lo = lo < 0.0f ? 0.0f : (lo > FFX_BRIXELIZER_CASCADE_RESOLUTION - 1 ? FFX_BRIXELIZER_CASCADE_RESOLUTION - 1 : lo);
+        hi = hi < 0.0f ? 0.0f : (hi > FFX_BRIXELIZER_CASCADE_RESOLUTION - 1 ? FFX_BRIXELIZER_CASCADE_RESOLUTION - 1 : hi);
+        brickMin[i] = (uint32_t)lo;
+        brickMax[i] = (uint32_t)hi + 1;
+    }
+    return true;
+}
+
+// Job AABB that ffxBrixelizerGetJobBricks() maps back to exactly the bricks in [brickMin, brickMax). The box starts
+// and ends a quarter brick inside the grown margin, so it is inverted for runs shorter than three bricks. Raw jobs
+// built this way are only meant for ffxBrixelizerRawContextUpdateCascade() and must not be used as bounds elsewhere.
+static inline void ffxBrixelizerGetBricksJobAABB(const float cascadeMin[3], float brickSize, const uint32_t brickMin[3], const uint32_t brickMax[3], float aabbMin[3], float aabbMax[3])
+{
+    for (uint32_t i = 0; i < 3; ++i) {
+        aabbMin[i] = cascadeMin[i] + ((float)brickMin[i] + 1.25f) * brickSize;
+        aabbMax[i] = cascadeMin[i] + ((float)brickMax[i] - 1.25f) * brickSize;
+    }
+}
@@ -32,17 +32,13 @@
 #include <FidelityFX/host/ffx_brixelizer_raw.h>
 #include <FidelityFX/gpu/brixelizer/ffx_brixelizer_resources.h>
 #include <ffx_object_management.h>
+#include <ffx_resource_binding.h>
 
 #include "ffx_brixelizer_raw_private.h"
+#include "ffx_brixelizer_job_bricks.h"
 
 // lists to map shader resource bindpoint name to resource identifier
-typedef struct ResourceBinding
-{
-    uint32_t index;
-    wchar_t  name[64];
-} ResourceBinding;
-
-static const ResourceBinding srvResourceBindingTable[] = {
+static constexpr ResourceBinding srvResourceBindingTable[] = {
     {FFX_BRIXELIZER_RESOURCE_IDENTIFIER_UPLOAD_JOB_BUFFER, L"r_job_buffer"},
     {FFX_BRIXELIZER_RESOURCE_IDENTIFIER_UPLOAD_JOB_INDEX_BUFFER, L"r_job_index_buffer"},
     {FFX_BRIXELIZER_RESOURCE_IDENTIFIER_INSTANCE_INFO_BUFFER, L"r_instance_info_buffer"},
@@ -50,8 +46,9 @@ static const ResourceBinding srvResourceBindingTable[] = {
     {FFX_BRIXELIZER_RESOURCE_IDENTIFIER_CONTEXT_SDF_ATLAS, L"r_sdf_atlas"},
     {FFX_BRIXELIZER_RESOURCE_IDENTIFIER_UPLOAD_DEBUG_INSTANCE_ID_BUFFER, L"r_debug_instance_id"},
 };
+static constexpr auto srvResourceBindingLookup = ffxMakeResourceBindingLookup(srvResourceBindingTable);
 
-static const ResourceBinding uavResourceBindingTable[] = {
+static constexpr ResourceBinding uavResourceBindingTable[] = {
     {FFX_BRIXELIZER_RESOURCE_IDENTIFIER_CASCADE_AABB_TREE, L"rw_cascade_aabbtree"},
     {FFX_BRIXELIZER_RESOURCE_IDENTIFIER_CASCADE_AABB_TREES, L"rw_cascade_aabbtrees"},
     {FFX_BRIXELIZER_RESOURCE_IDENTIFIER_CASCADE_BRICK_MAP, L"rw_cascade_brick_map"},
@@ -86,13 +83,15 @@ static const ResourceBinding uavResourceBindingTable[] = {
     {FFX_BRIXELIZER_RESOURCE_IDENTIFIER_DEBUG_OUTPUT, L"rw_debug_output"},
     {FFX_BRIXELIZER_RESOURCE_IDENTIFIER_SCRATCH_DEBUG_AABBS, L"rw_debug_aabbs"},
 };
+static constexpr auto uavResourceBindingLookup = ffxMakeResourceBindingLookup(uavResourceBindingTable);
 
-static const ResourceBinding cbvResourceBindingTable[] = {
+static constexpr ResourceBinding cbvResourceBindingTable[] = {
     {FFX_BRIXELIZER_CONSTANTBUFFER_IDENTIFIER_CASCADE_INFO, L"cbBrixelizerCascadeInfo"},
     {FFX_BRIXELIZER_CONSTANTBUFFER_IDENTIFIER_CONTEXT_INFO, L"cbBrixelizerContextInfo"},
     {FFX_BRIXELIZER_CONSTANTBUFFER_IDENTIFIER_BUILD_INFO, L"cbBrixelizerBuildInfo"},
     {FFX_BRIXELIZER_CONSTANTBUFFER_IDENTIFIER_DEBUG_INFO, L"cbBrixelizerDebugInfo"},
 };
+static constexpr auto cbvResourceBindingLookup = ffxMakeResourceBindingLookup(cbvResourceBindingTable);
 
 static size_t cbSizes[] = {
     sizeof(FfxBrixelizerCascadeInfo), 
@@ -188,13 +187,8 @@ static void patchResourceBindings(FfxPipelineState* inoutPipeline)
     {
         FfxResourceBinding& binding = inoutPipeline->srvTextureBindings[srvTextureIndex];
 
-        int32_t mapIndex = 0;
-        for (mapIndex = 0; mapIndex < _countof(srvResourceBindingTable); ++mapIndex)
-        {
-            if (0 == wcscmp(srvResourceBindingTable[mapIndex].name, binding.name))
-                break;
-        }
-        if (mapIndex == _countof(srvResourceBindingTable))
+        const int32_t mapIndex = ffxFindResourceBinding(srvResourceBindingTable, srvResourceBindingLookup, binding);
+        if (mapIndex < 0)
             return;
 
         binding.resourceIdentifier = srvResourceBindingTable[mapIndex].index + binding.arrayIndex;
@@ -204,13 +198,8 @@ static void patchResourceBindings(FfxPipelineState* inoutPipeline)
     {
         FfxResourceBinding& binding = inoutPipeline->srvBufferBindings[srvBufferIndex];
 
-        int32_t mapIndex = 0;
-        for (mapIndex = 0; mapIndex < _countof(srvResourceBindingTable); ++mapIndex)
-        {
-            if (0 == wcscmp(srvResourceBindingTable[mapIndex].name, binding.name))
-                break;
-        }
-        if (mapIndex == _countof(srvResourceBindingTable))
+        const int32_t mapIndex = ffxFindResourceBinding(srvResourceBindingTable, srvResourceBindingLookup, binding);
+        if (mapIndex < 0)
             return;
 
         binding.resourceIdentifier = srvResourceBindingTable[mapIndex].index + binding.arrayIndex;
@@ -218,13 +207,8 @@ static void patchResourceBindings(FfxPipelineState* inoutPipeline)
 
     for (uint32_t uavTextureIndex = 0; uavTextureIndex < inoutPipeline->uavTextureCount; ++uavTextureIndex)
     {
-        int32_t mapIndex = 0;
-        for (mapIndex = 0; mapIndex < _countof(uavResourceBindingTable); ++mapIndex)
-        {
-            if (0 == wcscmp(uavResourceBindingTable[mapIndex].name, inoutPipeline->uavTextureBindings[uavTextureIndex].name))
-                break;
-        }
-        if (mapIndex == _countof(uavResourceBindingTable))
+        const int32_t mapIndex = ffxFindResourceBinding(uavResourceBindingTable, uavResourceBindingLookup, inoutPipeline->uavTextureBindings[uavTextureIndex]);
+        if (mapIndex < 0)
             return;
 
         inoutPipeline->uavTextureBindings[uavTextureIndex].resourceIdentifier = uavResourceBindingTable[mapIndex].index;
@@ -234,13 +218,8 @@ static void patchResourceBindings(FfxPipelineState* inoutPipeline)
     {
         FfxResourceBinding& binding = inoutPipeline->uavBufferBindings[uavBufferIndex];
 
-        int32_t mapIndex = 0;
-        for (mapIndex = 0; mapIndex < _countof(uavResourceBindingTable); ++mapIndex)
-        {
-            if (0 == wcscmp(uavResourceBindingTable[mapIndex].name, binding.name))
-                break;
-        }
-        if (mapIndex == _countof(uavResourceBindingTable))
+        const int32_t mapIndex = ffxFindResourceBinding(uavResourceBindingTable, uavResourceBindingLookup, binding);
+        if (mapIndex < 0)
             return;
 
         binding.resourceIdentifier = uavResourceBindingTable[mapIndex].index + binding.arrayIndex;
@@ -250,13 +229,8 @@ static void patchResourceBindings(FfxPipelineState* inoutPipeline)
     {
         FfxResourceBinding& binding = inoutPipeline->constantBufferBindings[cbvIndex];
 
-        int32_t mapIndex = 0;
-        for (mapIndex = 0; mapIndex < _countof(cbvResourceBindingTable); ++mapIndex)
-        {
-            if (0 == wcscmp(cbvResourceBindingTable[mapIndex].name, binding.name))
-                break;
-        }
-        if (mapIndex == _countof(cbvResourceBindingTable))
+        const int32_t mapIndex = ffxFindResourceBinding(cbvResourceBindingTable, cbvResourceBindingLookup, binding);
+        if (mapIndex < 0)
             return;
 
         binding.resourceIdentifier = cbvResourceBindingTable[mapIndex].index;
@@ -1410,34 +1384,13 @@ static FfxErrorCode brixelizerDispatchUpdateCascade(FfxBrixelizerRawContext_Priv
     {
         FfxBrixelizerRawJobDescription const& apiJob        = desc->jobs[i];
         FfxBrixelizerBrixelizationJob&        job           = context->jobs[numJobs];
-        float                      inflationSize = cascadeInfo.voxel_size;
-
-        if (                                                               // Out of bounds
-            apiJob.aabbMax[0] < cascadeInfo.grid_min[0] - inflationSize ||  //
-            apiJob.aabbMax[1] < cascadeInfo.grid_min[1] - inflationSize ||  //
-            apiJob.aabbMax[2] < cascadeInfo.grid_min[2] - inflationSize ||  //
-            apiJob.aabbMin[0] > cascadeInfo.grid_max[0] + inflationSize ||  //
-            apiJob.aabbMin[1] > cascadeInfo.grid_max[1] + inflationSize ||  //
-            apiJob.aabbMin[2] > cascadeInfo.grid_max[2] + inflationSize     //
-        )
-            continue;
-
-        if (                                           // Zero volume
-            apiJob.aabbMax[0] == apiJob.aabbMin[0]     //
-            && apiJob.aabbMax[1] == apiJob.aabbMin[1]  //
-            && apiJob.aabbMax[2] == apiJob.aabbMin[2]  //
-        )
-            continue;
 
+        // Skips jobs out of bounds or of zero volume, shared with ffxBrixelizerBakeUpdate
         uint32_t aabbMin[3] = {};
         uint32_t aabbMax[3] = {};
+        if (!ffxBrixelizerGetJobBricks(cascadeInfo.grid_min, cascadeInfo.voxel_size, apiJob.aabbMin, apiJob.aabbMax, aabbMin, aabbMax))
+            continue;
 
-        for(uint32_t j = 0; j < 3; j++)
-            aabbMin[j] = uint32_t(ffxMax(0.0f, ffxMin((apiJob.aabbMin[j] - inflationSize - cascadeInfo.grid_min[j]) / cascadeInfo.voxel_size, (float)FFX_BRIXELIZER_CASCADE_RESOLUTION - 1)));
-
-        for (uint32_t j = 0; j < 3; j++)
-            aabbMax[j] = uint32_t(ffxMax(0.0f, ffxMin((apiJob.aabbMax[j] + inflationSize - cascadeInfo.grid_min[j]) / cascadeInfo.voxel_size, (float)FFX_BRIXELIZER_CASCADE_RESOLUTION - 1))) + 1u;
-        
         for (uint32_t j = 0; j < 3; j++)
             job.aabbMin[j] = aabbMin[j];
 
@@ -28,18 +28,13 @@
 #include <FidelityFX/gpu/brixelizergi/ffx_brixelizergi_host_interface.h>
 #include <FidelityFX/host/ffx_brixelizer_raw.h>
 #include <ffx_object_management.h>
+#include <ffx_resource_binding.h>
 
 #include "../brixelizer/ffx_brixelizer_raw_private.h"
 #include "ffx_brixelizergi_private.h"
 
 // lists to map shader resource bindpoint name to resource identifier
-typedef struct ResourceBinding
-{
-    uint32_t index;
-    wchar_t  name[64];
-} ResourceBinding;
-
-static const ResourceBinding srvResourceBindingTable[] = {
+static constexpr ResourceBinding srvResourceBindingTable[] = {
     {FFX_BRIXELIZER_GI_RESOURCE_IDENTIFIER_DISOCCLUSION_MASK, L"g_r_disocclusion_mask"},
     {FFX_BRIXELIZER_GI_PING_PONG_RESOURCE_STATIC_GI_TARGET_READ, L"g_sdfgi_r_static_gitarget"},
     {FFX_BRIXELIZER_GI_PING_PONG_RESOURCE_STATIC_SCREEN_PROBES_READ, L"g_sdfgi_r_static_screen_probes"},
@@ -71,8 +66,9 @@ static const ResourceBinding srvResourceBindingTable[] = {
     {FFX_BRIXELIZER_GI_RESOURCE_IDENTIFIER_OUTPUT_DIFFUSE_GI, L"g_downsampled_diffuse_gi"},
     {FFX_BRIXELIZER_GI_RESOURCE_IDENTIFIER_OUTPUT_SPECULAR_GI, L"g_downsampled_specular_gi"},
 };
+static constexpr auto srvResourceBindingLookup = ffxMakeResourceBindingLookup(srvResourceBindingTable);
 
-static const ResourceBinding uavResourceBindingTable[] = {
+static constexpr ResourceBinding uavResourceBindingTable[] = {
     {FFX_BRIXELIZER_GI_RESOURCE_IDENTIFIER_DISOCCLUSION_MASK, L"g_rw_disocclusion_mask"},
     {FFX_BRIXELIZER_GI_PING_PONG_RESOURCE_STATIC_SCREEN_PROBES_WRITE, L"g_sdfgi_rw_static_screen_probes"},
     {FFX_BRIXELIZER_GI_RESOURCE_IDENTIFIER_STATIC_PUSHOFF_MAP, L"g_sdfgi_rw_static_pushoff_map"},
@@ -107,13 +103,15 @@ static const ResourceBinding uavResourceBindingTable[] = {
     {FFX_BRIXELIZER_GI_RESOURCE_IDENTIFIER_UPSAMPLED_DIFFUSE_GI, L"g_upsampled_diffuse_gi"},
     {FFX_BRIXELIZER_GI_RESOURCE_IDENTIFIER_UPSAMPLED_SPECULAR_GI, L"g_upsampled_specular_gi"},
 };
+static constexpr auto uavResourceBindingLookup = ffxMakeResourceBindingLookup(uavResourceBindingTable);
 
-static const ResourceBinding cbvResourceBindingTable[] = {
+static constexpr ResourceBinding cbvResourceBindingTable[] = {
     {FFX_BRIXELIZER_GI_CONSTANTBUFFER_IDENTIFIER_GI_CONSTANTS, L"g_sdfgi_constants"},
     {FFX_BRIXELIZER_GI_CONSTANTBUFFER_IDENTIFIER_PASS_CONSTANTS, L"g_pass_constants"},
     {FFX_BRIXELIZER_GI_CONSTANTBUFFER_IDENTIFIER_SCALING_CONSTANTS, L"g_scaling_constants"},
     {FFX_BRIXELIZER_GI_CONSTANTBUFFER_IDENTIFIER_CONTEXT_INFO, L"g_bx_context_info"},
 };
+static constexpr auto cbvResourceBindingLookup = ffxMakeResourceBindingLookup(cbvResourceBindingTable);
 
 static size_t cbSizes[] = {
     sizeof(FfxBrixelizerGIConstants), 
@@ -334,13 +332,8 @@ static void patchResourceBindings(FfxPipelineState* inoutPipeline)
     {
         FfxResourceBinding& binding = inoutPipeline->srvTextureBindings[srvTextureIndex];
 
-        int32_t mapIndex = 0;
-        for (mapIndex = 0; mapIndex < _countof(srvResourceBindingTable); ++mapIndex)
-        {
-            if (0 == wcscmp(srvResourceBindingTable[mapIndex].name, binding.name))
-                break;
-        }
-        if (mapIndex == _countof(srvResourceBindingTable))
+        const int32_t mapIndex = ffxFindResourceBinding(srvResourceBindingTable, srvResourceBindingLookup, binding);
+        if (mapIndex < 0)
             return;
 
         binding.resourceIdentifier = srvResourceBindingTable[mapIndex].index + binding.arrayIndex;
@@ -350,13 +343,8 @@ static void patchResourceBindings(FfxPipelineState* inoutPipeline)
     {
         FfxResourceBinding& binding = inoutPipeline->srvBufferBindings[srvBufferIndex];
 
-        int32_t mapIndex = 0;
-        for (mapIndex = 0; mapIndex < _countof(srvResourceBindingTable); ++mapIndex)
-        {
-            if (0 == wcscmp(srvResourceBindingTable[mapIndex].name, binding.name))
-                break;
-        }
-        if (mapIndex == _countof(srvResourceBindingTable))
+        const int32_t mapIndex = ffxFindResourceBinding(srvResourceBindingTable, srvResourceBindingLookup, binding);
+        if (mapIndex < 0)
             return;
 
         binding.resourceIdentifier = srvResourceBindingTable[mapIndex].index + binding.arrayIndex;
@@ -364,13 +352,8 @@ static void patchResourceBindings(FfxPipelineState* inoutPipeline)
 
     for (uint32_t uavTextureIndex = 0; uavTextureIndex < inoutPipeline->uavTextureCount; ++uavTextureIndex)
     {
-        int32_t mapIndex = 0;
-        for (mapIndex = 0; mapIndex < _countof(uavResourceBindingTable); ++mapIndex)
-        {
-            if (0 == wcscmp(uavResourceBindingTable[mapIndex].name, inoutPipeline->uavTextureBindings[uavTextureIndex].name))
-                break;
-        }
-        if (mapIndex == _countof(uavResourceBindingTable))
+        const int32_t mapIndex = ffxFindResourceBinding(uavResourceBindingTable, uavResourceBindingLookup, inoutPipeline->uavTextureBindings[uavTextureIndex]);
+        if (mapIndex < 0)
             return;
 
         inoutPipeline->uavTextureBindings[uavTextureIndex].resourceIdentifier = uavResourceBindingTable[mapIndex].index;
@@ -380,13 +363,8 @@ static void patchResourceBindings(FfxPipelineState* inoutPipeline)
     {
         FfxResourceBinding& binding = inoutPipeline->uavBufferBindings[uavBufferIndex];
 
-        int32_t mapIndex = 0;
-        for (mapIndex = 0; mapIndex < _countof(uavResourceBindingTable); ++mapIndex)
-        {
-            if (0 == wcscmp(uavResourceBindingTable[mapIndex].name, binding.name))
-                break;
-        }
-        if (mapIndex == _countof(uavResourceBindingTable))
+        const int32_t mapIndex = ffxFindResourceBinding(uavResourceBindingTable, uavResourceBindingLookup, binding);
+        if (mapIndex < 0)
             return;
 
         binding.resourceIdentifier = uavResourceBindingTable[mapIndex].index + binding.arrayIndex;
@@ -396,13 +374,8 @@ static void patchResourceBindings(FfxPipelineState* inoutPipeline)
     {
         FfxResourceBinding& binding = inoutPipeline->constantBufferBindings[cbvIndex];
 
-        int32_t mapIndex = 0;
-        for (mapIndex = 0; mapIndex < _countof(cbvResourceBindingTable); ++mapIndex)
-        {
-            if (0 == wcscmp(cbvResourceBindingTable[mapIndex].name, binding.name))
-                break;
-        }
-        if (mapIndex == _countof(cbvResourceBindingTable))
+        const int32_t mapIndex = ffxFindResourceBinding(cbvResourceBindingTable, cbvResourceBindingLookup, binding);
+        if (mapIndex < 0)
             return;
 
         binding.resourceIdentifier = cbvResourceBindingTable[mapIndex].index;
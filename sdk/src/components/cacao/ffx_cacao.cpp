@@ -32,6 +32,7 @@
 #include <FidelityFX/host/ffx_cacao.h>
 #include <FidelityFX/gpu/ffx_core.h>
 #include <ffx_object_management.h>
+#include <ffx_resource_binding.h>
 
 #include "ffx_cacao_private.h"
 
@@ -62,17 +63,12 @@ inline static uint32_t dispatchSize(uint32_t tileSize, uint32_t totalSize)
 }
 
 // lists to map shader resource bindpoint name to resource identifier
-typedef struct ResourceBinding
-{
-    uint32_t index;
-    wchar_t  name[64];
-} ResourceBinding;
-
-static const ResourceBinding constantBufferBindingTable[] = {
+static constexpr ResourceBinding constantBufferBindingTable[] = {
     {FFX_CACAO_CONSTANTBUFFER_IDENTIFIER_CACAO, L"SSAOConstantsBuffer"},
 };
+static constexpr auto constantBufferBindingLookup = ffxMakeResourceBindingLookup(constantBufferBindingTable);
 
-static const ResourceBinding srvTextureBindingTable[] = {
+static constexpr ResourceBinding srvTextureBindingTable[] = {
     {FFX_CACAO_RESOURCE_IDENTIFIER_DEPTH_IN, L"g_DepthIn"},
     {FFX_CACAO_RESOURCE_IDENTIFIER_NORMAL_IN, L"g_NormalIn"},
     {FFX_CACAO_RESOURCE_IDENTIFIER_LOAD_COUNTER_BUFFER, L"g_LoadCounter"},
@@ -83,8 +79,9 @@ static const ResourceBinding srvTextureBindingTable[] = {
     {FFX_CACAO_RESOURCE_IDENTIFIER_IMPORTANCE_MAP, L"g_ImportanceMap"},
     {FFX_CACAO_RESOURCE_IDENTIFIER_IMPORTANCE_MAP_PONG, L"g_ImportanceMapPong"},
 };
+static constexpr auto srvTextureBindingLookup = ffxMakeResourceBindingLookup(srvTextureBindingTable);
 
-static const ResourceBinding uavTextureBindingTable[] = {
+static constexpr ResourceBinding uavTextureBindingTable[] = {
     {FFX_CACAO_RESOURCE_IDENTIFIER_LOAD_COUNTER_BUFFER, L"g_RwLoadCounter"},
     {FFX_CACAO_RESOURCE_IDENTIFIER_DEINTERLEAVED_DEPTHS, L"g_RwDeinterleavedDepth"},
     {FFX_CACAO_RESOURCE_IDENTIFIER_DEINTERLEAVED_NORMALS, L"g_RwDeinterleavedNormals"},
@@ -95,6 +92,7 @@ static const ResourceBinding uavTextureBindingTable[] = {
     {FFX_CACAO_RESOURCE_IDENTIFIER_OUTPUT, L"g_RwOutput"},
     {FFX_CACAO_RESOURCE_IDENTIFIER_DOWNSAMPLED_DEPTH_MIPMAP_0, L"g_RwDepthMips"},
 };
+static constexpr auto uavTextureBindingLookup = ffxMakeResourceBindingLookup(uavTextureBindingTable);
 
 void ffxCacaoUpdateBufferSizeInfo(const uint32_t width, const uint32_t height, const bool useDownsampledSsao, FfxCacaoBufferSizeInfo* bsi)
 {
@@ -332,13 +330,8 @@ static FfxErrorCode patchResourceBindings(FfxPipelineState* inoutPipeline)
 {
     for (uint32_t srvIndex = 0; srvIndex < inoutPipeline->srvTextureCount; ++srvIndex)
     {
-        int32_t mapIndex = 0;
-        for (mapIndex = 0; mapIndex < FFX_CACAO_ARRAY_SIZE(srvTextureBindingTable); ++mapIndex)
-        {
-            if (0 == wcscmp(srvTextureBindingTable[mapIndex].name, inoutPipeline->srvTextureBindings[srvIndex].name))
-                break;
-        }
-        if (mapIndex == FFX_CACAO_ARRAY_SIZE(srvTextureBindingTable))
+        const int32_t mapIndex = ffxFindResourceBinding(srvTextureBindingTable, srvTextureBindingLookup, inoutPipeline->srvTextureBindings[srvIndex]);
+        if (mapIndex < 0)
             return FFX_ERROR_INVALID_ARGUMENT;
 
         inoutPipeline->srvTextureBindings[srvIndex].resourceIdentifier = srvTextureBindingTable[mapIndex].index;
@@ -346,13 +339,8 @@ static FfxErrorCode patchResourceBindings(FfxPipelineState* inoutPipeline)
 
     for (uint32_t uavIndex = 0; uavIndex < inoutPipeline->uavTextureCount; ++uavIndex)
     {
-        int32_t mapIndex = 0;
-        for (mapIndex = 0; mapIndex < FFX_CACAO_ARRAY_SIZE(uavTextureBindingTable); ++mapIndex)
-        {
-            if (0 == wcscmp(uavTextureBindingTable[mapIndex].name, inoutPipeline->uavTextureBindings[uavIndex].name))
-                break;
-        }
-        if (mapIndex == FFX_CACAO_ARRAY_SIZE(uavTextureBindingTable))
+        const int32_t mapIndex = ffxFindResourceBinding(uavTextureBindingTable, uavTextureBindingLookup, inoutPipeline->uavTextureBindings[uavIndex]);
+        if (mapIndex < 0)
             return FFX_ERROR_INVALID_ARGUMENT;
 
         inoutPipeline->uavTextureBindings[uavIndex].resourceIdentifier = uavTextureBindingTable[mapIndex].index;
@@ -360,13 +348,8 @@ static FfxErrorCode patchResourceBindings(FfxPipelineState* inoutPipeline)
 
     for (uint32_t cbIndex = 0; cbIndex < inoutPipeline->constCount; ++cbIndex)
     {
-        int32_t mapIndex = 0;
-        for (mapIndex = 0; mapIndex < FFX_CACAO_ARRAY_SIZE(constantBufferBindingTable); ++mapIndex)
-        {
-            if (0 == wcscmp(constantBufferBindingTable[mapIndex].name, inoutPipeline->constantBufferBindings[cbIndex].name))
-                break;
-        }
-        if (mapIndex == FFX_CACAO_ARRAY_SIZE(constantBufferBindingTable))
+        const int32_t mapIndex = ffxFindResourceBinding(constantBufferBindingTable, constantBufferBindingLookup, inoutPipeline->constantBufferBindings[cbIndex]);
+        if (mapIndex < 0)
             return FFX_ERROR_INVALID_ARGUMENT;
 
         inoutPipeline->constantBufferBindings[cbIndex].resourceIdentifier = constantBufferBindingTable[mapIndex].index;
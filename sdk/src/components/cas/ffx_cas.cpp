@@ -33,39 +33,32 @@
 #include <FidelityFX/gpu/ffx_core.h>
 #include <FidelityFX/gpu/cas/ffx_cas.h>
 #include <ffx_object_management.h>
+#include <ffx_resource_binding.h>
 
 #include "ffx_cas_private.h"
 
 // lists to map shader resource bindpoint name to resource identifier
-typedef struct ResourceBinding
-{
-    uint32_t index;
-    wchar_t  name[64];
-} ResourceBinding;
-
-static const ResourceBinding s_SrvResourceBindingTable[] = {
+static constexpr ResourceBinding s_SrvResourceBindingTable[] = {
     {FFX_CAS_RESOURCE_IDENTIFIER_INPUT_COLOR, L"r_input_color"},
 };
+static constexpr auto s_SrvResourceBindingLookup = ffxMakeResourceBindingLookup(s_SrvResourceBindingTable);
 
-static const ResourceBinding s_UavResourceBindingTable[] = {
+static constexpr ResourceBinding s_UavResourceBindingTable[] = {
     {FFX_CAS_RESOURCE_IDENTIFIER_OUTPUT_COLOR, L"rw_output_color"},
 };
+static constexpr auto s_UavResourceBindingLookup = ffxMakeResourceBindingLookup(s_UavResourceBindingTable);
 
-static const ResourceBinding s_CbResourceBindingTable[] = {
+static constexpr ResourceBinding s_CbResourceBindingTable[] = {
     {FFX_CAS_CONSTANTBUFFER_IDENTIFIER_CAS, L"cbCAS"},
 };
+static constexpr auto s_CbResourceBindingLookup = ffxMakeResourceBindingLookup(s_CbResourceBindingTable);
 
 static FfxErrorCode patchResourceBindings(FfxPipelineState* inoutPipeline)
 {
     for (uint32_t srvIndex = 0; srvIndex < inoutPipeline->srvTextureCount; ++srvIndex)
     {
-        int32_t mapIndex = 0;
-        for (mapIndex = 0; mapIndex < _countof(s_SrvResourceBindingTable); ++mapIndex)
-        {
-            if (0 == wcscmp(s_SrvResourceBindingTable[mapIndex].name, inoutPipeline->srvTextureBindings[srvIndex].name))
-                break;
-        }
-        if (mapIndex == _countof(s_SrvResourceBindingTable))
+        const int32_t mapIndex = ffxFindResourceBinding(s_SrvResourceBindingTable, s_SrvResourceBindingLookup, inoutPipeline->srvTextureBindings[srvIndex]);
+        if (mapIndex < 0)
             return FFX_ERROR_INVALID_ARGUMENT;
 
         inoutPipeline->srvTextureBindings[srvIndex].resourceIdentifier = s_SrvResourceBindingTable[mapIndex].index;
@@ -73,13 +66,8 @@ static FfxErrorCode patchResourceBindings(FfxPipelineState* inoutPipeline)
 
     for (uint32_t uavIndex = 0; uavIndex < inoutPipeline->uavTextureCount; ++uavIndex)
     {
-        int32_t mapIndex = 0;
-        for (mapIndex = 0; mapIndex < _countof(s_UavResourceBindingTable); ++mapIndex)
-        {
-            if (0 == wcscmp(s_UavResourceBindingTable[mapIndex].name, inoutPipeline->uavTextureBindings[uavIndex].name))
-                break;
-        }
-        if (mapIndex == _countof(s_UavResourceBindingTable))
+        const int32_t mapIndex = ffxFindResourceBinding(s_UavResourceBindingTable, s_UavResourceBindingLookup, inoutPipeline->uavTextureBindings[uavIndex]);
+        if (mapIndex < 0)
             return FFX_ERROR_INVALID_ARGUMENT;
 
         inoutPipeline->uavTextureBindings[uavIndex].resourceIdentifier = s_UavResourceBindingTable[mapIndex].index;
@@ -87,13 +75,8 @@ static FfxErrorCode patchResourceBindings(FfxPipelineState* inoutPipeline)
 
     for (uint32_t cbIndex = 0; cbIndex < inoutPipeline->constCount; ++cbIndex)
     {
-        int32_t mapIndex = 0;
-        for (mapIndex = 0; mapIndex < _countof(s_CbResourceBindingTable); ++mapIndex)
-        {
-            if (0 == wcscmp(s_CbResourceBindingTable[mapIndex].name, inoutPipeline->constantBufferBindings[cbIndex].name))
-                break;
-        }
-        if (mapIndex == _countof(s_CbResourceBindingTable))
+        const int32_t mapIndex = ffxFindResourceBinding(s_CbResourceBindingTable, s_CbResourceBindingLookup, inoutPipeline->constantBufferBindings[cbIndex]);
+        if (mapIndex < 0)
             return FFX_ERROR_INVALID_ARGUMENT;
 
         inoutPipeline->constantBufferBindings[cbIndex].resourceIdentifier = s_CbResourceBindingTable[mapIndex].index;
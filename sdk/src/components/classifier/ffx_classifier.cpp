@@ -29,6 +29,7 @@
 #include <FidelityFX/host/ffx_util.h>
 #include <FidelityFX/gpu/ffx_core.h>
 #include <ffx_object_management.h>
+#include <ffx_resource_binding.h>
 
 #include "ffx_classifier_private.h"
 
@@ -36,13 +37,7 @@ static constexpr uint32_t k_tileSizeX = 8;
 static constexpr uint32_t k_tileSizeY = 4;
 
 // lists to map shader resource bindpoint name to resource identifier
-typedef struct ResourceBinding
-{
-    uint32_t    index;
-    wchar_t     name[64];
-}ResourceBinding;
-
-static const ResourceBinding srvTextureBindingTable[] =
+static constexpr ResourceBinding srvTextureBindingTable[] =
 {
     {FFX_CLASSIFIER_RESOURCE_IDENTIFIER_INPUT_DEPTH,                  L"r_input_depth"},
     {FFX_CLASSIFIER_RESOURCE_IDENTIFIER_INPUT_NORMAL,                 L"r_input_normal"},
@@ -53,13 +48,15 @@ static const ResourceBinding srvTextureBindingTable[] =
     {FFX_CLASSIFIER_RESOURCE_IDENTIFIER_VARIANCE_HISTORY,             L"r_variance_history"},
     {FFX_CLASSIFIER_RESOURCE_IDENTIFIER_INPUT_SHADOW_MAPS,            L"r_input_shadowMap"},
 };
+static constexpr auto srvTextureBindingLookup = ffxMakeResourceBindingLookup(srvTextureBindingTable);
 
-static const ResourceBinding srvBufferBindingTable[] =
+static constexpr ResourceBinding srvBufferBindingTable[] =
 {
     {FFX_CLASSIFIER_RESOURCE_IDENTIFIER_WORK_QUEUE,                   L"rsb_tiles"},
 };
+static constexpr auto srvBufferBindingLookup = ffxMakeResourceBindingLookup(srvBufferBindingTable);
 
-static const ResourceBinding uavBufferBindingTable[] =
+static constexpr ResourceBinding uavBufferBindingTable[] =
 {
     {FFX_CLASSIFIER_RESOURCE_IDENTIFIER_WORK_QUEUE,                   L"rwsb_tiles"},
     {FFX_CLASSIFIER_RESOURCE_IDENTIFIER_OUTPUT_WORK_QUEUE_COUNTER,    L"rwb_tileCount"},
@@ -68,32 +65,30 @@ static const ResourceBinding uavBufferBindingTable[] =
     {FFX_CLASSIFIER_RESOURCE_IDENTIFIER_DENOISER_TILE_LIST,           L"rw_denoiser_tile_list"},
     {FFX_CLASSIFIER_RESOURCE_IDENTIFIER_RAY_COUNTER,                  L"rw_ray_counter"},
 };
+static constexpr auto uavBufferBindingLookup = ffxMakeResourceBindingLookup(uavBufferBindingTable);
 
-static const ResourceBinding uavTextureBindingTable[] =
+static constexpr ResourceBinding uavTextureBindingTable[] =
 {
     {FFX_CLASSIFIER_RESOURCE_IDENTIFIER_OUTPUT_RAY_HIT,               L"rwt2d_rayHitResults"},
     {FFX_CLASSIFIER_RESOURCE_IDENTIFIER_RADIANCE,                     L"rw_radiance"},
     {FFX_CLASSIFIER_RESOURCE_IDENTIFIER_EXTRACTED_ROUGHNESS,          L"rw_extracted_roughness"},
     {FFX_CLASSIFIER_RESOURCE_IDENTIFIER_HIT_COUNTER,                  L"rw_hit_counter"},
 };
+static constexpr auto uavTextureBindingLookup = ffxMakeResourceBindingLookup(uavTextureBindingTable);
 
-static const ResourceBinding cbResourceBindingTable[] =
+static constexpr ResourceBinding cbResourceBindingTable[] =
 {
     {FFX_CLASSIFIER_CONSTANTBUFFER_IDENTIFIER_CLASSIFIER,             L"cbClassifier"},
     {FFX_CLASSIFIER_CONSTANTBUFFER_IDENTIFIER_REFLECTION ,            L"cbClassifierReflection"},
 };
+static constexpr auto cbResourceBindingLookup = ffxMakeResourceBindingLookup(cbResourceBindingTable);
 
 static FfxErrorCode patchResourceBindings(FfxPipelineState* inoutPipeline)
 {
     for (uint32_t srvIndex = 0; srvIndex < inoutPipeline->srvTextureCount; ++srvIndex)
     {
-        int32_t mapIndex = 0;
-        for (mapIndex = 0; mapIndex < _countof(srvTextureBindingTable); ++mapIndex)
-        {
-            if (0 == wcscmp(srvTextureBindingTable[mapIndex].name, inoutPipeline->srvTextureBindings[srvIndex].name))
-                break;
-        }
-        if (mapIndex == _countof(srvTextureBindingTable))
+        const int32_t mapIndex = ffxFindResourceBinding(srvTextureBindingTable, srvTextureBindingLookup, inoutPipeline->srvTextureBindings[srvIndex]);
+        if (mapIndex < 0)
             return FFX_ERROR_INVALID_ARGUMENT;
 
         inoutPipeline->srvTextureBindings[srvIndex].resourceIdentifier = srvTextureBindingTable[mapIndex].index;
@@ -101,13 +96,8 @@ static FfxErrorCode patchResourceBindings(FfxPipelineState* inoutPipeline)
 
     for (uint32_t srvIndex = 0; srvIndex < inoutPipeline->srvBufferCount; ++srvIndex)
     {
-        int32_t mapIndex = 0;
-        for (mapIndex = 0; mapIndex < _countof(srvBufferBindingTable); ++mapIndex)
-        {
-            if (0 == wcscmp(srvBufferBindingTable[mapIndex].name, inoutPipeline->srvBufferBindings[srvIndex].name))
-                break;
-        }
-        if (mapIndex == _countof(srvBufferBindingTable))
+        const int32_t mapIndex = ffxFindResourceBinding(srvBufferBindingTable, srvBufferBindingLookup, inoutPipeline->srvBufferBindings[srvIndex]);
+        if (mapIndex < 0)
             return FFX_ERROR_INVALID_ARGUMENT;
 
         inoutPipeline->srvBufferBindings[srvIndex].resourceIdentifier = srvBufferBindingTable[mapIndex].index;
@@ -115,13 +105,8 @@ static FfxErrorCode patchResourceBindings(FfxPipelineState* inoutPipeline)
 
     for (uint32_t uavIndex = 0; uavIndex < inoutPipeline->uavTextureCount; ++uavIndex)
     {
-        int32_t mapIndex = 0;
-        for (mapIndex = 0; mapIndex < _countof(uavTextureBindingTable); ++mapIndex)
-        {
-            if (0 == wcscmp(uavTextureBindingTable[mapIndex].name, inoutPipeline->uavTextureBindings[uavIndex].name))
-                break;
-        }
-        if (mapIndex == _countof(uavTextureBindingTable))
+        const int32_t mapIndex = ffxFindResourceBinding(uavTextureBindingTable, uavTextureBindingLookup, inoutPipeline->uavTextureBindings[uavIndex]);
+        if (mapIndex < 0)
             return FFX_ERROR_INVALID_ARGUMENT;
 
         inoutPipeline->uavTextureBindings[uavIndex].resourceIdentifier = uavTextureBindingTable[mapIndex].index;
@@ -129,13 +114,8 @@ static FfxErrorCode patchResourceBindings(FfxPipelineState* inoutPipeline)
 
     for (uint32_t uavIndex = 0; uavIndex < inoutPipeline->uavBufferCount; ++uavIndex)
     {
-        int32_t mapIndex = 0;
-        for (mapIndex = 0; mapIndex < _countof(uavBufferBindingTable); ++mapIndex)
-        {
-            if (0 == wcscmp(uavBufferBindingTable[mapIndex].name, inoutPipeline->uavBufferBindings[uavIndex].name))
-                break;
-        }
-        if (mapIndex == _countof(uavBufferBindingTable))
+        const int32_t mapIndex = ffxFindResourceBinding(uavBufferBindingTable, uavBufferBindingLookup, inoutPipeline->uavBufferBindings[uavIndex]);
+        if (mapIndex < 0)
             return FFX_ERROR_INVALID_ARGUMENT;
 
         inoutPipeline->uavBufferBindings[uavIndex].resourceIdentifier = uavBufferBindingTable[mapIndex].index;
@@ -143,13 +123,8 @@ static FfxErrorCode patchResourceBindings(FfxPipelineState* inoutPipeline)
 
     for (uint32_t cbIndex = 0; cbIndex < inoutPipeline->constCount; ++cbIndex)
     {
-        int32_t mapIndex = 0;
-        for (mapIndex = 0; mapIndex < _countof(cbResourceBindingTable); ++mapIndex)
-        {
-            if (0 == wcscmp(cbResourceBindingTable[mapIndex].name, inoutPipeline->constantBufferBindings[cbIndex].name))
-                break;
-        }
-        if (mapIndex == _countof(cbResourceBindingTable))
+        const int32_t mapIndex = ffxFindResourceBinding(cbResourceBindingTable, cbResourceBindingLookup, inoutPipeline->constantBufferBindings[cbIndex]);
+        if (mapIndex < 0)
             return FFX_ERROR_INVALID_ARGUMENT;
 
         inoutPipeline->constantBufferBindings[cbIndex].resourceIdentifier = cbResourceBindingTable[mapIndex].index;
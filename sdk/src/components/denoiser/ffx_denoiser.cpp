@@ -27,6 +27,7 @@
 #include <FidelityFX/host/ffx_denoiser.h>
 #include <FidelityFX/gpu/denoiser/ffx_denoiser_resources.h>
 #include <ffx_object_management.h>
+#include <ffx_resource_binding.h>
 
 #include "ffx_denoiser_private.h"
 
@@ -35,13 +36,7 @@ constexpr uint32_t k_tileSizeX = 8;
 constexpr uint32_t k_tileSizeY = 4;
 
 // lists to map shader resource bindpoint name to resource identifier
-typedef struct ResourceBinding
-{
-    uint32_t    index;
-    wchar_t     name[64];
-}ResourceBinding;
-
-static const ResourceBinding srvTextureBindingTable[] =
+static constexpr ResourceBinding srvTextureBindingTable[] =
 {
     {FFX_DENOISER_RESOURCE_IDENTIFIER_HIT_MASK_RESULTS,         L"r_hit_mask_results"},
     {FFX_DENOISER_RESOURCE_IDENTIFIER_DEPTH,                    L"r_depth"},
@@ -66,12 +61,14 @@ static const ResourceBinding srvTextureBindingTable[] =
     {FFX_DENOISER_RESOURCE_IDENTIFIER_ROUGHNESS_HISTORY,        L"r_roughness_history"},
     {FFX_DENOISER_RESOURCE_IDENTIFIER_REPROJECTED_RADIANCE,     L"r_reprojected_radiance"},
 };
+static constexpr auto srvTextureBindingLookup = ffxMakeResourceBindingLookup(srvTextureBindingTable);
 
-static const ResourceBinding srvBufferBindingTable[] = {
+static constexpr ResourceBinding srvBufferBindingTable[] = {
     {FFX_DENOISER_RESOURCE_IDENTIFIER_RAYTRACER_RESULT, L"sb_raytracer_result"},
 };
+static constexpr auto srvBufferBindingLookup = ffxMakeResourceBindingLookup(srvBufferBindingTable);
 
-static const ResourceBinding uavBufferBindingTable[] =
+static constexpr ResourceBinding uavBufferBindingTable[] =
 {
     {FFX_DENOISER_RESOURCE_IDENTIFIER_SHADOW_MASK,          L"rw_shadow_mask"},
     {FFX_DENOISER_RESOURCE_IDENTIFIER_RAYTRACER_RESULT,     L"rw_raytracer_result"},
@@ -80,8 +77,9 @@ static const ResourceBinding uavBufferBindingTable[] =
     {FFX_DENOISER_RESOURCE_IDENTIFIER_INDIRECT_ARGS,        L"rw_indirect_args"},
 
 };
+static constexpr auto uavBufferBindingLookup = ffxMakeResourceBindingLookup(uavBufferBindingTable);
 
-static const ResourceBinding uavTextureBindingTable[] =
+static constexpr ResourceBinding uavTextureBindingTable[] =
 {
     {FFX_DENOISER_RESOURCE_IDENTIFIER_FILTER_OUTPUT,            L"rw_filter_output"},
     {FFX_DENOISER_RESOURCE_IDENTIFIER_REPROJECTION_RESULTS,     L"rw_reprojection_results"},
@@ -93,8 +91,9 @@ static const ResourceBinding uavTextureBindingTable[] =
     {FFX_DENOISER_RESOURCE_IDENTIFIER_AVERAGE_RADIANCE,         L"rw_average_radiance"},
     {FFX_DENOISER_RESOURCE_IDENTIFIER_REPROJECTED_RADIANCE,     L"rw_reprojected_radiance"},
 };
+static constexpr auto uavTextureBindingLookup = ffxMakeResourceBindingLookup(uavTextureBindingTable);
 
-static const ResourceBinding cbResourceBindingTable[] =
+static constexpr ResourceBinding cbResourceBindingTable[] =
 {
     {FFX_DENOISER_SHADOWS_CONSTANTBUFFER_IDENTIFIER_DENOISER_SHADOWS0,  L"cb0DenoiserShadows"},
     {FFX_DENOISER_SHADOWS_CONSTANTBUFFER_IDENTIFIER_DENOISER_SHADOWS1,  L"cb1DenoiserShadows"},
@@ -102,6 +101,7 @@ static const ResourceBinding cbResourceBindingTable[] =
     {FFX_DENOISER_REFLECTIONS_CONSTANTBUFFER_IDENTIFIER,                L"cbDenoiserReflections"},
 
 };
+static constexpr auto cbResourceBindingLookup = ffxMakeResourceBindingLookup(cbResourceBindingTable);
 
 typedef struct DenoiserReflectionsConstants
 {
@@ -146,13 +146,8 @@ static FfxErrorCode patchResourceBindings(FfxPipelineState* inoutPipeline)
     // Texture srvs
     for (uint32_t srvIndex = 0; srvIndex < inoutPipeline->srvTextureCount; ++srvIndex)
     {
-        int32_t mapIndex = 0;
-        for (mapIndex = 0; mapIndex < _countof(srvTextureBindingTable); ++mapIndex)
-        {
-            if (0 == wcscmp(srvTextureBindingTable[mapIndex].name, inoutPipeline->srvTextureBindings[srvIndex].name))
-                break;
-        }
-        if (mapIndex == _countof(srvTextureBindingTable))
+        const int32_t mapIndex = ffxFindResourceBinding(srvTextureBindingTable, srvTextureBindingLookup, inoutPipeline->srvTextureBindings[srvIndex]);
+        if (mapIndex < 0)
             return FFX_ERROR_INVALID_ARGUMENT;
 
         inoutPipeline->srvTextureBindings[srvIndex].resourceIdentifier = srvTextureBindingTable[mapIndex].index;
@@ -161,13 +156,8 @@ static FfxErrorCode patchResourceBindings(FfxPipelineState* inoutPipeline)
     // Buffer srvs
     for (uint32_t srvIndex = 0; srvIndex < inoutPipeline->srvBufferCount; ++srvIndex)
     {
-        int32_t mapIndex = 0;
-        for (mapIndex = 0; mapIndex < _countof(srvBufferBindingTable); ++mapIndex)
-        {
-            if (0 == wcscmp(srvBufferBindingTable[mapIndex].name, inoutPipeline->srvBufferBindings[srvIndex].name))
-                break;
-        }
-        if (mapIndex == _countof(srvBufferBindingTable))
+        const int32_t mapIndex = ffxFindResourceBinding(srvBufferBindingTable, srvBufferBindingLookup, inoutPipeline->srvBufferBindings[srvIndex]);
+        if (mapIndex < 0)
             return FFX_ERROR_INVALID_ARGUMENT;
 
         inoutPipeline->srvBufferBindings[srvIndex].resourceIdentifier = srvBufferBindingTable[mapIndex].index;
@@ -176,13 +166,8 @@ static FfxErrorCode patchResourceBindings(FfxPipelineState* inoutPipeline)
     // Buffer uavs
     for (uint32_t uavIndex = 0; uavIndex < inoutPipeline->uavBufferCount; ++uavIndex)
     {
-        int32_t mapIndex = 0;
-        for (mapIndex = 0; mapIndex < _countof(uavBufferBindingTable); ++mapIndex)
-        {
-            if (0 == wcscmp(uavBufferBindingTable[mapIndex].name, inoutPipeline->uavBufferBindings[uavIndex].name))
-                break;
-        }
-        if (mapIndex == _countof(uavBufferBindingTable))
+        const int32_t mapIndex = ffxFindResourceBinding(uavBufferBindingTable, uavBufferBindingLookup, inoutPipeline->uavBufferBindings[uavIndex]);
+        if (mapIndex < 0)
             return FFX_ERROR_INVALID_ARGUMENT;
 
         inoutPipeline->uavBufferBindings[uavIndex].resourceIdentifier = uavBufferBindingTable[mapIndex].index;
@@ -192,13 +177,8 @@ static FfxErrorCode patchResourceBindings(FfxPipelineState* inoutPipeline)
     // Texture uavs
     for (uint32_t uavIndex = 0; uavIndex < inoutPipeline->uavTextureCount; ++uavIndex)
     {
-        int32_t mapIndex = 0;
-        for (mapIndex = 0; mapIndex < _countof(uavTextureBindingTable); ++mapIndex)
-        {
-            if (0 == wcscmp(uavTextureBindingTable[mapIndex].name, inoutPipeline->uavTextureBindings[uavIndex].name))
-                break;
-        }
-        if (mapIndex == _countof(uavTextureBindingTable))
+        const int32_t mapIndex = ffxFindResourceBinding(uavTextureBindingTable, uavTextureBindingLookup, inoutPipeline->uavTextureBindings[uavIndex]);
+        if (mapIndex < 0)
             return FFX_ERROR_INVALID_ARGUMENT;
 
         inoutPipeline->uavTextureBindings[uavIndex].resourceIdentifier = uavTextureBindingTable[mapIndex].index;
@@ -207,13 +187,8 @@ static FfxErrorCode patchResourceBindings(FfxPipelineState* inoutPipeline)
     // Constant buffers
     for (uint32_t cbIndex = 0; cbIndex < inoutPipeline->constCount; ++cbIndex)
     {
-        int32_t mapIndex = 0;
-        for (mapIndex = 0; mapIndex < _countof(cbResourceBindingTable); ++mapIndex)
-        {
-            if (0 == wcscmp(cbResourceBindingTable[mapIndex].name, inoutPipeline->constantBufferBindings[cbIndex].name))
-                break;
-        }
-        if (mapIndex == _countof(cbResourceBindingTable))
+        const int32_t mapIndex = ffxFindResourceBinding(cbResourceBindingTable, cbResourceBindingLookup, inoutPipeline->constantBufferBindings[cbIndex]);
+        if (mapIndex < 0)
             return FFX_ERROR_INVALID_ARGUMENT;
 
         inoutPipeline->constantBufferBindings[cbIndex].resourceIdentifier = cbResourceBindingTable[mapIndex].index;
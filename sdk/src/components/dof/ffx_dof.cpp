@@ -29,25 +29,21 @@
 #include <FidelityFX/host/ffx_dof.h>
 #include <FidelityFX/gpu/ffx_core.h>
 #include <ffx_object_management.h>
+#include <ffx_resource_binding.h>
 
 #include "ffx_dof_private.h"
 
 // lists to map shader resource bindpoint name to resource identifier
-typedef struct ResourceBinding
-{
-    uint32_t    index;
-    wchar_t     name[64];
-}ResourceBinding;
-
-static const ResourceBinding srvTextureBindingTable[] =
+static constexpr ResourceBinding srvTextureBindingTable[] =
 {
     {FFX_DOF_RESOURCE_IDENTIFIER_INPUT_DEPTH,                  L"r_input_depth"},
     {FFX_DOF_RESOURCE_IDENTIFIER_INPUT_COLOR,                  L"r_input_color"},
     {FFX_DOF_RESOURCE_IDENTIFIER_INTERNAL_BILAT_COLOR,         L"r_internal_bilat_color"},
     {FFX_DOF_RESOURCE_IDENTIFIER_INTERNAL_DILATED_RADIUS,      L"r_internal_dilated_radius"},
 };
+static constexpr auto srvTextureBindingLookup = ffxMakeResourceBindingLookup(srvTextureBindingTable);
 
-static const ResourceBinding uavTextureBindingTable[] =
+static constexpr ResourceBinding uavTextureBindingTable[] =
 {
     {FFX_DOF_RESOURCE_IDENTIFIER_INTERNAL_BILAT_COLOR_MIP0,    L"rw_internal_bilat_color"},
     {FFX_DOF_RESOURCE_IDENTIFIER_INTERNAL_RADIUS,              L"rw_internal_radius"},
@@ -57,23 +53,20 @@ static const ResourceBinding uavTextureBindingTable[] =
     {FFX_DOF_RESOURCE_IDENTIFIER_OUTPUT_COLOR,                 L"rw_output_color"},
     {FFX_DOF_RESOURCE_IDENTIFIER_INTERNAL_GLOBALS,             L"rw_internal_globals"},
 };
+static constexpr auto uavTextureBindingLookup = ffxMakeResourceBindingLookup(uavTextureBindingTable);
 
-static const ResourceBinding cbResourceBindingTable[] =
+static constexpr ResourceBinding cbResourceBindingTable[] =
 {
     {FFX_DOF_CONSTANTBUFFER_IDENTIFIER_DOF,                    L"cbDOF"},
 };
+static constexpr auto cbResourceBindingLookup = ffxMakeResourceBindingLookup(cbResourceBindingTable);
 
 static FfxErrorCode patchResourceBindings(FfxPipelineState* inoutPipeline)
 {
     for (uint32_t srvIndex = 0; srvIndex < inoutPipeline->srvTextureCount; ++srvIndex)
     {
-        int32_t mapIndex = 0;
-        for (mapIndex = 0; mapIndex < _countof(srvTextureBindingTable); ++mapIndex)
-        {
-            if (0 == wcscmp(srvTextureBindingTable[mapIndex].name, inoutPipeline->srvTextureBindings[srvIndex].name))
-                break;
-        }
-        if (mapIndex == _countof(srvTextureBindingTable))
+        const int32_t mapIndex = ffxFindResourceBinding(srvTextureBindingTable, srvTextureBindingLookup, inoutPipeline->srvTextureBindings[srvIndex]);
+        if (mapIndex < 0)
             return FFX_ERROR_INVALID_ARGUMENT;
 
         inoutPipeline->srvTextureBindings[srvIndex].resourceIdentifier = srvTextureBindingTable[mapIndex].index;
@@ -81,13 +74,8 @@ static FfxErrorCode patchResourceBindings(FfxPipelineState* inoutPipeline)
 
     for (uint32_t uavIndex = 0; uavIndex < inoutPipeline->uavTextureCount; ++uavIndex)
     {
-        int32_t mapIndex = 0;
-        for (mapIndex = 0; mapIndex < _countof(uavTextureBindingTable); ++mapIndex)
-        {
-            if (0 == wcscmp(uavTextureBindingTable[mapIndex].name, inoutPipeline->uavTextureBindings[uavIndex].name))
-                break;
-        }
-        if (mapIndex == _countof(uavTextureBindingTable))
+        const int32_t mapIndex = ffxFindResourceBinding(uavTextureBindingTable, uavTextureBindingLookup, inoutPipeline->uavTextureBindings[uavIndex]);
+        if (mapIndex < 0)
             return FFX_ERROR_INVALID_ARGUMENT;
 
         inoutPipeline->uavTextureBindings[uavIndex].resourceIdentifier = uavTextureBindingTable[mapIndex].index;
@@ -95,13 +83,8 @@ static FfxErrorCode patchResourceBindings(FfxPipelineState* inoutPipeline)
 
     for (uint32_t uavIndex = 0; uavIndex < inoutPipeline->uavBufferCount; ++uavIndex)
     {
-        int32_t mapIndex = 0;
-        for (mapIndex = 0; mapIndex < _countof(uavTextureBindingTable); ++mapIndex)
-        {
-            if (0 == wcscmp(uavTextureBindingTable[mapIndex].name, inoutPipeline->uavBufferBindings[uavIndex].name))
-                break;
-        }
-        if (mapIndex == _countof(uavTextureBindingTable))
+        const int32_t mapIndex = ffxFindResourceBinding(uavTextureBindingTable, uavTextureBindingLookup, inoutPipeline->uavBufferBindings[uavIndex]);
+        if (mapIndex < 0)
             return FFX_ERROR_INVALID_ARGUMENT;
 
         inoutPipeline->uavBufferBindings[uavIndex].resourceIdentifier = uavTextureBindingTable[mapIndex].index;
@@ -109,13 +92,8 @@ static FfxErrorCode patchResourceBindings(FfxPipelineState* inoutPipeline)
 
     for (uint32_t cbIndex = 0; cbIndex < inoutPipeline->constCount; ++cbIndex)
     {
-        int32_t mapIndex = 0;
-        for (mapIndex = 0; mapIndex < _countof(cbResourceBindingTable); ++mapIndex)
-        {
-            if (0 == wcscmp(cbResourceBindingTable[mapIndex].name, inoutPipeline->constantBufferBindings[cbIndex].name))
-                break;
-        }
-        if (mapIndex == _countof(cbResourceBindingTable))
+        const int32_t mapIndex = ffxFindResourceBinding(cbResourceBindingTable, cbResourceBindingLookup, inoutPipeline->constantBufferBindings[cbIndex]);
+        if (mapIndex < 0)
             return FFX_ERROR_INVALID_ARGUMENT;
 
         inoutPipeline->constantBufferBindings[cbIndex].resourceIdentifier = cbResourceBindingTable[mapIndex].index;
@@ -36,18 +36,13 @@
 #include <FidelityFX/gpu/spd/ffx_spd.h>
 #include <FidelityFX/gpu/opticalflow/ffx_opticalflow_callbacks_hlsl.h>
 #include <ffx_object_management.h>
+#include <ffx_resource_binding.h>
 
 #define FFX_OPTICALFLOW_MAX_QUEUED_FRAMES 16
 
 #include "ffx_opticalflow_private.h"
 
-typedef struct Binding
-{
-    uint32_t    index;
-    wchar_t     name[64];
-}Binding;
-
-static const Binding srvBindingNames[] =
+static constexpr ResourceBinding srvBindingNames[] =
 {
     {FFX_OF_BINDING_IDENTIFIER_INPUT_COLOR,                           L"r_input_color"},
     {FFX_OF_BINDING_IDENTIFIER_OPTICAL_FLOW_INPUT,                    L"r_optical_flow_input"},
@@ -55,8 +50,9 @@ static const Binding srvBindingNames[] =
     {FFX_OF_BINDING_IDENTIFIER_OPTICAL_FLOW,                          L"r_optical_flow"},
     {FFX_OF_BINDING_IDENTIFIER_OPTICAL_FLOW_PREVIOUS,                 L"r_optical_flow_previous"},
 };
+static constexpr auto srvBindingLookup = ffxMakeResourceBindingLookup(srvBindingNames);
 
-static const Binding uavBindingNames[] =
+static constexpr ResourceBinding uavBindingNames[] =
 {
     {FFX_OF_BINDING_IDENTIFIER_OPTICAL_FLOW_INPUT,                      L"rw_optical_flow_input"},
     {FFX_OF_BINDING_IDENTIFIER_OPTICAL_FLOW_INPUT_LEVEL_1,              L"rw_optical_flow_input_level_1"},
@@ -72,12 +68,14 @@ static const Binding uavBindingNames[] =
     {FFX_OF_BINDING_IDENTIFIER_OPTICAL_FLOW_SCD_TEMP,                   L"rw_optical_flow_scd_temp"},
     {FFX_OF_BINDING_IDENTIFIER_OPTICAL_FLOW_SCD_OUTPUT,                 L"rw_optical_flow_scd_output"},
 };
+static constexpr auto uavBindingLookup = ffxMakeResourceBindingLookup(uavBindingNames);
 
-static const Binding cbBindingNames[] =
+static constexpr ResourceBinding cbBindingNames[] =
 {
     {FFX_OPTICALFLOW_CONSTANTBUFFER_IDENTIFIER,       L"cbOF"},
     {FFX_OPTICALFLOW_CONSTANTBUFFER_IDENTIFIER_SPD,   L"cbOF_SPD"}
 };
+static constexpr auto cbBindingLookup = ffxMakeResourceBindingLookup(cbBindingNames);
 
 // Broad structure of the root signature.
 typedef enum OpticalFlowRootSignatureLayout {
@@ -106,14 +104,9 @@ static FfxErrorCode patchResourceBindings(FfxPipelineState* inoutPipeline)
 {
     for (uint32_t srvIndex = 0; srvIndex < inoutPipeline->srvTextureCount; ++srvIndex)
     {
-        int32_t mapIndex = 0;
-        for (mapIndex = 0; mapIndex < _countof(srvBindingNames); ++mapIndex)
-        {
-            if (0 == wcscmp(srvBindingNames[mapIndex].name, inoutPipeline->srvTextureBindings[srvIndex].name))
-                break;
-        }
-        FFX_ASSERT(mapIndex < _countof(srvBindingNames));
-        if (mapIndex == _countof(srvBindingNames))
+        const int32_t mapIndex = ffxFindResourceBinding(srvBindingNames, srvBindingLookup, inoutPipeline->srvTextureBindings[srvIndex]);
+        FFX_ASSERT(mapIndex >= 0);
+        if (mapIndex < 0)
             return FFX_ERROR_INVALID_ARGUMENT;
 
         inoutPipeline->srvTextureBindings[srvIndex].resourceIdentifier = srvBindingNames[mapIndex].index;
@@ -121,14 +114,9 @@ static FfxErrorCode patchResourceBindings(FfxPipelineState* inoutPipeline)
 
     for (uint32_t uavIndex = 0; uavIndex < inoutPipeline->uavTextureCount; ++uavIndex)
     {
-        int32_t mapIndex = 0;
-        for (mapIndex = 0; mapIndex < _countof(uavBindingNames); ++mapIndex)
-        {
-            if (0 == wcscmp(uavBindingNames[mapIndex].name, inoutPipeline->uavTextureBindings[uavIndex].name))
-                break;
-        }
-        FFX_ASSERT(mapIndex < _countof(uavBindingNames));
-        if (mapIndex == _countof(uavBindingNames))
+        const int32_t mapIndex = ffxFindResourceBinding(uavBindingNames, uavBindingLookup, inoutPipeline->uavTextureBindings[uavIndex]);
+        FFX_ASSERT(mapIndex >= 0);
+        if (mapIndex < 0)
             return FFX_ERROR_INVALID_ARGUMENT;
 
         inoutPipeline->uavTextureBindings[uavIndex].resourceIdentifier = uavBindingNames[mapIndex].index;
@@ -136,14 +124,9 @@ static FfxErrorCode patchResourceBindings(FfxPipelineState* inoutPipeline)
 
     for (uint32_t cbIndex = 0; cbIndex < inoutPipeline->constCount; ++cbIndex)
     {
-        int32_t mapIndex = 0;
-        for (mapIndex = 0; mapIndex < _countof(cbBindingNames); ++mapIndex)
-        {
-            if (0 == wcscmp(cbBindingNames[mapIndex].name, inoutPipeline->constantBufferBindings[cbIndex].name))
-                break;
-        }
-        FFX_ASSERT(mapIndex < _countof(cbBindingNames));
-        if (mapIndex == _countof(cbBindingNames))
+        const int32_t mapIndex = ffxFindResourceBinding(cbBindingNames, cbBindingLookup, inoutPipeline->constantBufferBindings[cbIndex]);
+        FFX_ASSERT(mapIndex >= 0);
+        if (mapIndex < 0)
             return FFX_ERROR_INVALID_ARGUMENT;
 
         inoutPipeline->constantBufferBindings[cbIndex].resourceIdentifier = cbBindingNames[mapIndex].index;
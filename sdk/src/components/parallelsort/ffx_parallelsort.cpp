@@ -26,15 +26,10 @@
 #include <FidelityFX/host/ffx_parallelsort.h>
 #include "ffx_parallelsort_private.h"
 #include <ffx_object_management.h>
+#include <ffx_resource_binding.h>
 
 // lists to map shader resource bind point name to resource identifier
-typedef struct ResourceBinding
-{
-    uint32_t    index;
-    wchar_t     name[64];
-}ResourceBinding;
-
-static const ResourceBinding uavBufferBindingTable[] =
+static constexpr ResourceBinding uavBufferBindingTable[] =
 {
     {FFX_PARALLELSORT_RESOURCE_IDENTIFIER_INDIRECT_COUNT_SCATTER_ARGS_BUFFER,   L"rw_count_scatter_args"},
     {FFX_PARALLELSORT_RESOURCE_IDENTIFIER_INDIRECT_REDUCE_SCAN_ARGS_BUFER,      L"rw_reduce_scan_args"},
@@ -48,24 +43,21 @@ static const ResourceBinding uavBufferBindingTable[] =
     {FFX_PARALLELSORT_RESOURCE_IDENTIFIER_PAYLOAD_SRC,                          L"rw_source_payloads"},
     {FFX_PARALLELSORT_RESOURCE_IDENTIFIER_PAYLOAD_DST,                          L"rw_dest_payloads"},
 };
+static constexpr auto uavBufferBindingLookup = ffxMakeResourceBindingLookup(uavBufferBindingTable);
 
-static const ResourceBinding cbResourceBindingTable[] =
+static constexpr ResourceBinding cbResourceBindingTable[] =
 {
     {FFX_PARALLELSORT_CONSTANTBUFFER_IDENTIFIER_PARALLEL_SORT,                  L"cbParallelSort"},
 };
+static constexpr auto cbResourceBindingLookup = ffxMakeResourceBindingLookup(cbResourceBindingTable);
 
 static FfxErrorCode patchResourceBindings(FfxPipelineState* inoutPipeline)
 {
     // Buffer uavs
     for (uint32_t uavIndex = 0; uavIndex < inoutPipeline->uavBufferCount; ++uavIndex)
     {
-        int32_t mapIndex = 0;
-        for (mapIndex = 0; mapIndex < _countof(uavBufferBindingTable); ++mapIndex)
-        {
-            if (0 == wcscmp(uavBufferBindingTable[mapIndex].name, inoutPipeline->uavBufferBindings[uavIndex].name))
-                break;
-        }
-        if (mapIndex == _countof(uavBufferBindingTable))
+        const int32_t mapIndex = ffxFindResourceBinding(uavBufferBindingTable, uavBufferBindingLookup, inoutPipeline->uavBufferBindings[uavIndex]);
+        if (mapIndex < 0)
             return FFX_ERROR_INVALID_ARGUMENT;
 
         inoutPipeline->uavBufferBindings[uavIndex].resourceIdentifier = uavBufferBindingTable[mapIndex].index;
@@ -74,13 +66,8 @@ static FfxErrorCode patchResourceBindings(FfxPipelineState* inoutPipeline)
     // Constant buffers
     for (uint32_t cbIndex = 0; cbIndex < inoutPipeline->constCount; ++cbIndex)
     {
-        int32_t mapIndex = 0;
-        for (mapIndex = 0; mapIndex < _countof(cbResourceBindingTable); ++mapIndex)
-        {
-            if (0 == wcscmp(cbResourceBindingTable[mapIndex].name, inoutPipeline->constantBufferBindings[cbIndex].name))
-                break;
-        }
-        if (mapIndex == _countof(cbResourceBindingTable))
+        const int32_t mapIndex = ffxFindResourceBinding(cbResourceBindingTable, cbResourceBindingLookup, inoutPipeline->constantBufferBindings[cbIndex]);
+        if (mapIndex < 0)
             return FFX_ERROR_INVALID_ARGUMENT;
 
         inoutPipeline->constantBufferBindings[cbIndex].resourceIdentifier = cbResourceBindingTable[mapIndex].index;
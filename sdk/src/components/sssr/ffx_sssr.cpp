@@ -28,6 +28,7 @@ using namespace std;
 #include <FidelityFX/host/ffx_sssr.h>
 #include <FidelityFX/gpu/sssr/ffx_sssr_resources.h>
 #include <ffx_object_management.h>
+#include <ffx_resource_binding.h>
 
 #include <FidelityFX/host/ffx_denoiser.h>
 #include "ffx_sssr_private.h"
@@ -38,13 +39,7 @@ namespace _noiseBuffers
 }
 
 // lists to map shader resource bindpoint name to resource identifier
-typedef struct ResourceBinding
-{
-    uint32_t    index;
-    wchar_t     name[64];
-}ResourceBinding;
-
-static const ResourceBinding srvTextureBindingTable[] =
+static constexpr ResourceBinding srvTextureBindingTable[] =
 {
     {FFX_SSSR_RESOURCE_IDENTIFIER_INPUT_COLOR,                  L"r_input_color"},
     {FFX_SSSR_RESOURCE_IDENTIFIER_INPUT_DEPTH,                  L"r_input_depth"},
@@ -62,8 +57,9 @@ static const ResourceBinding srvTextureBindingTable[] =
     {FFX_SSSR_RESOURCE_IDENTIFIER_BLUE_NOISE_TEXTURE,           L"r_blue_noise_texture"},
     {FFX_SSSR_RESOURCE_IDENTIFIER_INPUT_BRDF_TEXTURE,           L"r_input_brdf_texture"},
 };
+static constexpr auto srvTextureBindingLookup = ffxMakeResourceBindingLookup(srvTextureBindingTable);
 
-static const ResourceBinding uavTextureBindingTable[] =
+static constexpr ResourceBinding uavTextureBindingTable[] =
 {
     {FFX_SSSR_RESOURCE_IDENTIFIER_RADIANCE,                        L"rw_radiance"},
     {FFX_SSSR_RESOURCE_IDENTIFIER_VARIANCE,                        L"rw_variance"},
@@ -71,8 +67,9 @@ static const ResourceBinding uavTextureBindingTable[] =
     {FFX_SSSR_RESOURCE_IDENTIFIER_BLUE_NOISE_TEXTURE,              L"rw_blue_noise_texture"},
     {FFX_SSSR_RESOURCE_IDENTIFIER_DEPTH_HIERARCHY,                 L"rw_depth_hierarchy"},
 };
+static constexpr auto uavTextureBindingLookup = ffxMakeResourceBindingLookup(uavTextureBindingTable);
 
-static const ResourceBinding uavBufferBindingTable[] =
+static constexpr ResourceBinding uavBufferBindingTable[] =
 {
     {FFX_SSSR_RESOURCE_IDENTIFIER_RAY_LIST,                        L"rw_ray_list"},
     {FFX_SSSR_RESOURCE_IDENTIFIER_DENOISER_TILE_LIST,              L"rw_denoiser_tile_list"},
@@ -80,11 +77,13 @@ static const ResourceBinding uavBufferBindingTable[] =
     {FFX_SSSR_RESOURCE_IDENTIFIER_INTERSECTION_PASS_INDIRECT_ARGS, L"rw_intersection_pass_indirect_args"},
     {FFX_SSSR_RESOURCE_IDENTIFIER_SPD_GLOBAL_ATOMIC,               L"rw_spd_global_atomic"},
 };
+static constexpr auto uavBufferBindingLookup = ffxMakeResourceBindingLookup(uavBufferBindingTable);
 
-static const ResourceBinding constantBufferBindingTable[] =
+static constexpr ResourceBinding constantBufferBindingTable[] =
 {
     {FFX_SSSR_CONSTANTBUFFER_IDENTIFIER_SSSR,     L"cbSSSR"},
 };
+static constexpr auto constantBufferBindingLookup = ffxMakeResourceBindingLookup(constantBufferBindingTable);
 
 template<typename T> inline T DivideRoundingUp(T a, T b)
 {
@@ -95,13 +94,8 @@ static FfxErrorCode patchResourceBindings(FfxPipelineState* inoutPipeline)
 {
     for (uint32_t srvIndex = 0; srvIndex < inoutPipeline->srvTextureCount; ++srvIndex)
     {
-        int32_t mapIndex = 0;
-        for (mapIndex = 0; mapIndex < FFX_ARRAY_ELEMENTS(srvTextureBindingTable); ++mapIndex)
-        {
-            if (0 == wcscmp(srvTextureBindingTable[mapIndex].name, inoutPipeline->srvTextureBindings[srvIndex].name))
-                break;
-        }
-        if (mapIndex == FFX_ARRAY_ELEMENTS(srvTextureBindingTable))
+        const int32_t mapIndex = ffxFindResourceBinding(srvTextureBindingTable, srvTextureBindingLookup, inoutPipeline->srvTextureBindings[srvIndex]);
+        if (mapIndex < 0)
             return FFX_ERROR_INVALID_ARGUMENT;
 
         inoutPipeline->srvTextureBindings[srvIndex].resourceIdentifier = srvTextureBindingTable[mapIndex].index;
@@ -109,13 +103,8 @@ static FfxErrorCode patchResourceBindings(FfxPipelineState* inoutPipeline)
 
     for (uint32_t uavIndex = 0; uavIndex < inoutPipeline->uavTextureCount; ++uavIndex)
     {
-        int32_t mapIndex = 0;
-        for (mapIndex = 0; mapIndex < FFX_ARRAY_ELEMENTS(uavTextureBindingTable); ++mapIndex)
-        {
-            if (0 == wcscmp(uavTextureBindingTable[mapIndex].name, inoutPipeline->uavTextureBindings[uavIndex].name))
-                break;
-        }
-        if (mapIndex == FFX_ARRAY_ELEMENTS(uavTextureBindingTable))
+        const int32_t mapIndex = ffxFindResourceBinding(uavTextureBindingTable, uavTextureBindingLookup, inoutPipeline->uavTextureBindings[uavIndex]);
+        if (mapIndex < 0)
             return FFX_ERROR_INVALID_ARGUMENT;
 
         inoutPipeline->uavTextureBindings[uavIndex].resourceIdentifier = uavTextureBindingTable[mapIndex].index;
@@ -124,13 +113,8 @@ static FfxErrorCode patchResourceBindings(FfxPipelineState* inoutPipeline)
     // Buffer uavs
     for (uint32_t uavIndex = 0; uavIndex < inoutPipeline->uavBufferCount; ++uavIndex)
     {
-        int32_t mapIndex = 0;
-        for (mapIndex = 0; mapIndex < FFX_ARRAY_ELEMENTS(uavBufferBindingTable); ++mapIndex)
-        {
-            if (0 == wcscmp(uavBufferBindingTable[mapIndex].name, inoutPipeline->uavBufferBindings[uavIndex].name))
-                break;
-        }
-        if (mapIndex == FFX_ARRAY_ELEMENTS(uavBufferBindingTable))
+        const int32_t mapIndex = ffxFindResourceBinding(uavBufferBindingTable, uavBufferBindingLookup, inoutPipeline->uavBufferBindings[uavIndex]);
+        if (mapIndex < 0)
             return FFX_ERROR_INVALID_ARGUMENT;
 
         inoutPipeline->uavBufferBindings[uavIndex].resourceIdentifier = uavBufferBindingTable[mapIndex].index;
@@ -138,13 +122,8 @@ static FfxErrorCode patchResourceBindings(FfxPipelineState* inoutPipeline)
 
     for (uint32_t cbIndex = 0; cbIndex < inoutPipeline->constCount; ++cbIndex)
     {
-        int32_t mapIndex = 0;
-        for (mapIndex = 0; mapIndex < FFX_ARRAY_ELEMENTS(constantBufferBindingTable); ++mapIndex)
-        {
-            if (0 == wcscmp(constantBufferBindingTable[mapIndex].name, inoutPipeline->constantBufferBindings[cbIndex].name))
-                break;
-        }
-        if (mapIndex == FFX_ARRAY_ELEMENTS(constantBufferBindingTable))
+        const int32_t mapIndex = ffxFindResourceBinding(constantBufferBindingTable, constantBufferBindingLookup, inoutPipeline->constantBufferBindings[cbIndex]);
+        if (mapIndex < 0)
             return FFX_ERROR_INVALID_ARGUMENT;
 
         inoutPipeline->constantBufferBindings[cbIndex].resourceIdentifier = constantBufferBindingTable[mapIndex].index;
@@ -22,11 +22,35 @@
 
 #include "ffx_breadcrumbs_list.h"
 
+// Lists grown with ffxBreadcrumbsAppendList don't store their capacity, it's implied by the element count instead.
+// Rounding it up to a power of two keeps appends amortized O(1), a list of n elements is only reallocated O(log n) times.
+static size_t breadcrumbsListCapacity(size_t count)
+{
+    if (count == 0)
+        return 0;
+    if (count <= FFX_BREADCRUMBS_LIST_MIN_CAPACITY)
+        return FFX_BREADCRUMBS_LIST_MIN_CAPACITY;
+
+    // Called for every appended string fragment, so round up without looping
+    size_t capacity = count - 1;
+    capacity |= capacity >> 1;
+    capacity |= capacity >> 2;
+    capacity |= capacity >> 4;
+    capacity |= capacity >> 8;
+    capacity |= capacity >> 16;
+    capacity |= (uint64_t)capacity >> 32;
+    return capacity + 1;
+}
+
 void* ffxBreadcrumbsAppendList(void* src, size_t currentCount, size_t elementSize, size_t appendCount, FfxAllocationCallbacks* callbacks)
 {
     FFX_ASSERT(src ? currentCount > 0 : currentCount == 0);
 
-    void* dst = callbacks->fpRealloc(src, elementSize * (currentCount + appendCount));
+    const size_t newCapacity = breadcrumbsListCapacity(currentCount + appendCount);
+    if (newCapacity <= breadcrumbsListCapacity(currentCount))
+        return src;
+
+    void* dst = callbacks->fpRealloc(src, elementSize * newCapacity);
     FFX_ASSERT(dst);
 
     return dst;
@@ -36,14 +60,29 @@ void* ffxBreadcrumbsPopList(void* src, size_t newCount, size_t elementSize, FfxA
 {
     FFX_ASSERT(src);
 
-    void* dst = nullptr;
+    // Keep the memory around for the next append, the implied capacity of a shorter list is never bigger
     if (newCount > 0)
-    {
-        dst = callbacks->fpRealloc(src, elementSize * newCount);
-        FFX_ASSERT(dst);
-    }
-    else
-        callbacks->fpFree(src);
+        return src;
+
+    callbacks->fpFree(src);
+    return nullptr;
+}
+
+void* ffxBreadcrumbsReserveList(void* src, size_t* capacity, size_t elementSize, size_t requiredCount, FfxAllocationCallbacks* callbacks)
+{
+    FFX_ASSERT(capacity);
+    FFX_ASSERT(src ? *capacity > 0 : *capacity == 0);
+
+    if (requiredCount <= *capacity)
+        return src;
+
+    size_t newCapacity = *capacity ? *capacity : FFX_BREADCRUMBS_LIST_MIN_CAPACITY;
+    while (newCapacity < requiredCount)
+        newCapacity <<= 1;
+
+    void* dst = callbacks->fpRealloc(src, elementSize * newCapacity);
+    FFX_ASSERT(dst);
 
+    *capacity = newCapacity;
     return dst;
 }
@@ -23,9 +23,12 @@
 #pragma once
 
 #include <cstdint>
-#include <cstdio>      // sprintf_s
+#include <cstdio>      // snprintf
 #include <FidelityFX/host/ffx_assert.h>
 
+// Smallest number of elements allocated for a list, growth doubles from there
+#define FFX_BREADCRUMBS_LIST_MIN_CAPACITY 16
+
 #define FFX_BREADCRUMBS_APPEND_STRING(buff, count, str)                                  \
     do                                                                                   \
     {                                                                                    \
@@ -44,11 +47,16 @@
         count += _length;                                                        \
     } while (false)
 
+// Length of what snprintf() wrote to a buffer, output that didn't fit was truncated and an encoding error wrote nothing
+#define FFX_BREADCRUMBS_SNPRINTF_LENGTH(written, buffer) \
+    ((written) < 0 ? size_t(0) : size_t(written) < sizeof(buffer) ? size_t(written) : sizeof(buffer) - 1)
+
 #define FFX_BREADCRUMBS_APPEND_NUMBER(buff, count, number, maxLength, format)    \
     do                                                                           \
     {                                                                            \
         char _numberStr[maxLength];                                              \
-        const size_t _length = sprintf_s(_numberStr, maxLength, format, number); \
+        const int _written = snprintf(_numberStr, maxLength, format, number);    \
+        const size_t _length = FFX_BREADCRUMBS_SNPRINTF_LENGTH(_written, _numberStr); \
         buff = (char*)ffxBreadcrumbsAppendList(buff, count, 1, _length, allocs); \
         memcpy(buff + count, _numberStr, _length);                               \
         count += _length;                                                        \
@@ -116,7 +124,8 @@
     {                                                                                               \
         FFX_BREADCRUMBS_APPEND_STRING(buff, count, FFX_BREADCRUMBS_PRINTING_INDENT #member ": 0x"); \
         char _hexStr[maxLength];                                                                    \
-        const size_t _length = sprintf_s(_hexStr, maxLength, format, baseStruct.member);            \
+        const int _written = snprintf(_hexStr, maxLength, format, baseStruct.member);               \
+        const size_t _length = FFX_BREADCRUMBS_SNPRINTF_LENGTH(_written, _hexStr);                  \
         buff = (char*)ffxBreadcrumbsAppendList(buff, count, 1, _length + 1, allocs);                \
         memcpy(buff + count, _hexStr, _length);                                                     \
         count += _length;                                                                           \
@@ -141,10 +150,17 @@
 extern "C" {
 #endif // #if defined(__cplusplus)
 
+    // Grows a list to fit appendCount more elements. The capacity is implied by currentCount, so the list must only
+    // ever be resized with ffxBreadcrumbsAppendList and ffxBreadcrumbsPopList.
     FFX_API void* ffxBreadcrumbsAppendList(void* src, size_t currentCount, size_t elementSize, size_t appendCount, FfxAllocationCallbacks* callbacks);
 
+    // Shrinks a list grown with ffxBreadcrumbsAppendList, memory is only released once it's empty.
     FFX_API void* ffxBreadcrumbsPopList(void* src, size_t newCount, size_t elementSize, FfxAllocationCallbacks* callbacks);
 
+    // Grows a list with an explicitly tracked capacity to hold at least requiredCount elements, doubling the capacity as needed.
+    // Used for storage that is reset and refilled every frame without giving up its memory.
+    FFX_API void* ffxBreadcrumbsReserveList(void* src, size_t* capacity, size_t elementSize, size_t requiredCount, FfxAllocationCallbacks* callbacks);
+
 #if defined(__cplusplus)
 }
 #endif // #if defined(__cplusplus)
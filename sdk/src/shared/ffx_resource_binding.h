@@ -0,0 +1,124 @@
+// This file is part of the FidelityFX SDK.
+//
+// Copyright (C) 2024 Advanced Micro Devices, Inc.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#pragma once
+
+#include <FidelityFX/host/ffx_types.h>
+
+#include <stddef.h>
+#include <wchar.h>
+
+// 32-bit FNV-1a hash of a shader resource bind point name. FidelityFX_SC stores the same hash for every reflected
+// binding in the shader blobs. Bind point names are ASCII, so wide and UTF-8 names hash to the same value.
+template<typename CharType>
+constexpr uint32_t ffxGetResourceBindingNameHash(const CharType* name)
+{
+    uint32_t hash = 2166136261u;
+    for (; *name; ++name)
+    {
+        hash ^= uint32_t(*name) & 0xFF;
+        hash *= 16777619u;
+    }
+
+    return hash;
+}
+
+// Maps a shader resource bind point name to a resource identifier, the name is hashed at compile time
+struct ResourceBinding
+{
+    constexpr ResourceBinding(uint32_t index, const wchar_t* name)
+        : index(index)
+        , name(name)
+        , nameHash(ffxGetResourceBindingNameHash(name))
+    {
+    }
+
+    uint32_t       index;
+    const wchar_t* name;
+    uint32_t       nameHash;
+};
+
+// Number of slots of a ResourceBindingLookup, a power of two with at least twice as many slots as table entries
+constexpr uint32_t ffxGetResourceBindingLookupSize(size_t tableSize)
+{
+    uint32_t size = 1;
+    while (size < 2 * tableSize)
+        size <<= 1;
+
+    return size;
+}
+
+// Open addressed map from the name hash to the index of a table entry, built at compile time
+template<size_t TableSize>
+struct ResourceBindingLookup
+{
+    static constexpr uint32_t SlotCount = ffxGetResourceBindingLookupSize(TableSize);
+
+    constexpr ResourceBindingLookup(const ResourceBinding (&table)[TableSize])
+        : slots()
+    {
+        for (uint32_t slot = 0; slot < SlotCount; ++slot)
+            slots[slot] = -1;
+
+        for (int32_t mapIndex = 0; mapIndex < int32_t(TableSize); ++mapIndex)
+        {
+            uint32_t slot = table[mapIndex].nameHash & (SlotCount - 1);
+            while (slots[slot] >= 0)
+                slot = (slot + 1) & (SlotCount - 1);
+
+            slots[slot] = mapIndex;
+        }
+    }
+
+    int32_t slots[SlotCount];
+};
+
+// Builds the lookup of a binding table, meant for a static constexpr next to the table
+template<size_t TableSize>
+constexpr ResourceBindingLookup<TableSize> ffxMakeResourceBindingLookup(const ResourceBinding (&table)[TableSize])
+{
+    return ResourceBindingLookup<TableSize>(table);
+}
+
+// Returns the index of the table entry for a binding of a newly created pipeline, or -1 if the table has no entry for
+// it. Until it is patched, the resource identifier of the binding holds the name hash the backend took from the shader
+// blob, which is looked up in the lookup of the table and only the name of a match is compared. Backends that don't
+// provide the hash get the name scan.
+template<size_t TableSize>
+int32_t ffxFindResourceBinding(const ResourceBinding (&table)[TableSize], const ResourceBindingLookup<TableSize>& lookup, const FfxResourceBinding& binding)
+{
+    const uint32_t slotMask = ResourceBindingLookup<TableSize>::SlotCount - 1;
+    for (uint32_t slot = binding.resourceIdentifier & slotMask; lookup.slots[slot] >= 0; slot = (slot + 1) & slotMask)
+    {
+        const int32_t mapIndex = lookup.slots[slot];
+        if (table[mapIndex].nameHash == binding.resourceIdentifier && 0 == wcscmp(table[mapIndex].name, binding.name))
+            return mapIndex;
+    }
+
+    for (int32_t mapIndex = 0; mapIndex < int32_t(TableSize); ++mapIndex)
+    {
+        if (0 == wcscmp(table[mapIndex].name, binding.name))
+            return mapIndex;
+    }
+
+    return -1;
+}
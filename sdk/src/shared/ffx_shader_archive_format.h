@@ -0,0 +1,146 @@
+// This file is part of the FidelityFX SDK.
+//
+// Copyright (C) 2024 Advanced Micro Devices, Inc.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Layout of the shader archives written by FidelityFX_SC and read by the backends. An archive starts with a header,
+// followed by the index entries sorted by key, followed by the blob data. Offsets are from the start of the file and
+// all values are little endian.
+//
+// A blob is keyed by the hash of its permutation name "<shader name>_<MD5 of the bytecode>". The shader name names the
+// effect, pass and variant (e.g. ffx_spd_downsample_pass_wave64_16bit) and the generated indirection table of the pass
+// maps a permutation key to the permutation, so the key stands for (effect, pass, permutation key).
+
+#define FFX_SHADER_ARCHIVE_MAGIC   0x41535846  // "FXSA"
+#define FFX_SHADER_ARCHIVE_VERSION 1
+
+typedef enum FfxShaderArchiveCompression
+{
+    FFX_SHADER_ARCHIVE_COMPRESSION_NONE = 0,  ///< The blob is stored as is and used in place.
+    FFX_SHADER_ARCHIVE_COMPRESSION_LZ4  = 1,  ///< The blob is stored in the LZ4 block format (no frame) and decompressed on first use.
+} FfxShaderArchiveCompression;
+
+typedef struct FfxShaderArchiveHeader
+{
+    uint32_t magic;       ///< FFX_SHADER_ARCHIVE_MAGIC
+    uint32_t version;     ///< FFX_SHADER_ARCHIVE_VERSION
+    uint32_t entryCount;  ///< Number of entries in the index following the header
+    uint32_t reserved;
+} FfxShaderArchiveHeader;
+
+typedef struct FfxShaderArchiveEntry
+{
+    uint64_t key;          ///< ffxGetShaderArchiveKey of the permutation name
+    uint64_t offset;       ///< Offset of the stored data
+    uint32_t storedSize;   ///< Size of the stored data in bytes
+    uint32_t size;         ///< Size of the blob in bytes
+    uint32_t compression;  ///< FfxShaderArchiveCompression of the stored data
+    uint32_t reserved;
+} FfxShaderArchiveEntry;
+
+static_assert(sizeof(FfxShaderArchiveHeader) == 16, "FfxShaderArchiveHeader is part of the file format");
+static_assert(sizeof(FfxShaderArchiveEntry) == 32, "FfxShaderArchiveEntry is part of the file format");
+
+// 64-bit FNV-1a hash of a permutation name. A key of 0 is reserved for blobs embedded in the permutation headers.
+inline uint64_t ffxGetShaderArchiveKey(const char* permutationName)
+{
+    uint64_t hash = 14695981039346656037ull;
+    for (; *permutationName; ++permutationName)
+    {
+        hash ^= uint8_t(*permutationName);
+        hash *= 1099511628211ull;
+    }
+
+    return hash != 0 ? hash : 1;
+}
+
+// Decompresses an LZ4 block into a buffer of exactly the decompressed size. Returns false on malformed input instead
+// of reading or writing out of bounds.
+inline bool ffxShaderArchiveDecompressLZ4(const uint8_t* src, size_t srcSize, uint8_t* dst, size_t dstSize)
+{
+    const uint8_t* srcEnd = src + srcSize;
+    uint8_t*       dstPtr = dst;
+    uint8_t*       dstEnd = dst + dstSize;
+
+    while (src < srcEnd)
+    {
+        const uint8_t token = *src++;
+
+        size_t literalLength = token >> 4;
+        if (literalLength == 15)
+        {
+            uint8_t extra;
+            do
+            {
+                if (src == srcEnd)
+                    return false;
+                extra = *src++;
+                literalLength += extra;
+            } while (extra == 255);
+        }
+
+        if (literalLength > size_t(srcEnd - src) || literalLength > size_t(dstEnd - dstPtr))
+            return false;
+        for (size_t i = 0; i < literalLength; ++i)
+            dstPtr[i] = src[i];
+        src += literalLength;
+        dstPtr += literalLength;
+
+        // the last sequence only has literals
+        if (src == srcEnd)
+            break;
+
+        if (srcEnd - src < 2)
+            return false;
+        const size_t matchOffset = size_t(src[0]) | (size_t(src[1]) << 8);
+        src += 2;
+        if (matchOffset == 0 || matchOffset > size_t(dstPtr - dst))
+            return false;
+
+        size_t matchLength = (token & 15) + 4;
+        if ((token & 15) == 15)
+        {
+            uint8_t extra;
+            do
+            {
+                if (src == srcEnd)
+                    return false;
+                extra = *src++;
+                matchLength += extra;
+            } while (extra == 255);
+        }
+
+        if (matchLength > size_t(dstEnd - dstPtr))
+            return false;
+
+        // matches may overlap their own output, so copy byte by byte
+        const uint8_t* match = dstPtr - matchOffset;
+        for (size_t i = 0; i < matchLength; ++i)
+            dstPtr[i] = match[i];
+        dstPtr += matchLength;
+    }
+
+    return dstPtr == dstEnd;
+}
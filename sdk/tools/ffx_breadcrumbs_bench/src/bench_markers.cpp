@@ -0,0 +1,136 @@
+// This file is part of the FidelityFX SDK.
+//
+// Copyright (C) 2024 Advanced Micro Devices, Inc.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include <cstdio>
+
+#include "ffx_breadcrumbs_bench.h"
+
+static FfxCommandList benchListHandle(uint32_t index)
+{
+    return (FfxCommandList)(uintptr_t)(0x100000 + index * 256);
+}
+
+static FfxPipeline benchPipelineHandle(uint32_t index)
+{
+    return (FfxPipeline)(uintptr_t)(0x10000 + index * 64);
+}
+
+// Records markers into randomly picked command lists, switching to a random pipeline before each of them,
+// so every marker looks up its command list and every pipeline change looks up the pipeline
+int benchMarkers(int argc, char** argv)
+{
+    int markers   = 20000;
+    int lists     = 200;
+    int pipelines = 3000;
+    int frames    = 100;
+
+    for (int arg = 0; arg < argc; ++arg)
+    {
+        const char* value = nullptr;
+        if (benchParseOption(argv[arg], "-markers=", &value))
+            markers = atoi(value);
+        else if (benchParseOption(argv[arg], "-lists=", &value))
+            lists = atoi(value);
+        else if (benchParseOption(argv[arg], "-pipelines=", &value))
+            pipelines = atoi(value);
+        else if (benchParseOption(argv[arg], "-frames=", &value))
+            frames = atoi(value);
+        else
+        {
+            fprintf(stderr, "Unknown option \"%s\"!\n", argv[arg]);
+            return 1;
+        }
+    }
+
+    if (markers <= 0 || lists <= 0 || pipelines <= 0 || frames <= 0)
+    {
+        fprintf(stderr, "Invalid marker, command list, pipeline or frame count!\n");
+        return 1;
+    }
+
+    uint32_t queue = 0;
+    FfxBreadcrumbsContextDescription desc = {};
+    desc.flags                    = FFX_BREADCRUMBS_PRINT_SKIP_DEVICE_INFO;
+    desc.frameHistoryLength       = 3;
+    desc.maxMarkersPerMemoryBlock = 1024;
+    desc.usedGpuQueuesCount       = 1;
+    desc.pUsedGpuQueues           = &queue;
+    benchInitHostBackend(&desc);
+
+    FfxBreadcrumbsContext context;
+    if (ffxBreadcrumbsContextCreate(&context, &desc) != FFX_OK)
+    {
+        fprintf(stderr, "Cannot create Breadcrumbs context!\n");
+        return 1;
+    }
+
+    for (int p = 0; p < pipelines; ++p)
+    {
+        FfxBreadcrumbsPipelineStateDescription pipelineDesc = {};
+        pipelineDesc.pipeline      = benchPipelineHandle(p);
+        pipelineDesc.name          = { "Pipeline", true };
+        pipelineDesc.computeShader = { "CSMain", true };
+        ffxBreadcrumbsRegisterPipeline(&context, &pipelineDesc);
+    }
+
+    int                 result = 0;
+    uint32_t            random = 1;
+    std::vector<double> frameMs;
+    for (int f = 0; f < frames && result == 0; ++f)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        ffxBreadcrumbsStartFrame(&context);
+        for (int l = 0; l < lists; ++l)
+        {
+            FfxBreadcrumbsCommandListDescription listDesc = {};
+            listDesc.commandList = benchListHandle(l);
+            listDesc.name        = { "List", true };
+            if (ffxBreadcrumbsRegisterCommandList(&context, &listDesc) != FFX_OK)
+                result = 1;
+        }
+
+        for (int m = 0; m < markers; ++m)
+        {
+            random = random * 1664525u + 1013904223u;
+            const FfxCommandList list = benchListHandle((random >> 8) % lists);
+            ffxBreadcrumbsSetPipeline(&context, list, benchPipelineHandle((random >> 4) % pipelines));
+
+            const FfxBreadcrumbsNameTag name = { "Dispatch", true };
+            if (ffxBreadcrumbsBeginMarker(&context, list, FFX_BREADCRUMBS_MARKER_DISPATCH, &name) != FFX_OK ||
+                ffxBreadcrumbsEndMarker(&context, list) != FFX_OK)
+                result = 1;
+        }
+        frameMs.push_back(benchElapsedMs(start));
+    }
+
+    ffxBreadcrumbsContextDestroy(&context);
+    if (result != 0)
+    {
+        fprintf(stderr, "Recording markers failed!\n");
+        return result;
+    }
+
+    const double medianMs = benchPercentile(frameMs, 0.5);
+    printf("Setup:   %d markers per frame in %d command lists, %d pipelines\n", markers, lists, pipelines);
+    printf("Record:  %.3f ms p50, %.3f ms p95 per frame, %.1f M markers/s\n", medianMs, benchPercentile(frameMs, 0.95), markers / medianMs * 1e-3);
+    return 0;
+}
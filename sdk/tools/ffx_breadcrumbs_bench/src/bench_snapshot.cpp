@@ -0,0 +1,268 @@
+// This file is part of the FidelityFX SDK.
+//
+// Copyright (C) 2024 Advanced Micro Devices, Inc.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include <cstdio>
+#include <string>
+
+#include <ffx_breadcrumbs_list.h>
+
+#include "ffx_breadcrumbs_bench.h"
+
+static const int s_listCount = 6;
+
+static void snapshotPrintDeviceInfo(FfxInterface* backendInterface, FfxAllocationCallbacks* allocs, bool extendedInfo, char** printBuffer, size_t* printSize)
+{
+    FFX_BREADCRUMBS_APPEND_STRING(*printBuffer, *printSize, "[DEVICE]\n    name: \"Host \\ memory\"\n");
+}
+
+static bool snapshotWriteFile(const std::string& path, const void* data, size_t size)
+{
+    FILE* file = fopen(path.c_str(), "wb");
+    if (file == nullptr)
+        return false;
+
+    const bool written = fwrite(data, 1, size, file) == size;
+    fclose(file);
+    return written;
+}
+
+// Records named and unnamed lists and markers with escaped names over every kind of pipeline, the last frame
+// skips every 7th write so lists end up finished, in progress and not started
+static bool snapshotRecord(FfxBreadcrumbsContext* context, int markers, int frames)
+{
+    char name[64];
+    for (int p = 1; p <= 5; ++p)
+    {
+        snprintf(name, sizeof(name), "Pipeline \"%d\"\n\t", p);
+        FfxBreadcrumbsPipelineStateDescription pipelineDesc = {};
+        pipelineDesc.pipeline = (FfxPipeline)(uintptr_t)(0x1000 * p);
+        pipelineDesc.name     = { name, false };
+        if (p == 1)
+            pipelineDesc.computeShader = { "CSMain", false };
+        else if (p == 2)
+            pipelineDesc.rayTracingShader = { "RayGen", false };
+        else if (p == 3)
+        {
+            pipelineDesc.vertexShader   = { "VSMain", false };
+            pipelineDesc.pixelShader    = { "PSMain", false };
+            pipelineDesc.geometryShader = { "GSMain", false };
+        }
+        else if (p == 4)
+        {
+            pipelineDesc.meshShader          = { "MSMain", false };
+            pipelineDesc.amplificationShader = { "ASMain", false };
+        }
+        if (ffxBreadcrumbsRegisterPipeline(context, &pipelineDesc) != FFX_OK)
+            return false;
+    }
+
+    uint32_t random = 7;
+    auto next = [&random](uint32_t range) {
+        random = random * 1664525u + 1013904223u;
+        return (random >> 8) % range;
+    };
+
+    for (int f = 0; f < frames; ++f)
+    {
+        ffxBreadcrumbsStartFrame(context);
+        benchDropEveryNthWrite(f == frames - 1 ? 7 : 0);
+        for (int l = 0; l < s_listCount; ++l)
+        {
+            const FfxCommandList commandList = (FfxCommandList)(uintptr_t)(l + 1);
+
+            snprintf(name, sizeof(name), "List %d", l);
+            FfxBreadcrumbsCommandListDescription listDesc = {};
+            listDesc.commandList     = commandList;
+            listDesc.queueType       = l % 2;
+            listDesc.submissionIndex = (uint16_t)l;
+            listDesc.name            = { l % 3 ? name : nullptr, false };
+            if (ffxBreadcrumbsRegisterCommandList(context, &listDesc) != FFX_OK)
+                return false;
+
+            int depth = 0;
+            for (int m = 0; m < markers; ++m)
+            {
+                const uint32_t action = next(10);
+                if (action < 2 && depth > 0)
+                {
+                    ffxBreadcrumbsEndMarker(context, commandList);
+                    --depth;
+                    continue;
+                }
+                if (action == 9)
+                    ffxBreadcrumbsSetPipeline(context, commandList, (FfxPipeline)(uintptr_t)(0x1000 * (1 + next(5))));
+
+                const FfxBreadcrumbsMarkerType type = next(4) == 0 ? FFX_BREADCRUMBS_MARKER_PASS : (FfxBreadcrumbsMarkerType)(FFX_BREADCRUMBS_MARKER_DRAW + next(3));
+                snprintf(name, sizeof(name), "Pass %d", m);
+                const char* markerName = (type == FFX_BREADCRUMBS_MARKER_PASS || next(2)) ? (next(2) ? name : "Static") : nullptr;
+                const FfxBreadcrumbsNameTag tag = { markerName, markerName != name };
+                if (ffxBreadcrumbsBeginMarker(context, commandList, type, &tag) != FFX_OK)
+                    return false;
+
+                if (next(3))
+                    ffxBreadcrumbsEndMarker(context, commandList);
+                else
+                    ++depth;
+            }
+            while (depth--)
+                ffxBreadcrumbsEndMarker(context, commandList);
+        }
+    }
+    benchDropEveryNthWrite(0);
+    return true;
+}
+
+// Checks for every set of printing flags that a saved snapshot decodes to exactly the status the live context prints,
+// and that truncated or bit flipped snapshots are rejected or decoded without crashing
+int benchSnapshot(int argc, char** argv)
+{
+    int         markers     = 200;
+    int         frames      = 5;
+    int         corruptions = 3000;
+    const char* outPrefix   = nullptr;
+
+    for (int arg = 0; arg < argc; ++arg)
+    {
+        const char* value = nullptr;
+        if (benchParseOption(argv[arg], "-markers=", &value))
+            markers = atoi(value);
+        else if (benchParseOption(argv[arg], "-frames=", &value))
+            frames = atoi(value);
+        else if (benchParseOption(argv[arg], "-corruptions=", &value))
+            corruptions = atoi(value);
+        else if (benchParseOption(argv[arg], "-out=", &value))
+            outPrefix = value;
+        else
+        {
+            fprintf(stderr, "Unknown option \"%s\"!\n", argv[arg]);
+            return 1;
+        }
+    }
+
+    if (markers <= 0 || frames <= 0 || corruptions < 0)
+    {
+        fprintf(stderr, "Invalid marker, frame or corruption count!\n");
+        return 1;
+    }
+
+    const uint32_t flagSets[] =
+    {
+        0,
+        FFX_BREADCRUMBS_PRINT_FINISHED_LISTS | FFX_BREADCRUMBS_PRINT_NOT_STARTED_LISTS | FFX_BREADCRUMBS_PRINT_FINISHED_NODES | FFX_BREADCRUMBS_PRINT_NOT_STARTED_NODES,
+        FFX_BREADCRUMBS_PRINT_FINISHED_NODES | FFX_BREADCRUMBS_PRINT_EXTENDED_DEVICE_INFO | FFX_BREADCRUMBS_PRINT_SKIP_PIPELINE_INFO,
+        FFX_BREADCRUMBS_PRINT_NOT_STARTED_LISTS | FFX_BREADCRUMBS_PRINT_SKIP_DEVICE_INFO,
+    };
+
+    int                    result = 0;
+    FfxAllocationCallbacks allocs = {};
+    FfxBreadcrumbsSnapshot snapshot = {};
+    for (const uint32_t flags : flagSets)
+    {
+        uint32_t queues[2] = { 0, 1 };
+        FfxBreadcrumbsContextDescription desc = {};
+        desc.flags                    = flags;
+        desc.frameHistoryLength       = 3;
+        desc.maxMarkersPerMemoryBlock = 100000;
+        desc.usedGpuQueuesCount       = 2;
+        desc.pUsedGpuQueues           = queues;
+        benchInitHostBackend(&desc);
+        desc.backendInterface.fpBreadcrumbsPrintDeviceInfo = snapshotPrintDeviceInfo;
+        allocs = desc.allocCallbacks;
+
+        FfxBreadcrumbsContext context;
+        if (ffxBreadcrumbsContextCreate(&context, &desc) != FFX_OK)
+        {
+            fprintf(stderr, "Cannot create Breadcrumbs context!\n");
+            return 1;
+        }
+
+        FfxBreadcrumbsMarkersStatus status = {};
+        FfxBreadcrumbsMarkersStatus text   = {};
+        FfxBreadcrumbsMarkersStatus json   = {};
+        free(snapshot.pBuffer);
+        snapshot = {};
+
+        const bool recorded = snapshotRecord(&context, markers, frames);
+        const bool printed  = recorded && ffxBreadcrumbsPrintStatus(&context, &status) == FFX_OK;
+        const bool saved    = printed && ffxBreadcrumbsSaveSnapshot(&context, &snapshot) == FFX_OK;
+        const bool decoded  = saved && ffxBreadcrumbsPrintSnapshot(&snapshot, FFX_BREADCRUMBS_STATUS_FORMAT_TEXT, &allocs, &text) == FFX_OK &&
+                              ffxBreadcrumbsPrintSnapshot(&snapshot, FFX_BREADCRUMBS_STATUS_FORMAT_JSON, &allocs, &json) == FFX_OK;
+        const bool same     = decoded && status.bufferSize == text.bufferSize && memcmp(status.pBuffer, text.pBuffer, text.bufferSize) == 0;
+        printf("Flags 0x%02X:  %zu bytes of snapshot, %zu of status, %zu of JSON, %s\n", flags, snapshot.bufferSize, status.bufferSize, json.bufferSize,
+               same ? "decoded status matches" : "MISMATCH");
+        result |= same ? 0 : 1;
+
+        // Files for checking FidelityFX_BreadcrumbsDecoder against, "<prefix>.bin" has to decode to "<prefix>.txt" and "<prefix>.json"
+        if (outPrefix && same && flags == flagSets[1])
+        {
+            const std::string prefix = outPrefix;
+            if (!snapshotWriteFile(prefix + ".bin", snapshot.pBuffer, snapshot.bufferSize) ||
+                !snapshotWriteFile(prefix + ".txt", status.pBuffer, status.bufferSize) ||
+                !snapshotWriteFile(prefix + ".json", json.pBuffer, json.bufferSize))
+            {
+                fprintf(stderr, "Cannot write \"%s\" files!\n", outPrefix);
+                result = 1;
+            }
+        }
+
+        free(status.pBuffer);
+        free(text.pBuffer);
+        free(json.pBuffer);
+        ffxBreadcrumbsContextDestroy(&context);
+    }
+
+    if (snapshot.pBuffer == nullptr)
+        return 1;
+
+    // The header is checked most, so half of the bit flips land in it
+    int       rejected = 0;
+    int       accepted = 0;
+    uint32_t  random   = 1;
+    uint64_t* copy     = (uint64_t*)malloc(snapshot.bufferSize + sizeof(uint64_t));
+    for (size_t cut = 0; cut < snapshot.bufferSize; cut += 1 + cut / 64)
+    {
+        memcpy(copy, snapshot.pBuffer, cut);
+        const FfxBreadcrumbsSnapshot truncated = { cut, copy };
+        FfxBreadcrumbsMarkersStatus  output    = {};
+        (ffxBreadcrumbsPrintSnapshot(&truncated, FFX_BREADCRUMBS_STATUS_FORMAT_JSON, &allocs, &output) == FFX_OK ? accepted : rejected)++;
+        free(output.pBuffer);
+    }
+    for (int i = 0; i < corruptions; ++i)
+    {
+        memcpy(copy, snapshot.pBuffer, snapshot.bufferSize);
+        const size_t range = i % 2 ? std::min<size_t>(120, snapshot.bufferSize) : snapshot.bufferSize;
+        for (int flip = 0; flip <= i % 4; ++flip)
+        {
+            random = random * 1664525u + 1013904223u;
+            ((unsigned char*)copy)[(random >> 8) % range] ^= (unsigned char)(1 << (random >> 29));
+        }
+        const FfxBreadcrumbsSnapshot corrupted = { snapshot.bufferSize, copy };
+        FfxBreadcrumbsMarkersStatus  output    = {};
+        (ffxBreadcrumbsPrintSnapshot(&corrupted, (FfxBreadcrumbsStatusFormat)(i % 2), &allocs, &output) == FFX_OK ? accepted : rejected)++;
+        free(output.pBuffer);
+    }
+    printf("Corrupted:   %d rejected, %d decoded without crashing\n", rejected, accepted);
+
+    free(copy);
+    free(snapshot.pBuffer);
+    return result;
+}
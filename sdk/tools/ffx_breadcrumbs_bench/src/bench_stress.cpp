@@ -0,0 +1,241 @@
+// This file is part of the FidelityFX SDK.
+//
+// Copyright (C) 2024 Advanced Micro Devices, Inc.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include <atomic>
+#include <cstdio>
+#include <string>
+#include <thread>
+
+#include "ffx_breadcrumbs_bench.h"
+
+static const int s_listsPerThread = 6;
+static const int s_pipelineCount  = 64;
+static const int s_frameCount     = 12;
+
+struct StressParams
+{
+    int  threads;
+    int  markers;
+    bool parallel;             // Record every thread's lists on its own thread
+    bool parallelRegistration; // Also register the lists from those threads
+};
+
+static FfxCommandList stressListHandle(int thread, int list)
+{
+    return (FfxCommandList)(uintptr_t)(0x1000000 + (thread * s_listsPerThread + list) * 4096);
+}
+
+static FfxPipeline stressPipelineHandle(int pipeline)
+{
+    return (FfxPipeline)(uintptr_t)(0x10000 + pipeline * 64);
+}
+
+// Nested markers and pipeline changes, seeded per list and frame so every thread schedule records the same content
+static void stressRecordList(FfxBreadcrumbsContext* context, const StressParams& params, int thread, int list, int frame)
+{
+    const FfxCommandList commandList = stressListHandle(thread, list);
+    uint32_t random = 0x9E3779B9u * (thread * 131 + list * 7 + frame + 1);
+    int depth = 0;
+    char name[64];
+    for (int m = 0; m < params.markers; ++m)
+    {
+        random = random * 1664525u + 1013904223u;
+        if ((random >> 28) < 3)
+            ffxBreadcrumbsSetPipeline(context, commandList, stressPipelineHandle((random >> 8) % s_pipelineCount));
+        if (depth > 0 && ((random >> 20) & 3) == 0)
+        {
+            ffxBreadcrumbsEndMarker(context, commandList);
+            --depth;
+            continue;
+        }
+
+        snprintf(name, sizeof(name), "Marker %d/%d/%d", thread, list, m);
+        const FfxBreadcrumbsNameTag tag = { name, false };
+        ffxBreadcrumbsBeginMarker(context, commandList, (FfxBreadcrumbsMarkerType)(FFX_BREADCRUMBS_MARKER_DRAW + (random >> 12) % 10), &tag);
+        ++depth;
+        if (depth > 6 || ((random >> 16) & 1))
+        {
+            ffxBreadcrumbsEndMarker(context, commandList);
+            --depth;
+        }
+    }
+    while (depth--)
+        ffxBreadcrumbsEndMarker(context, commandList);
+}
+
+static bool stressRegisterList(FfxBreadcrumbsContext* context, int thread, int list)
+{
+    const std::string name = "List " + std::to_string(thread) + "." + std::to_string(list);
+    FfxBreadcrumbsCommandListDescription listDesc = {};
+    listDesc.commandList     = stressListHandle(thread, list);
+    listDesc.queueType       = (thread + list) % 3;
+    listDesc.submissionIndex = (uint16_t)list;
+    listDesc.pipeline        = stressPipelineHandle(thread % (s_pipelineCount / 2));
+    listDesc.name            = { name.c_str(), false };
+    return ffxBreadcrumbsRegisterCommandList(context, &listDesc) == FFX_OK;
+}
+
+static void stressRegisterPipelines(FfxBreadcrumbsContext* context, int first, int last)
+{
+    for (int p = first; p < last; ++p)
+    {
+        const std::string name = "Pipeline " + std::to_string(p);
+        FfxBreadcrumbsPipelineStateDescription pipelineDesc = {};
+        pipelineDesc.pipeline     = stressPipelineHandle(p);
+        pipelineDesc.name         = { name.c_str(), false };
+        pipelineDesc.vertexShader = { "VSMain", true };
+        pipelineDesc.pixelShader  = { "PSMain", true };
+        ffxBreadcrumbsRegisterPipeline(context, &pipelineDesc);
+    }
+}
+
+// Records s_frameCount frames and prints the status with everything the library knows about. The last frame
+// never finishes its markers, like a GPU that hung partway through it.
+static bool stressRun(const StressParams& params, std::string* status, double* frameMs)
+{
+    uint32_t queues[3] = { 0, 1, 2 };
+    FfxBreadcrumbsContextDescription desc = {};
+    desc.flags = FFX_BREADCRUMBS_PRINT_SKIP_DEVICE_INFO | FFX_BREADCRUMBS_ENABLE_THREAD_SYNCHRONIZATION |
+                 FFX_BREADCRUMBS_PRINT_FINISHED_LISTS | FFX_BREADCRUMBS_PRINT_NOT_STARTED_LISTS |
+                 FFX_BREADCRUMBS_PRINT_FINISHED_NODES | FFX_BREADCRUMBS_PRINT_NOT_STARTED_NODES;
+    desc.frameHistoryLength       = 3;
+    desc.maxMarkersPerMemoryBlock = 100;
+    desc.usedGpuQueuesCount       = 3;
+    desc.pUsedGpuQueues           = queues;
+    benchInitHostBackend(&desc);
+
+    FfxBreadcrumbsContext context;
+    if (ffxBreadcrumbsContextCreate(&context, &desc) != FFX_OK)
+        return false;
+
+    // Half of the pipelines are registered up front, the rest while the first frame is recorded
+    stressRegisterPipelines(&context, 0, s_pipelineCount / 2);
+
+    std::atomic<bool> registered{ true };
+    const auto start = std::chrono::steady_clock::now();
+    for (int f = 0; f < s_frameCount; ++f)
+    {
+        benchDropEndWrites(f == s_frameCount - 1);
+        ffxBreadcrumbsStartFrame(&context);
+        if (!params.parallelRegistration)
+        {
+            for (int t = 0; t < params.threads; ++t)
+                for (int l = 0; l < s_listsPerThread; ++l)
+                    registered = stressRegisterList(&context, t, l) && registered;
+        }
+
+        if (params.parallel)
+        {
+            std::vector<std::thread> threads;
+            for (int t = 0; t < params.threads; ++t)
+            {
+                threads.emplace_back([&context, &params, &registered, t, f]() {
+                    for (int l = 0; l < s_listsPerThread; ++l)
+                    {
+                        if (params.parallelRegistration && !stressRegisterList(&context, t, l))
+                            registered = false;
+                        stressRecordList(&context, params, t, l, f);
+                    }
+                });
+            }
+            if (f == 0)
+                stressRegisterPipelines(&context, s_pipelineCount / 2, s_pipelineCount);
+            for (std::thread& thread : threads)
+                thread.join();
+        }
+        else
+        {
+            if (f == 0)
+                stressRegisterPipelines(&context, s_pipelineCount / 2, s_pipelineCount);
+            for (int t = 0; t < params.threads; ++t)
+                for (int l = 0; l < s_listsPerThread; ++l)
+                    stressRecordList(&context, params, t, l, f);
+        }
+    }
+    *frameMs = benchElapsedMs(start) / s_frameCount;
+    benchDropEndWrites(false);
+
+    FfxBreadcrumbsMarkersStatus markersStatus = {};
+    const bool printed = ffxBreadcrumbsPrintStatus(&context, &markersStatus) == FFX_OK;
+    if (printed)
+        status->assign(markersStatus.pBuffer, markersStatus.bufferSize);
+    free(markersStatus.pBuffer);
+    ffxBreadcrumbsContextDestroy(&context);
+    return printed && registered;
+}
+
+// Records the same command lists from many threads and from one, with thread synchronization enabled the printed
+// status has to match byte for byte
+int benchStress(int argc, char** argv)
+{
+    int markers = 400;
+    int threads = 8;
+    int runs    = 5;
+
+    for (int arg = 0; arg < argc; ++arg)
+    {
+        const char* value = nullptr;
+        if (benchParseOption(argv[arg], "-markers=", &value))
+            markers = atoi(value);
+        else if (benchParseOption(argv[arg], "-threads=", &value))
+            threads = atoi(value);
+        else if (benchParseOption(argv[arg], "-runs=", &value))
+            runs = atoi(value);
+        else
+        {
+            fprintf(stderr, "Unknown option \"%s\"!\n", argv[arg]);
+            return 1;
+        }
+    }
+
+    if (markers <= 0 || threads <= 0 || runs <= 0)
+    {
+        fprintf(stderr, "Invalid marker, thread or run count!\n");
+        return 1;
+    }
+
+    std::string serialStatus;
+    double      frameMs = 0.0;
+    if (!stressRun({ threads, markers, false, false }, &serialStatus, &frameMs))
+    {
+        fprintf(stderr, "Serialized run failed!\n");
+        return 1;
+    }
+    printf("Serialized:             %zu bytes of status, %.3f ms per frame\n", serialStatus.size(), frameMs);
+
+    int mismatches = 0;
+    for (int r = 0; r < runs; ++r)
+    {
+        std::string parallelStatus;
+        const bool  recorded = stressRun({ threads, markers, true, false }, &parallelStatus, &frameMs);
+        const bool  same     = recorded && parallelStatus == serialStatus;
+        mismatches += same ? 0 : 1;
+        printf("Parallel:               %zu bytes of status, %.3f ms per frame%s\n", parallelStatus.size(), frameMs, same ? "" : ", MISMATCH");
+    }
+
+    // Registration order decides the order of the lists in the status, so this one only has to run clean
+    std::string registrationStatus;
+    const bool  registeredClean = stressRun({ threads, markers, true, true }, &registrationStatus, &frameMs);
+    printf("Parallel registration:  %zu bytes of status, %.3f ms per frame%s\n", registrationStatus.size(), frameMs, registeredClean ? "" : ", FAILED");
+
+    return mismatches == 0 && registeredClean ? 0 : 1;
+}
@@ -0,0 +1,161 @@
+// This file is part of the FidelityFX SDK.
+//
+// Copyright (C) 2024 Advanced Micro Devices, Inc.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+// CPU benchmarks of marker recording, runs the Breadcrumbs context on a host memory backend so the numbers quoted in
+// changes to the library can be reproduced without a GPU.
+//
+// Usage: FidelityFX_BreadcrumbsBench <benchmark> [options]
+//
+// Benchmarks:
+//   markers    markers recorded per second with many command lists and registered pipelines
+//   stress     record from many threads at once and compare the printed status against a serialized run
+//   snapshot   save a binary snapshot, decode it like FidelityFX_BreadcrumbsDecoder and feed the decoder corrupted copies
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include "ffx_breadcrumbs_bench.h"
+
+static std::atomic<bool>     s_dropEndWrites{ false };
+static std::atomic<uint32_t> s_dropEveryNthWrite{ 0 };
+static std::atomic<uint32_t> s_writeCount{ 0 };
+
+static void* benchAlloc(size_t size)
+{
+    return malloc(size);
+}
+
+static void* benchRealloc(void* ptr, size_t size)
+{
+    return realloc(ptr, size);
+}
+
+static void benchFree(void* ptr)
+{
+    free(ptr);
+}
+
+static FfxVersionNumber benchGetSDKVersion(FfxInterface* backendInterface)
+{
+    return FFX_SDK_MAKE_VERSION(FFX_SDK_VERSION_MAJOR, FFX_SDK_VERSION_MINOR, FFX_SDK_VERSION_PATCH);
+}
+
+static FfxErrorCode benchCreateBackendContext(FfxInterface* backendInterface, FfxEffect effect, FfxEffectBindlessConfig* bindlessConfig, FfxUInt32* effectContextId)
+{
+    *effectContextId = 0;
+    return FFX_OK;
+}
+
+static FfxErrorCode benchDestroyBackendContext(FfxInterface* backendInterface, FfxUInt32 effectContextId)
+{
+    return FFX_OK;
+}
+
+static FfxErrorCode benchAllocBlock(FfxInterface* backendInterface, uint64_t blockBytes, FfxBreadcrumbsBlockData* blockData)
+{
+    *blockData = {};
+    blockData->memory = calloc(1, (size_t)blockBytes);
+    if (blockData->memory == nullptr)
+        return FFX_ERROR_OUT_OF_MEMORY;
+
+    blockData->buffer      = blockData->memory;
+    blockData->baseAddress = (uint64_t)(uintptr_t)blockData->memory;
+    return FFX_OK;
+}
+
+static void benchFreeBlock(FfxInterface* backendInterface, FfxBreadcrumbsBlockData* blockData)
+{
+    free(blockData->memory);
+    blockData->memory = nullptr;
+    blockData->buffer = nullptr;
+}
+
+static void benchWrite(FfxInterface* backendInterface, FfxCommandList commandList, uint32_t value, uint64_t gpuLocation, void* gpuBuffer, bool isBegin)
+{
+    if (!isBegin && s_dropEndWrites.load(std::memory_order_relaxed))
+        return;
+
+    const uint32_t dropEveryNth = s_dropEveryNthWrite.load(std::memory_order_relaxed);
+    if (dropEveryNth != 0 && (s_writeCount.fetch_add(1, std::memory_order_relaxed) + 1) % dropEveryNth == 0)
+        return;
+
+    *(volatile uint32_t*)(uintptr_t)gpuLocation = value;
+}
+
+void benchDropEndWrites(bool drop)
+{
+    s_dropEndWrites.store(drop, std::memory_order_relaxed);
+}
+
+void benchDropEveryNthWrite(uint32_t n)
+{
+    s_writeCount.store(0, std::memory_order_relaxed);
+    s_dropEveryNthWrite.store(n, std::memory_order_relaxed);
+}
+
+void benchInitHostBackend(FfxBreadcrumbsContextDescription* desc)
+{
+    desc->allocCallbacks.fpAlloc   = benchAlloc;
+    desc->allocCallbacks.fpRealloc = benchRealloc;
+    desc->allocCallbacks.fpFree    = benchFree;
+
+    desc->backendInterface = {};
+    desc->backendInterface.fpGetSDKVersion         = benchGetSDKVersion;
+    desc->backendInterface.fpCreateBackendContext  = benchCreateBackendContext;
+    desc->backendInterface.fpDestroyBackendContext = benchDestroyBackendContext;
+    desc->backendInterface.fpBreadcrumbsAllocBlock = benchAllocBlock;
+    desc->backendInterface.fpBreadcrumbsFreeBlock  = benchFreeBlock;
+    desc->backendInterface.fpBreadcrumbsWrite      = benchWrite;
+}
+
+struct Benchmark
+{
+    const char* name;
+    const char* options;
+    BenchFunc   func;
+};
+
+static const Benchmark s_benchmarks[] =
+{
+    { "markers", "-markers=<n> -lists=<n> -pipelines=<n> -frames=<n>", benchMarkers },
+    { "stress",  "-markers=<n> -threads=<n> -runs=<n>", benchStress },
+    { "snapshot", "-markers=<n> -frames=<n> -corruptions=<n> -out=<prefix>", benchSnapshot },
+};
+
+int main(int argc, char** argv)
+{
+    if (argc >= 2)
+    {
+        for (const Benchmark& benchmark : s_benchmarks)
+        {
+            if (strcmp(argv[1], benchmark.name) == 0)
+                return benchmark.func(argc - 2, argv + 2);
+        }
+    }
+
+    fprintf(stderr, "Usage: %s <benchmark> [options]\n", argv[0]);
+    for (const Benchmark& benchmark : s_benchmarks)
+        fprintf(stderr, "       %s %s %s\n", argv[0], benchmark.name, benchmark.options);
+    return 1;
+}
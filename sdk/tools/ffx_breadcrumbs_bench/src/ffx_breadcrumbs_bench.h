@@ -0,0 +1,73 @@
+// This file is part of the FidelityFX SDK.
+//
+// Copyright (C) 2024 Advanced Micro Devices, Inc.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include <FidelityFX/host/ffx_breadcrumbs.h>
+
+// Every benchmark parses its own options from argv and returns the process exit code
+typedef int (*BenchFunc)(int argc, char** argv);
+
+int benchMarkers(int argc, char** argv);
+int benchStress(int argc, char** argv);
+int benchSnapshot(int argc, char** argv);
+
+// Fills in the allocation callbacks and a backend that keeps marker blocks in host memory, writes go straight to them
+void benchInitHostBackend(FfxBreadcrumbsContextDescription* desc);
+
+// Simulates a GPU that stopped partway, markers recorded while set are left started but never finished
+void benchDropEndWrites(bool drop);
+
+// Simulates a GPU that stopped partway through a list, every nth marker write is skipped while n isn't 0
+void benchDropEveryNthWrite(uint32_t n);
+
+// Matches "-name=" options, value points behind the '='
+inline bool benchParseOption(const char* arg, const char* name, const char** value)
+{
+    const size_t length = strlen(name);
+    if (strncmp(arg, name, length) != 0)
+        return false;
+
+    *value = arg + length;
+    return true;
+}
+
+inline double benchPercentile(std::vector<double> values, double percentile)
+{
+    if (values.empty())
+        return 0.0;
+
+    std::sort(values.begin(), values.end());
+    const size_t index = std::min(values.size() - 1, (size_t)(percentile * (values.size() - 1) + 0.5));
+    return values[index];
+}
+
+inline double benchElapsedMs(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
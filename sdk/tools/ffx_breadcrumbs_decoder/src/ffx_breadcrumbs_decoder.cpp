@@ -0,0 +1,122 @@
+// This file is part of the FidelityFX SDK.
+//
+// Copyright (C) 2024 Advanced Micro Devices, Inc.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+// Prints binary snapshots saved with ffxBreadcrumbsSaveSnapshot() without the application or GPU that produced them.
+//
+// Usage: FidelityFX_BreadcrumbsDecoder [-json] <snapshot> [output]
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include <FidelityFX/host/ffx_breadcrumbs.h>
+
+static void* decoderAlloc(size_t size)
+{
+    return malloc(size);
+}
+
+static void* decoderRealloc(void* ptr, size_t size)
+{
+    return realloc(ptr, size);
+}
+
+static void decoderFree(void* ptr)
+{
+    free(ptr);
+}
+
+static bool decoderReadFile(const char* path, FfxBreadcrumbsSnapshot* snapshot)
+{
+    FILE* file = fopen(path, "rb");
+    if (file == nullptr)
+        return false;
+
+    bool result = false;
+    if (fseek(file, 0, SEEK_END) == 0)
+    {
+        const long size = ftell(file);
+        if (size > 0 && fseek(file, 0, SEEK_SET) == 0)
+        {
+            // malloc() alignment is enough for the snapshot header
+            snapshot->pBuffer = malloc((size_t)size);
+            if (snapshot->pBuffer)
+            {
+                snapshot->bufferSize = (size_t)size;
+                result = fread(snapshot->pBuffer, 1, snapshot->bufferSize, file) == snapshot->bufferSize;
+            }
+        }
+    }
+    fclose(file);
+    return result;
+}
+
+int main(int argc, char** argv)
+{
+    FfxBreadcrumbsStatusFormat format = FFX_BREADCRUMBS_STATUS_FORMAT_TEXT;
+    int arg = 1;
+    if (arg < argc && strcmp(argv[arg], "-json") == 0)
+    {
+        format = FFX_BREADCRUMBS_STATUS_FORMAT_JSON;
+        ++arg;
+    }
+    if (arg >= argc || argc - arg > 2)
+    {
+        fprintf(stderr, "Usage: %s [-json] <snapshot> [output]\n", argv[0]);
+        return 1;
+    }
+
+    FfxBreadcrumbsSnapshot snapshot = {};
+    if (!decoderReadFile(argv[arg], &snapshot))
+    {
+        fprintf(stderr, "Cannot read snapshot file \"%s\"!\n", argv[arg]);
+        free(snapshot.pBuffer);
+        return 1;
+    }
+
+    FfxAllocationCallbacks allocs = { decoderAlloc, decoderRealloc, decoderFree };
+    FfxBreadcrumbsMarkersStatus status = {};
+    const FfxErrorCode errorCode = ffxBreadcrumbsPrintSnapshot(&snapshot, format, &allocs, &status);
+    free(snapshot.pBuffer);
+    if (errorCode != FFX_OK)
+    {
+        fprintf(stderr, "Cannot decode snapshot file \"%s\", error 0x%X!\n", argv[arg], (unsigned)errorCode);
+        return 1;
+    }
+
+    FILE* output = stdout;
+    if (arg + 1 < argc)
+    {
+        output = fopen(argv[arg + 1], "wb");
+        if (output == nullptr)
+        {
+            fprintf(stderr, "Cannot open output file \"%s\"!\n", argv[arg + 1]);
+            free(status.pBuffer);
+            return 1;
+        }
+    }
+    const bool written = fwrite(status.pBuffer, 1, status.bufferSize, output) == status.bufferSize;
+    if (output != stdout)
+        fclose(output);
+    free(status.pBuffer);
+    return written ? 0 : 1;
+}
@@ -0,0 +1,224 @@
+// This file is part of the FidelityFX SDK.
+//
+// Copyright (C) 2024 Advanced Micro Devices, Inc.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+
+#include <cmath>
+#include <cstdio>
+
+#include "ffx_brixelizer_bench.h"
+
+static const uint32_t s_numCascades   = 8;
+static const float    s_baseVoxelSize = 0.2f;
+
+static float benchRandom(uint64_t* state)
+{
+    *state ^= *state << 13;
+    *state ^= *state >> 7;
+    *state ^= *state << 17;
+    return (float)(*state >> 40) / (float)(1 << 24);
+}
+
+static bool benchAABBsOverlap(const FfxBrixelizerAABB& x, const FfxBrixelizerAABB& y)
+{
+    for (uint32_t i = 0; i < 3; ++i)
+    {
+        if (x.min[i] > y.max[i] || y.min[i] > x.max[i])
+            return false;
+    }
+    return true;
+}
+
+// Blocks of buildings on a grid, with a few large landmarks every thousand instances
+static void benchBuildCity(uint32_t numInstances, float citySize, std::vector<FfxBrixelizerInstanceDescription>* descs)
+{
+    uint64_t     state = 0x9E3779B97F4A7C15ull;
+    const uint32_t side  = (uint32_t)ceilf(sqrtf((float)numInstances));
+    const float    cell  = citySize / side;
+
+    descs->assign(numInstances, FfxBrixelizerInstanceDescription{});
+    for (uint32_t i = 0; i < numInstances; ++i)
+    {
+        float x      = (i % side) * cell - 0.5f * citySize + benchRandom(&state) * cell * 0.3f;
+        float z      = (i / side) * cell - 0.5f * citySize + benchRandom(&state) * cell * 0.3f;
+        float width  = cell * (0.2f + 0.6f * benchRandom(&state));
+        float depth  = cell * (0.2f + 0.6f * benchRandom(&state));
+        float height = 3.0f + 60.0f * benchRandom(&state) * benchRandom(&state);
+        if (i % 997 == 0)
+        {
+            width  *= 8.0f;
+            depth  *= 8.0f;
+            height *= 4.0f;
+        }
+
+        FfxBrixelizerInstanceDescription& desc = (*descs)[i];
+        desc.maxCascade = s_numCascades - 1;
+        desc.aabb       = { { x, 0.0f, z }, { x + width, height, z + depth } };
+    }
+}
+
+// Flies a camera around a city of static instances and times ffxBrixelizerBakeUpdate, optionally deleting and
+// recreating instances every frame like streaming does. The instance jobs of every update are checked against a
+// linear scan over all instances, which is also timed as the cost of culling without the instance tree.
+int benchBake(int argc, char** argv)
+{
+    int   instances = 65535;
+    float citySize  = 4000.0f;
+    int   frames    = 2048;
+    int   churn     = 0;
+
+    for (int arg = 0; arg < argc; ++arg)
+    {
+        const char* value = nullptr;
+        if (benchParseOption(argv[arg], "-instances=", &value))
+            instances = atoi(value);
+        else if (benchParseOption(argv[arg], "-city=", &value))
+            citySize = (float)atof(value);
+        else if (benchParseOption(argv[arg], "-frames=", &value))
+            frames = atoi(value);
+        else if (benchParseOption(argv[arg], "-churn=", &value))
+            churn = atoi(value);
+        else
+        {
+            fprintf(stderr, "Unknown option \"%s\"!\n", argv[arg]);
+            return 1;
+        }
+    }
+
+    if (instances <= 0 || instances >= (int)FFX_BRIXELIZER_MAX_INSTANCES || citySize <= 0.0f || frames <= 0 || churn < 0 || churn > instances)
+    {
+        fprintf(stderr, "Invalid instance count, city size, frame count or churn!\n");
+        return 1;
+    }
+
+    // Both are megabytes in size
+    FfxBrixelizerContext*                context = (FfxBrixelizerContext*)calloc(1, sizeof(FfxBrixelizerContext));
+    FfxBrixelizerBakedUpdateDescription* baked   = (FfxBrixelizerBakedUpdateDescription*)calloc(1, sizeof(FfxBrixelizerBakedUpdateDescription));
+
+    FfxBrixelizerContextDescription contextDesc = {};
+    contextDesc.numCascades = s_numCascades;
+    for (uint32_t i = 0; i < s_numCascades; ++i)
+    {
+        contextDesc.cascadeDescs[i].flags     = (FfxBrixelizerCascadeFlag)(FFX_BRIXELIZER_CASCADE_STATIC | FFX_BRIXELIZER_CASCADE_DYNAMIC);
+        contextDesc.cascadeDescs[i].voxelSize = s_baseVoxelSize * (float)(1u << i);
+    }
+
+    if (context == nullptr || baked == nullptr || ffxBrixelizerContextCreate(&contextDesc, context) != FFX_OK)
+    {
+        fprintf(stderr, "Failed to create the Brixelizer context!\n");
+        free(context);
+        free(baked);
+        return 1;
+    }
+
+    std::vector<FfxBrixelizerInstanceDescription> descs;
+    benchBuildCity(instances, citySize, &descs);
+
+    std::vector<FfxBrixelizerInstanceID> ids(instances);
+    for (int i = 0; i < instances; ++i)
+        descs[i].outInstanceID = &ids[i];
+
+    auto createStart = std::chrono::steady_clock::now();
+    for (int i = 0; i < instances; i += 1024)
+        ffxBrixelizerCreateInstances(context, &descs[i], std::min(1024, instances - i));
+    const double createMs = benchElapsedMs(createStart);
+
+    size_t                         scratchSize = 0;
+    FfxBrixelizerUpdateDescription update      = {};
+    update.outScratchBufferSize = &scratchSize;
+
+    std::vector<double>   bakeMs;
+    std::vector<double>   linearMs;
+    std::vector<uint32_t> jobInstances;
+    std::vector<uint32_t> linearInstances;
+    uint64_t              instanceJobs = 0;
+    int                   mismatches   = 0;
+    for (int frame = 0; frame < frames; ++frame)
+    {
+        const float t = (float)frame / frames;
+        update.frameIndex   = frame;
+        update.sdfCenter[0] = citySize * 0.4f * cosf(6.28f * t);
+        update.sdfCenter[1] = 20.0f;
+        update.sdfCenter[2] = citySize * 0.4f * sinf(6.28f * t);
+
+        for (int i = 0; i < churn; ++i)
+        {
+            const uint32_t index = (frame * 7919u + i * 104729u) % instances;
+            ffxBrixelizerDeleteInstances(context, &ids[index], 1);
+            ffxBrixelizerCreateInstances(context, &descs[index], 1);
+        }
+
+        auto bakeStart = std::chrono::steady_clock::now();
+        ffxBrixelizerBakeUpdate(context, &update, baked);
+        bakeMs.push_back(benchElapsedMs(bakeStart));
+
+        const FfxBrixelizerRawCascadeUpdateDescription& cascadeUpdate = benchGetStaticCascadeUpdate();
+        const float                                     cascadeSize   = s_baseVoxelSize * (float)(1u << cascadeUpdate.cascadeIndex) * FFX_BRIXELIZER_CASCADE_RESOLUTION;
+
+        FfxBrixelizerAABB cascadeAABB = {};
+        for (uint32_t i = 0; i < 3; ++i)
+        {
+            cascadeAABB.min[i] = cascadeUpdate.cascadeMin[i];
+            cascadeAABB.max[i] = cascadeUpdate.cascadeMin[i] + cascadeSize;
+        }
+
+        auto linearStart = std::chrono::steady_clock::now();
+        linearInstances.clear();
+        for (int i = 0; i < instances; ++i)
+        {
+            if (benchAABBsOverlap(descs[i].aabb, cascadeAABB))
+                linearInstances.push_back(ids[i]);
+        }
+        linearMs.push_back(benchElapsedMs(linearStart));
+
+        jobInstances.clear();
+        for (const FfxBrixelizerRawJobDescription& job : benchGetStaticJobs())
+        {
+            if (!(job.flags & FFX_BRIXELIZER_RAW_JOB_FLAG_INVALIDATE))
+                jobInstances.push_back(job.instanceIdx);
+        }
+        instanceJobs += jobInstances.size();
+
+        std::sort(jobInstances.begin(), jobInstances.end());
+        std::sort(linearInstances.begin(), linearInstances.end());
+        if (jobInstances != linearInstances)
+            ++mismatches;
+    }
+
+    double bakeTotalMs   = 0.0;
+    double linearTotalMs = 0.0;
+    for (int frame = 0; frame < frames; ++frame)
+    {
+        bakeTotalMs   += bakeMs[frame];
+        linearTotalMs += linearMs[frame];
+    }
+
+    printf("Instances: %d in a %.0f m city, %d recreated per frame\n", instances, citySize, churn);
+    printf("Create:    %.2f ms\n", createMs);
+    printf("Bake:      %.4f ms mean, %.4f ms p50, %.4f ms p99\n", bakeTotalMs / frames, benchPercentile(bakeMs, 0.5), benchPercentile(bakeMs, 0.99));
+    printf("Linear:    %.4f ms mean, %.4f ms p50, %.4f ms p99\n", linearTotalMs / frames, benchPercentile(linearMs, 0.5), benchPercentile(linearMs, 0.99));
+    printf("Jobs:      %.1f instance jobs per frame, %d of %d frames differ from the linear scan\n", (double)instanceJobs / frames, mismatches, frames);
+
+    ffxBrixelizerContextDestroy(context);
+    free(context);
+    free(baked);
+    return mismatches == 0 ? 0 : 1;
+}
@@ -0,0 +1,279 @@
+// This file is part of the FidelityFX SDK.
+//
+// Copyright (C) 2024 Advanced Micro Devices, Inc.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+
+#include <cstdio>
+
+#include "ffx_brixelizer_cascade_cache.h"
+#include "ffx_brixelizer_bench.h"
+
+static uint32_t cacheRandom(uint64_t* state)
+{
+    *state ^= *state << 13;
+    *state ^= *state >> 7;
+    *state ^= *state << 17;
+    return (uint32_t)*state;
+}
+
+// Offset of the first texel of a brick in the tightly packed atlas
+static size_t cacheAtlasBrickOffset(uint32_t brickIndex)
+{
+    const uint32_t bricksPerDimension = FFX_BRIXELIZER_STATIC_CONFIG_SDF_ATLAS_SIZE / FFX_BRIXELIZER_BRICK_DIMENSION;
+    const size_t   x = (brickIndex % bricksPerDimension) * FFX_BRIXELIZER_BRICK_DIMENSION;
+    const size_t   y = (brickIndex / bricksPerDimension % bricksPerDimension) * FFX_BRIXELIZER_BRICK_DIMENSION;
+    const size_t   z = (brickIndex / bricksPerDimension / bricksPerDimension) * FFX_BRIXELIZER_BRICK_DIMENSION;
+    return (z * FFX_BRIXELIZER_STATIC_CONFIG_SDF_ATLAS_SIZE + y) * FFX_BRIXELIZER_STATIC_CONFIG_SDF_ATLAS_SIZE + x;
+}
+
+static bool cacheBricksEqual(const std::vector<uint8_t>& atlasA, uint32_t brickA, const std::vector<uint8_t>& atlasB, uint32_t brickB)
+{
+    for (uint32_t z = 0; z < FFX_BRIXELIZER_BRICK_DIMENSION; ++z)
+    {
+        for (uint32_t y = 0; y < FFX_BRIXELIZER_BRICK_DIMENSION; ++y)
+        {
+            const size_t row = ((size_t)z * FFX_BRIXELIZER_STATIC_CONFIG_SDF_ATLAS_SIZE + y) * FFX_BRIXELIZER_STATIC_CONFIG_SDF_ATLAS_SIZE;
+            if (memcmp(&atlasA[cacheAtlasBrickOffset(brickA) + row], &atlasB[cacheAtlasBrickOffset(brickB) + row], FFX_BRIXELIZER_BRICK_DIMENSION) != 0)
+                return false;
+        }
+    }
+    return true;
+}
+
+static int s_cacheFailures = 0;
+
+static void cacheCheck(bool condition, const char* what)
+{
+    if (!condition)
+    {
+        printf("FAILED:      %s\n", what);
+        ++s_cacheFailures;
+    }
+}
+
+// Writes a synthetic cascade with a spherical shell of bricks to a cascade cache and restores it at different brick
+// indices, compares every restored brick and checks the invalidations against a changed instance set. Then feeds
+// the validation single byte corruptions, truncation and a version bump, all of which have to be rejected.
+int benchCache(int argc, char** argv)
+{
+    int instances   = 5000;
+    int corruptions = 1000;
+
+    for (int arg = 0; arg < argc; ++arg)
+    {
+        const char* value = nullptr;
+        if (benchParseOption(argv[arg], "-instances=", &value))
+            instances = atoi(value);
+        else if (benchParseOption(argv[arg], "-corruptions=", &value))
+            corruptions = atoi(value);
+        else
+        {
+            fprintf(stderr, "Unknown option \"%s\"!\n", argv[arg]);
+            return 1;
+        }
+    }
+
+    if (instances < 3 || corruptions < 0)
+    {
+        fprintf(stderr, "Invalid instance or corruption count!\n");
+        return 1;
+    }
+
+    const size_t atlasSize = (size_t)FFX_BRIXELIZER_STATIC_CONFIG_SDF_ATLAS_SIZE * FFX_BRIXELIZER_STATIC_CONFIG_SDF_ATLAS_SIZE * FFX_BRIXELIZER_STATIC_CONFIG_SDF_ATLAS_SIZE;
+    const uint32_t brickMapEntries = FFX_BRIXELIZER_CASCADE_RESOLUTION * FFX_BRIXELIZER_CASCADE_RESOLUTION * FFX_BRIXELIZER_CASCADE_RESOLUTION;
+
+    uint64_t              state = 88172645463325252ull;
+    std::vector<uint8_t>  atlas(atlasSize);
+    std::vector<uint32_t> brickMap(brickMapEntries);
+    std::vector<uint8_t>  aabbTree(FFX_BRIXELIZER_CASCADE_AABB_TREE_SIZE);
+    std::vector<uint32_t> brickAABBs(FFX_BRIXELIZER_MAX_BRICKS);
+    for (size_t i = 0; i < atlasSize; i += sizeof(uint32_t))
+    {
+        const uint32_t random = cacheRandom(&state);
+        memcpy(&atlas[i], &random, sizeof(random));
+    }
+    for (uint8_t& value : aabbTree)
+        value = (uint8_t)cacheRandom(&state);
+    for (uint32_t& value : brickAABBs)
+        value = cacheRandom(&state);
+
+    // Surface bricks at random distinct atlas bricks, the rest of the map either empty or never built
+    std::vector<uint32_t> atlasBricks(FFX_BRIXELIZER_MAX_BRICKS);
+    for (uint32_t i = 0; i < FFX_BRIXELIZER_MAX_BRICKS; ++i)
+        atlasBricks[i] = i;
+    for (uint32_t i = FFX_BRIXELIZER_MAX_BRICKS; i > 1; --i)
+        std::swap(atlasBricks[i - 1], atlasBricks[cacheRandom(&state) % i]);
+
+    uint32_t numBricks = 0;
+    for (uint32_t i = 0; i < brickMapEntries; ++i)
+    {
+        const int x = (int)(i % FFX_BRIXELIZER_CASCADE_RESOLUTION) - 32;
+        const int y = (int)(i / FFX_BRIXELIZER_CASCADE_RESOLUTION % FFX_BRIXELIZER_CASCADE_RESOLUTION) - 32;
+        const int z = (int)(i / FFX_BRIXELIZER_CASCADE_RESOLUTION / FFX_BRIXELIZER_CASCADE_RESOLUTION) - 32;
+        const int distance = x * x + y * y + z * z;
+        if (distance > 400 && distance < 500)
+            brickMap[i] = atlasBricks[numBricks++];
+        else
+            brickMap[i] = cacheRandom(&state) & 1 ? FFX_BRIXELIZER_UNINITIALIZED_ID : FFX_BRIXELIZER_INVALID_ID;
+    }
+
+    std::vector<FfxBrixelizerCascadeCacheInstance> cacheInstances(instances);
+    for (int i = 0; i < instances; ++i)
+    {
+        FfxBrixelizerRawInstanceDescription desc = {};
+        desc.aabbMin[0]    = (float)i;
+        desc.aabbMax[0]    = (float)i + 1.0f;
+        desc.triangleCount = i;
+        desc.vertexBuffer  = cacheRandom(&state);
+
+        cacheInstances[i].hash = brixelizerGetInstanceHash(&desc);
+        memcpy(cacheInstances[i].aabbMin, desc.aabbMin, sizeof(desc.aabbMin));
+        memcpy(cacheInstances[i].aabbMax, desc.aabbMax, sizeof(desc.aabbMax));
+    }
+
+    FfxBrixelizerCascadeCacheDescription cacheDesc = {};
+    cacheDesc.voxelSize        = 0.4f;
+    cacheDesc.clipmapOffset[0] = -3;
+    cacheDesc.clipmapOffset[1] = 7;
+    cacheDesc.clipmapOffset[2] = 100;
+    cacheDesc.instances        = cacheInstances.data();
+    cacheDesc.numInstances     = instances;
+    cacheDesc.resourceData     = { brickMap.data(), aabbTree.data(), brickAABBs.data(), atlas.data() };
+
+    size_t cacheSize = 0;
+    if (brixelizerCascadeCacheGetSize(&cacheDesc, &cacheSize) != FFX_OK)
+    {
+        fprintf(stderr, "Cannot size the cascade cache!\n");
+        return 1;
+    }
+
+    std::vector<uint64_t> cacheStorage((cacheSize + sizeof(uint64_t) - 1) / sizeof(uint64_t));
+    void*                 cache = cacheStorage.data();
+    cacheCheck(brixelizerCascadeCacheWrite(&cacheDesc, cache, cacheSize - 1) == (FfxErrorCode)FFX_ERROR_INSUFFICIENT_MEMORY, "write into a too small cache");
+
+    auto writeStart = std::chrono::steady_clock::now();
+    const bool written = brixelizerCascadeCacheWrite(&cacheDesc, cache, cacheSize) == FFX_OK;
+    const double writeMs = benchElapsedMs(writeStart);
+
+    FfxBrixelizerCascadeCacheInfo info = {};
+    auto validateStart = std::chrono::steady_clock::now();
+    const bool valid = written && brixelizerCascadeCacheValidate(cache, cacheSize, &info) == FFX_OK;
+    const double validateMs = benchElapsedMs(validateStart);
+    if (!valid)
+    {
+        fprintf(stderr, "Cannot write and validate the cascade cache!\n");
+        return 1;
+    }
+
+    cacheCheck(info.numBricks == numBricks && info.numInstances == (uint32_t)instances, "brick and instance counts");
+    cacheCheck(info.key.voxelSize == cacheDesc.voxelSize && memcmp(info.key.clipmapOffset, cacheDesc.clipmapOffset, sizeof(cacheDesc.clipmapOffset)) == 0, "key");
+    cacheCheck(info.key.instanceSetHash == brixelizerGetInstanceSetHash(cacheInstances.data(), instances), "instance set hash");
+
+    std::vector<FfxBrixelizerCascadeCacheInstance> shuffled = cacheInstances;
+    std::swap(shuffled.front(), shuffled.back());
+    cacheCheck(brixelizerGetInstanceSetHash(shuffled.data(), instances) == info.key.instanceSetHash, "instance set hash independent of order");
+    cacheCheck(brixelizerGetInstanceSetHash(shuffled.data(), instances - 1) != info.key.instanceSetHash, "instance set hash of fewer instances");
+
+    // Restore in reverse order, so no brick lands where it was
+    std::vector<uint8_t>  restoredAtlas(atlasSize);
+    std::vector<uint32_t> restoredBrickMap(brickMapEntries);
+    std::vector<uint8_t>  restoredAABBTree(FFX_BRIXELIZER_CASCADE_AABB_TREE_SIZE);
+    std::vector<uint32_t> restoredBrickAABBs(FFX_BRIXELIZER_MAX_BRICKS);
+    std::vector<uint32_t> brickIndices(numBricks);
+    for (uint32_t i = 0; i < numBricks; ++i)
+        brickIndices[i] = numBricks - 1 - i;
+
+    const FfxBrixelizerCascadeCacheResourceData restored = { restoredBrickMap.data(), restoredAABBTree.data(), restoredBrickAABBs.data(), restoredAtlas.data() };
+    auto readStart = std::chrono::steady_clock::now();
+    cacheCheck(brixelizerCascadeCacheRead(cache, cacheSize, brickIndices.data(), &restored) == FFX_OK, "read");
+    const double readMs = benchElapsedMs(readStart);
+
+    uint32_t restoredBricks = 0;
+    bool     same           = restoredAABBTree == aabbTree;
+    for (uint32_t i = 0; i < brickMapEntries && same; ++i)
+    {
+        const uint32_t brick        = brickMap[i];
+        const uint32_t restoredBrick = restoredBrickMap[i];
+        if ((brick & FFX_BRIXELIZER_BRICK_ID_MASK) == FFX_BRIXELIZER_INVALID_ID)
+        {
+            same = brick == restoredBrick;
+            continue;
+        }
+        same = brickAABBs[brick] == restoredBrickAABBs[restoredBrick] && cacheBricksEqual(atlas, brick, restoredAtlas, restoredBrick);
+        ++restoredBricks;
+    }
+    cacheCheck(same && restoredBricks == numBricks, "restored bricks, brick map and AABB tree");
+
+    brickIndices[0] = FFX_BRIXELIZER_MAX_BRICKS;
+    cacheCheck(brixelizerCascadeCacheRead(cache, cacheSize, brickIndices.data(), &restored) == (FfxErrorCode)FFX_ERROR_OUT_OF_RANGE, "read to a brick out of range");
+
+    // Three instances removed and two added since the cache was written
+    std::vector<FfxBrixelizerCascadeCacheInstance> currentInstances(cacheInstances.begin() + 3, cacheInstances.end());
+    for (uint32_t i = 0; i < 2; ++i)
+    {
+        FfxBrixelizerCascadeCacheInstance instance = {};
+        instance.hash       = 1234567 + i;
+        instance.aabbMin[1] = 50.0f;
+        instance.aabbMax[1] = 60.0f;
+        currentInstances.push_back(instance);
+    }
+
+    uint32_t numJobs = 0;
+    cacheCheck(brixelizerCascadeCacheGetInvalidations(cache, cacheSize, currentInstances.data(), (uint32_t)currentInstances.size(), nullptr, 0, &numJobs) == (FfxErrorCode)FFX_ERROR_INSUFFICIENT_MEMORY && numJobs == 5,
+               "invalidation count");
+
+    std::vector<FfxBrixelizerRawJobDescription> jobs(numJobs);
+    uint32_t removed = 0;
+    uint32_t added   = 0;
+    if (brixelizerCascadeCacheGetInvalidations(cache, cacheSize, currentInstances.data(), (uint32_t)currentInstances.size(), jobs.data(), numJobs, &numJobs) == FFX_OK)
+    {
+        for (const FfxBrixelizerRawJobDescription& job : jobs)
+        {
+            if (job.flags == FFX_BRIXELIZER_RAW_JOB_FLAG_INVALIDATE && job.aabbMax[1] == 60.0f)
+                ++added;
+            else if (job.flags == FFX_BRIXELIZER_RAW_JOB_FLAG_INVALIDATE && job.aabbMax[0] <= 3.0f)
+                ++removed;
+        }
+    }
+    cacheCheck(removed == 3 && added == 2, "invalidations of removed and added instances");
+    cacheCheck(brixelizerCascadeCacheGetInvalidations(cache, cacheSize, cacheInstances.data(), instances, nullptr, 0, &numJobs) == FFX_OK && numJobs == 0, "no invalidations for the same instances");
+
+    int accepted = 0;
+    for (int i = 0; i < corruptions; ++i)
+    {
+        uint8_t*      byte  = (uint8_t*)cache + (((uint64_t)cacheRandom(&state) << 32 | cacheRandom(&state)) % cacheSize);
+        const uint8_t value = *byte;
+        *byte ^= (uint8_t)(1 + cacheRandom(&state) % 255);
+        accepted += brixelizerCascadeCacheValidate(cache, cacheSize, &info) == FFX_OK ? 1 : 0;
+        *byte = value;
+    }
+    cacheCheck(accepted == 0, "corrupted caches rejected");
+    cacheCheck(brixelizerCascadeCacheValidate(cache, cacheSize - 4, &info) == (FfxErrorCode)FFX_ERROR_MALFORMED_DATA, "truncated cache rejected");
+    cacheCheck(brixelizerCascadeCacheValidate((uint8_t*)cache + 4, cacheSize - 4, &info) == (FfxErrorCode)FFX_ERROR_INVALID_ALIGNMENT, "misaligned cache rejected");
+    ((FfxBrixelizerCascadeCacheHeader*)cache)->version++;
+    cacheCheck(brixelizerCascadeCacheValidate(cache, cacheSize, &info) == (FfxErrorCode)FFX_ERROR_INVALID_VERSION, "newer version rejected");
+
+    printf("Cascade:     %u bricks, %d instances\n", numBricks, instances);
+    printf("Cache:       %.2f MB, atlas and brick map %.0f MB\n", cacheSize / 1048576.0, (atlasSize + brickMapEntries * sizeof(uint32_t)) / 1048576.0);
+    printf("Timings:     write %.2f ms, validate %.2f ms, read %.2f ms\n", writeMs, validateMs, readMs);
+    printf("Corrupted:   %d of %d accepted\n", accepted, corruptions);
+    return s_cacheFailures == 0 ? 0 : 1;
+}
@@ -0,0 +1,214 @@
+// This file is part of the FidelityFX SDK.
+//
+// Copyright (C) 2024 Advanced Micro Devices, Inc.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+
+// CPU benchmarks of the Brixelizer context, runs it on a stand-in for the raw context so the numbers quoted in
+// changes to the library can be reproduced without a GPU.
+//
+// Usage: FidelityFX_BrixelizerBench <benchmark> [options]
+//
+// Benchmarks:
+//   bake       time ffxBrixelizerBakeUpdate over a city of static instances and check its instance jobs against a linear scan
+//   cache      write a synthetic cascade to a cascade cache, restore it at other bricks and feed validation corrupted copies
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include <FidelityFX/host/ffx_brixelizer_raw.h>
+
+#include "ffx_brixelizer_bench.h"
+
+// Stand-in for the raw context, the Brixelizer context only needs instance IDs back from it
+static std::vector<FfxBrixelizerInstanceID>        s_freeInstanceIDs;
+static FfxBrixelizerRawCascadeUpdateDescription    s_staticCascadeUpdate;
+static std::vector<FfxBrixelizerRawJobDescription> s_staticJobs;
+
+const FfxBrixelizerRawCascadeUpdateDescription& benchGetStaticCascadeUpdate()
+{
+    return s_staticCascadeUpdate;
+}
+
+const std::vector<FfxBrixelizerRawJobDescription>& benchGetStaticJobs()
+{
+    return s_staticJobs;
+}
+
+FfxErrorCode ffxBrixelizerRawContextCreate(FfxBrixelizerRawContext* context, const FfxBrixelizerRawContextDescription* contextDescription)
+{
+    s_freeInstanceIDs.clear();
+    for (uint32_t i = FFX_BRIXELIZER_MAX_INSTANCES; i-- > 0;)
+        s_freeInstanceIDs.push_back(i);
+    return FFX_OK;
+}
+
+FfxErrorCode ffxBrixelizerRawContextDestroy(FfxBrixelizerRawContext* context)
+{
+    return FFX_OK;
+}
+
+FfxErrorCode ffxBrixelizerRawContextGetInfo(FfxBrixelizerRawContext* context, FfxBrixelizerContextInfo* contextInfo)
+{
+    *contextInfo = {};
+    return FFX_OK;
+}
+
+FfxErrorCode ffxBrixelizerRawContextCreateCascade(FfxBrixelizerRawContext* context, const FfxBrixelizerRawCascadeDescription* cascadeDescription)
+{
+    return FFX_OK;
+}
+
+FfxErrorCode ffxBrixelizerRawContextBegin(FfxBrixelizerRawContext* context, FfxBrixelizerResources resources)
+{
+    return FFX_OK;
+}
+
+FfxErrorCode ffxBrixelizerRawContextEnd(FfxBrixelizerRawContext* context)
+{
+    return FFX_OK;
+}
+
+FfxErrorCode ffxBrixelizerRawContextSubmit(FfxBrixelizerRawContext* context, FfxCommandList cmdList)
+{
+    return FFX_OK;
+}
+
+FfxErrorCode ffxBrixelizerRawContextGetScratchMemorySize(FfxBrixelizerRawContext* context, const FfxBrixelizerRawCascadeUpdateDescription* cascadeUpdateDescription, size_t* size)
+{
+    if (!(cascadeUpdateDescription->flags & FFX_BRIXELIZER_CASCADE_UPDATE_FLAG_RESET))
+    {
+        s_staticCascadeUpdate = *cascadeUpdateDescription;
+        s_staticJobs.assign(cascadeUpdateDescription->jobs, cascadeUpdateDescription->jobs + cascadeUpdateDescription->numJobs);
+    }
+    *size = 0;
+    return FFX_OK;
+}
+
+FfxErrorCode ffxBrixelizerRawContextUpdateCascade(FfxBrixelizerRawContext* context, const FfxBrixelizerRawCascadeUpdateDescription* cascadeUpdateDescription)
+{
+    return FFX_OK;
+}
+
+FfxErrorCode ffxBrixelizerRawContextMergeCascades(FfxBrixelizerRawContext* context, uint32_t src_cascade_A_idx, uint32_t src_cascade_B_idx, uint32_t dst_cascade_idx)
+{
+    return FFX_OK;
+}
+
+FfxErrorCode ffxBrixelizerRawContextBuildAABBTree(FfxBrixelizerRawContext* context, uint32_t cascadeIndex)
+{
+    return FFX_OK;
+}
+
+FfxErrorCode ffxBrixelizerRawContextDebugVisualization(FfxBrixelizerRawContext* context, const FfxBrixelizerDebugVisualizationDescription* debugVisualizationDescription)
+{
+    return FFX_OK;
+}
+
+FfxErrorCode ffxBrixelizerRawContextGetDebugCounters(FfxBrixelizerRawContext* context, FfxBrixelizerDebugCounters* debugCounters)
+{
+    return FFX_OK;
+}
+
+FfxErrorCode ffxBrixelizerRawContextGetCascadeCounters(FfxBrixelizerRawContext* context, uint32_t cascadeIndex, FfxBrixelizerScratchCounters* counters)
+{
+    return FFX_OK;
+}
+
+FfxErrorCode ffxBrixelizerRawContextCreateInstances(FfxBrixelizerRawContext* context, const FfxBrixelizerRawInstanceDescription* instanceDescriptions, uint32_t numInstanceDescriptions)
+{
+    if (numInstanceDescriptions > s_freeInstanceIDs.size())
+        return FFX_ERROR_OUT_OF_RANGE;
+
+    for (uint32_t i = 0; i < numInstanceDescriptions; ++i)
+    {
+        *instanceDescriptions[i].outInstanceID = s_freeInstanceIDs.back();
+        s_freeInstanceIDs.pop_back();
+    }
+    return FFX_OK;
+}
+
+FfxErrorCode ffxBrixelizerRawContextDestroyInstances(FfxBrixelizerRawContext* context, const FfxBrixelizerInstanceID* instanceIDs, uint32_t numInstanceIDs)
+{
+    s_freeInstanceIDs.insert(s_freeInstanceIDs.end(), instanceIDs, instanceIDs + numInstanceIDs);
+    return FFX_OK;
+}
+
+FfxErrorCode ffxBrixelizerRawContextFlushInstances(FfxBrixelizerRawContext* context, FfxCommandList cmdList)
+{
+    return FFX_OK;
+}
+
+FfxErrorCode ffxBrixelizerRawContextRegisterBuffers(FfxBrixelizerRawContext* context, const FfxBrixelizerBufferDescription* bufferDescs, uint32_t numBufferDescs)
+{
+    return FFX_OK;
+}
+
+FfxErrorCode ffxBrixelizerRawContextUnregisterBuffers(FfxBrixelizerRawContext* context, const uint32_t* indices, uint32_t numIndices)
+{
+    return FFX_OK;
+}
+
+FfxErrorCode ffxBrixelizerRawContextRegisterScratchBuffer(FfxBrixelizerRawContext* context, FfxResource scratchBuffer)
+{
+    return FFX_OK;
+}
+
+// Same schedule as the raw context, the first cascade is updated every other frame
+uint32_t ffxBrixelizerRawGetCascadeToUpdate(uint32_t frameIndex, uint32_t maxCascades)
+{
+    uint32_t n = frameIndex & ((1 << maxCascades) - 1);
+    n = n - (n & (n - 1));
+    if (n == 0)
+        n = 1 << (maxCascades - 1);
+    return (uint32_t)log2(double(n));
+}
+
+struct Benchmark
+{
+    const char* name;
+    const char* options;
+    BenchFunc   func;
+};
+
+static const Benchmark s_benchmarks[] =
+{
+    { "bake",  "-instances=<n> -city=<meters> -frames=<n> -churn=<n>", benchBake },
+    { "cache", "-instances=<n> -corruptions=<n>", benchCache },
+};
+
+int main(int argc, char** argv)
+{
+    if (argc >= 2)
+    {
+        for (const Benchmark& benchmark : s_benchmarks)
+        {
+            if (strcmp(argv[1], benchmark.name) == 0)
+                return benchmark.func(argc - 2, argv + 2);
+        }
+    }
+
+    fprintf(stderr, "Usage: %s <benchmark> [options]\n", argv[0]);
+    for (const Benchmark& benchmark : s_benchmarks)
+        fprintf(stderr, "       %s %s %s\n", argv[0], benchmark.name, benchmark.options);
+    return 1;
+}
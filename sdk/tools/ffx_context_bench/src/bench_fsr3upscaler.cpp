@@ -0,0 +1,147 @@
+// This file is part of the FidelityFX SDK.
+//
+// Copyright (C) 2024 Advanced Micro Devices, Inc.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+
+
+#include <cstdio>
+
+#include <FidelityFX/host/ffx_fsr3upscaler.h>
+
+#include "ffx_context_bench.h"
+
+// Bind points of the FSR3 upscaler shaders
+static const BenchShaderBindings s_fsr3UpscalerBindings =
+{
+    {
+        "r_input_color_jittered", "r_input_opaque_only", "r_input_motion_vectors", "r_input_depth", "r_input_exposure",
+        "r_frame_info", "r_reactive_mask", "r_transparency_and_composition_mask", "r_reconstructed_previous_nearest_depth",
+        "r_dilated_motion_vectors", "r_dilated_depth", "r_internal_upscaled_color", "r_accumulation", "r_luma_history",
+        "r_rcas_input", "r_lanczos_lut", "r_spd_mips", "r_dilated_reactive_masks", "r_new_locks", "r_farthest_depth",
+        "r_farthest_depth_mip1", "r_shading_change", "r_current_luma", "r_previous_luma", "r_luma_instability",
+    },
+    {
+        "rw_reconstructed_previous_nearest_depth", "rw_dilated_motion_vectors", "rw_dilated_depth", "rw_internal_upscaled_color",
+        "rw_accumulation", "rw_luma_history", "rw_upscaled_output", "rw_dilated_reactive_masks", "rw_frame_info",
+        "rw_spd_global_atomic", "rw_new_locks", "rw_output_autoreactive", "rw_shading_change", "rw_farthest_depth",
+        "rw_farthest_depth_mip1", "rw_current_luma", "rw_luma_instability", "rw_spd_mip0", "rw_spd_mip1", "rw_spd_mip2",
+        "rw_spd_mip3", "rw_spd_mip4", "rw_spd_mip5",
+    },
+    {
+        "cbFSR3Upscaler", "cbSPD", "cbRCAS", "cbGenerateReactive",
+    },
+};
+
+static FfxErrorCode fsr3UpscalerCreateDestroy(FfxFsr3UpscalerContext* context, bool nameHashes, bool keepPipelines)
+{
+    FfxFsr3UpscalerContextDescription contextDescription = {};
+    contextDescription.flags          = FFX_FSR3UPSCALER_ENABLE_HIGH_DYNAMIC_RANGE | FFX_FSR3UPSCALER_ENABLE_DEPTH_INVERTED;
+    contextDescription.maxRenderSize  = { 2560, 1440 };
+    contextDescription.maxUpscaleSize = { 3840, 2160 };
+    benchGetInterface(&contextDescription.backendInterface, &s_fsr3UpscalerBindings, nameHashes, keepPipelines);
+
+    FfxErrorCode errorCode = ffxFsr3UpscalerContextCreate(context, &contextDescription);
+    if (errorCode != FFX_OK)
+        return errorCode;
+
+    return ffxFsr3UpscalerContextDestroy(context);
+}
+
+static bool fsr3UpscalerBindingsEqual(const FfxResourceBinding* bindingsA, const FfxResourceBinding* bindingsB, uint32_t count)
+{
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        if (bindingsA[i].resourceIdentifier != bindingsB[i].resourceIdentifier)
+            return false;
+    }
+    return true;
+}
+
+// Creates and destroys FSR3 upscaler contexts on the stand-in backend, once with the bind point name hashes a backend
+// takes from the shader blobs and once without, so the effect resolves the bindings of every pipeline by name. Both
+// have to resolve every binding to the same resource identifier.
+int benchFsr3Upscaler(int argc, char** argv)
+{
+    int iterations = 2000;
+
+    for (int arg = 0; arg < argc; ++arg)
+    {
+        const char* value = nullptr;
+        if (benchParseOption(argv[arg], "-iterations=", &value))
+            iterations = std::max(1, atoi(value));
+        else
+        {
+            fprintf(stderr, "Unknown option \"%s\"!\n", argv[arg]);
+            return 1;
+        }
+    }
+
+    // The context holds every pipeline state of the effect, too large for the stack
+    std::vector<FfxFsr3UpscalerContext> context(1);
+
+    std::vector<FfxPipelineState> pipelines[2];
+    for (int nameHashes = 0; nameHashes < 2; ++nameHashes)
+    {
+        const FfxErrorCode errorCode = fsr3UpscalerCreateDestroy(&context[0], nameHashes != 0, true);
+        if (errorCode != FFX_OK)
+        {
+            printf("FAILED:      context creation %s name hashes returned %d\n", nameHashes ? "with" : "without", errorCode);
+            return 1;
+        }
+        pipelines[nameHashes] = benchTakeDestroyedPipelines();
+    }
+
+    bool bindingsEqual = pipelines[0].size() == pipelines[1].size();
+    for (size_t i = 0; bindingsEqual && i < pipelines[0].size(); ++i)
+    {
+        const FfxPipelineState& pipelineA = pipelines[0][i];
+        const FfxPipelineState& pipelineB = pipelines[1][i];
+        bindingsEqual = fsr3UpscalerBindingsEqual(pipelineA.srvTextureBindings, pipelineB.srvTextureBindings, pipelineA.srvTextureCount) &&
+                        fsr3UpscalerBindingsEqual(pipelineA.uavTextureBindings, pipelineB.uavTextureBindings, pipelineA.uavTextureCount) &&
+                        fsr3UpscalerBindingsEqual(pipelineA.constantBufferBindings, pipelineB.constantBufferBindings, pipelineA.constCount);
+    }
+
+    printf("Pipelines:   %u\n", uint32_t(pipelines[0].size()));
+    printf("Bindings:    %s\n", bindingsEqual ? "identical with and without name hashes" : "MISMATCH");
+    if (!bindingsEqual)
+        return 1;
+
+    for (int nameHashes = 1; nameHashes >= 0; --nameHashes)
+    {
+        std::vector<double> timesMs;
+        timesMs.reserve(iterations);
+        for (int iteration = 0; iteration < iterations; ++iteration)
+        {
+            const auto start = std::chrono::steady_clock::now();
+            fsr3UpscalerCreateDestroy(&context[0], nameHashes != 0, false);
+            timesMs.push_back(benchElapsedMs(start));
+        }
+
+        double totalMs = 0.0;
+        for (double timeMs : timesMs)
+            totalMs += timeMs;
+
+        printf("%-12s create/destroy mean %.2f us, p50 %.2f us, p99 %.2f us\n", nameHashes ? "Hashes:" : "Names:",
+            1000.0 * totalMs / iterations, 1000.0 * benchPercentile(timesMs, 0.5), 1000.0 * benchPercentile(timesMs, 0.99));
+    }
+
+    return 0;
+}
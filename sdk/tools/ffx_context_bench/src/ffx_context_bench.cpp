@@ -0,0 +1,182 @@
+// This file is part of the FidelityFX SDK.
+//
+// Copyright (C) 2024 Advanced Micro Devices, Inc.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+
+
+// CPU benchmarks of effect context creation, runs the effects on a stand-in backend so the numbers quoted in changes
+// to the effect libraries can be reproduced without a GPU.
+//
+// Usage: FidelityFX_ContextBench <benchmark> [options]
+//
+// Benchmarks:
+//   fsr3upscaler   time ffxFsr3UpscalerContextCreate/Destroy with and without bind point name hashes and check both resolve the same bindings
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include <ffx_resource_binding.h>
+
+#include "ffx_context_bench.h"
+
+// Bind points a pass of an effect binds at most, the stand-in backend reflects windows of this size
+static const size_t s_srvTexturesPerPass     = 12;
+static const size_t s_uavTexturesPerPass     = 8;
+static const size_t s_constantBuffersPerPass = 2;
+
+static const BenchShaderBindings*    s_bindings      = nullptr;
+static bool                          s_nameHashes    = false;
+static bool                          s_keepPipelines = false;
+static uint32_t                      s_nextResource  = 0;
+static std::vector<FfxPipelineState> s_destroyedPipelines;
+
+std::vector<FfxPipelineState> benchTakeDestroyedPipelines()
+{
+    std::vector<FfxPipelineState> pipelines;
+    pipelines.swap(s_destroyedPipelines);
+    return pipelines;
+}
+
+// Fills a binding the way the backends do from the reflection data of a shader blob
+static void benchSetBinding(FfxResourceBinding* binding, uint32_t slotIndex, const char* name)
+{
+    binding->slotIndex          = slotIndex;
+    binding->arrayIndex         = 0;
+    binding->resourceIdentifier = s_nameHashes ? ffxGetResourceBindingNameHash(name) : 0;
+
+    size_t length = 0;
+    for (; length + 1 < FFX_RESOURCE_NAME_SIZE && name[length]; ++length)
+        binding->name[length] = wchar_t(name[length]);
+    binding->name[length] = 0;
+}
+
+static uint32_t benchSetBindings(FfxResourceBinding* bindings, const std::vector<const char*>& names, size_t perPass, FfxPass pass)
+{
+    const size_t count = std::min(names.size(), perPass);
+    for (size_t i = 0; i < count; ++i)
+        benchSetBinding(&bindings[i], uint32_t(i), names[(pass * perPass + i) % names.size()]);
+    return uint32_t(count);
+}
+
+static FfxVersionNumber benchGetSDKVersion(FfxInterface* backendInterface)
+{
+    return FFX_SDK_MAKE_VERSION(FFX_SDK_VERSION_MAJOR, FFX_SDK_VERSION_MINOR, FFX_SDK_VERSION_PATCH);
+}
+
+static FfxErrorCode benchCreateBackendContext(FfxInterface* backendInterface, FfxEffect effect, FfxEffectBindlessConfig* bindlessConfig, FfxUInt32* effectContextId)
+{
+    *effectContextId = 0;
+    return FFX_OK;
+}
+
+static FfxErrorCode benchGetDeviceCapabilities(FfxInterface* backendInterface, FfxDeviceCapabilities* outDeviceCapabilities)
+{
+    *outDeviceCapabilities = {};
+    outDeviceCapabilities->maximumSupportedShaderModel = FFX_SHADER_MODEL_6_6;
+    outDeviceCapabilities->waveLaneCountMin            = 32;
+    outDeviceCapabilities->waveLaneCountMax            = 64;
+    outDeviceCapabilities->fp16Supported               = true;
+    return FFX_OK;
+}
+
+static FfxErrorCode benchDestroyBackendContext(FfxInterface* backendInterface, FfxUInt32 effectContextId)
+{
+    return FFX_OK;
+}
+
+static FfxErrorCode benchCreateResource(FfxInterface* backendInterface, const FfxCreateResourceDescription* createResourceDescription, FfxUInt32 effectContextId, FfxResourceInternal* outResource)
+{
+    // Resources with init data get a copy resource at the next index, as in the backends
+    outResource->internalIndex = int32_t(s_nextResource);
+    s_nextResource += createResourceDescription->initData.type != FFX_RESOURCE_INIT_DATA_TYPE_UNINITIALIZED ? 2 : 1;
+    return FFX_OK;
+}
+
+static FfxErrorCode benchDestroyResource(FfxInterface* backendInterface, FfxResourceInternal resource, FfxUInt32 effectContextId)
+{
+    return FFX_OK;
+}
+
+static FfxErrorCode benchCreatePipeline(FfxInterface* backendInterface, FfxEffect effect, FfxPass pass, uint32_t permutationOptions, const FfxPipelineDescription* pipelineDescription, FfxUInt32 effectContextId, FfxPipelineState* outPipeline)
+{
+    // The effect expects the pipeline as it was before, only the bindings are filled in
+    outPipeline->passId          = pass;
+    outPipeline->srvTextureCount = benchSetBindings(outPipeline->srvTextureBindings, s_bindings->srvTextures, s_srvTexturesPerPass, pass);
+    outPipeline->uavTextureCount = benchSetBindings(outPipeline->uavTextureBindings, s_bindings->uavTextures, s_uavTexturesPerPass, pass);
+    outPipeline->constCount      = benchSetBindings(outPipeline->constantBufferBindings, s_bindings->constantBuffers, s_constantBuffersPerPass, pass);
+    return FFX_OK;
+}
+
+static FfxErrorCode benchDestroyPipeline(FfxInterface* backendInterface, FfxPipelineState* pipeline, FfxUInt32 effectContextId)
+{
+    if (s_keepPipelines)
+        s_destroyedPipelines.push_back(*pipeline);
+    return FFX_OK;
+}
+
+void benchGetInterface(FfxInterface* backendInterface, const BenchShaderBindings* bindings, bool nameHashes, bool keepPipelines)
+{
+    s_bindings      = bindings;
+    s_nameHashes    = nameHashes;
+    s_keepPipelines = keepPipelines;
+    s_nextResource  = 0;
+    s_destroyedPipelines.clear();
+
+    *backendInterface = {};
+    backendInterface->fpGetSDKVersion           = benchGetSDKVersion;
+    backendInterface->fpCreateBackendContext    = benchCreateBackendContext;
+    backendInterface->fpGetDeviceCapabilities   = benchGetDeviceCapabilities;
+    backendInterface->fpDestroyBackendContext   = benchDestroyBackendContext;
+    backendInterface->fpCreateResource          = benchCreateResource;
+    backendInterface->fpDestroyResource         = benchDestroyResource;
+    backendInterface->fpCreatePipeline          = benchCreatePipeline;
+    backendInterface->fpDestroyPipeline         = benchDestroyPipeline;
+}
+
+struct Benchmark
+{
+    const char* name;
+    const char* options;
+    BenchFunc   func;
+};
+
+static const Benchmark s_benchmarks[] =
+{
+    { "fsr3upscaler", "-iterations=<n>", benchFsr3Upscaler },
+};
+
+int main(int argc, char** argv)
+{
+    if (argc >= 2)
+    {
+        for (const Benchmark& benchmark : s_benchmarks)
+        {
+            if (strcmp(argv[1], benchmark.name) == 0)
+                return benchmark.func(argc - 2, argv + 2);
+        }
+    }
+
+    fprintf(stderr, "Usage: %s <benchmark> [options]\n", argv[0]);
+    for (const Benchmark& benchmark : s_benchmarks)
+        fprintf(stderr, "       %s %s %s\n", argv[0], benchmark.name, benchmark.options);
+    return 1;
+}
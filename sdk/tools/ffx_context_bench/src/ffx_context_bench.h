@@ -0,0 +1,81 @@
+// This file is part of the FidelityFX SDK.
+//
+// Copyright (C) 2024 Advanced Micro Devices, Inc.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include <FidelityFX/host/ffx_interface.h>
+
+// Every benchmark parses its own options from argv and returns the process exit code
+typedef int (*BenchFunc)(int argc, char** argv);
+
+int benchFsr3Upscaler(int argc, char** argv);
+
+// Bind points the stand-in backend reflects for every pipeline it creates, names as a shader compiler reports them
+struct BenchShaderBindings
+{
+    std::vector<const char*> srvTextures;
+    std::vector<const char*> uavTextures;
+    std::vector<const char*> constantBuffers;
+};
+
+// Sets up a backend interface that creates pipelines and resources without a device. Every pipeline gets a rotating
+// window of the bind points, as many as a pass of the effect binds. With nameHashes the bindings carry the bind point
+// name hash like a backend loading shader blobs of FidelityFX_SC with hashes, otherwise the effect has to resolve
+// them by name. With keepPipelines every pipeline is copied when the effect destroys it, after it patched the bindings.
+void benchGetInterface(FfxInterface* backendInterface, const BenchShaderBindings* bindings, bool nameHashes, bool keepPipelines);
+
+// Pipelines kept since the last call, in order of destruction
+std::vector<FfxPipelineState> benchTakeDestroyedPipelines();
+
+// Matches "-name=" options, value points behind the '='
+inline bool benchParseOption(const char* arg, const char* name, const char** value)
+{
+    const size_t length = strlen(name);
+    if (strncmp(arg, name, length) != 0)
+        return false;
+
+    *value = arg + length;
+    return true;
+}
+
+inline double benchPercentile(std::vector<double> values, double percentile)
+{
+    if (values.empty())
+        return 0.0;
+
+    std::sort(values.begin(), values.end());
+    const size_t index = std::min(values.size() - 1, (size_t)(percentile * (values.size() - 1) + 0.5));
+    return values[index];
+}
+
+inline double benchElapsedMs(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
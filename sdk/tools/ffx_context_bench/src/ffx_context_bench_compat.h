@@ -0,0 +1,58 @@
+// This file is part of the FidelityFX SDK.
+//
+// Copyright (C) 2024 Advanced Micro Devices, Inc.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+
+
+#pragma once
+
+// Force included into every source when not building with MSVC. The effects are built with a 2 byte wchar_t there as
+// on Windows, which the wide string functions of the C library don't handle, and use the secure CRT of MSVC.
+
+#include <cstddef>
+#include <cwchar>
+#include <wchar.h>
+
+#define _countof(array) (sizeof(array) / sizeof((array)[0]))
+
+inline int benchWcscmp(const wchar_t* first, const wchar_t* second)
+{
+    while (*first && *first == *second)
+    {
+        ++first;
+        ++second;
+    }
+
+    return int(*first) - int(*second);
+}
+
+#define wcscmp benchWcscmp
+
+template<size_t Size>
+int wcscpy_s(wchar_t (&destination)[Size], const wchar_t* source)
+{
+    size_t length = 0;
+    for (; length + 1 < Size && source[length]; ++length)
+        destination[length] = source[length];
+
+    destination[length] = 0;
+    return 0;
+}
@@ -0,0 +1,637 @@
+// This file is part of the FidelityFX SDK.
+//
+// Copyright (C) 2024 Advanced Micro Devices, Inc.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+// Replays game frame times through the frame pacing of the frame interpolation swapchains on a simulated clock and
+// reports how evenly the interpolated and real frames would have been presented.
+//
+// Usage: FidelityFX_FramePacingSim [options] <trace>
+//        FidelityFX_FramePacingSim [options] -synthetic=<fps>[,<jitter %>[,<frames>]]
+//        FidelityFX_FramePacingSim -measure-wait=<us>[,<count>]
+//        FidelityFX_FramePacingSim -bench-statistics[=<updates>]
+//
+// A trace holds one frame time in milliseconds per line, or is a PresentMon CSV capture of the game without frame
+// generation, read from the MsBetweenPresents column or the one given with -column=<name>.
+//
+// -measure-wait doesn't simulate anything, it measures how late the presenter's wait returns on this machine,
+// both sleeping and spinning, and how much CPU time it takes.
+//
+// -bench-statistics checks the frame time statistics of the pacer against recomputing them over the whole window, with
+// resets and repeated values in between, then times an update and query per frame against that recomputation.
+//
+// Options:
+//   -safety-margin=<ms>     FfxSwapchainFramePacingTuning::safetyMarginInMs, default 0.1
+//   -variance-factor=<f>    FfxSwapchainFramePacingTuning::varianceFactor, default 0.1
+//   -percentile=<p>         pace on this frame time percentile instead of average and variance, e.g. 0.1
+//   -wake-jitter=<ms>       late wake-up of the presenter, uniformly distributed up to the given time
+//   -refresh=<Hz>           show presents on the next free vblank with two presents queued at most, presents show
+//                           immediately without it
+//   -warmup=<frames>        game frames left out of the statistics, default 10 to fill the pacing history
+//   -hitch=<every>,<ms>     replace every n-th frame time of a synthetic trace with a hitch
+//   -seed=<n>               seed of the synthetic trace and wake jitter
+//   -dump=<file>            write every present as CSV for plotting
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <random>
+#include <vector>
+
+#include <ffx_frameinterpolation_pacing.h>
+#include <ffx_precise_wait.h>
+
+// matches PacingData::FrameType of the swapchains
+enum SimFrameType
+{
+    SIM_FRAME_INTERPOLATED,
+    SIM_FRAME_REAL,
+    SIM_FRAME_COUNT
+};
+
+struct SimPresent
+{
+    uint32_t gameFrame;
+    uint32_t frameType;
+    int64_t  presentTicks;
+    int64_t  displayTicks;
+    double   contentTicks;
+};
+
+struct SimPresentSink : public FrameInterpolationPresentSink
+{
+    static const size_t MAX_QUEUED_PRESENTS = 2;
+
+    FrameInterpolationSimulatedClock* clock;
+    std::vector<SimPresent>*          presents;
+    uint32_t                          gameFrame;
+    int64_t                           refreshTicks;
+
+    void present(uint32_t frameType) override
+    {
+        SimPresent present   = {};
+        present.gameFrame    = gameFrame;
+        present.frameType    = frameType;
+        present.presentTicks = clock->getTicks();
+        present.displayTicks = present.presentTicks;
+
+        if (refreshTicks > 0)
+        {
+            // Present blocks while the flip queue is full
+            const size_t count = presents->size();
+            if (count >= MAX_QUEUED_PRESENTS)
+                clock->waitForTicks((*presents)[count - MAX_QUEUED_PRESENTS].displayTicks);
+
+            const int64_t vblank = (clock->getTicks() + refreshTicks - 1) / refreshTicks * refreshTicks;
+            present.displayTicks = count > 0 ? std::max(vblank, presents->back().displayTicks + refreshTicks) : vblank;
+        }
+
+        presents->push_back(present);
+    }
+};
+
+static bool simParseOption(const char* arg, const char* name, const char** value)
+{
+    const size_t length = strlen(name);
+    if (strncmp(arg, name, length) != 0)
+        return false;
+
+    *value = arg + length;
+    return true;
+}
+
+static bool simReadTrace(const char* path, const char* column, std::vector<double>& frameTimes)
+{
+    FILE* file = fopen(path, "r");
+    if (file == nullptr)
+        return false;
+
+    // -1 for plain traces, otherwise the index of the column in every CSV line
+    int  columnIndex = -1;
+    bool firstLine   = true;
+    char line[4096];
+    while (fgets(line, sizeof(line), file))
+    {
+        if (line[0] == '#' || line[0] == '\n' || line[0] == '\r')
+            continue;
+
+        if (firstLine && strchr(line, ','))
+        {
+            // CSV header
+            int index = 0;
+            for (char* name = strtok(line, ",\r\n"); name; name = strtok(nullptr, ",\r\n"), ++index)
+            {
+                if (strcmp(name, column) == 0)
+                    columnIndex = index;
+            }
+            firstLine = false;
+            if (columnIndex < 0)
+            {
+                fprintf(stderr, "Column \"%s\" not found in \"%s\"!\n", column, path);
+                fclose(file);
+                return false;
+            }
+            continue;
+        }
+        firstLine = false;
+
+        const char* value = line;
+        for (int index = 0; index < columnIndex && value; ++index)
+        {
+            value = strchr(value, ',');
+            value = value ? value + 1 : nullptr;
+        }
+
+        char* end = nullptr;
+        const double frameTime = value ? strtod(value, &end) : 0.0;
+        if (end != value && frameTime > 0.0)
+            frameTimes.push_back(frameTime);
+    }
+
+    fclose(file);
+    return !frameTimes.empty();
+}
+
+static double simPercentile(std::vector<double> values, double percentile)
+{
+    if (values.empty())
+        return 0.0;
+
+    std::sort(values.begin(), values.end());
+    const size_t index = std::min(values.size() - 1, size_t(percentile * double(values.size() - 1) + 0.5));
+    return values[index];
+}
+
+static int simMeasureWait(const char* arg)
+{
+    const double waitUs = atof(arg);
+    const char*  next   = strchr(arg, ',');
+    const size_t count  = next ? size_t(strtoul(next + 1, nullptr, 10)) : 1000;
+    if (waitUs <= 0.0 || count == 0)
+    {
+        fprintf(stderr, "Invalid wait measurement \"%s\"!\n", arg);
+        return 1;
+    }
+
+    const int64_t frequency = PreciseWaiter::getFrequency();
+    const int64_t waitTicks = int64_t(waitUs * double(frequency) / 1000000.0);
+
+    for (uint32_t allowSleep = 1; allowSleep <= 1; allowSleep--)
+    {
+        PreciseWaiter waiter;
+        waiter.allowSleep = allowSleep != 0;
+
+        std::vector<double> lateness;
+        const clock_t       cpuStart  = clock();
+        const int64_t       wallStart = PreciseWaiter::getTicks();
+        for (size_t wait = 0; wait < count; ++wait)
+        {
+            const int64_t targetTicks = PreciseWaiter::getTicks() + waitTicks;
+            waiter.waitUntil(targetTicks);
+            lateness.push_back(double(PreciseWaiter::getTicks() - targetTicks) * 1000000.0 / double(frequency));
+        }
+        const double cpuSeconds  = double(clock() - cpuStart) / CLOCKS_PER_SEC;
+        const double wallSeconds = double(PreciseWaiter::getTicks() - wallStart) / double(frequency);
+
+        printf("%s %zu x %.0f us: late by %.1f us p50, %.1f us p99, %.1f us max, %.0f%% CPU",
+               allowSleep ? "Hybrid" : "Spin  ",
+               count,
+               waitUs,
+               simPercentile(lateness, 0.5),
+               simPercentile(lateness, 0.99),
+               simPercentile(lateness, 1.0),
+               100.0 * cpuSeconds / wallSeconds);
+        if (allowSleep)
+            printf(", %.1f us spin margin, %llu of %llu sleeps late",
+                   waiter.getSpinMarginInSec() * 1000000.0,
+                   (unsigned long long)waiter.getLateWakeCount(),
+                   (unsigned long long)waiter.getSleepCount());
+        printf("\n");
+    }
+
+    return 0;
+}
+
+// Window statistics recomputed from the history on every query, like the swapchains did before SlidingWindowStatistics
+template <const int Size>
+struct SimRecomputedStatistics
+{
+    double       history[Size] = {};
+    unsigned int idx           = 0;
+    unsigned int updateCount   = 0;
+
+    double getAverage()
+    {
+        if (updateCount < Size)
+            return 0.0;
+
+        double sum = 0.0;
+        for (unsigned int i = 0; i < Size; i++)
+            sum += history[i];
+        return sum / Size;
+    }
+
+    double getVariance()
+    {
+        if (updateCount < Size)
+            return 0.0;
+
+        const double average  = getAverage();
+        double       variance = 0.0;
+        for (unsigned int i = 0; i < Size; i++)
+            variance += (history[i] - average) * (history[i] - average);
+        return sqrt(variance / Size);
+    }
+
+    double getPercentile(double percentile)
+    {
+        if (updateCount < Size)
+            return 0.0;
+
+        double sorted[Size];
+        std::copy(history, history + Size, sorted);
+        std::sort(sorted, sorted + Size);
+
+        const double       position = percentile * (Size - 1);
+        const unsigned int lower    = unsigned(position);
+        const unsigned int upper    = std::min(lower + 1, unsigned(Size - 1));
+        return sorted[lower] + (sorted[upper] - sorted[lower]) * (position - lower);
+    }
+
+    void reset()
+    {
+        updateCount = 0;
+        idx         = 0;
+    }
+
+    void update(double newValue)
+    {
+        history[idx] = newValue;
+        idx          = (idx + 1) % Size;
+        updateCount++;
+    }
+};
+
+// Counts queries of the running statistics that differ from the recomputed ones. Frame times are in ticks of a 10 MHz
+// clock like the swapchains', a mismatch is a present delay the pacer would have rounded to a different tick.
+template <const int Size>
+static uint32_t simCheckStatistics(std::mt19937& random, uint32_t updates, double& maxRelativeError, uint32_t& percentileMismatches)
+{
+    SimRecomputedStatistics<Size>          reference;
+    SlidingWindowStatistics<Size, double>  statistics;
+    std::uniform_real_distribution<double> frameTicks(20000.0, 1000000.0);
+
+    uint32_t mismatches = 0;
+    for (uint32_t update = 0; update < updates; ++update)
+    {
+        // Whole ticks and a repeated value, as locked frame rates produce
+        double value = random() % 17 == 0 ? double(int64_t(frameTicks(random))) : frameTicks(random);
+        if (random() % 5 == 0)
+            value = 166667.0;
+
+        if (random() % 500 == 0)
+        {
+            reference.reset();
+            statistics.reset();
+        }
+        reference.update(value);
+        statistics.update(value);
+
+        const double expectedAverage  = reference.getAverage();
+        const double expectedVariance = reference.getVariance();
+        const double average          = statistics.getAverage();
+        const double variance         = statistics.getVariance();
+
+        const double scale = std::max(1.0, expectedAverage);
+        maxRelativeError   = std::max(maxRelativeError, std::abs(expectedAverage - average) / scale);
+        maxRelativeError   = std::max(maxRelativeError, std::abs(expectedVariance - variance) / scale);
+        if (int64_t(expectedAverage * 0.5 - expectedVariance * 0.1) != int64_t(average * 0.5 - variance * 0.1))
+            ++mismatches;
+
+        if (reference.updateCount >= Size)
+        {
+            for (double percentile : {0.0, 0.1, 0.5, 0.9, 1.0})
+            {
+                if (std::abs(reference.getPercentile(percentile) - statistics.getPercentile(percentile)) > 1e-6)
+                    ++percentileMismatches;
+            }
+        }
+    }
+
+    return mismatches;
+}
+
+// Nanoseconds per frame of an update and the average and deviation query the pacer makes
+template <typename Statistics>
+static double simTimeStatistics(uint32_t updates)
+{
+    Statistics                             statistics{};
+    std::mt19937                           random(3);
+    std::uniform_real_distribution<double> frameTicks(100000.0, 200000.0);
+    std::vector<double>                    values(4096);
+    for (double& value : values)
+        value = frameTicks(random);
+
+    volatile double sink  = 0.0;
+    const int64_t   start = PreciseWaiter::getTicks();
+    for (uint32_t update = 0; update < updates; ++update)
+    {
+        statistics.update(values[update & 4095]);
+        sink = sink + statistics.getAverage() * 0.5 - statistics.getVariance() * 0.1;
+    }
+    return double(PreciseWaiter::getTicks() - start) * 1000000000.0 / double(PreciseWaiter::getFrequency()) / updates;
+}
+
+static int simBenchStatistics(uint32_t updates)
+{
+    if (updates == 0)
+    {
+        fprintf(stderr, "Invalid update count!\n");
+        return 1;
+    }
+
+    std::mt19937 random(11);
+    double       maxRelativeError     = 0.0;
+    uint32_t     percentileMismatches = 0;
+    uint32_t     mismatches           = 0;
+    mismatches += simCheckStatistics<3>(random, updates, maxRelativeError, percentileMismatches);
+    mismatches += simCheckStatistics<10>(random, updates, maxRelativeError, percentileMismatches);
+    mismatches += simCheckStatistics<64>(random, updates, maxRelativeError, percentileMismatches);
+
+    printf("Checked:  %u updates, %u present delays off by a tick, %.3g max relative error, %u percentile mismatches\n",
+           3 * updates, mismatches, maxRelativeError, percentileMismatches);
+    printf("Size 10:  recomputed %.1f ns/frame, running %.1f ns/frame\n",
+           simTimeStatistics<SimRecomputedStatistics<10>>(updates * 50), simTimeStatistics<SlidingWindowStatistics<10, double>>(updates * 50));
+    printf("Size 64:  recomputed %.1f ns/frame, running %.1f ns/frame\n",
+           simTimeStatistics<SimRecomputedStatistics<64>>(updates * 10), simTimeStatistics<SlidingWindowStatistics<64, double>>(updates * 10));
+    printf("Size 256: recomputed %.1f ns/frame, running %.1f ns/frame\n",
+           simTimeStatistics<SimRecomputedStatistics<256>>(updates * 5), simTimeStatistics<SlidingWindowStatistics<256, double>>(updates * 5));
+
+    return percentileMismatches == 0 && maxRelativeError < 1e-6 ? 0 : 1;
+}
+
+int main(int argc, char** argv)
+{
+    if (argc == 2 && strncmp(argv[1], "-measure-wait=", 14) == 0)
+        return simMeasureWait(argv[1] + 14);
+
+    if (argc == 2 && strncmp(argv[1], "-bench-statistics", 17) == 0 && (argv[1][17] == '\0' || argv[1][17] == '='))
+        return simBenchStatistics(argv[1][17] == '=' ? uint32_t(strtoul(argv[1] + 18, nullptr, 10)) : 200000);
+
+    const char* tracePath       = nullptr;
+    const char* column          = "MsBetweenPresents";
+    const char* synthetic       = nullptr;
+    const char* dumpPath        = nullptr;
+    double      safetyMarginMs  = 0.1;
+    double      varianceFactor  = 0.1;
+    double      percentile      = 0.0;
+    double      wakeJitterMs    = 0.0;
+    double      refreshRate     = 0.0;
+    uint32_t    hitchEvery      = 0;
+    double      hitchMs         = 0.0;
+    uint32_t    seed            = 1;
+    uint32_t    warmupFrames    = 10;
+
+    for (int arg = 1; arg < argc; ++arg)
+    {
+        const char* value = nullptr;
+        if (simParseOption(argv[arg], "-safety-margin=", &value))
+            safetyMarginMs = atof(value);
+        else if (simParseOption(argv[arg], "-variance-factor=", &value))
+            varianceFactor = atof(value);
+        else if (simParseOption(argv[arg], "-percentile=", &value))
+            percentile = atof(value);
+        else if (simParseOption(argv[arg], "-wake-jitter=", &value))
+            wakeJitterMs = atof(value);
+        else if (simParseOption(argv[arg], "-refresh=", &value))
+            refreshRate = atof(value);
+        else if (simParseOption(argv[arg], "-hitch=", &value))
+        {
+            hitchEvery = uint32_t(strtoul(value, nullptr, 10));
+            const char* ms = strchr(value, ',');
+            hitchMs = ms ? atof(ms + 1) : 0.0;
+        }
+        else if (simParseOption(argv[arg], "-warmup=", &value))
+            warmupFrames = uint32_t(strtoul(value, nullptr, 10));
+        else if (simParseOption(argv[arg], "-seed=", &value))
+            seed = uint32_t(strtoul(value, nullptr, 10));
+        else if (simParseOption(argv[arg], "-column=", &value))
+            column = value;
+        else if (simParseOption(argv[arg], "-synthetic=", &value))
+            synthetic = value;
+        else if (simParseOption(argv[arg], "-dump=", &value))
+            dumpPath = value;
+        else if (argv[arg][0] != '-' && tracePath == nullptr)
+            tracePath = argv[arg];
+        else
+        {
+            tracePath = nullptr;
+            synthetic = nullptr;
+            break;
+        }
+    }
+
+    if ((tracePath == nullptr) == (synthetic == nullptr))
+    {
+        fprintf(stderr, "Usage: %s [options] <trace>\n", argv[0]);
+        fprintf(stderr, "       %s [options] -synthetic=<fps>[,<jitter %%>[,<frames>]]\n", argv[0]);
+        fprintf(stderr, "       %s -measure-wait=<us>[,<count>]\n", argv[0]);
+        fprintf(stderr, "       %s -bench-statistics[=<updates>]\n", argv[0]);
+        fprintf(stderr, "Options: -safety-margin=<ms> -variance-factor=<f> -percentile=<p> -wake-jitter=<ms> -refresh=<Hz>\n");
+        fprintf(stderr, "         -warmup=<frames> -hitch=<every>,<ms> -seed=<n> -column=<name> -dump=<file>\n");
+        return 1;
+    }
+
+    std::mt19937 random(seed);
+
+    std::vector<double> frameTimes;
+    if (synthetic)
+    {
+        double   fps       = atof(synthetic);
+        double   jitter    = 0.0;
+        uint32_t numFrames = 1000;
+        if (const char* next = strchr(synthetic, ','))
+        {
+            jitter = atof(next + 1) / 100.0;
+            if ((next = strchr(next + 1, ',')))
+                numFrames = uint32_t(strtoul(next + 1, nullptr, 10));
+        }
+        if (fps <= 0.0 || numFrames == 0)
+        {
+            fprintf(stderr, "Invalid synthetic trace \"%s\"!\n", synthetic);
+            return 1;
+        }
+
+        std::uniform_real_distribution<double> distribution(1.0 - jitter, 1.0 + jitter);
+        for (uint32_t frame = 0; frame < numFrames; ++frame)
+        {
+            const bool hitch = hitchEvery && (frame + 1) % hitchEvery == 0;
+            frameTimes.push_back(hitch ? hitchMs : 1000.0 / fps * distribution(random));
+        }
+    }
+    else if (!simReadTrace(tracePath, column, frameTimes))
+    {
+        fprintf(stderr, "Cannot read frame times from \"%s\"!\n", tracePath);
+        return 1;
+    }
+
+    FrameInterpolationSimulatedClock clock;
+    const int64_t frequency   = clock.getFrequency();
+    const double  ticksPerMs  = double(frequency) / 1000.0;
+    const int64_t refreshTicks = refreshRate > 0.0 ? int64_t(double(frequency) / refreshRate) : 0;
+
+    FrameInterpolationPacer pacer(clock);
+    pacer.safetyMarginInSec   = safetyMarginMs / 1000.0;
+    pacer.varianceFactor      = varianceFactor;
+    pacer.frameTimePercentile = percentile;
+    pacer.reset();
+
+    // Interpolation of a game frame completes when the next game frame is presented, which is when the interpolation
+    // thread calls scheduleFrame. It doesn't depend on the presenter, so all of them are scheduled up front.
+    const size_t         numFrames = frameTimes.size();
+    std::vector<int64_t> readyTicks(numFrames);
+    std::vector<int64_t> presentDeltas(numFrames);
+    int64_t              ticks = clock.getTicks();
+    for (size_t frame = 0; frame < numFrames; ++frame)
+    {
+        ticks += int64_t(frameTimes[frame] * ticksPerMs);
+        readyTicks[frame] = ticks;
+
+        clock.setTicks(ticks);
+        presentDeltas[frame] = pacer.scheduleFrame(false);
+    }
+
+    // The presenter takes the scheduled frame once it finished the previous one. There is only a single slot for
+    // scheduled frames, a frame is dropped if the next one is scheduled before the presenter got to it.
+    std::vector<SimPresent> presents;
+    std::uniform_real_distribution<double> wakeJitter(0.0, wakeJitterMs * ticksPerMs);
+    SimPresentSink sink;
+    sink.clock    = &clock;
+    sink.presents     = &presents;
+    sink.refreshTicks = refreshTicks;
+
+    uint32_t droppedFrames  = 0;
+    int64_t  presenterTicks = 0;
+    for (size_t frame = 0; frame < numFrames; ++frame)
+    {
+        if (frame + 1 < numFrames && presenterTicks > readyTicks[frame + 1])
+        {
+            ++droppedFrames;
+            continue;
+        }
+
+        clock.setTicks(std::max(presenterTicks, readyTicks[frame]));
+        sink.gameFrame = uint32_t(frame);
+        for (uint32_t frameType = 0; frameType < SIM_FRAME_COUNT; ++frameType)
+        {
+            clock.wakeUpLatency = int64_t(wakeJitter(random));
+            pacer.presentFrame(presentDeltas[frame], sink, frameType);
+        }
+        presenterTicks = clock.getTicks();
+    }
+
+    // The interpolated frame shows the middle of the previous and the current game frame
+    size_t firstPresent = presents.size();
+    for (size_t index = 0; index < presents.size(); ++index)
+    {
+        SimPresent&    present   = presents[index];
+        const uint32_t gameFrame = present.gameFrame;
+        if (present.frameType == SIM_FRAME_REAL || gameFrame == 0)
+            present.contentTicks = double(readyTicks[gameFrame]);
+        else
+            present.contentTicks = 0.5 * double(readyTicks[gameFrame - 1] + readyTicks[gameFrame]);
+
+        if (gameFrame >= warmupFrames)
+            firstPresent = std::min(firstPresent, index);
+    }
+
+    if (presents.size() < firstPresent + 3)
+    {
+        fprintf(stderr, "Not enough frames presented for statistics!\n");
+        return 1;
+    }
+
+    double              intervalSum   = 0.0;
+    double              intervalSqSum = 0.0;
+    double              judderSqSum   = 0.0;
+    std::vector<double> intervals;
+    std::vector<double> latencies;
+    for (size_t index = firstPresent + 1; index < presents.size(); ++index)
+    {
+        const double interval = double(presents[index].displayTicks - presents[index - 1].displayTicks) / ticksPerMs;
+        const double content  = (presents[index].contentTicks - presents[index - 1].contentTicks) / ticksPerMs;
+
+        intervals.push_back(interval);
+        intervalSum += interval;
+        intervalSqSum += interval * interval;
+        judderSqSum += (interval - content) * (interval - content);
+    }
+    for (size_t index = firstPresent; index < presents.size(); ++index)
+    {
+        const SimPresent& present = presents[index];
+        if (present.frameType == SIM_FRAME_REAL)
+            latencies.push_back(double(present.displayTicks - readyTicks[present.gameFrame]) / ticksPerMs);
+    }
+
+    double latencySum = 0.0;
+    for (double latency : latencies)
+        latencySum += latency;
+
+    const double count        = double(intervals.size());
+    const double intervalMean = intervalSum / count;
+    const double intervalVar  = std::max(0.0, intervalSqSum / count - intervalMean * intervalMean);
+
+    double gameFrameSum = 0.0;
+    for (double frameTime : frameTimes)
+        gameFrameSum += frameTime;
+
+    printf("Game frames:          %zu, %.3f ms average\n", numFrames, gameFrameSum / double(numFrames));
+    printf("Presents:             %zu, %u game frames dropped\n", presents.size(), droppedFrames);
+    printf("Present interval:     %.3f ms mean, %.3f ms stddev, %.3f ms p99\n", intervalMean, sqrt(intervalVar), simPercentile(intervals, 0.99));
+    printf("Judder:               %.3f ms RMS\n", sqrt(judderSqSum / count));
+    printf("Added latency:        %.3f ms mean, %.3f ms p99\n", latencySum / double(latencies.size()), simPercentile(latencies, 0.99));
+
+    if (dumpPath)
+    {
+        FILE* dump = fopen(dumpPath, "w");
+        if (dump == nullptr)
+        {
+            fprintf(stderr, "Cannot open dump file \"%s\"!\n", dumpPath);
+            return 1;
+        }
+
+        fprintf(dump, "GameFrame,Interpolated,PresentMs,DisplayMs,ContentMs\n");
+        for (const SimPresent& present : presents)
+        {
+            fprintf(dump, "%u,%u,%.4f,%.4f,%.4f\n",
+                    present.gameFrame,
+                    present.frameType == SIM_FRAME_INTERPOLATED,
+                    double(present.presentTicks) / ticksPerMs,
+                    double(present.displayTicks) / ticksPerMs,
+                    present.contentTicks / ticksPerMs);
+        }
+        fclose(dump);
+    }
+
+    return 0;
+}
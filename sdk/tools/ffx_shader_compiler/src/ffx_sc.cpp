@@ -22,6 +22,7 @@
 
 #include "hlsl_compiler.h"
 #include "glsl_compiler.h"
+#include "shader_archive.h"
 #include "utils.h"
 
 #include <Windows.h>
@@ -110,12 +111,15 @@ struct LaunchParameters
     std::wstring                   d3dDll;
     std::wstring                   glslangExe;
     std::wstring                   deps;
+    std::wstring                   packArchive;
     int                            numThreads         = 0;
     bool                           generateReflection = false;
     bool                           embedArguments     = false;
     bool                           printArguments     = false;
     bool                           disableLogs        = false;
     bool                           debugCompile       = false;
+    bool                           archive            = false;
+    bool                           compressArchive    = false;
 
     static void PrintCommandLineSyntax();
     void        ParseCommandLine(int argCount, const wchar_t* const* args);
@@ -124,6 +128,7 @@ private:
     static void ParsePermutationOption(PermutationOption& outPermutationOption, const std::wstring arg);
     static void ParseString(std::wstring& outCompilerArg, const wchar_t* arg);
     static void ParseNumThreads(int& outNumThreads, const wchar_t* arg);
+    void        ParseArchive(const wchar_t* arg);
     static void EnsureOutputPathExistsAndMakeCanonical(std::wstring & inoutOutputPath);
 };
 
@@ -139,6 +144,7 @@ private:
     int                                  m_LastPermutationIndex = 0;
     std::unordered_map<int, int>         m_KeyToIndexMap;
     std::unordered_map<std::string, int> m_HashToIndexMap;
+    std::vector<ShaderArchiveBlob>       m_ArchiveBlobs;
     std::wstring                         m_ShaderFileName;
     std::wstring                         m_ShaderName;
 
@@ -148,6 +154,7 @@ public:
     {
     }
     void Process();
+    void PackShaderArchives();
 
 private:
     static std::wstring MakeFullPath(const std::wstring& outputPath, const std::wstring& fileName);
@@ -205,6 +212,11 @@ void LaunchParameters::PrintCommandLineSyntax()
         L"  Dump depfile which recorded the include file dependencies in format of (gcc or msvc).\n"
         L"-debugcompile\n"
         L"  Compile shader with debug information.\n"
+        L"-archive[=<Compression>]\n"
+        L"  Write the shader binaries to <Name>_permutations.bin instead of embedding them in the headers.\n"
+        L"  The binaries can be stored compressed (none or lz4), uncompressed by default.\n"
+        L"-pack-archive=<ListFile>\n"
+        L"  Merge the archives listed in the file (one path per line) into the archive <Output>\\<Name>, no shader is compiled.\n"
         L"-debugcmdline\n"
         L"  Print all the input arguments.\n"
     );
@@ -275,6 +287,10 @@ void LaunchParameters::ParseCommandLine(int argCount, const wchar_t* const* args
             ParseString(glslangExe, args[i]);
         else if (StartsWith(args[i], L"-deps"))
             ParseString(deps, args[i]);
+        else if (StartsWith(args[i], L"-pack-archive"))
+            ParseString(packArchive, args[i]);
+        else if (StartsWith(args[i], L"-archive"))
+            ParseArchive(args[i]);
         else if (std::wstring(args[i]) == L"-reflection")
             generateReflection = true;
         else if (std::wstring(args[i]) == L"-embed-arguments")
@@ -387,6 +403,20 @@ void LaunchParameters::ParseNumThreads(int& outNumThreads, const wchar_t* arg)
     outNumThreads         = std::stoi(argStr.substr(equalPos + 1, argStr.length() - equalPos));
 }
 
+void LaunchParameters::ParseArchive(const wchar_t* arg)
+{
+    archive = true;
+
+    std::wstring compression;
+    if (Contains(arg, L"="))
+        ParseString(compression, arg);
+
+    if (compression == L"lz4")
+        compressArchive = true;
+    else if (!compression.empty() && compression != L"none")
+        throw std::runtime_error("Unknown archive compression requested (valid options: none or lz4)");
+}
+
 Application::Application(const LaunchParameters& params)
     : m_Params(params) {}
 
@@ -848,6 +878,18 @@ void Application::WriteShaderBinaryHeader(Permutation& permutation)
 
     fprintf(fp, "static const uint32_t g_%s_size = %d;\n\n", permutationName.c_str(), (int)shaderBinarySize);
 
+    if (m_Params.archive)
+    {
+        ShaderArchiveBlob archiveBlob = MakeShaderArchiveBlob(permutationName, shaderBinary, shaderBinarySize, m_Params.compressArchive);
+
+        fprintf(fp, "static const uint64_t g_%s_archiveKey = 0x%016llxull;\n\n", permutationName.c_str(), (unsigned long long)archiveBlob.key);
+        fclose(fp);
+
+        std::lock_guard<std::mutex> guard(m_WriteMutex);
+        m_ArchiveBlobs.push_back(std::move(archiveBlob));
+        return;
+    }
+
     fprintf(fp, "static const unsigned char g_%s_data[] = {\n", permutationName.c_str());
 
     for (int32_t i = 0; i < shaderBinarySize; ++i)
@@ -991,7 +1033,13 @@ void Application::WriteShaderPermutationsHeader()
     // ------------------------------------------------------------------------------------------------
     fprintf(fp, "typedef struct %s_PermutationInfo {\n", shaderName.c_str());
     fprintf(fp, "    const uint32_t       blobSize;\n");
-    fprintf(fp, "    const unsigned char* blobData;\n\n");
+    fprintf(fp, "    const unsigned char* blobData;\n");
+
+    // only archived permutations have a key, so headers without an archive keep the layout of older versions
+    if (m_Params.archive)
+        fprintf(fp, "    const uint64_t       blobArchiveKey;\n");
+
+    fprintf(fp, "\n");
 
     if (m_Params.generateReflection)
         m_Compiler->WritePermutationHeaderReflectionStructMembers(fp);
@@ -1028,7 +1076,11 @@ void Application::WriteShaderPermutationsHeader()
 
             std::string permutationName = shaderName + "_" + permutation.hashDigest;
 
-            fprintf(fp, "    { g_%s_size, g_%s_data, ", permutationName.c_str(), permutationName.c_str());
+            // archived blobs are loaded by the backend on first use, only their size and key are compiled in
+            if (m_Params.archive)
+                fprintf(fp, "    { g_%s_size, nullptr, g_%s_archiveKey, ", permutationName.c_str(), permutationName.c_str());
+            else
+                fprintf(fp, "    { g_%s_size, g_%s_data, ", permutationName.c_str(), permutationName.c_str());
 
             if (m_Params.generateReflection)
                 m_Compiler->WritePermutationHeaderReflectionData(fp, permutation);
@@ -1040,6 +1092,38 @@ void Application::WriteShaderPermutationsHeader()
     }
 
     fclose(fp);
+
+    if (m_Params.archive)
+        WriteShaderArchive(MakeFullPath(m_Params.ouputPath, m_ShaderName + L"_permutations.bin"), m_ArchiveBlobs);
+}
+
+void Application::PackShaderArchives()
+{
+    std::ifstream listFile(std::filesystem::path(m_Params.packArchive));
+    if (!listFile)
+        throw std::runtime_error("Failed to open archive list " + WCharToUTF8(m_Params.packArchive));
+
+    std::vector<ShaderArchiveBlob> blobs;
+    size_t                         archiveCount = 0;
+
+    std::string line;
+    while (std::getline(listFile, line))
+    {
+        if (!line.empty() && line.back() == '\r')
+            line.pop_back();
+        if (line.empty())
+            continue;
+
+        ReadShaderArchive(UTF8ToWChar(line), blobs);
+        archiveCount++;
+    }
+
+    if (m_Params.shaderName.empty())
+        throw std::runtime_error("No archive name given, please use the -name option");
+
+    WriteShaderArchive(MakeFullPath(m_Params.ouputPath, m_Params.shaderName), blobs);
+
+    printf("%s: Packed %zu shader archives.\n", WCharToUTF8(m_Params.shaderName).c_str(), archiveCount);
 }
 
 void Application::DumpDepfileGCC()
@@ -1098,7 +1182,10 @@ int wmain(int argc, wchar_t** argv)
         params.ParseCommandLine(argc - 1, argv + 1);
 
         Application app(params);
-        app.Process();
+        if (params.packArchive.empty())
+            app.Process();
+        else
+            app.PackShaderArchives();
 
         return 0;
     }
@@ -964,6 +964,17 @@ void HLSLCompiler::WriteBinaryHeaderReflectionData(FILE* fp, const Permutation&
 
                 fprintf(fp, " };\n");
 
+                fprintf(fp, "static const uint32_t g_%s_%sResourceNameHashes[] = { ", permutationName.c_str(), resourceTypeString.c_str());
+
+                for (int j = 0; j < resourceInfo.size(); j++)
+                {
+                    const ShaderResourceInfo& info = resourceInfo[j];
+
+                    fprintf(fp, " 0x%08x,", GetResourceNameHash(info.name));
+                }
+
+                fprintf(fp, " };\n");
+
                 fprintf(fp, "static const uint32_t g_%s_%sResourceBindings[] = { ", permutationName.c_str(), resourceTypeString.c_str());
 
                 for (int j = 0; j < resourceInfo.size(); j++)
@@ -1026,42 +1037,49 @@ void HLSLCompiler::WritePermutationHeaderReflectionStructMembers(FILE* fp)
     fprintf(fp, "\n");
     fprintf(fp, "    const uint32_t  numConstantBuffers;\n");
     fprintf(fp, "    const char**    constantBufferNames;\n");
+    fprintf(fp, "    const uint32_t* constantBufferNameHashes;\n");
     fprintf(fp, "    const uint32_t* constantBufferBindings;\n");
     fprintf(fp, "    const uint32_t* constantBufferCounts;\n");
     fprintf(fp, "    const uint32_t* constantBufferSpaces;\n");
     fprintf(fp, "\n");
     fprintf(fp, "    const uint32_t  numSRVTextures;\n");
     fprintf(fp, "    const char**    srvTextureNames;\n");
+    fprintf(fp, "    const uint32_t* srvTextureNameHashes;\n");
     fprintf(fp, "    const uint32_t* srvTextureBindings;\n");
     fprintf(fp, "    const uint32_t* srvTextureCounts;\n");
     fprintf(fp, "    const uint32_t* srvTextureSpaces;\n");
     fprintf(fp, "\n");
     fprintf(fp, "    const uint32_t  numUAVTextures;\n");
     fprintf(fp, "    const char**    uavTextureNames;\n");
+    fprintf(fp, "    const uint32_t* uavTextureNameHashes;\n");
     fprintf(fp, "    const uint32_t* uavTextureBindings;\n");
     fprintf(fp, "    const uint32_t* uavTextureCounts;\n");
     fprintf(fp, "    const uint32_t* uavTextureSpaces;\n");
     fprintf(fp, "\n");
     fprintf(fp, "    const uint32_t  numSRVBuffers;\n");
     fprintf(fp, "    const char**    srvBufferNames;\n");
+    fprintf(fp, "    const uint32_t* srvBufferNameHashes;\n");
     fprintf(fp, "    const uint32_t* srvBufferBindings;\n");
     fprintf(fp, "    const uint32_t* srvBufferCounts;\n");
     fprintf(fp, "    const uint32_t* srvBufferSpaces;\n");
     fprintf(fp, "\n");
     fprintf(fp, "    const uint32_t  numUAVBuffers;\n");
     fprintf(fp, "    const char**    uavBufferNames;\n");
+    fprintf(fp, "    const uint32_t* uavBufferNameHashes;\n");
     fprintf(fp, "    const uint32_t* uavBufferBindings;\n");
     fprintf(fp, "    const uint32_t* uavBufferCounts;\n");
     fprintf(fp, "    const uint32_t* uavBufferSpaces;\n");
     fprintf(fp, "\n");
     fprintf(fp, "    const uint32_t  numSamplers;\n");
     fprintf(fp, "    const char**    samplerNames;\n");
+    fprintf(fp, "    const uint32_t* samplerNameHashes;\n");
     fprintf(fp, "    const uint32_t* samplerBindings;\n");
     fprintf(fp, "    const uint32_t* samplerCounts;\n");
     fprintf(fp, "    const uint32_t* samplerSpaces;\n");
     fprintf(fp, "\n");
     fprintf(fp, "    const uint32_t  numRTAccelerationStructures;\n");
     fprintf(fp, "    const char**    rtAccelerationStructureNames;\n");
+    fprintf(fp, "    const uint32_t* rtAccelerationStructureNameHashes;\n");
     fprintf(fp, "    const uint32_t* rtAccelerationStructureBindings;\n");
     fprintf(fp, "    const uint32_t* rtAccelerationStructureCounts;\n");
     fprintf(fp, "    const uint32_t* rtAccelerationStructureSpaces;\n");
@@ -1074,12 +1092,12 @@ void HLSLCompiler::WritePermutationHeaderReflectionData(FILE* fp, const Permutat
     const auto WriteResourceInfo = [](FILE* fp, const int& numResources, const std::string& permutationName, const std::string& resourceTypeString) {
         if (numResources == 0)
         {
-            fprintf(fp, "0, 0, 0, 0, 0, ");
+            fprintf(fp, "0, 0, 0, 0, 0, 0, ");
         }
         else
         {
             fprintf(fp,
-                    "%i, g_%s_%sResourceNames, g_%s_%sResourceBindings, g_%s_%sResourceCounts, g_%s_%sResourceSpaces, ",
+                    "%i, g_%s_%sResourceNames, g_%s_%sResourceNameHashes, g_%s_%sResourceBindings, g_%s_%sResourceCounts, g_%s_%sResourceSpaces, ",
                     numResources,
                     permutationName.c_str(),
                     resourceTypeString.c_str(),
@@ -1088,6 +1106,8 @@ void HLSLCompiler::WritePermutationHeaderReflectionData(FILE* fp, const Permutat
                     permutationName.c_str(),
                     resourceTypeString.c_str(),
                     permutationName.c_str(),
+                    resourceTypeString.c_str(),
+                    permutationName.c_str(),
                     resourceTypeString.c_str());
         }
     };
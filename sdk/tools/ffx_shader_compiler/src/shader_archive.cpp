@@ -0,0 +1,238 @@
+// This file is part of the FidelityFX SDK.
+//
+// Copyright (C) 2024 Advanced Micro Devices, Inc.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "shader_archive.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string.h>
+
+// LZ4 block format limits: matches are at least 4 bytes, the last 5 bytes are always literals and the last match has
+// to start at least 12 bytes before the end of the block.
+static const size_t LZ4_MIN_MATCH       = 4;
+static const size_t LZ4_LAST_LITERALS   = 5;
+static const size_t LZ4_MATCH_FIND_END  = 12;
+static const size_t LZ4_MAX_OFFSET      = 65535;
+static const int    LZ4_HASH_TABLE_BITS = 16;
+
+static uint32_t ReadUInt32(const uint8_t* data)
+{
+    uint32_t value;
+    memcpy(&value, data, sizeof(value));
+    return value;
+}
+
+static uint32_t HashSequence(const uint8_t* data)
+{
+    return (ReadUInt32(data) * 2654435761u) >> (32 - LZ4_HASH_TABLE_BITS);
+}
+
+static void WriteLength(std::vector<uint8_t>& output, size_t length)
+{
+    for (; length >= 255; length -= 255)
+        output.push_back(255);
+    output.push_back(uint8_t(length));
+}
+
+static void WriteSequence(std::vector<uint8_t>& output, const uint8_t* literals, size_t literalLength, size_t matchOffset, size_t matchLength)
+{
+    const size_t matchToken = matchLength ? matchLength - LZ4_MIN_MATCH : 0;
+
+    output.push_back(uint8_t((std::min<size_t>(literalLength, 15) << 4) | std::min<size_t>(matchToken, 15)));
+    if (literalLength >= 15)
+        WriteLength(output, literalLength - 15);
+    output.insert(output.end(), literals, literals + literalLength);
+
+    if (matchLength)
+    {
+        output.push_back(uint8_t(matchOffset & 0xFF));
+        output.push_back(uint8_t(matchOffset >> 8));
+        if (matchToken >= 15)
+            WriteLength(output, matchToken - 15);
+    }
+}
+
+std::vector<uint8_t> CompressLZ4Block(const uint8_t* data, size_t size)
+{
+    std::vector<uint8_t> output;
+    output.reserve(size + size / 255 + 16);
+
+    const uint8_t* anchor = data;
+    const uint8_t* end    = data + size;
+
+    if (size > LZ4_MATCH_FIND_END)
+    {
+        // greedy parse, remembering the last position of every hashed 4 byte sequence
+        std::vector<uint32_t> hashTable(size_t(1) << LZ4_HASH_TABLE_BITS, UINT32_MAX);
+
+        const uint8_t* matchFindEnd = end - LZ4_MATCH_FIND_END;
+        const uint8_t* matchEnd     = end - LZ4_LAST_LITERALS;
+        const uint8_t* current      = data;
+
+        while (current < matchFindEnd)
+        {
+            const uint32_t hash      = HashSequence(current);
+            const uint32_t candidate = hashTable[hash];
+            hashTable[hash]          = uint32_t(current - data);
+
+            if (candidate == UINT32_MAX || size_t(current - data) - candidate > LZ4_MAX_OFFSET || ReadUInt32(data + candidate) != ReadUInt32(current))
+            {
+                ++current;
+                continue;
+            }
+
+            const uint8_t* match       = data + candidate;
+            size_t         matchLength = LZ4_MIN_MATCH;
+            while (current + matchLength < matchEnd && current[matchLength] == match[matchLength])
+                ++matchLength;
+
+            WriteSequence(output, anchor, size_t(current - anchor), size_t(current - match), matchLength);
+
+            current += matchLength;
+            anchor = current;
+
+            if (current - 2 < matchFindEnd)
+                hashTable[HashSequence(current - 2)] = uint32_t(current - 2 - data);
+        }
+    }
+
+    WriteSequence(output, anchor, size_t(end - anchor), 0, 0);
+    return output;
+}
+
+ShaderArchiveBlob MakeShaderArchiveBlob(const std::string& permutationName, const uint8_t* data, size_t size, bool compress)
+{
+    ShaderArchiveBlob blob;
+    blob.key         = ffxGetShaderArchiveKey(permutationName.c_str());
+    blob.size        = uint32_t(size);
+    blob.compression = FFX_SHADER_ARCHIVE_COMPRESSION_NONE;
+
+    if (compress)
+    {
+        std::vector<uint8_t> compressedData = CompressLZ4Block(data, size);
+
+        std::vector<uint8_t> decompressedData(size);
+        if (!ffxShaderArchiveDecompressLZ4(compressedData.data(), compressedData.size(), decompressedData.data(), size) ||
+            memcmp(decompressedData.data(), data, size) != 0)
+            throw std::runtime_error("Failed to compress shader binary of " + permutationName);
+
+        if (compressedData.size() < size)
+        {
+            blob.compression = FFX_SHADER_ARCHIVE_COMPRESSION_LZ4;
+            blob.storedData  = std::move(compressedData);
+            return blob;
+        }
+    }
+
+    blob.storedData.assign(data, data + size);
+    return blob;
+}
+
+void WriteShaderArchive(const std::wstring& path, std::vector<ShaderArchiveBlob>& blobs)
+{
+    std::sort(blobs.begin(), blobs.end(), [](const ShaderArchiveBlob& a, const ShaderArchiveBlob& b) { return a.key < b.key; });
+
+    // the same permutation can be packed more than once, but a key must never stand for two different blobs
+    std::vector<ShaderArchiveBlob*> uniqueBlobs;
+    for (ShaderArchiveBlob& blob : blobs)
+    {
+        if (!uniqueBlobs.empty() && uniqueBlobs.back()->key == blob.key)
+        {
+            if (uniqueBlobs.back()->size != blob.size || uniqueBlobs.back()->storedData != blob.storedData)
+                throw std::runtime_error("Shader archive key collision");
+            continue;
+        }
+
+        uniqueBlobs.push_back(&blob);
+    }
+
+    FfxShaderArchiveHeader header = {};
+    header.magic                  = FFX_SHADER_ARCHIVE_MAGIC;
+    header.version                = FFX_SHADER_ARCHIVE_VERSION;
+    header.entryCount             = uint32_t(uniqueBlobs.size());
+
+    std::vector<FfxShaderArchiveEntry> entries(uniqueBlobs.size());
+
+    uint64_t offset = sizeof(FfxShaderArchiveHeader) + entries.size() * sizeof(FfxShaderArchiveEntry);
+    for (size_t i = 0; i < uniqueBlobs.size(); ++i)
+    {
+        // keep blobs used in place aligned for the runtime APIs consuming them
+        offset = (offset + 15) & ~uint64_t(15);
+
+        entries[i]             = {};
+        entries[i].key         = uniqueBlobs[i]->key;
+        entries[i].offset      = offset;
+        entries[i].storedSize  = uint32_t(uniqueBlobs[i]->storedData.size());
+        entries[i].size        = uniqueBlobs[i]->size;
+        entries[i].compression = uniqueBlobs[i]->compression;
+
+        offset += entries[i].storedSize;
+    }
+
+    std::ofstream file(std::filesystem::path(path), std::ios::binary | std::ios::trunc);
+    if (!file)
+        throw std::runtime_error("Failed to open shader archive for writing");
+
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(entries.data()), entries.size() * sizeof(FfxShaderArchiveEntry));
+
+    for (size_t i = 0; i < uniqueBlobs.size(); ++i)
+    {
+        static const char padding[16] = {};
+        file.write(padding, std::streamsize(entries[i].offset - uint64_t(file.tellp())));
+        file.write(reinterpret_cast<const char*>(uniqueBlobs[i]->storedData.data()), uniqueBlobs[i]->storedData.size());
+    }
+
+    if (!file)
+        throw std::runtime_error("Failed to write shader archive");
+}
+
+void ReadShaderArchive(const std::wstring& path, std::vector<ShaderArchiveBlob>& blobs)
+{
+    std::ifstream file(std::filesystem::path(path), std::ios::binary);
+
+    FfxShaderArchiveHeader header = {};
+    if (!file.read(reinterpret_cast<char*>(&header), sizeof(header)) || header.magic != FFX_SHADER_ARCHIVE_MAGIC ||
+        header.version != FFX_SHADER_ARCHIVE_VERSION)
+        throw std::runtime_error("Invalid shader archive");
+
+    std::vector<FfxShaderArchiveEntry> entries(header.entryCount);
+    if (!file.read(reinterpret_cast<char*>(entries.data()), entries.size() * sizeof(FfxShaderArchiveEntry)))
+        throw std::runtime_error("Invalid shader archive");
+
+    for (const FfxShaderArchiveEntry& entry : entries)
+    {
+        ShaderArchiveBlob blob;
+        blob.key         = entry.key;
+        blob.size        = entry.size;
+        blob.compression = entry.compression;
+        blob.storedData.resize(entry.storedSize);
+
+        file.seekg(std::streamoff(entry.offset));
+        if (!file.read(reinterpret_cast<char*>(blob.storedData.data()), entry.storedSize))
+            throw std::runtime_error("Invalid shader archive");
+
+        blobs.push_back(std::move(blob));
+    }
+}
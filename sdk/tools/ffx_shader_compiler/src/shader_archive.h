@@ -0,0 +1,49 @@
+// This file is part of the FidelityFX SDK.
+//
+// Copyright (C) 2024 Advanced Micro Devices, Inc.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#pragma once
+
+#include <ffx_shader_archive_format.h>
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+struct ShaderArchiveBlob
+{
+    uint64_t             key;          ///< ffxGetShaderArchiveKey of the permutation name.
+    uint32_t             size;         ///< Size of the shader binary.
+    uint32_t             compression;  ///< FfxShaderArchiveCompression of the stored data.
+    std::vector<uint8_t> storedData;   ///< Shader binary as stored in the archive.
+};
+
+// Creates the archive blob for a shader binary, compressed if that makes it smaller.
+ShaderArchiveBlob MakeShaderArchiveBlob(const std::string& permutationName, const uint8_t* data, size_t size, bool compress);
+
+// Compresses data into the LZ4 block format.
+std::vector<uint8_t> CompressLZ4Block(const uint8_t* data, size_t size);
+
+// Writes an archive of the blobs sorted by key. Throws if two different blobs have the same key.
+void WriteShaderArchive(const std::wstring& path, std::vector<ShaderArchiveBlob>& blobs);
+
+// Appends the blobs of an archive written by WriteShaderArchive.
+void ReadShaderArchive(const std::wstring& path, std::vector<ShaderArchiveBlob>& blobs);
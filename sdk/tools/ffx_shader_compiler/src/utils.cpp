@@ -49,3 +49,15 @@ std::wstring UTF8ToWChar(const std::string& str)
 
     return wstr;
 }
+
+uint32_t GetResourceNameHash(const std::string& name)
+{
+    uint32_t hash = 2166136261u;
+    for (const char character : name)
+    {
+        hash ^= uint8_t(character);
+        hash *= 16777619u;
+    }
+
+    return hash;
+}
@@ -27,3 +27,6 @@
 
 std::string WCharToUTF8(const std::wstring& wstr);
 std::wstring UTF8ToWChar(const std::string& str);
+
+// 32-bit FNV-1a hash of a resource bind point name, must match ffxGetResourceBindingNameHash in the SDK
+uint32_t GetResourceNameHash(const std::string& name);